@@ -0,0 +1,15 @@
+#version 460 core
+
+layout(location = 0) in vec4 in_color;
+layout(location = 1) in vec3 in_normal;
+
+layout(location = 0) out vec4 out_color;
+
+void main()
+{
+    // A fixed directional light over an ambient term, enough to tell shapes apart
+    const vec3 lightDirection = normalize(vec3(0.4, -1.0, 0.3));
+
+    float diffuse = max(dot(normalize(in_normal), -lightDirection), 0.0);
+    out_color     = vec4(in_color.rgb * (0.25 + 0.75 * diffuse), in_color.a);
+}
@@ -0,0 +1,31 @@
+#version 460 core
+
+#include "include/MeshData.glsl"
+
+layout(location = 0) in vec3 in_position;
+layout(location = 1) in vec3 in_normal;
+layout(location = 2) in vec2 in_uv;
+
+layout(push_constant) uniform Camera
+{
+    mat4 view_projection;
+} u_camera;
+
+layout(std430, set = 0, binding = 0) readonly buffer Instances
+{
+    MeshInstance u_instances[];
+};
+
+layout(location = 0) out vec4 out_color;
+layout(location = 1) out vec3 out_normal;
+
+void main()
+{
+    // Every indirect draw is a single instance, firstInstance being the instance's index
+    MeshInstance instance = u_instances[gl_InstanceIndex];
+
+    gl_Position = u_camera.view_projection * instance.transform * vec4(in_position, 1.0);
+
+    out_color  = instance.color;
+    out_normal = mat3(instance.transform) * in_normal;
+}
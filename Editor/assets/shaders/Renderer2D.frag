@@ -0,0 +1,38 @@
+#version 460 core
+
+layout(location = 0) in vec4 in_color;
+layout(location = 1) in vec2 in_uv;
+layout(location = 2) flat in uint in_texture_index;
+
+layout(set = 0, binding = 0) uniform sampler2D u_textures[16];
+
+layout(location = 0) out vec4 out_color;
+
+// The index varies within a draw, so without descriptor indexing every slot needs its own constant index
+vec4 SampleTexture(uint index, vec2 uv)
+{
+    switch (index)
+    {
+        case 0:  return texture(u_textures[0], uv);
+        case 1:  return texture(u_textures[1], uv);
+        case 2:  return texture(u_textures[2], uv);
+        case 3:  return texture(u_textures[3], uv);
+        case 4:  return texture(u_textures[4], uv);
+        case 5:  return texture(u_textures[5], uv);
+        case 6:  return texture(u_textures[6], uv);
+        case 7:  return texture(u_textures[7], uv);
+        case 8:  return texture(u_textures[8], uv);
+        case 9:  return texture(u_textures[9], uv);
+        case 10: return texture(u_textures[10], uv);
+        case 11: return texture(u_textures[11], uv);
+        case 12: return texture(u_textures[12], uv);
+        case 13: return texture(u_textures[13], uv);
+        case 14: return texture(u_textures[14], uv);
+        default: return texture(u_textures[15], uv);
+    }
+}
+
+void main()
+{
+    out_color = in_color * SampleTexture(in_texture_index, in_uv);
+}
@@ -0,0 +1,34 @@
+#version 460 core
+
+layout(location = 0) in vec3 in_position;
+layout(location = 1) in float in_rotation;
+layout(location = 2) in vec2 in_size;
+layout(location = 3) in vec4 in_color;
+layout(location = 4) in uint in_texture_index;
+layout(location = 5) in vec4 in_uv_rect;
+
+layout(push_constant) uniform Scene
+{
+    mat4 view_projection;
+} u_scene;
+
+layout(location = 0) out vec4 out_color;
+layout(location = 1) out vec2 out_uv;
+layout(location = 2) flat out uint out_texture_index;
+
+void main()
+{
+    // Triangle strip corners: (0, 0), (1, 0), (0, 1), (1, 1)
+    vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+
+    vec2 offset = (corner - 0.5) * in_size;
+    float s     = sin(in_rotation);
+    float c     = cos(in_rotation);
+    offset      = vec2(offset.x * c - offset.y * s, offset.x * s + offset.y * c);
+
+    gl_Position = u_scene.view_projection * vec4(in_position.xy + offset, in_position.z, 1.0);
+
+    out_color         = in_color;
+    out_uv            = mix(in_uv_rect.xy, in_uv_rect.zw, corner);
+    out_texture_index = in_texture_index;
+}
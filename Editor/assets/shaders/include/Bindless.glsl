@@ -0,0 +1,20 @@
+// The bindless table, see VulkanBindlessTable. Set and bindings must match VulkanBindlessTable::BINDLESS_SET and
+// BindlessResourceType.
+#extension GL_EXT_nonuniform_qualifier : require
+
+#define BINDLESS_SET 0
+
+layout(set = BINDLESS_SET, binding = 0) uniform texture2D u_bindless_textures[];
+layout(set = BINDLESS_SET, binding = 1) uniform sampler u_bindless_samplers[];
+
+// Declares the storage buffers as an array of a given block, e.g.
+//     BINDLESS_STORAGE_BUFFERS(readonly, Materials, Material data[], u_materials);
+//     Material material = u_materials[nonuniformEXT(index)].data[i];
+#define BINDLESS_STORAGE_BUFFERS(qualifiers, block, members, name) \
+    layout(std430, set = BINDLESS_SET, binding = 2) qualifiers buffer block { members; } name[]
+
+vec4 SampleBindless(uint textureIndex, uint samplerIndex, vec2 uv)
+{
+    return texture(sampler2D(u_bindless_textures[nonuniformEXT(textureIndex)],
+                             u_bindless_samplers[nonuniformEXT(samplerIndex)]), uv);
+}
@@ -0,0 +1,21 @@
+// Mirrors MeshData and MeshInstanceData in Engine/Renderer/MeshRenderer.h
+
+#define INVALID_MESH 0xffffffffu
+
+struct MeshData
+{
+    uint index_count;
+    uint first_index;
+    int vertex_offset;
+    uint padding;
+    // Object space center and radius
+    vec4 bounding_sphere;
+};
+
+struct MeshInstance
+{
+    mat4 transform;
+    vec4 color;
+    uint mesh;
+    uint padding[3];
+};
@@ -9,7 +9,7 @@ class ExampleLayer final : public Layer
   public:
     ExampleLayer() : Layer("Example") {}
 
-    void OnUpdate() override {}
+    void OnUpdate(Timestep ts) override {}
 
     void OnEvent(Event& event) override {}
 };
@@ -17,14 +17,25 @@ class ExampleLayer final : public Layer
 class Editor : public Application
 {
   public:
-    Editor() { PushLayer(new ExampleLayer()); }
+    explicit Editor(const ApplicationSpecification& specification) : Application(specification)
+    {
+        if (specification.CommandLineArgs.Contains("--benchmark-math"))
+            MathBenchmark::Run();
+
+        PushLayer(new ExampleLayer());
+    }
 
     ~Editor() = default;
 };
 
-Application* CreateApplication()
+Application* CreateApplication(ApplicationCommandLineArgs args)
 {
-    return new Editor();
+    ApplicationSpecification specification;
+    specification.Name            = "Noctis";
+    specification.Headless        = args.Contains("--headless");
+    specification.CommandLineArgs = args;
+
+    return new Editor(specification);
 }
 
 } // namespace Noctis
\ No newline at end of file
@@ -1,17 +1,26 @@
 #include "Application.h"
 
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/Memory/FrameAllocator.h"
 #include "Engine/Renderer/Renderer.h"
 
 namespace Noctis
 {
 Application* Application::s_Instance = nullptr;
 
-Application::Application()
+Application::Application(const ApplicationSpecification& specification) : m_Specification(specification)
 {
+    NOC_PROFILE_FUNCTION();
+
     s_Instance = this;
 
-    m_Window.reset(Window::Create());
-    m_Window->SetEventCallback(NOC_BIND_EVENT_FN(Application::OnEvent));
+    JobSystem::Init();
+    FrameAllocator::Init();
+
+    WindowProps props(m_Specification.Name, m_Specification.Width, m_Specification.Height);
+    props.Headless = m_Specification.Headless;
+    m_Window.reset(Window::Create(props));
+    m_Window->SetEventCallback(NOC_BIND_EVENT_FN(Application::QueueEvent));
 
     Renderer::Init();
 
@@ -19,15 +28,59 @@ Application::Application()
     // PushOverlay(m_ImGuiLayer);
 }
 
+Application::~Application()
+{
+    NOC_PROFILE_FUNCTION();
+
+    Renderer::Shutdown();
+    FrameAllocator::Shutdown();
+    JobSystem::Shutdown();
+}
+
 void Application::Run()
 {
+    NOC_PROFILE_FUNCTION();
+
+    m_FrameTimer.Reset();
+
     while (m_Running)
     {
+        Timestep timestep = m_FrameTimer.Elapsed();
+        m_FrameTimer.Reset();
+
+        FrameAllocator::BeginFrame();
+
+        m_Window->OnUpdate();
+        ProcessEvents();
+
+        if (!m_Running)
+            break;
+
         if (!m_Minimized)
         {
             {
-                for (Layer* layer : m_LayerStack)
-                    layer->OnUpdate();
+                if (m_FixedTimestep > 0.0f)
+                {
+                    NOC_PROFILE_SCOPE("LayerStack OnFixedUpdate");
+                    NOC_MEMORY_SCOPE(Layers);
+
+                    // Cap the catch-up work so a long stall can't snowball into ever longer frames
+                    m_FixedAccumulator = std::min(m_FixedAccumulator + timestep, m_FixedTimestep * MAX_FIXED_STEPS);
+                    while (m_FixedAccumulator >= m_FixedTimestep)
+                    {
+                        for (Layer* layer : m_LayerStack)
+                            layer->OnFixedUpdate(m_FixedTimestep);
+                        m_FixedAccumulator -= m_FixedTimestep;
+                    }
+                }
+
+                {
+                    NOC_PROFILE_SCOPE("LayerStack OnUpdate");
+                    NOC_MEMORY_SCOPE(Layers);
+
+                    for (Layer* layer : m_LayerStack)
+                        layer->OnUpdate(timestep);
+                }
 
                 Renderer::Render();
             }
@@ -40,17 +93,46 @@ void Application::Run()
             // m_ImGuiLayer->End();
         }
 
-        m_Window->OnUpdate();
+        if (m_Minimized)
+        {
+            // Nothing to draw, sleep until the window is restored or closed
+            m_Window->WaitEvents();
+            m_FrameTimer.Reset();
+        }
+        else if (m_FrameRateLimit > 0)
+        {
+            NOC_PROFILE_SCOPE("Application FrameRateLimit");
+
+            const float frameTime = 1.0f / static_cast<float>(m_FrameRateLimit);
+            float remaining;
+            while (m_Running && (remaining = frameTime - m_FrameTimer.Elapsed()) > 0.0f)
+                m_Window->WaitEventsTimeout(remaining);
+        }
+
+        MemoryTracker::EndFrame();
     }
 }
 
+void Application::SetFixedTimestep(float seconds)
+{
+    m_FixedTimestep    = std::max(seconds, 0.0f);
+    m_FixedAccumulator = 0.0f;
+}
+
+float Application::GetFixedStepAlpha() const
+{
+    return m_FixedTimestep > 0.0f ? m_FixedAccumulator / m_FixedTimestep : 1.0f;
+}
+
 void Application::OnEvent(Event& e)
 {
+    NOC_PROFILE_FUNCTION();
+
     EventDispatcher dispatcher(e);
     dispatcher.Dispatch<WindowCloseEvent>(NOC_BIND_EVENT_FN(Application::OnWindowClose));
     dispatcher.Dispatch<WindowResizeEvent>(NOC_BIND_EVENT_FN(Application::OnWindowResize));
 
-    NOC_CORE_INFO("{0}", e.ToString());
+    NOC_CORE_TRACE("{0}", e.ToString());
     for (auto it = m_LayerStack.rbegin(); it != m_LayerStack.rend(); ++it)
     {
         if (e.Handled)
@@ -59,6 +141,20 @@ void Application::OnEvent(Event& e)
     }
 }
 
+void Application::QueueEvent(Event& e)
+{
+    NOC_MEMORY_SCOPE(Events);
+    m_EventQueue.Push(e);
+}
+
+void Application::ProcessEvents()
+{
+    NOC_PROFILE_FUNCTION();
+    NOC_MEMORY_SCOPE(Events);
+
+    m_EventQueue.Flush(NOC_BIND_EVENT_FN(Application::OnEvent));
+}
+
 void Application::Close()
 {
     m_Running = false;
@@ -78,18 +174,25 @@ bool Application::OnWindowResize(WindowResizeEvent& e)
         return false;
     }
     m_Minimized = false;
+    Renderer::OnWindowResize(e.GetWidth(), e.GetHeight());
 
     return false;
 }
 
 void Application::PushLayer(Layer* layer)
 {
+    NOC_PROFILE_FUNCTION();
+    NOC_MEMORY_SCOPE(Layers);
+
     m_LayerStack.PushLayer(layer);
     layer->OnAttach();
 }
 
 void Application::PushOverlay(Layer* layer)
 {
+    NOC_PROFILE_FUNCTION();
+    NOC_MEMORY_SCOPE(Layers);
+
     m_LayerStack.PushOverlay(layer);
     layer->OnAttach();
 }
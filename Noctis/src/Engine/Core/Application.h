@@ -3,51 +3,111 @@
 #include "Window.h"
 
 #include "LayerStack.h"
+#include "Timer.h"
+#include "Timestep.h"
 
 #include "Engine/Events/Event.h"
 #include "Engine/Events/ApplicationEvent.h"
+#include "Engine/Events/EventQueue.h"
 #include "Engine/ImGui/ImGuiLayer.h"
 
 namespace Noctis
 {
 
+struct ApplicationCommandLineArgs
+{
+    int Count   = 0;
+    char** Args = nullptr;
+
+    const char* operator[](int index) const
+    {
+        NOC_CORE_ASSERT(index < Count, "Command line argument out of range!");
+        return Args[index];
+    }
+
+    bool Contains(std::string_view arg) const
+    {
+        for (int i = 1; i < Count; i++)
+        {
+            if (arg == Args[i])
+                return true;
+        }
+        return false;
+    }
+};
+
+struct ApplicationSpecification
+{
+    std::string Name = "Noctis";
+    uint32_t Width   = 1280;
+    uint32_t Height  = 720;
+    // No window or surface: frames are rendered into offscreen images, e.g. for benchmarks on a server without a GPU
+    // or display (with a software driver such as lavapipe)
+    bool Headless = false;
+    ApplicationCommandLineArgs CommandLineArgs;
+};
+
 class Application
 {
   public:
-    Application();
-    ~Application() = default;
+    explicit Application(const ApplicationSpecification& specification = ApplicationSpecification());
+    ~Application();
 
     void Run();
 
     void OnEvent(Event& e);
+    // Platform callbacks only queue events, they are coalesced and dispatched once per frame from Run
+    void QueueEvent(Event& e);
 
     void PushLayer(Layer* layer);
     void PushOverlay(Layer* layer);
 
     void Close();
 
+    // 0 disables the fixed-step tick. Layers receive OnFixedUpdate at this rate, independent of the frame rate.
+    void SetFixedTimestep(float seconds);
+    float GetFixedTimestep() const { return m_FixedTimestep; }
+    // How far rendering is between the last and the next fixed step, in [0, 1), for interpolating simulation state
+    float GetFixedStepAlpha() const;
+
+    // Frames per second, 0 is uncapped. The loop waits on window events rather than spinning.
+    void SetFrameRateLimit(uint32_t framesPerSecond) { m_FrameRateLimit = framesPerSecond; }
+    uint32_t GetFrameRateLimit() const { return m_FrameRateLimit; }
+
     Window& GetWindow() { return *m_Window; }
+    const ApplicationSpecification& GetSpecification() const { return m_Specification; }
 
     static Application& Get() { return *s_Instance; }
 
   private:
+    void ProcessEvents();
+
     bool OnWindowClose(WindowCloseEvent& e);
     bool OnWindowResize(WindowResizeEvent& e);
 
   private:
+    ApplicationSpecification m_Specification;
     Scope<Window> m_Window;
     bool m_Running   = true;
     bool m_Minimized = false;
 
     LayerStack m_LayerStack;
+    EventQueue m_EventQueue;
     // ImGuiLayer* m_ImGuiLayer;
 
+    Timer m_FrameTimer;
+    float m_FixedTimestep     = 0.0f;
+    float m_FixedAccumulator  = 0.0f;
+    uint32_t m_FrameRateLimit = 0;
+
+    static constexpr float MAX_FIXED_STEPS = 8.0f;
+
     static Application* s_Instance;
 
     friend class Renderer;
 };
 
 // To be defined in CLIENT
-Application* CreateApplication();
+Application* CreateApplication(ApplicationCommandLineArgs args);
 
 } // namespace Noctis
\ No newline at end of file
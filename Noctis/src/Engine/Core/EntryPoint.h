@@ -2,15 +2,32 @@
 
 #include "Base.h"
 #include "Application.h"
+#include "Engine/Debug/MemoryTracker.h"
+#include "Engine/Debug/Profiler.h"
 
-extern Noctis::Application* Noctis::CreateApplication();
+extern Noctis::Application* Noctis::CreateApplication(Noctis::ApplicationCommandLineArgs args);
 
 int main(int argc, char** argv)
 {
     Noctis::Log::Init();
     NOC_CORE_INFO("Initialized Log");
 
-    const auto app = Noctis::CreateApplication();
+    NOC_PROFILE_THREAD("Main");
+
+    NOC_PROFILE_BEGIN_SESSION("Startup", "NoctisProfile-Startup.json");
+    const auto app = Noctis::CreateApplication({argc, argv});
+    NOC_PROFILE_END_SESSION();
+
+    NOC_PROFILE_BEGIN_SESSION("Runtime", "NoctisProfile-Runtime.json");
     app->Run();
+    NOC_PROFILE_END_SESSION();
+
+    NOC_PROFILE_BEGIN_SESSION("Shutdown", "NoctisProfile-Shutdown.json");
     delete app;
+    NOC_PROFILE_END_SESSION();
+
+    // Only once the application's members, the window and the layers among them, are gone too
+    Noctis::MemoryTracker::ReportLeaks();
+
+    Noctis::Log::Shutdown();
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "FileSystem.h"
+
+#include <fstream>
+#include <thread>
+
+namespace Noctis
+{
+
+bool FileSystem::ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& data)
+{
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream)
+        return false;
+
+    data.resize(static_cast<size_t>(stream.tellg()));
+    stream.seekg(0);
+    return static_cast<bool>(
+        stream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())));
+}
+
+bool FileSystem::ReadTextFile(const std::filesystem::path& path, std::string& text)
+{
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream)
+        return false;
+
+    text.resize(static_cast<size_t>(stream.tellg()));
+    stream.seekg(0);
+    return static_cast<bool>(stream.read(text.data(), static_cast<std::streamsize>(text.size())));
+}
+
+bool FileSystem::WriteFileAtomic(const std::filesystem::path& path, const void* data, size_t size)
+{
+    std::error_code error;
+    if (path.has_parent_path())
+        std::filesystem::create_directories(path.parent_path(), error);
+
+    // Unique per thread, so concurrent writers of the same file don't trample each other's temporary
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+    {
+        std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+        stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        stream.flush();
+        if (!stream)
+        {
+            NOC_CORE_WARN("Failed to write {0}", tempPath.string());
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        NOC_CORE_WARN("Failed to replace {0}: {1}", path.string(), error.message());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+} // namespace Noctis
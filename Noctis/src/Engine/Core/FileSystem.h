@@ -0,0 +1,20 @@
+#pragma once
+
+#include <filesystem>
+
+namespace Noctis
+{
+
+class FileSystem
+{
+  public:
+    // Both return false if the file can't be opened or read completely
+    static bool ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& data);
+    static bool ReadTextFile(const std::filesystem::path& path, std::string& text);
+
+    // Writes to a temporary file next to path and renames it over path, so readers (and a crash mid-write) only
+    // ever see the old file or the complete new one. Creates missing parent directories.
+    static bool WriteFileAtomic(const std::filesystem::path& path, const void* data, size_t size);
+};
+
+} // namespace Noctis
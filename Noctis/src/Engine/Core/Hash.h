@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Noctis
+{
+
+// 64-bit FNV-1a. Not cryptographic, but stable across runs and platforms, so it can key on-disk caches.
+class Hash
+{
+  public:
+    static constexpr uint64_t OFFSET_BASIS = 0xcbf29ce484222325ull;
+
+    static uint64_t FNV1a(const void* data, size_t size, uint64_t hash = OFFSET_BASIS)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= PRIME;
+        }
+        return hash;
+    }
+
+    static constexpr uint64_t FNV1a(std::string_view text, uint64_t hash = OFFSET_BASIS)
+    {
+        for (char c : text)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= PRIME;
+        }
+        return hash;
+    }
+
+    // Order dependent, for hashing several fields into one key
+    static constexpr uint64_t Combine(uint64_t seed, uint64_t value)
+    {
+        return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+    }
+
+  private:
+    static constexpr uint64_t PRIME = 0x100000001b3ull;
+};
+
+} // namespace Noctis
@@ -0,0 +1,258 @@
+#include "JobSystem.h"
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace Noctis
+{
+
+namespace
+{
+
+// Owner pushes and pops at the back for cache locality, thieves take the oldest job from the front
+struct WorkerQueue
+{
+    std::mutex Mutex;
+    std::deque<JobEntry> Jobs;
+};
+
+struct JobSystemData
+{
+    std::vector<Scope<WorkerQueue>> Queues;
+    std::vector<std::thread> Workers;
+
+    std::atomic<bool> Running        = false;
+    std::atomic<uint32_t> QueuedJobs = 0;
+
+    std::atomic<uint32_t> SleepingWorkers = 0;
+    std::mutex WakeMutex;
+    std::condition_variable WakeCondition;
+};
+
+JobSystemData s_Data;
+
+thread_local uint32_t s_ThreadIndex = JobSystem::InvalidThreadIndex;
+
+} // namespace
+
+std::vector<JobEntry> JobCounter::Decrement()
+{
+    std::vector<JobEntry> released;
+
+    // Held across the decrement so a waiter can't observe zero and destroy the counter while it is still in use
+    std::lock_guard lock(m_Mutex);
+    if (m_Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        released.swap(m_Dependents);
+
+    return released;
+}
+
+bool JobCounter::AddDependent(JobEntry&& entry)
+{
+    std::lock_guard lock(m_Mutex);
+    if (m_Pending.load(std::memory_order_acquire) == 0)
+        return false;
+
+    m_Dependents.push_back(std::move(entry));
+    return true;
+}
+
+void JobSystem::Init(uint32_t workerCount)
+{
+    NOC_PROFILE_FUNCTION();
+    NOC_MEMORY_SCOPE(Core);
+
+    NOC_CORE_ASSERT(!s_Data.Running, "JobSystem already initialized!");
+
+    if (workerCount == 0)
+        workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+    s_ThreadIndex = 0;
+
+    s_Data.Queues.clear();
+    for (uint32_t i = 0; i < workerCount + 1; i++)
+        s_Data.Queues.push_back(CreateScope<WorkerQueue>());
+
+    s_Data.Running = true;
+    for (uint32_t i = 1; i <= workerCount; i++)
+        s_Data.Workers.emplace_back(WorkerLoop, i);
+
+    NOC_CORE_INFO("JobSystem initialized with {0} worker threads", workerCount);
+}
+
+void JobSystem::Shutdown()
+{
+    NOC_PROFILE_FUNCTION();
+
+    if (!s_Data.Running)
+        return;
+
+    {
+        std::lock_guard lock(s_Data.WakeMutex);
+        s_Data.Running = false;
+    }
+    s_Data.WakeCondition.notify_all();
+
+    for (std::thread& worker : s_Data.Workers)
+        worker.join();
+    s_Data.Workers.clear();
+
+    // Anything still queued runs on the main thread so counters are honoured
+    while (TryRunJob(0))
+        ;
+
+    s_Data.Queues.clear();
+}
+
+void JobSystem::Execute(Job job, JobCounter* counter, JobCounter* dependency)
+{
+    if (s_Data.Queues.empty())
+    {
+        job();
+        return;
+    }
+
+    if (counter)
+        counter->Increment();
+
+    // Jobs queued outside any memory scope are charged to Jobs rather than General
+    const MemoryTag tag = MemoryTracker::GetCurrentTag();
+    JobEntry entry{std::move(job), counter, tag != MemoryTag::General ? tag : MemoryTag::Jobs};
+    if (dependency && dependency->AddDependent(std::move(entry)))
+        return;
+
+    Push(std::move(entry));
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    NOC_PROFILE_FUNCTION();
+
+    const uint32_t threadIndex = GetThreadIndex();
+    while (!counter.IsDone())
+    {
+        if (!TryRunJob(threadIndex))
+            std::this_thread::yield();
+    }
+
+    // Let the thread that released the counter finish with it before the caller destroys it
+    std::lock_guard lock(counter.m_Mutex);
+}
+
+uint32_t JobSystem::GetThreadCount()
+{
+    return std::max(static_cast<uint32_t>(s_Data.Queues.size()), 1u);
+}
+
+uint32_t JobSystem::GetThreadIndex()
+{
+    return s_ThreadIndex;
+}
+
+uint32_t JobSystem::ResolveBatchSize(uint32_t count, uint32_t batchSize)
+{
+    if (batchSize != 0)
+        return batchSize;
+
+    // A few batches per thread keeps stealing effective without drowning small loops in overhead
+    const uint32_t targetBatches = GetThreadCount() * 4;
+    return std::max((count + targetBatches - 1) / targetBatches, 1u);
+}
+
+void JobSystem::Push(JobEntry&& entry)
+{
+    // Threads the job system doesn't own feed the main thread's queue, where workers can steal from
+    const uint32_t threadIndex = GetThreadIndex() < s_Data.Queues.size() ? GetThreadIndex() : 0;
+
+    WorkerQueue& queue = *s_Data.Queues[threadIndex];
+    {
+        std::lock_guard lock(queue.Mutex);
+        queue.Jobs.push_back(std::move(entry));
+    }
+
+    s_Data.QueuedJobs.fetch_add(1);
+    if (s_Data.SleepingWorkers.load() > 0)
+    {
+        { std::lock_guard lock(s_Data.WakeMutex); }
+        s_Data.WakeCondition.notify_one();
+    }
+}
+
+bool JobSystem::TryRunJob(uint32_t threadIndex)
+{
+    const uint32_t queueCount = static_cast<uint32_t>(s_Data.Queues.size());
+    if (queueCount == 0 || s_Data.QueuedJobs.load(std::memory_order_relaxed) == 0)
+        return false;
+
+    threadIndex = threadIndex < queueCount ? threadIndex : 0;
+
+    JobEntry entry;
+    bool found = false;
+
+    {
+        WorkerQueue& own = *s_Data.Queues[threadIndex];
+        std::lock_guard lock(own.Mutex);
+        if (!own.Jobs.empty())
+        {
+            entry = std::move(own.Jobs.back());
+            own.Jobs.pop_back();
+            found = true;
+        }
+    }
+
+    for (uint32_t offset = 1; !found && offset < queueCount; offset++)
+    {
+        WorkerQueue& victim = *s_Data.Queues[(threadIndex + offset) % queueCount];
+        std::lock_guard lock(victim.Mutex);
+        if (!victim.Jobs.empty())
+        {
+            entry = std::move(victim.Jobs.front());
+            victim.Jobs.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found)
+        return false;
+
+    s_Data.QueuedJobs.fetch_sub(1);
+    RunJob(entry);
+    return true;
+}
+
+void JobSystem::RunJob(JobEntry& entry)
+{
+    {
+        NOC_PROFILE_SCOPE("JobSystem::RunJob");
+        MemoryScope memoryScope(entry.Tag);
+        entry.Function();
+    }
+
+    if (entry.Counter)
+    {
+        for (JobEntry& dependent : entry.Counter->Decrement())
+            Push(std::move(dependent));
+    }
+}
+
+void JobSystem::WorkerLoop(uint32_t threadIndex)
+{
+    s_ThreadIndex = threadIndex;
+
+    const std::string threadName = "Worker " + std::to_string(threadIndex);
+    NOC_PROFILE_THREAD(threadName.c_str());
+
+    while (s_Data.Running)
+    {
+        if (TryRunJob(threadIndex))
+            continue;
+
+        std::unique_lock lock(s_Data.WakeMutex);
+        s_Data.SleepingWorkers.fetch_add(1);
+        s_Data.WakeCondition.wait(lock, [] { return s_Data.QueuedJobs.load() > 0 || !s_Data.Running; });
+        s_Data.SleepingWorkers.fetch_sub(1);
+    }
+}
+
+} // namespace Noctis
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "Engine/Debug/MemoryTracker.h"
+
+namespace Noctis
+{
+
+using Job = std::function<void()>;
+
+class JobCounter;
+
+struct JobEntry
+{
+    Job Function;
+    JobCounter* Counter = nullptr;
+    // Of the code that queued the job, its allocations are charged to it
+    MemoryTag Tag = MemoryTag::Jobs;
+};
+
+// Tracks a group of in-flight jobs. Jobs executed with a counter as their dependency are held back until it drains.
+class JobCounter
+{
+  public:
+    JobCounter()                             = default;
+    JobCounter(const JobCounter&)            = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+
+  private:
+    void Increment() { m_Pending.fetch_add(1, std::memory_order_relaxed); }
+    std::vector<JobEntry> Decrement();
+    bool AddDependent(JobEntry&& entry);
+
+  private:
+    std::atomic<uint32_t> m_Pending = 0;
+    std::mutex m_Mutex;
+    std::vector<JobEntry> m_Dependents;
+
+    friend class JobSystem;
+};
+
+class JobSystem
+{
+  public:
+    static constexpr uint32_t InvalidThreadIndex = UINT32_MAX;
+
+    // workerCount == 0 spawns one worker per hardware thread, minus the main thread
+    static void Init(uint32_t workerCount = 0);
+    static void Shutdown();
+
+    static void Execute(Job job, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+    // Runs queued jobs on the calling thread until the counter drains
+    static void Wait(JobCounter& counter);
+
+    // func(begin, end) is invoked for contiguous ranges of [0, count). batchSize == 0 picks one automatically.
+    template <typename F> static void ParallelFor(uint32_t count, uint32_t batchSize, F&& func);
+    // map(begin, end) -> T per range, partial results are folded with reduce(T, T) -> T in range order
+    template <typename T, typename MapFn, typename ReduceFn>
+    static T ParallelReduce(uint32_t count, uint32_t batchSize, T identity, MapFn&& map, ReduceFn&& reduce);
+
+    // Includes the main thread
+    static uint32_t GetThreadCount();
+    // 0 is the main thread, workers are 1..GetThreadCount()-1, threads the job system doesn't own get InvalidThreadIndex
+    static uint32_t GetThreadIndex();
+
+  private:
+    static uint32_t ResolveBatchSize(uint32_t count, uint32_t batchSize);
+
+    static void Push(JobEntry&& entry);
+    static bool TryRunJob(uint32_t threadIndex);
+    static void RunJob(JobEntry& entry);
+    static void WorkerLoop(uint32_t threadIndex);
+};
+
+template <typename F> void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, F&& func)
+{
+    if (count == 0)
+        return;
+
+    batchSize                 = ResolveBatchSize(count, batchSize);
+    const uint32_t batchCount = (count + batchSize - 1) / batchSize;
+    if (batchCount == 1)
+    {
+        func(0u, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (uint32_t batch = 1; batch < batchCount; batch++)
+    {
+        const uint32_t begin = batch * batchSize;
+        const uint32_t end   = std::min(begin + batchSize, count);
+        Execute([&func, begin, end]() { func(begin, end); }, &counter);
+    }
+
+    // The calling thread takes the first range instead of idling
+    func(0u, batchSize);
+    Wait(counter);
+}
+
+template <typename T, typename MapFn, typename ReduceFn>
+T JobSystem::ParallelReduce(uint32_t count, uint32_t batchSize, T identity, MapFn&& map, ReduceFn&& reduce)
+{
+    if (count == 0)
+        return identity;
+
+    batchSize                 = ResolveBatchSize(count, batchSize);
+    const uint32_t batchCount = (count + batchSize - 1) / batchSize;
+
+    std::vector<T> partials(batchCount, identity);
+    ParallelFor(batchCount, 1, [&](uint32_t first, uint32_t last) {
+        for (uint32_t batch = first; batch < last; batch++)
+        {
+            const uint32_t begin = batch * batchSize;
+            const uint32_t end   = std::min(begin + batchSize, count);
+            partials[batch]      = map(begin, end);
+        }
+    });
+
+    T result = identity;
+    for (T& partial : partials)
+        result = reduce(result, partial);
+    return result;
+}
+
+} // namespace Noctis
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Engine/Core/Timestep.h"
 #include "Engine/Events/Event.h"
 
 namespace Noctis
@@ -13,7 +14,8 @@ class Layer
 
     virtual void OnAttach() {}
     virtual void OnDetach() {}
-    virtual void OnUpdate() {}
+    virtual void OnUpdate(Timestep ts) {}
+    virtual void OnFixedUpdate(Timestep ts) {}
     virtual void OnRender() {}
     virtual void OnImGuiRender() {}
     virtual void OnEvent(Event& e) {}
@@ -5,6 +5,8 @@ namespace Noctis
 
 LayerStack::~LayerStack()
 {
+    NOC_PROFILE_FUNCTION();
+
     for (Layer* layer : m_Layers)
     {
         layer->OnDetach();
@@ -14,17 +16,23 @@ LayerStack::~LayerStack()
 
 void LayerStack::PushLayer(Layer* layer)
 {
+    NOC_PROFILE_FUNCTION();
+
     m_Layers.emplace(m_Layers.begin() + m_LayerInsertIndex, layer);
     m_LayerInsertIndex++;
 }
 
 void LayerStack::PushOverlay(Layer* layer)
 {
+    NOC_PROFILE_FUNCTION();
+
     m_Layers.emplace_back(layer);
 }
 
 void LayerStack::PopLayer(Layer* layer)
 {
+    NOC_PROFILE_FUNCTION();
+
     auto it = std::find(m_Layers.begin(), m_Layers.end(), layer);
     if (it != m_Layers.end())
     {
@@ -36,6 +44,8 @@ void LayerStack::PopLayer(Layer* layer)
 
 void LayerStack::PopOverlay(Layer* layer)
 {
+    NOC_PROFILE_FUNCTION();
+
     auto it = std::find(m_Layers.begin(), m_Layers.end(), layer);
     if (it != m_Layers.end())
     {
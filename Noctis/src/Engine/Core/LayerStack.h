@@ -29,7 +29,7 @@ class LayerStack
 
   private:
     std::vector<Layer*> m_Layers;
-    uint32_t m_LayerInsertIndex;
+    uint32_t m_LayerInsertIndex = 0;
 };
 
 } // namespace Noctis
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "Log.h"
 
-#include <spdlog/sinks/stdout_color_sinks-inl.h>
+#include <spdlog/async.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
 
 namespace Noctis
 {
@@ -8,14 +10,78 @@ namespace Noctis
 std::shared_ptr<spdlog::logger> Log::s_CoreLogger;
 std::shared_ptr<spdlog::logger> Log::s_ClientLogger;
 
-void Log::Init()
+// Puts sink work in the profiler, on the log thread when async or on the calling thread otherwise
+class ProfiledSink : public spdlog::sinks::sink
 {
-    spdlog::set_pattern("%^[%T] %n: %v%$");
-    s_CoreLogger = spdlog::stdout_color_mt("NOCTIS");
-    s_CoreLogger->set_level(spdlog::level::trace);
+  public:
+    explicit ProfiledSink(spdlog::sink_ptr sink) : m_Sink(std::move(sink)) {}
 
-    s_ClientLogger = spdlog::stdout_color_mt("APP");
-    s_ClientLogger->set_level(spdlog::level::trace);
+    void log(const spdlog::details::log_msg& msg) override
+    {
+        NOC_PROFILE_SCOPE("Log::Sink");
+        m_Sink->log(msg);
+    }
+
+    void flush() override
+    {
+        NOC_PROFILE_SCOPE("Log::Flush");
+        m_Sink->flush();
+    }
+
+    void set_pattern(const std::string& pattern) override { m_Sink->set_pattern(pattern); }
+    void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override
+    {
+        m_Sink->set_formatter(std::move(formatter));
+    }
+
+  private:
+    spdlog::sink_ptr m_Sink;
+};
+
+static Ref<spdlog::logger> CreateLogger(const std::string& name, const std::vector<spdlog::sink_ptr>& sinks,
+                                        const LogSpecification& specification)
+{
+    Ref<spdlog::logger> logger;
+    if (specification.Async)
+        logger = CreateRef<spdlog::async_logger>(name, sinks.begin(), sinks.end(), spdlog::thread_pool(),
+                                                 spdlog::async_overflow_policy::overrun_oldest);
+    else
+        logger = CreateRef<spdlog::logger>(name, sinks.begin(), sinks.end());
+
+    // Anything passing the compile-time filter is wanted at runtime as well
+    logger->set_level(static_cast<spdlog::level::level_enum>(NOC_LOG_ACTIVE_LEVEL));
+    logger->flush_on(spdlog::level::err);
+    spdlog::register_logger(logger);
+
+    return logger;
+}
+
+void Log::Init(const LogSpecification& specification)
+{
+    if (specification.Async)
+        spdlog::init_thread_pool(specification.QueueSize, 1, []() { NOC_PROFILE_THREAD("Log"); });
+
+    // Sinks are shared by both loggers, so the _mt variants keep them safe when used synchronously from many threads
+    std::vector<spdlog::sink_ptr> sinks;
+    sinks.push_back(CreateRef<ProfiledSink>(CreateRef<spdlog::sinks::stdout_color_sink_mt>()));
+    sinks.back()->set_pattern("%^[%T] %n: %v%$");
+    if (!specification.FilePath.empty())
+    {
+        sinks.push_back(
+            CreateRef<ProfiledSink>(CreateRef<spdlog::sinks::basic_file_sink_mt>(specification.FilePath, true)));
+        sinks.back()->set_pattern("[%T] [%l] %n: %v");
+    }
+
+    s_CoreLogger   = CreateLogger("NOCTIS", sinks, specification);
+    s_ClientLogger = CreateLogger("APP", sinks, specification);
+}
+
+void Log::Shutdown()
+{
+    // Drains the async queue before the worker thread is joined
+    s_ClientLogger.reset();
+    s_CoreLogger.reset();
+    spdlog::shutdown();
 }
 
-} // namespace Noctis
\ No newline at end of file
+} // namespace Noctis
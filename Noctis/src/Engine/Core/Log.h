@@ -3,13 +3,38 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/fmt/ostr.h>
 
+// Matches spdlog::level::level_enum
+#define NOC_LOG_LEVEL_TRACE 0
+#define NOC_LOG_LEVEL_DEBUG 1
+#define NOC_LOG_LEVEL_INFO 2
+#define NOC_LOG_LEVEL_WARN 3
+#define NOC_LOG_LEVEL_ERROR 4
+#define NOC_LOG_LEVEL_CRITICAL 5
+#define NOC_LOG_LEVEL_OFF 6
+
+// Log calls below this level are compiled out entirely, Release builds set it from CMake
+#ifndef NOC_LOG_ACTIVE_LEVEL
+#define NOC_LOG_ACTIVE_LEVEL NOC_LOG_LEVEL_TRACE
+#endif
+
 namespace Noctis
 {
 
+struct LogSpecification
+{
+    // Formatting of the log pattern and all sink I/O happen on a background thread
+    bool Async = true;
+    // Messages the async queue holds, the oldest are dropped rather than blocking the caller when it is full
+    uint32_t QueueSize = 8192;
+    // Also write to this file when set
+    std::string FilePath;
+};
+
 class Log
 {
   public:
-    static void Init();
+    static void Init(const LogSpecification& specification = LogSpecification());
+    static void Shutdown();
 
     static Ref<spdlog::logger>& GetCoreLogger() { return s_CoreLogger; }
     static Ref<spdlog::logger>& GetClientLogger() { return s_ClientLogger; }
@@ -21,16 +46,46 @@ class Log
 
 } // namespace Noctis
 
+// The arguments stay referenced but unevaluated, so variables only logged don't become unused in Release
+#define NOC_LOG_DISCARD(...) static_cast<void>(sizeof((::spdlog::log(::spdlog::level::off, __VA_ARGS__), 0)))
+
 // Core log macros
+#if NOC_LOG_ACTIVE_LEVEL <= NOC_LOG_LEVEL_TRACE
 #define NOC_CORE_TRACE(...) Noctis::Log::GetCoreLogger()->trace(__VA_ARGS__)
-#define NOC_CORE_INFO(...) Noctis::Log::GetCoreLogger()->info(__VA_ARGS__)
-#define NOC_CORE_WARN(...) Noctis::Log::GetCoreLogger()->warn(__VA_ARGS__)
-#define NOC_CORE_ERROR(...) Noctis::Log::GetCoreLogger()->error(__VA_ARGS__)
-#define NOC_CORE_CRITICAL(...) Noctis::Log::GetCoreLogger()->critical(__VA_ARGS__)
-
-// Client log macros
 #define NOC_TRACE(...) Noctis::Log::GetClientLogger()->trace(__VA_ARGS__)
+#else
+#define NOC_CORE_TRACE(...) NOC_LOG_DISCARD(__VA_ARGS__)
+#define NOC_TRACE(...) NOC_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if NOC_LOG_ACTIVE_LEVEL <= NOC_LOG_LEVEL_INFO
+#define NOC_CORE_INFO(...) Noctis::Log::GetCoreLogger()->info(__VA_ARGS__)
 #define NOC_INFO(...) Noctis::Log::GetClientLogger()->info(__VA_ARGS__)
+#else
+#define NOC_CORE_INFO(...) NOC_LOG_DISCARD(__VA_ARGS__)
+#define NOC_INFO(...) NOC_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if NOC_LOG_ACTIVE_LEVEL <= NOC_LOG_LEVEL_WARN
+#define NOC_CORE_WARN(...) Noctis::Log::GetCoreLogger()->warn(__VA_ARGS__)
 #define NOC_WARN(...) Noctis::Log::GetClientLogger()->warn(__VA_ARGS__)
+#else
+#define NOC_CORE_WARN(...) NOC_LOG_DISCARD(__VA_ARGS__)
+#define NOC_WARN(...) NOC_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if NOC_LOG_ACTIVE_LEVEL <= NOC_LOG_LEVEL_ERROR
+#define NOC_CORE_ERROR(...) Noctis::Log::GetCoreLogger()->error(__VA_ARGS__)
 #define NOC_ERROR(...) Noctis::Log::GetClientLogger()->error(__VA_ARGS__)
-#define NOC_CRITICAL(...) Noctis::Log::GetClientLogger()->critical(__VA_ARGS__)
\ No newline at end of file
+#else
+#define NOC_CORE_ERROR(...) NOC_LOG_DISCARD(__VA_ARGS__)
+#define NOC_ERROR(...) NOC_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if NOC_LOG_ACTIVE_LEVEL <= NOC_LOG_LEVEL_CRITICAL
+#define NOC_CORE_CRITICAL(...) Noctis::Log::GetCoreLogger()->critical(__VA_ARGS__)
+#define NOC_CRITICAL(...) Noctis::Log::GetClientLogger()->critical(__VA_ARGS__)
+#else
+#define NOC_CORE_CRITICAL(...) NOC_LOG_DISCARD(__VA_ARGS__)
+#define NOC_CRITICAL(...) NOC_LOG_DISCARD(__VA_ARGS__)
+#endif
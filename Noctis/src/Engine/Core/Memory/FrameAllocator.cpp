@@ -0,0 +1,122 @@
+#include "FrameAllocator.h"
+
+#include "Engine/Core/JobSystem.h"
+
+#include <mutex>
+
+namespace Noctis
+{
+
+namespace
+{
+
+// Cache line aligned so threads bumping their own arenas don't share lines
+struct alignas(64) ThreadArenas
+{
+    std::array<Scope<LinearAllocator>, FrameAllocator::FRAME_COUNT> Arenas;
+};
+
+class FrameResource final : public std::pmr::memory_resource
+{
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override { return FrameAllocator::Allocate(bytes, alignment); }
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+struct FrameAllocatorData
+{
+    // One per job system thread, plus the shared one for other threads at the end
+    std::vector<ThreadArenas> Threads;
+    std::mutex SharedMutex;
+
+    uint64_t FrameIndex = 0;
+    uint32_t Current    = 0;
+    size_t PeakBytes    = 0;
+
+    FrameResource Resource;
+};
+
+FrameAllocatorData s_Data;
+
+void CreateArenas(ThreadArenas& thread, size_t blockSize)
+{
+    for (Scope<LinearAllocator>& arena : thread.Arenas)
+        arena = CreateScope<LinearAllocator>(blockSize);
+}
+
+} // namespace
+
+void FrameAllocator::Init(size_t blockSize)
+{
+    NOC_PROFILE_FUNCTION();
+    NOC_MEMORY_SCOPE(Core);
+
+    NOC_CORE_ASSERT(s_Data.Threads.empty(), "FrameAllocator already initialized!");
+
+    s_Data.Threads = std::vector<ThreadArenas>(JobSystem::GetThreadCount() + 1);
+    for (ThreadArenas& thread : s_Data.Threads)
+        CreateArenas(thread, blockSize);
+
+    s_Data.FrameIndex = 0;
+    s_Data.Current    = 0;
+    s_Data.PeakBytes  = 0;
+}
+
+void FrameAllocator::Shutdown()
+{
+    NOC_PROFILE_FUNCTION();
+
+    NOC_CORE_INFO("FrameAllocator peak usage: {0} KiB per frame", GetPeakBytes() / 1024);
+    s_Data.Threads.clear();
+}
+
+void FrameAllocator::BeginFrame()
+{
+    NOC_PROFILE_FUNCTION();
+    NOC_MEMORY_SCOPE(Core);
+
+    s_Data.PeakBytes = GetPeakBytes();
+    s_Data.FrameIndex++;
+    s_Data.Current = s_Data.FrameIndex % FRAME_COUNT;
+
+    for (ThreadArenas& thread : s_Data.Threads)
+        thread.Arenas[s_Data.Current]->Reset();
+}
+
+void* FrameAllocator::Allocate(size_t size, size_t alignment)
+{
+    NOC_CORE_ASSERT(!s_Data.Threads.empty(), "FrameAllocator not initialized!");
+
+    const uint32_t threadIndex = JobSystem::GetThreadIndex();
+    if (threadIndex < s_Data.Threads.size() - 1)
+        return s_Data.Threads[threadIndex].Arenas[s_Data.Current]->Allocate(size, alignment);
+
+    std::lock_guard lock(s_Data.SharedMutex);
+    return s_Data.Threads.back().Arenas[s_Data.Current]->Allocate(size, alignment);
+}
+
+std::pmr::memory_resource* FrameAllocator::GetResource()
+{
+    return &s_Data.Resource;
+}
+
+uint64_t FrameAllocator::GetFrameIndex()
+{
+    return s_Data.FrameIndex;
+}
+
+size_t FrameAllocator::GetUsedBytes()
+{
+    size_t used = 0;
+    for (const ThreadArenas& thread : s_Data.Threads)
+        used += thread.Arenas[s_Data.Current]->GetUsedBytes();
+    return used;
+}
+
+size_t FrameAllocator::GetPeakBytes()
+{
+    return std::max(s_Data.PeakBytes, GetUsedBytes());
+}
+
+} // namespace Noctis
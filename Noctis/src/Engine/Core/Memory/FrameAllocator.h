@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Engine/Core/Memory/LinearAllocator.h"
+
+namespace Noctis
+{
+
+// Per-frame memory: allocations stay valid for the rest of the frame and the whole next one, so data built while
+// updating can still be read by work the next frame picks up, then are released together. Each job system thread
+// bumps its own pair of arenas, so allocating is lock-free from jobs too; threads the job system doesn't own share a
+// locked pair.
+//
+// Application calls BeginFrame at the top of every frame, nothing may still be allocating from the frame being reset.
+// The arenas keep their memory, so once they have grown to the peak a frame needs, frames allocate nothing from the
+// heap.
+class FrameAllocator
+{
+  public:
+    static constexpr uint32_t FRAME_COUNT      = 2;
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 1024 * 1024;
+
+    // After JobSystem::Init, one pair of arenas is made per job system thread
+    static void Init(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    static void Shutdown();
+
+    // Resets the arenas of the frame before last and makes them current
+    static void BeginFrame();
+
+    static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    template <typename T> static T* AllocateArray(size_t count)
+    {
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+    // The object's destructor is never called
+    template <typename T, typename... Args> static T* New(Args&&... args)
+    {
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // For std::pmr containers living at most until the end of the next frame
+    static std::pmr::memory_resource* GetResource();
+
+    static uint64_t GetFrameIndex();
+    // Across all threads, for the current frame and its peak so far
+    static size_t GetUsedBytes();
+    static size_t GetPeakBytes();
+};
+
+} // namespace Noctis
@@ -0,0 +1,122 @@
+#include "LinearAllocator.h"
+
+namespace Noctis
+{
+
+namespace
+{
+
+size_t AlignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+LinearAllocator::LinearAllocator(size_t blockSize) : m_BlockSize(blockSize)
+{
+}
+
+LinearAllocator::~LinearAllocator()
+{
+    for (const Block& block : m_Blocks)
+        FreeBlock(block);
+}
+
+void* LinearAllocator::Allocate(size_t size, size_t alignment)
+{
+    NOC_CORE_ASSERT((alignment & (alignment - 1)) == 0, "LinearAllocator: alignment must be a power of two!");
+
+    if (!m_Blocks.empty())
+    {
+        const Block& block = m_Blocks[m_CurrentBlock];
+        // Aligned by address, the block itself is only BLOCK_ALIGNMENT aligned
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.Data);
+        const size_t offset  = AlignUp(base + m_Offset, alignment) - base;
+        if (offset + size <= block.Size)
+        {
+            m_Offset = offset + size;
+            return block.Data + offset;
+        }
+    }
+
+    return AllocateFromNextBlock(size, alignment);
+}
+
+void LinearAllocator::Rewind(const Marker& marker)
+{
+    NOC_CORE_ASSERT(marker.Block < m_CurrentBlock || (marker.Block == m_CurrentBlock && marker.Offset <= m_Offset),
+                    "LinearAllocator::Rewind: the marker is ahead of the allocator!");
+
+    m_PeakBytes    = GetPeakBytes();
+    m_CurrentBlock = marker.Block;
+    m_Offset       = marker.Offset;
+}
+
+void LinearAllocator::Reset()
+{
+    m_PeakBytes = GetPeakBytes();
+    if (m_Blocks.size() > 1)
+    {
+        size_t size = 0;
+        for (const Block& block : m_Blocks)
+        {
+            size += block.Size;
+            FreeBlock(block);
+        }
+        m_Blocks.assign(1, AllocateBlock(size));
+    }
+
+    m_CurrentBlock = 0;
+    m_Offset       = 0;
+}
+
+size_t LinearAllocator::GetUsedBytes() const
+{
+    size_t used = m_Offset;
+    for (uint32_t i = 0; i < m_CurrentBlock; i++)
+        used += m_Blocks[i].Size;
+    return used;
+}
+
+size_t LinearAllocator::GetPeakBytes() const
+{
+    return std::max(m_PeakBytes, GetUsedBytes());
+}
+
+size_t LinearAllocator::GetCapacity() const
+{
+    size_t capacity = 0;
+    for (const Block& block : m_Blocks)
+        capacity += block.Size;
+    return capacity;
+}
+
+void* LinearAllocator::AllocateFromNextBlock(size_t size, size_t alignment)
+{
+    // Blocks past the current one are left over from before a Rewind, use them if they are large enough
+    const size_t required = size + (alignment > BLOCK_ALIGNMENT ? alignment : 0);
+    uint32_t next         = m_Blocks.empty() ? 0 : m_CurrentBlock + 1;
+    while (next < m_Blocks.size() && m_Blocks[next].Size < required)
+        next++;
+
+    if (next == m_Blocks.size())
+        m_Blocks.push_back(AllocateBlock(std::max(m_BlockSize, required)));
+
+    // Blocks skipped over count as used until the next rewind, which keeps markers ordered
+    m_CurrentBlock = next;
+    m_Offset       = 0;
+    return Allocate(size, alignment);
+}
+
+LinearAllocator::Block LinearAllocator::AllocateBlock(size_t size)
+{
+    return {static_cast<uint8_t*>(::operator new(size, std::align_val_t(BLOCK_ALIGNMENT))), size};
+}
+
+void LinearAllocator::FreeBlock(const Block& block)
+{
+    ::operator delete(block.Data, std::align_val_t(BLOCK_ALIGNMENT));
+}
+
+} // namespace Noctis
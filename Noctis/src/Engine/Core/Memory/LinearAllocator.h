@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Noctis
+{
+
+// Bump allocator over blocks it keeps between resets. Nothing is freed individually and no destructors run: it is
+// meant for short-lived, trivially destructible data, released all at once by Reset or back to a marker by Rewind.
+//
+// When a block runs out another is appended, and the next Reset merges them into one block large enough for the
+// peak, so a workload that repeats (a frame, a job) stops allocating after its first run. Not thread-safe.
+class LinearAllocator
+{
+  public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+    static constexpr size_t BLOCK_ALIGNMENT    = 64;
+
+    // Where the allocator is at, to Rewind to
+    struct Marker
+    {
+        uint32_t Block = 0;
+        size_t Offset  = 0;
+    };
+
+    explicit LinearAllocator(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~LinearAllocator();
+
+    LinearAllocator(const LinearAllocator&)            = delete;
+    LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    template <typename T> T* AllocateArray(size_t count)
+    {
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+    // The object's destructor is never called
+    template <typename T, typename... Args> T* New(Args&&... args)
+    {
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    Marker GetMarker() const { return {m_CurrentBlock, m_Offset}; }
+    // Frees everything allocated since the marker was taken
+    void Rewind(const Marker& marker);
+    // Frees everything, merging the blocks if more than one was needed
+    void Reset();
+
+    // Bytes handed out since the last reset, including alignment padding
+    size_t GetUsedBytes() const;
+    size_t GetCapacity() const;
+    // Highest GetUsedBytes seen
+    size_t GetPeakBytes() const;
+
+  private:
+    struct Block
+    {
+        uint8_t* Data = nullptr;
+        size_t Size   = 0;
+    };
+
+    void* AllocateFromNextBlock(size_t size, size_t alignment);
+
+    static Block AllocateBlock(size_t size);
+    static void FreeBlock(const Block& block);
+
+  private:
+    std::vector<Block> m_Blocks;
+    uint32_t m_CurrentBlock = 0;
+    size_t m_Offset         = 0;
+    size_t m_BlockSize;
+    // As of the last Rewind or Reset
+    size_t m_PeakBytes = 0;
+};
+
+// Lets std::pmr containers allocate from a LinearAllocator. Deallocation does nothing, the memory comes back when the
+// allocator is reset or rewound, so the containers must not outlive that.
+class LinearResource final : public std::pmr::memory_resource
+{
+  public:
+    explicit LinearResource(LinearAllocator& allocator) : m_Allocator(allocator) {}
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override { return m_Allocator.Allocate(bytes, alignment); }
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  private:
+    LinearAllocator& m_Allocator;
+};
+
+} // namespace Noctis
@@ -0,0 +1,69 @@
+#include "PoolAllocator.h"
+
+namespace Noctis
+{
+
+PoolAllocator::PoolAllocator(size_t slotSize, size_t alignment, uint32_t slotsPerPage)
+    : m_SlotsPerPage(slotsPerPage)
+{
+    NOC_CORE_ASSERT(slotsPerPage > 0, "PoolAllocator: pages need at least one slot!");
+
+    // Free slots hold the list link
+    m_Alignment = std::max(alignment, alignof(FreeSlot));
+    m_SlotSize  = (std::max(slotSize, sizeof(FreeSlot)) + m_Alignment - 1) / m_Alignment * m_Alignment;
+}
+
+PoolAllocator::~PoolAllocator()
+{
+    if (m_AllocatedCount > 0)
+        NOC_CORE_WARN("PoolAllocator destroyed with {0} slots still allocated", m_AllocatedCount);
+
+    for (uint8_t* page : m_Pages)
+        ::operator delete(page, std::align_val_t(m_Alignment));
+}
+
+void* PoolAllocator::Allocate()
+{
+    if (!m_FreeList)
+        AddPage();
+
+    FreeSlot* slot = m_FreeList;
+    m_FreeList     = slot->Next;
+    m_AllocatedCount++;
+    return slot;
+}
+
+void PoolAllocator::Free(void* slot)
+{
+    if (!slot)
+        return;
+
+    NOC_CORE_ASSERT(m_AllocatedCount > 0, "PoolAllocator::Free: nothing is allocated!");
+
+    FreeSlot* freed = static_cast<FreeSlot*>(slot);
+    freed->Next     = m_FreeList;
+    m_FreeList      = freed;
+    m_AllocatedCount--;
+}
+
+void PoolAllocator::Reserve(uint32_t count)
+{
+    while (GetCapacity() < count)
+        AddPage();
+}
+
+void PoolAllocator::AddPage()
+{
+    uint8_t* page = static_cast<uint8_t*>(::operator new(m_SlotSize * m_SlotsPerPage, std::align_val_t(m_Alignment)));
+    m_Pages.push_back(page);
+
+    // Linked back to front so the page is handed out in address order
+    for (uint32_t i = m_SlotsPerPage; i > 0; i--)
+    {
+        FreeSlot* slot = reinterpret_cast<FreeSlot*>(page + (i - 1) * m_SlotSize);
+        slot->Next     = m_FreeList;
+        m_FreeList     = slot;
+    }
+}
+
+} // namespace Noctis
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Noctis
+{
+
+// Fixed-size slots carved out of pages, with the free slots linked through their own storage. Allocating and freeing
+// is popping and pushing the free list; pages are only added when every slot is taken and are kept until the pool is
+// destroyed, so a pool sized for its peak never touches the heap again. Not thread-safe.
+class PoolAllocator
+{
+  public:
+    static constexpr uint32_t DEFAULT_SLOTS_PER_PAGE = 256;
+
+    PoolAllocator(size_t slotSize, size_t alignment, uint32_t slotsPerPage = DEFAULT_SLOTS_PER_PAGE);
+    ~PoolAllocator();
+
+    PoolAllocator(const PoolAllocator&)            = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    void* Allocate();
+    void Free(void* slot);
+    // Adds pages until count slots fit without growing
+    void Reserve(uint32_t count);
+
+    uint32_t GetAllocatedCount() const { return m_AllocatedCount; }
+    uint32_t GetCapacity() const { return static_cast<uint32_t>(m_Pages.size()) * m_SlotsPerPage; }
+    size_t GetSlotSize() const { return m_SlotSize; }
+
+  private:
+    struct FreeSlot
+    {
+        FreeSlot* Next;
+    };
+
+    void AddPage();
+
+  private:
+    std::vector<uint8_t*> m_Pages;
+    FreeSlot* m_FreeList = nullptr;
+    size_t m_SlotSize;
+    size_t m_Alignment;
+    uint32_t m_SlotsPerPage;
+    uint32_t m_AllocatedCount = 0;
+};
+
+// PoolAllocator for one type, constructing and destroying the objects. Objects still alive when the pool is destroyed
+// aren't destroyed, only their memory is released.
+template <typename T> class ObjectPool
+{
+  public:
+    explicit ObjectPool(uint32_t objectsPerPage = PoolAllocator::DEFAULT_SLOTS_PER_PAGE)
+        : m_Pool(sizeof(T), alignof(T), objectsPerPage)
+    {
+    }
+
+    template <typename... Args> T* Create(Args&&... args)
+    {
+        return new (m_Pool.Allocate()) T(std::forward<Args>(args)...);
+    }
+    void Destroy(T* object)
+    {
+        object->~T();
+        m_Pool.Free(object);
+    }
+    void Reserve(uint32_t count) { m_Pool.Reserve(count); }
+
+    uint32_t GetAllocatedCount() const { return m_Pool.GetAllocatedCount(); }
+    uint32_t GetCapacity() const { return m_Pool.GetCapacity(); }
+
+  private:
+    PoolAllocator m_Pool;
+};
+
+} // namespace Noctis
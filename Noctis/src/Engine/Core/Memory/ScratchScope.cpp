@@ -0,0 +1,43 @@
+#include "ScratchScope.h"
+
+namespace Noctis
+{
+
+namespace
+{
+
+struct ScratchState
+{
+    LinearAllocator Allocator;
+    // Scopes currently open on the thread
+    uint32_t Depth = 0;
+};
+
+thread_local ScratchState t_Scratch;
+
+} // namespace
+
+ScratchScope::ScratchScope()
+    : m_Allocator(t_Scratch.Allocator), m_Marker(m_Allocator.GetMarker()), m_Resource(m_Allocator),
+      m_Depth(++t_Scratch.Depth)
+{
+}
+
+ScratchScope::~ScratchScope()
+{
+    NOC_CORE_ASSERT(t_Scratch.Depth == m_Depth, "ScratchScope: scopes must end in the reverse order they began!");
+
+    // The outermost scope resets rather than rewinds, which merges the arena's blocks once it has outgrown one
+    if (--t_Scratch.Depth == 0)
+        m_Allocator.Reset();
+    else
+        m_Allocator.Rewind(m_Marker);
+}
+
+void* ScratchScope::Allocate(size_t size, size_t alignment)
+{
+    NOC_CORE_ASSERT(t_Scratch.Depth == m_Depth, "ScratchScope: only the innermost scope may allocate!");
+    return m_Allocator.Allocate(size, alignment);
+}
+
+} // namespace Noctis
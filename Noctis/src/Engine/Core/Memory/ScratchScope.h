@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Engine/Core/Memory/LinearAllocator.h"
+
+namespace Noctis
+{
+
+// Temporary memory for the lifetime of a scope, from an arena owned by the calling thread. Scopes nest like a stack:
+// each one frees what was allocated through it when it ends, and only the innermost scope of a thread may allocate.
+// The arena is kept for the thread's lifetime, so scratch work that repeats stops touching the heap.
+//
+//     ScratchScope scratch;
+//     std::pmr::vector<uint32_t> indices(count, scratch.GetResource());
+class ScratchScope
+{
+  public:
+    ScratchScope();
+    ~ScratchScope();
+
+    ScratchScope(const ScratchScope&)            = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    template <typename T> T* AllocateArray(size_t count)
+    {
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+    // The object's destructor is never called
+    template <typename T, typename... Args> T* New(Args&&... args)
+    {
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    std::pmr::memory_resource* GetResource() { return &m_Resource; }
+
+  private:
+    LinearAllocator& m_Allocator;
+    LinearAllocator::Marker m_Marker;
+    LinearResource m_Resource;
+    uint32_t m_Depth;
+};
+
+} // namespace Noctis
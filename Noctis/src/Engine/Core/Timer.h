@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chrono>
+
+namespace Noctis
+{
+
+class Timer
+{
+  public:
+    Timer() { Reset(); }
+
+    void Reset() { m_Start = std::chrono::steady_clock::now(); }
+
+    // Seconds since the last Reset
+    float Elapsed() const
+    {
+        return std::chrono::duration<float>(std::chrono::steady_clock::now() - m_Start).count();
+    }
+
+    float ElapsedMillis() const { return Elapsed() * 1000.0f; }
+
+  private:
+    std::chrono::time_point<std::chrono::steady_clock> m_Start;
+};
+
+} // namespace Noctis
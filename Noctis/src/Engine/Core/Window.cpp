@@ -0,0 +1,17 @@
+#include "Window.h"
+
+#include "Platform/MacOS/MacOSWindow.h"
+#include "Platform/Null/NullWindow.h"
+
+namespace Noctis
+{
+
+Window* Window::Create(const WindowProps& props)
+{
+    if (props.Headless)
+        return new NullWindow(props);
+
+    return new MacOSWindow(props);
+}
+
+} // namespace Noctis
@@ -11,6 +11,8 @@ struct WindowProps
     std::string Title;
     unsigned int Width;
     unsigned int Height;
+    // Creates a NullWindow, the renderer draws offscreen
+    bool Headless = false;
 
     explicit WindowProps(const std::string& title = "Noctis", unsigned int width = 1280, unsigned int height = 720)
         : Title(title), Width(width), Height(height)
@@ -32,6 +34,10 @@ class Window
 
     virtual void OnUpdate() = 0;
 
+    // Block until an event arrives, or until the timeout elapses
+    virtual void WaitEvents()                     = 0;
+    virtual void WaitEventsTimeout(float seconds) = 0;
+
     virtual unsigned int GetWidth() const  = 0;
     virtual unsigned int GetHeight() const = 0;
 
@@ -0,0 +1,397 @@
+#include "MemoryTracker.h"
+
+#include "Engine/Core/Timer.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+namespace Noctis
+{
+
+namespace
+{
+
+constexpr uint32_t TAG_COUNT = static_cast<uint32_t>(MemoryTag::Count);
+
+constexpr std::array<const char*, TAG_COUNT> TAG_NAMES = {"General", "Core", "Events", "Layers", "Renderer",
+                                                          "Assets", "ECS", "Scene", "Jobs"};
+
+// Updated from every thread allocating, so each tag gets its own cache line
+struct alignas(64) TagCounters
+{
+    std::atomic<int64_t> LiveBytes        = 0;
+    std::atomic<int64_t> PeakBytes        = 0;
+    std::atomic<uint64_t> LiveAllocations = 0;
+    std::atomic<uint64_t> AllocationCount = 0;
+
+    // Only touched by EndFrame
+    uint64_t FrameStartCount  = 0;
+    uint64_t FrameAllocations = 0;
+};
+
+// constinit: the operator new hooks run before dynamic initialization
+constinit std::array<TagCounters, TAG_COUNT> s_Counters;
+constinit TagCounters s_Total;
+constinit thread_local MemoryTag t_Tag = MemoryTag::General;
+
+struct MemoryTrackerData
+{
+    std::mutex QueryMutex;
+    std::function<std::vector<DeviceMemoryHeap>()> DeviceMemoryQuery;
+
+    float DumpInterval      = 0.0f;
+    uint64_t SpikeThreshold = 0;
+    Timer DumpTimer;
+};
+
+MemoryTrackerData s_Data;
+
+void Add(TagCounters& counters, size_t size)
+{
+    const int64_t live = counters.LiveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) +
+                         static_cast<int64_t>(size);
+    int64_t peak = counters.PeakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !counters.PeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        ;
+
+    counters.LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+    counters.AllocationCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Remove(TagCounters& counters, size_t size)
+{
+    counters.LiveBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+    counters.LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+MemoryTagStatistics ToStatistics(const TagCounters& counters)
+{
+    MemoryTagStatistics statistics;
+    statistics.LiveBytes        = counters.LiveBytes.load(std::memory_order_relaxed);
+    statistics.PeakBytes        = counters.PeakBytes.load(std::memory_order_relaxed);
+    statistics.LiveAllocations  = counters.LiveAllocations.load(std::memory_order_relaxed);
+    statistics.AllocationCount  = counters.AllocationCount.load(std::memory_order_relaxed);
+    statistics.FrameAllocations = counters.FrameAllocations;
+    return statistics;
+}
+
+void CloseFrame(TagCounters& counters)
+{
+    const uint64_t count      = counters.AllocationCount.load(std::memory_order_relaxed);
+    counters.FrameAllocations = count - counters.FrameStartCount;
+    counters.FrameStartCount  = count;
+}
+
+} // namespace
+
+MemoryTag MemoryTracker::GetCurrentTag()
+{
+    return t_Tag;
+}
+
+void MemoryTracker::SetCurrentTag(MemoryTag tag)
+{
+    t_Tag = tag;
+}
+
+const char* MemoryTracker::GetTagName(MemoryTag tag)
+{
+    return static_cast<uint32_t>(tag) < TAG_COUNT ? TAG_NAMES[static_cast<uint32_t>(tag)] : "Unknown";
+}
+
+MemoryTagStatistics MemoryTracker::GetStatistics(MemoryTag tag)
+{
+    NOC_CORE_ASSERT(static_cast<uint32_t>(tag) < TAG_COUNT, "MemoryTracker: invalid tag!");
+    return ToStatistics(s_Counters[static_cast<uint32_t>(tag)]);
+}
+
+MemoryTagStatistics MemoryTracker::GetTotalStatistics()
+{
+    return ToStatistics(s_Total);
+}
+
+void MemoryTracker::SetDeviceMemoryQuery(std::function<std::vector<DeviceMemoryHeap>()> query)
+{
+    std::lock_guard lock(s_Data.QueryMutex);
+    s_Data.DeviceMemoryQuery = std::move(query);
+}
+
+std::vector<DeviceMemoryHeap> MemoryTracker::GetDeviceMemoryHeaps()
+{
+    std::lock_guard lock(s_Data.QueryMutex);
+    return s_Data.DeviceMemoryQuery ? s_Data.DeviceMemoryQuery() : std::vector<DeviceMemoryHeap>();
+}
+
+void MemoryTracker::EndFrame()
+{
+    NOC_PROFILE_FUNCTION();
+
+    if constexpr (IsEnabled())
+    {
+        for (TagCounters& counters : s_Counters)
+            CloseFrame(counters);
+        CloseFrame(s_Total);
+
+        if (s_Data.SpikeThreshold > 0 && s_Total.FrameAllocations > s_Data.SpikeThreshold)
+        {
+            NOC_CORE_WARN("MemoryTracker: {0} allocations last frame (threshold {1})", s_Total.FrameAllocations,
+                          s_Data.SpikeThreshold);
+            for (uint32_t tag = 0; tag < TAG_COUNT; tag++)
+            {
+                if (s_Counters[tag].FrameAllocations > 0)
+                    NOC_CORE_WARN("  {0}: {1}", TAG_NAMES[tag], s_Counters[tag].FrameAllocations);
+            }
+        }
+    }
+
+    if (s_Data.DumpInterval > 0.0f && s_Data.DumpTimer.Elapsed() >= s_Data.DumpInterval)
+    {
+        Dump();
+        s_Data.DumpTimer.Reset();
+    }
+}
+
+void MemoryTracker::SetDumpInterval(float seconds)
+{
+    s_Data.DumpInterval = std::max(seconds, 0.0f);
+    s_Data.DumpTimer.Reset();
+}
+
+void MemoryTracker::SetSpikeThreshold(uint64_t allocations)
+{
+    s_Data.SpikeThreshold = allocations;
+}
+
+void MemoryTracker::Dump()
+{
+    if constexpr (IsEnabled())
+    {
+        const MemoryTagStatistics total = GetTotalStatistics();
+        NOC_CORE_INFO("Host memory: {0} KiB live in {1} allocations, peak {2} KiB, {3} allocations last frame",
+                      total.LiveBytes / 1024, total.LiveAllocations, total.PeakBytes / 1024, total.FrameAllocations);
+        for (uint32_t tag = 0; tag < TAG_COUNT; tag++)
+        {
+            const MemoryTagStatistics statistics = GetStatistics(static_cast<MemoryTag>(tag));
+            if (statistics.AllocationCount == 0)
+                continue;
+
+            NOC_CORE_INFO("  {0}: {1} KiB live in {2} allocations, peak {3} KiB, {4} allocations last frame",
+                          TAG_NAMES[tag], statistics.LiveBytes / 1024, statistics.LiveAllocations,
+                          statistics.PeakBytes / 1024, statistics.FrameAllocations);
+        }
+    }
+    else
+    {
+        NOC_CORE_INFO("Host memory: not tracked, build with NOC_ENABLE_MEMORY_TRACKING");
+    }
+
+    const std::vector<DeviceMemoryHeap> heaps = GetDeviceMemoryHeaps();
+    for (size_t i = 0; i < heaps.size(); i++)
+    {
+        const DeviceMemoryHeap& heap = heaps[i];
+        NOC_CORE_INFO("Device heap {0} ({1}): {2} MiB used of {3} MiB allocated, {4} allocations, heap size {5} MiB", i,
+                      heap.DeviceLocal ? "device local" : "host", heap.UsedBytes >> 20, heap.AllocatedBytes >> 20,
+                      heap.AllocationCount, heap.Size >> 20);
+    }
+}
+
+void MemoryTracker::ReportLeaks()
+{
+    if constexpr (!IsEnabled())
+        return;
+
+    // General also holds whatever static objects and the logger keep until exit, so it isn't reported
+    for (uint32_t tag = static_cast<uint32_t>(MemoryTag::General) + 1; tag < TAG_COUNT; tag++)
+    {
+        const MemoryTagStatistics statistics = GetStatistics(static_cast<MemoryTag>(tag));
+        if (statistics.LiveAllocations > 0)
+            NOC_CORE_WARN("MemoryTracker: {0} leaked {1} bytes in {2} allocations", TAG_NAMES[tag],
+                          statistics.LiveBytes, statistics.LiveAllocations);
+    }
+}
+
+void MemoryTracker::OnAllocate(MemoryTag tag, size_t size)
+{
+    Add(s_Counters[static_cast<uint32_t>(tag)], size);
+    Add(s_Total, size);
+}
+
+void MemoryTracker::OnFree(MemoryTag tag, size_t size)
+{
+    Remove(s_Counters[static_cast<uint32_t>(tag)], size);
+    Remove(s_Total, size);
+}
+
+} // namespace Noctis
+
+#if NOC_MEMORY_TRACKING
+
+namespace
+{
+
+// Stored right before every tracked allocation
+struct AllocationHeader
+{
+    uint64_t Size;
+    // From the start of the underlying block to the pointer handed out
+    uint32_t Offset;
+    Noctis::MemoryTag Tag;
+};
+
+constexpr size_t HEADER_SIZE = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+static_assert(sizeof(AllocationHeader) <= HEADER_SIZE, "AllocationHeader must fit in the default alignment");
+
+void* TrackedAllocate(size_t size, size_t alignment) noexcept
+{
+    // The header takes a whole alignment unit, so the pointer after it keeps the alignment
+    const size_t offset = std::max(alignment, HEADER_SIZE);
+    void* block;
+    if (offset == HEADER_SIZE)
+        block = std::malloc(size + offset);
+    else
+        block = std::aligned_alloc(offset, (size + offset + offset - 1) / offset * offset);
+    if (!block)
+        return nullptr;
+
+    uint8_t* pointer         = static_cast<uint8_t*>(block) + offset;
+    AllocationHeader* header = reinterpret_cast<AllocationHeader*>(pointer - HEADER_SIZE);
+    header->Size             = size;
+    header->Offset           = static_cast<uint32_t>(offset);
+    header->Tag              = Noctis::MemoryTracker::GetCurrentTag();
+
+    Noctis::MemoryTracker::OnAllocate(header->Tag, size);
+    return pointer;
+}
+
+void* TrackedAllocateOrThrow(size_t size, size_t alignment)
+{
+    for (;;)
+    {
+        if (void* pointer = TrackedAllocate(size, alignment))
+            return pointer;
+
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void TrackedFree(void* pointer) noexcept
+{
+    if (!pointer)
+        return;
+
+    uint8_t* bytes                 = static_cast<uint8_t*>(pointer);
+    const AllocationHeader* header = reinterpret_cast<const AllocationHeader*>(bytes - HEADER_SIZE);
+    Noctis::MemoryTracker::OnFree(header->Tag, header->Size);
+    std::free(bytes - header->Offset);
+}
+
+} // namespace
+
+// Replacements of every global allocation function, so nothing allocated through one is freed through an untracked one
+
+void* operator new(size_t size)
+{
+    return TrackedAllocateOrThrow(size, HEADER_SIZE);
+}
+
+void* operator new[](size_t size)
+{
+    return TrackedAllocateOrThrow(size, HEADER_SIZE);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return TrackedAllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return TrackedAllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return TrackedAllocate(size, HEADER_SIZE);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return TrackedAllocate(size, HEADER_SIZE);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return TrackedAllocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return TrackedAllocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    TrackedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    TrackedFree(pointer);
+}
+
+#endif
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Set from CMake with NOC_ENABLE_MEMORY_TRACKING, which replaces the global operator new and delete
+#ifndef NOC_MEMORY_TRACKING
+#define NOC_MEMORY_TRACKING 0
+#endif
+
+namespace Noctis
+{
+
+// Who heap allocations are charged to. Allocations outside any MemoryScope are General, jobs inherit the tag of the
+// code that queued them.
+enum class MemoryTag : uint8_t
+{
+    General = 0,
+    Core,
+    Events,
+    Layers,
+    Renderer,
+    Assets,
+    ECS,
+    Scene,
+    Jobs,
+    Count
+};
+
+struct MemoryTagStatistics
+{
+    int64_t LiveBytes        = 0;
+    int64_t PeakBytes        = 0;
+    uint64_t LiveAllocations = 0;
+    // Since startup
+    uint64_t AllocationCount = 0;
+    // During the last complete frame
+    uint64_t FrameAllocations = 0;
+};
+
+// One device memory heap, as reported by the renderer
+struct DeviceMemoryHeap
+{
+    uint64_t Size    = 0;
+    bool DeviceLocal = false;
+    // Memory obtained from the driver, and how much of it is handed out to resources
+    uint64_t AllocatedBytes  = 0;
+    uint64_t UsedBytes       = 0;
+    uint32_t AllocationCount = 0;
+};
+
+// Heap usage per MemoryTag, counted by the global operator new and delete when built with NOC_MEMORY_TRACKING (every
+// allocation then carries a small header recording its size and tag). Without it the host statistics stay zero and
+// scopes compile to nothing, while device memory, which comes from the renderer, is always available.
+//
+// Application calls EndFrame once per frame: it closes the per-frame allocation counts, warns when a frame allocated
+// more than the spike threshold and dumps everything to the log at the dump interval.
+class MemoryTracker
+{
+  public:
+    static constexpr bool IsEnabled() { return NOC_MEMORY_TRACKING != 0; }
+
+    static MemoryTag GetCurrentTag();
+    static void SetCurrentTag(MemoryTag tag);
+    static const char* GetTagName(MemoryTag tag);
+
+    static MemoryTagStatistics GetStatistics(MemoryTag tag);
+    // Summed over every tag
+    static MemoryTagStatistics GetTotalStatistics();
+
+    // Set by the renderer, returns the heaps of the device in use
+    static void SetDeviceMemoryQuery(std::function<std::vector<DeviceMemoryHeap>()> query);
+    static std::vector<DeviceMemoryHeap> GetDeviceMemoryHeaps();
+
+    static void EndFrame();
+    // Seconds between dumps, 0 disables them
+    static void SetDumpInterval(float seconds);
+    // Allocations per frame above which a frame is reported, 0 disables the check
+    static void SetSpikeThreshold(uint64_t allocations);
+    static void Dump();
+    // Logs memory still held by tags other than General, call once their subsystems have shut down
+    static void ReportLeaks();
+
+    // Called by the operator new and delete hooks
+    static void OnAllocate(MemoryTag tag, size_t size);
+    static void OnFree(MemoryTag tag, size_t size);
+};
+
+// Charges the heap allocations of the enclosing scope, on this thread, to a tag
+class MemoryScope
+{
+  public:
+    explicit MemoryScope(MemoryTag tag) : m_Previous(MemoryTracker::GetCurrentTag())
+    {
+        MemoryTracker::SetCurrentTag(tag);
+    }
+    ~MemoryScope() { MemoryTracker::SetCurrentTag(m_Previous); }
+
+    MemoryScope(const MemoryScope&)            = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+
+  private:
+    MemoryTag m_Previous;
+};
+
+} // namespace Noctis
+
+#if NOC_MEMORY_TRACKING
+#define NOC_MEMORY_SCOPE_LINE2(tag, line) ::Noctis::MemoryScope memoryScope##line(::Noctis::MemoryTag::tag)
+#define NOC_MEMORY_SCOPE_LINE(tag, line) NOC_MEMORY_SCOPE_LINE2(tag, line)
+#define NOC_MEMORY_SCOPE(tag) NOC_MEMORY_SCOPE_LINE(tag, __LINE__)
+#else
+#define NOC_MEMORY_SCOPE(tag)
+#endif
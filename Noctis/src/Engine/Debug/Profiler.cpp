@@ -0,0 +1,241 @@
+#include "Profiler.h"
+
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace Noctis
+{
+
+namespace
+{
+
+struct ProfileEvent
+{
+    const char* Name;
+    int64_t Start;
+    int64_t Duration;
+};
+
+// Events a buffer holds before they are written out, which bounds the memory a long session takes
+constexpr size_t FLUSH_THRESHOLD = 16384;
+
+// Only its own thread appends, the mutex is uncontended except while a session is being written out
+struct ThreadBuffer
+{
+    std::mutex Mutex;
+    std::vector<ProfileEvent> Events;
+    // Swapped with Events to write them out without holding Mutex, only touched under StreamMutex
+    std::vector<ProfileEvent> Flushing;
+    uint32_t ThreadID;
+    std::string Name;
+};
+
+struct ProfilerData
+{
+    std::atomic<bool> SessionActive = false;
+    std::string SessionName;
+    std::string Filepath;
+    int64_t SessionStart = 0;
+
+    // Taken before RegistryMutex and the buffer mutexes
+    std::mutex StreamMutex;
+    std::ofstream Stream;
+    bool FirstEvent = true;
+
+    std::mutex RegistryMutex;
+    std::vector<Ref<ThreadBuffer>> Buffers;
+    Ref<ThreadBuffer> GPUBuffer;
+
+    std::mutex NameMutex;
+    std::unordered_set<std::string> InternedNames;
+};
+
+ProfilerData s_Data;
+
+thread_local Ref<ThreadBuffer> t_Buffer;
+
+ThreadBuffer& RegisterBuffer(Ref<ThreadBuffer>& buffer, const char* name)
+{
+    std::lock_guard lock(s_Data.RegistryMutex);
+
+    buffer           = CreateRef<ThreadBuffer>();
+    buffer->ThreadID = static_cast<uint32_t>(s_Data.Buffers.size());
+    buffer->Name     = name ? name : "Thread " + std::to_string(buffer->ThreadID);
+    buffer->Events.reserve(FLUSH_THRESHOLD);
+    buffer->Flushing.reserve(FLUSH_THRESHOLD);
+    s_Data.Buffers.push_back(buffer);
+
+    return *buffer;
+}
+
+ThreadBuffer& GetThreadBuffer()
+{
+    if (!t_Buffer)
+        RegisterBuffer(t_Buffer, nullptr);
+    return *t_Buffer;
+}
+
+void WriteEscaped(std::ofstream& stream, std::string_view text)
+{
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            stream << '\\';
+        stream << c;
+    }
+}
+
+// Caller holds StreamMutex
+std::ofstream& WriteSeparator()
+{
+    if (!s_Data.FirstEvent)
+        s_Data.Stream << ",";
+    s_Data.FirstEvent = false;
+    return s_Data.Stream;
+}
+
+// Caller holds StreamMutex
+void WriteEvents(const ThreadBuffer& buffer, const std::vector<ProfileEvent>& events)
+{
+    for (const ProfileEvent& event : events)
+    {
+        // Trace timestamps are microseconds, fractional values keep the nanosecond precision
+        WriteSeparator() << "{\"cat\":\"function\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer.ThreadID
+                         << ",\"ts\":" << static_cast<double>(event.Start - s_Data.SessionStart) / 1000.0
+                         << ",\"dur\":" << static_cast<double>(event.Duration) / 1000.0 << ",\"name\":\"";
+        WriteEscaped(s_Data.Stream, event.Name);
+        s_Data.Stream << "\"}";
+    }
+}
+
+// Writes out a full buffer, on the thread that filled it
+void FlushBuffer(ThreadBuffer& buffer)
+{
+    std::lock_guard streamLock(s_Data.StreamMutex);
+    {
+        std::lock_guard lock(buffer.Mutex);
+        buffer.Flushing.swap(buffer.Events);
+    }
+
+    if (s_Data.Stream.is_open())
+        WriteEvents(buffer, buffer.Flushing);
+    buffer.Flushing.clear();
+}
+
+void RecordEvent(ThreadBuffer& buffer, const ProfileEvent& event)
+{
+    bool full;
+    {
+        std::lock_guard lock(buffer.Mutex);
+        buffer.Events.push_back(event);
+        full = buffer.Events.size() >= FLUSH_THRESHOLD;
+    }
+
+    if (full)
+        FlushBuffer(buffer);
+}
+
+} // namespace
+
+void Profiler::BeginSession(const std::string& name, const std::string& filepath)
+{
+    if (s_Data.SessionActive)
+    {
+        NOC_CORE_ERROR("Profiler::BeginSession('{0}') while session '{1}' is already open", name, s_Data.SessionName);
+        EndSession();
+    }
+
+    // Created here rather than on the first GPU event, which could come from more than one thread
+    if (!s_Data.GPUBuffer)
+        RegisterBuffer(s_Data.GPUBuffer, "GPU");
+
+    std::lock_guard streamLock(s_Data.StreamMutex);
+    {
+        std::lock_guard lock(s_Data.RegistryMutex);
+        for (const Ref<ThreadBuffer>& buffer : s_Data.Buffers)
+        {
+            std::lock_guard bufferLock(buffer->Mutex);
+            buffer->Events.clear();
+        }
+    }
+
+    s_Data.Stream.open(filepath);
+    if (!s_Data.Stream.is_open())
+    {
+        NOC_CORE_ERROR("Profiler could not open results file '{0}'", filepath);
+        return;
+    }
+
+    s_Data.Stream << "{\"otherData\": {\"session\": \"";
+    WriteEscaped(s_Data.Stream, name);
+    s_Data.Stream << "\"},\"displayTimeUnit\": \"ms\",\"traceEvents\":[";
+    s_Data.FirstEvent = true;
+
+    s_Data.SessionName   = name;
+    s_Data.Filepath      = filepath;
+    s_Data.SessionStart  = GetTimestamp();
+    s_Data.SessionActive = true;
+}
+
+void Profiler::EndSession()
+{
+    if (!s_Data.SessionActive)
+        return;
+
+    s_Data.SessionActive = false;
+
+    std::lock_guard streamLock(s_Data.StreamMutex);
+    std::lock_guard lock(s_Data.RegistryMutex);
+    for (const Ref<ThreadBuffer>& buffer : s_Data.Buffers)
+    {
+        std::lock_guard bufferLock(buffer->Mutex);
+
+        WriteSeparator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->ThreadID
+                         << ",\"args\":{\"name\":\"";
+        WriteEscaped(s_Data.Stream, buffer->Name);
+        s_Data.Stream << "\"}}";
+
+        WriteEvents(*buffer, buffer->Events);
+        buffer->Events.clear();
+    }
+
+    s_Data.Stream << "]}";
+    s_Data.Stream.close();
+}
+
+bool Profiler::IsSessionActive()
+{
+    return s_Data.SessionActive.load(std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+
+    std::lock_guard lock(buffer.Mutex);
+    buffer.Name = name;
+}
+
+void Profiler::RecordScope(const char* name, int64_t start, int64_t duration)
+{
+    RecordEvent(GetThreadBuffer(), {name, start, duration});
+}
+
+void Profiler::RecordGPUScope(const char* name, int64_t start, int64_t duration)
+{
+    if (!IsSessionActive())
+        return;
+
+    RecordEvent(*s_Data.GPUBuffer, {name, start, duration});
+}
+
+const char* Profiler::InternName(std::string_view name)
+{
+    std::lock_guard lock(s_Data.NameMutex);
+    return s_Data.InternedNames.emplace(name).first->c_str();
+}
+
+} // namespace Noctis
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Set from CMake with NOC_ENABLE_PROFILING
+#ifndef NOC_PROFILE
+#define NOC_PROFILE 0
+#endif
+
+namespace Noctis
+{
+
+// Records timed scopes into per-thread buffers and writes them as a Chrome trace (chrome://tracing, ui.perfetto.dev).
+// A buffer is written out whenever it fills up and once more when the session ends, so memory stays bounded however
+// long the session runs. Names are stored by pointer, so they must outlive the session: use literals or InternName.
+class Profiler
+{
+  public:
+    static void BeginSession(const std::string& name, const std::string& filepath);
+    static void EndSession();
+    static bool IsSessionActive();
+
+    static void SetThreadName(const char* name);
+
+    // Nanoseconds on the profiler clock
+    static int64_t GetTimestamp()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    static void RecordScope(const char* name, int64_t start, int64_t duration);
+    // Adds an event to the GPU track. Times must already be converted to the profiler clock.
+    static void RecordGPUScope(const char* name, int64_t start, int64_t duration);
+
+    static const char* InternName(std::string_view name);
+};
+
+class ProfileScope
+{
+  public:
+    explicit ProfileScope(const char* name) : m_Name(name), m_Start(Profiler::GetTimestamp()) {}
+    ~ProfileScope()
+    {
+        if (Profiler::IsSessionActive())
+            Profiler::RecordScope(m_Name, m_Start, Profiler::GetTimestamp() - m_Start);
+    }
+
+    ProfileScope(const ProfileScope&)            = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+  private:
+    const char* m_Name;
+    int64_t m_Start;
+};
+
+} // namespace Noctis
+
+#if NOC_PROFILE
+#define NOC_PROFILE_BEGIN_SESSION(name, filepath) ::Noctis::Profiler::BeginSession(name, filepath)
+#define NOC_PROFILE_END_SESSION() ::Noctis::Profiler::EndSession()
+#define NOC_PROFILE_THREAD(name) ::Noctis::Profiler::SetThreadName(name)
+#define NOC_PROFILE_SCOPE_LINE2(name, line) ::Noctis::ProfileScope profileScope##line(name)
+#define NOC_PROFILE_SCOPE_LINE(name, line) NOC_PROFILE_SCOPE_LINE2(name, line)
+#define NOC_PROFILE_SCOPE(name) NOC_PROFILE_SCOPE_LINE(name, __LINE__)
+#define NOC_PROFILE_FUNCTION() NOC_PROFILE_SCOPE(__PRETTY_FUNCTION__)
+#else
+#define NOC_PROFILE_BEGIN_SESSION(name, filepath)
+#define NOC_PROFILE_END_SESSION()
+#define NOC_PROFILE_THREAD(name)
+#define NOC_PROFILE_SCOPE(name)
+#define NOC_PROFILE_FUNCTION()
+#endif
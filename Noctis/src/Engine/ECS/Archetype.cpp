@@ -0,0 +1,122 @@
+#include "Archetype.h"
+
+#include <new>
+
+namespace Noctis
+{
+
+namespace
+{
+
+uint32_t AlignUp(uint32_t value, uint32_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+uint8_t* AllocateChunk()
+{
+    return static_cast<uint8_t*>(::operator new(Archetype::CHUNK_SIZE, std::align_val_t(Archetype::CHUNK_ALIGNMENT)));
+}
+
+void FreeChunk(uint8_t* data)
+{
+    ::operator delete(data, std::align_val_t(Archetype::CHUNK_ALIGNMENT));
+}
+
+} // namespace
+
+Archetype::Archetype(const ComponentMask& mask) : m_Mask(mask)
+{
+    m_Columns.fill(INVALID_COLUMN);
+
+    uint32_t rowSize = sizeof(Entity);
+    for (ComponentID id = 0; id < ComponentRegistry::MAX_COMPONENTS; id++)
+    {
+        if (!mask.test(id))
+            continue;
+
+        const ComponentInfo& info = ComponentRegistry::GetInfo(id);
+        NOC_CORE_ASSERT(info.Alignment <= CHUNK_ALIGNMENT, "Component alignment exceeds the chunk alignment");
+
+        m_Columns[id] = static_cast<uint32_t>(m_Components.size());
+        m_Components.push_back(id);
+        m_Sizes.push_back(info.Size);
+        rowSize += info.Size;
+    }
+    m_Offsets.resize(m_Components.size());
+
+    // Start from the capacity ignoring padding and shrink until the cache line aligned arrays fit
+    for (m_ChunkCapacity = CHUNK_SIZE / rowSize; m_ChunkCapacity > 0; m_ChunkCapacity--)
+    {
+        uint32_t offset = sizeof(Entity) * m_ChunkCapacity;
+        for (size_t column = 0; column < m_Components.size(); column++)
+        {
+            offset            = AlignUp(offset, CHUNK_ALIGNMENT);
+            m_Offsets[column] = offset;
+            offset += m_Sizes[column] * m_ChunkCapacity;
+        }
+        if (offset <= CHUNK_SIZE)
+            break;
+    }
+    NOC_CORE_ASSERT(m_ChunkCapacity > 0, "Archetype components don't fit in a chunk");
+}
+
+Archetype::~Archetype()
+{
+    for (uint32_t row = 0; row < m_EntityCount; row++)
+        DestroyComponents(row);
+
+    for (Chunk& chunk : m_Chunks)
+        FreeChunk(chunk.Data);
+    if (m_SpareChunk)
+        FreeChunk(m_SpareChunk);
+}
+
+uint32_t Archetype::AddRow(Entity entity)
+{
+    if (m_Chunks.empty() || m_Chunks.back().Count == m_ChunkCapacity)
+    {
+        Chunk& chunk = m_Chunks.emplace_back();
+        chunk.Data   = m_SpareChunk ? m_SpareChunk : AllocateChunk();
+        m_SpareChunk = nullptr;
+    }
+
+    Chunk& chunk                      = m_Chunks.back();
+    GetEntities(chunk)[chunk.Count++] = entity;
+    return m_EntityCount++;
+}
+
+Entity Archetype::RemoveRow(uint32_t row)
+{
+    NOC_CORE_ASSERT(row < m_EntityCount, "Archetype::RemoveRow: row out of range");
+
+    const uint32_t last = m_EntityCount - 1;
+    Entity moved;
+    if (row != last)
+    {
+        for (uint32_t column = 0; column < m_Components.size(); column++)
+            ComponentRegistry::Relocate(m_Components[column], GetComponent(row, column), GetComponent(last, column));
+
+        moved                                     = GetEntity(last);
+        const Chunk& chunk                        = m_Chunks[row / m_ChunkCapacity];
+        GetEntities(chunk)[row % m_ChunkCapacity] = moved;
+    }
+
+    m_EntityCount--;
+    if (--m_Chunks.back().Count == 0)
+    {
+        if (m_SpareChunk)
+            FreeChunk(m_SpareChunk);
+        m_SpareChunk = m_Chunks.back().Data;
+        m_Chunks.pop_back();
+    }
+    return moved;
+}
+
+void Archetype::DestroyComponents(uint32_t row)
+{
+    for (uint32_t column = 0; column < m_Components.size(); column++)
+        ComponentRegistry::Destroy(m_Components[column], GetComponent(row, column));
+}
+
+} // namespace Noctis
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Engine/ECS/Component.h"
+#include "Engine/ECS/Entity.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace Noctis
+{
+
+// Fixed-size block of an archetype's entities: the entity handles, then one array per component (structure of
+// arrays), each array starting on a cache line. Rows [0, Count) are live.
+struct Chunk
+{
+    uint8_t* Data  = nullptr;
+    uint32_t Count = 0;
+};
+
+// Storage of every entity having exactly one set of components. Entities are kept packed: all chunks but the last
+// are full, and removing an entity moves the archetype's last one into its row. Rows are numbered across chunks.
+class Archetype
+{
+  public:
+    static constexpr uint32_t CHUNK_SIZE      = 16 * 1024;
+    static constexpr uint32_t CHUNK_ALIGNMENT = 64;
+    static constexpr uint32_t INVALID_COLUMN  = UINT32_MAX;
+
+    explicit Archetype(const ComponentMask& mask);
+    ~Archetype();
+
+    Archetype(const Archetype&)            = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    const ComponentMask& GetMask() const { return m_Mask; }
+    // Sorted by ID, a component's column is its index in here
+    const std::vector<ComponentID>& GetComponents() const { return m_Components; }
+    uint32_t GetColumn(ComponentID id) const { return m_Columns[id]; }
+
+    uint32_t GetEntityCount() const { return m_EntityCount; }
+    uint32_t GetChunkCapacity() const { return m_ChunkCapacity; }
+    uint32_t GetChunkCount() const { return static_cast<uint32_t>(m_Chunks.size()); }
+    const Chunk& GetChunk(uint32_t index) const { return m_Chunks[index]; }
+
+    Entity* GetEntities(const Chunk& chunk) const { return reinterpret_cast<Entity*>(chunk.Data); }
+    void* GetArray(const Chunk& chunk, uint32_t column) const { return chunk.Data + m_Offsets[column]; }
+
+    Entity GetEntity(uint32_t row) const
+    {
+        return GetEntities(m_Chunks[row / m_ChunkCapacity])[row % m_ChunkCapacity];
+    }
+    void* GetComponent(uint32_t row, uint32_t column) const
+    {
+        const Chunk& chunk = m_Chunks[row / m_ChunkCapacity];
+        return chunk.Data + m_Offsets[column] + (row % m_ChunkCapacity) * m_Sizes[column];
+    }
+
+    // Appends a row for entity, its components are left for the caller to construct. Returns the row.
+    uint32_t AddRow(Entity entity);
+    // Removes a row whose components have been destroyed or relocated already. Returns the entity moved into the
+    // row to fill the hole, an invalid one if it was the last row.
+    Entity RemoveRow(uint32_t row);
+    void DestroyComponents(uint32_t row);
+
+  private:
+    ComponentMask m_Mask;
+    std::vector<ComponentID> m_Components;
+    // Per component ID, its column or INVALID_COLUMN
+    std::array<uint32_t, ComponentRegistry::MAX_COMPONENTS> m_Columns;
+    std::vector<uint32_t> m_Offsets;
+    std::vector<uint32_t> m_Sizes;
+    uint32_t m_ChunkCapacity = 0;
+
+    std::vector<Chunk> m_Chunks;
+    uint32_t m_EntityCount = 0;
+    // The last chunk to empty, kept so an entity moving back and forth doesn't allocate every time
+    uint8_t* m_SpareChunk = nullptr;
+
+    // Archetypes with one component more or less, filled in by the World as it moves entities around
+    std::unordered_map<ComponentID, Archetype*> m_AddEdges;
+    std::unordered_map<ComponentID, Archetype*> m_RemoveEdges;
+
+    friend class World;
+};
+
+} // namespace Noctis
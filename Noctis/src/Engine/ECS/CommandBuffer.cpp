@@ -0,0 +1,135 @@
+#include "CommandBuffer.h"
+
+namespace Noctis
+{
+
+namespace
+{
+
+constexpr std::align_val_t PAYLOAD_ALIGNMENT = std::align_val_t(Archetype::CHUNK_ALIGNMENT);
+
+uint8_t* AllocateBlock(size_t size)
+{
+    return static_cast<uint8_t*>(::operator new(size, PAYLOAD_ALIGNMENT));
+}
+
+void FreeBlock(uint8_t* block)
+{
+    ::operator delete(block, PAYLOAD_ALIGNMENT);
+}
+
+} // namespace
+
+CommandBuffer::~CommandBuffer()
+{
+    Clear();
+    for (uint8_t* block : m_Blocks)
+        FreeBlock(block);
+}
+
+void CommandBuffer::DestroyEntity(Entity entity)
+{
+    Command& command = m_Commands.emplace_back();
+    command.Type     = CommandType::DestroyEntity;
+    command.Target   = entity;
+}
+
+void CommandBuffer::Playback(World& world)
+{
+    if (m_Commands.empty())
+        return;
+
+    NOC_PROFILE_FUNCTION();
+    NOC_MEMORY_SCOPE(ECS);
+
+    std::array<ComponentID, ComponentRegistry::MAX_COMPONENTS> components;
+    for (size_t i = 0; i < m_Commands.size(); i++)
+    {
+        const Command& command = m_Commands[i];
+        switch (command.Type)
+        {
+            case CommandType::CreateEntity:
+            {
+                const Command* payloads = m_Commands.data() + i + 1;
+                for (uint32_t j = 0; j < command.ComponentCount; j++)
+                    components[j] = payloads[j].Component;
+
+                const Entity entity = world.CreateEntity(components.data(), command.ComponentCount);
+                for (uint32_t j = 0; j < command.ComponentCount; j++)
+                {
+                    const ComponentID id = payloads[j].Component;
+                    ComponentRegistry::Relocate(id, world.GetComponent(entity, id), payloads[j].Payload);
+                }
+                i += command.ComponentCount;
+                break;
+            }
+            case CommandType::CreateComponent:
+                NOC_CORE_ASSERT(false, "CommandBuffer: component without an entity!");
+                break;
+            case CommandType::DestroyEntity:
+                if (world.IsAlive(command.Target))
+                    world.DestroyEntity(command.Target);
+                break;
+            case CommandType::AddComponent:
+                if (world.IsAlive(command.Target))
+                {
+                    void* component = world.AddComponent(command.Target, command.Component);
+                    ComponentRegistry::Relocate(command.Component, component, command.Payload);
+                }
+                else
+                {
+                    ComponentRegistry::Destroy(command.Component, command.Payload);
+                }
+                break;
+            case CommandType::RemoveComponent:
+                if (world.IsAlive(command.Target))
+                    world.RemoveComponent(command.Target, command.Component);
+                break;
+        }
+    }
+
+    Reset();
+}
+
+void CommandBuffer::Clear()
+{
+    for (const Command& command : m_Commands)
+    {
+        if (command.Payload)
+            ComponentRegistry::Destroy(command.Component, command.Payload);
+    }
+    Reset();
+}
+
+void* CommandBuffer::AllocatePayload(const ComponentInfo& info)
+{
+    if (info.Size > BLOCK_SIZE)
+        return m_LargePayloads.emplace_back(AllocateBlock(info.Size));
+
+    if (m_Blocks.empty())
+        m_Blocks.push_back(AllocateBlock(BLOCK_SIZE));
+
+    size_t offset = (m_BlockOffset + info.Alignment - 1) / info.Alignment * info.Alignment;
+    if (offset + info.Size > BLOCK_SIZE)
+    {
+        if (++m_CurrentBlock == m_Blocks.size())
+            m_Blocks.push_back(AllocateBlock(BLOCK_SIZE));
+        offset = 0;
+    }
+
+    m_BlockOffset = offset + info.Size;
+    return m_Blocks[m_CurrentBlock] + offset;
+}
+
+void CommandBuffer::Reset()
+{
+    m_Commands.clear();
+    m_CurrentBlock = 0;
+    m_BlockOffset  = 0;
+
+    for (uint8_t* payload : m_LargePayloads)
+        FreeBlock(payload);
+    m_LargePayloads.clear();
+}
+
+} // namespace Noctis
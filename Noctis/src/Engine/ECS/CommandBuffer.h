@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Engine/ECS/World.h"
+
+namespace Noctis
+{
+
+// Structural changes recorded while a World can't take them (during iteration or from systems running in parallel),
+// applied in recording order by Playback. Component values are moved into blocks the buffer keeps between frames, so
+// steady-state recording doesn't allocate.
+//
+// Commands targeting an entity that has been destroyed by the time they play back are dropped.
+class CommandBuffer
+{
+  public:
+    CommandBuffer() = default;
+    ~CommandBuffer();
+
+    CommandBuffer(const CommandBuffer&)            = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    // The entity doesn't exist until playback, so no handle is returned
+    template <typename... Components> void CreateEntity(Components&&... components);
+    void DestroyEntity(Entity entity);
+    template <typename T> void AddComponent(Entity entity, T&& component);
+    template <typename T> void RemoveComponent(Entity entity);
+
+    void Playback(World& world);
+    // Drops the recorded commands without applying them
+    void Clear();
+    bool IsEmpty() const { return m_Commands.empty(); }
+
+  private:
+    enum class CommandType : uint8_t
+    {
+        CreateEntity,
+        // One per component of the preceding CreateEntity
+        CreateComponent,
+        DestroyEntity,
+        AddComponent,
+        RemoveComponent
+    };
+
+    struct Command
+    {
+        CommandType Type;
+        // Components following a CreateEntity
+        uint32_t ComponentCount = 0;
+        ComponentID Component   = 0;
+        Entity Target;
+        void* Payload = nullptr;
+    };
+
+    static constexpr size_t BLOCK_SIZE = 16 * 1024;
+
+    template <typename T> void PushPayload(CommandType type, Entity target, T&& component);
+    void* AllocatePayload(const ComponentInfo& info);
+    // Forgets the commands and rewinds the payload blocks, the payloads must have been relocated or destroyed
+    void Reset();
+
+  private:
+    std::vector<Command> m_Commands;
+
+    // Payload blocks, [0, m_CurrentBlock] are in use. Blocks never move so payloads stay put as more are recorded.
+    std::vector<uint8_t*> m_Blocks;
+    size_t m_CurrentBlock = 0;
+    size_t m_BlockOffset  = 0;
+    // Payloads too large for a block, freed on playback
+    std::vector<uint8_t*> m_LargePayloads;
+};
+
+template <typename... Components> void CommandBuffer::CreateEntity(Components&&... components)
+{
+    Command& command       = m_Commands.emplace_back();
+    command.Type           = CommandType::CreateEntity;
+    command.ComponentCount = sizeof...(Components);
+    (PushPayload(CommandType::CreateComponent, Entity(), std::forward<Components>(components)), ...);
+}
+
+template <typename T> void CommandBuffer::AddComponent(Entity entity, T&& component)
+{
+    PushPayload(CommandType::AddComponent, entity, std::forward<T>(component));
+}
+
+template <typename T> void CommandBuffer::RemoveComponent(Entity entity)
+{
+    Command& command  = m_Commands.emplace_back();
+    command.Type      = CommandType::RemoveComponent;
+    command.Component = ComponentRegistry::GetID<T>();
+    command.Target    = entity;
+}
+
+template <typename T> void CommandBuffer::PushPayload(CommandType type, Entity target, T&& component)
+{
+    using Component = std::remove_cvref_t<T>;
+
+    const ComponentID id = ComponentRegistry::GetID<Component>();
+    void* payload        = AllocatePayload(ComponentRegistry::GetInfo(id));
+    new (payload) Component(std::forward<T>(component));
+
+    Command& command  = m_Commands.emplace_back();
+    command.Type      = type;
+    command.Component = id;
+    command.Target    = target;
+    command.Payload   = payload;
+}
+
+} // namespace Noctis
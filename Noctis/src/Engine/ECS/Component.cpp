@@ -0,0 +1,45 @@
+#include "Component.h"
+
+#include <cstring>
+#include <mutex>
+
+namespace Noctis
+{
+
+std::array<ComponentInfo, ComponentRegistry::MAX_COMPONENTS> ComponentRegistry::s_Infos;
+
+namespace
+{
+
+std::mutex s_RegistryMutex;
+uint32_t s_ComponentCount = 0;
+
+} // namespace
+
+ComponentID ComponentRegistry::Register(const ComponentInfo& info)
+{
+    std::lock_guard lock(s_RegistryMutex);
+
+    NOC_CORE_ASSERT(s_ComponentCount < MAX_COMPONENTS, "Too many component types, raise MAX_COMPONENTS");
+    const ComponentID id = s_ComponentCount++;
+    s_Infos[id]          = info;
+    return id;
+}
+
+void ComponentRegistry::Relocate(ComponentID id, void* destination, void* source)
+{
+    const ComponentInfo& info = s_Infos[id];
+    if (info.Relocate)
+        info.Relocate(destination, source);
+    else
+        std::memcpy(destination, source, info.Size);
+}
+
+void ComponentRegistry::Destroy(ComponentID id, void* component)
+{
+    const ComponentInfo& info = s_Infos[id];
+    if (info.Destroy)
+        info.Destroy(component);
+}
+
+} // namespace Noctis
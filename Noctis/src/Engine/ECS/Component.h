@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Noctis
+{
+
+using ComponentID = uint32_t;
+
+// How the world moves and destroys a component without knowing its type. Both are null for trivially copyable
+// types, which are moved with memcpy and need no destruction.
+struct ComponentInfo
+{
+    uint32_t Size      = 0;
+    uint32_t Alignment = 0;
+    // Move constructs at destination, then destroys source
+    void (*Relocate)(void* destination, void* source) = nullptr;
+    void (*Destroy)(void* component)                  = nullptr;
+};
+
+// Components are plain structs, each type gets a dense ID on first use so archetypes and queries can be matched with
+// bitsets. IDs depend on the order types are first used in, so they aren't stable across runs.
+class ComponentRegistry
+{
+  public:
+    static constexpr uint32_t MAX_COMPONENTS = 128;
+
+    template <typename T> static ComponentID GetID()
+    {
+        static_assert(std::is_same_v<T, std::remove_cvref_t<T>>, "Component IDs are per unqualified type");
+        static_assert(std::is_move_constructible_v<T> && std::is_destructible_v<T>,
+                      "Components must be move constructible");
+
+        static const ComponentID id = Register(MakeInfo<T>());
+        return id;
+    }
+
+    static const ComponentInfo& GetInfo(ComponentID id) { return s_Infos[id]; }
+
+    static void Relocate(ComponentID id, void* destination, void* source);
+    static void Destroy(ComponentID id, void* component);
+
+  private:
+    template <typename T> static ComponentInfo MakeInfo()
+    {
+        ComponentInfo info;
+        info.Size      = sizeof(T);
+        info.Alignment = alignof(T);
+        if constexpr (!std::is_trivially_copyable_v<T>)
+        {
+            info.Relocate = [](void* destination, void* source) {
+                new (destination) T(std::move(*static_cast<T*>(source)));
+                static_cast<T*>(source)->~T();
+            };
+            info.Destroy = [](void* component) { static_cast<T*>(component)->~T(); };
+        }
+        return info;
+    }
+
+    static ComponentID Register(const ComponentInfo& info);
+
+  private:
+    // Fixed size, so entries can be read while another thread registers a type
+    static std::array<ComponentInfo, MAX_COMPONENTS> s_Infos;
+};
+
+using ComponentMask = std::bitset<ComponentRegistry::MAX_COMPONENTS>;
+
+template <typename... Components> ComponentMask MakeComponentMask()
+{
+    ComponentMask mask;
+    (mask.set(ComponentRegistry::GetID<std::remove_const_t<Components>>()), ...);
+    return mask;
+}
+
+} // namespace Noctis
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Noctis
+{
+
+// Handle to an entity of a World. Indices are reused once an entity is destroyed, the generation tells the old
+// handles apart from the new entity's.
+struct Entity
+{
+    uint32_t Index      = UINT32_MAX;
+    uint32_t Generation = 0;
+
+    // Whether the handle refers to an entity at all, see World::IsAlive for whether that entity still exists
+    bool IsValid() const { return Index != UINT32_MAX; }
+    bool operator==(const Entity& other) const = default;
+};
+
+} // namespace Noctis
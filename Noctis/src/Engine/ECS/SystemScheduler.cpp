@@ -0,0 +1,105 @@
+#include "SystemScheduler.h"
+
+namespace Noctis
+{
+
+SystemBuilder& SystemBuilder::SetExclusive()
+{
+    GetSystem().Exclusive = true;
+    return *this;
+}
+
+System& SystemBuilder::GetSystem()
+{
+    // Access changes which systems conflict
+    m_Scheduler.m_StagesDirty = true;
+    return m_Scheduler.m_Systems[m_System];
+}
+
+SystemBuilder SystemScheduler::AddSystem(const char* name, SystemFn update)
+{
+    System& system = m_Systems.emplace_back();
+    system.Name    = name;
+    system.Update  = std::move(update);
+    m_Commands.push_back(CreateScope<CommandBuffer>());
+    m_StagesDirty = true;
+    return SystemBuilder(*this, static_cast<uint32_t>(m_Systems.size() - 1));
+}
+
+void SystemScheduler::Update(World& world, Timestep timestep)
+{
+    NOC_PROFILE_FUNCTION();
+    NOC_MEMORY_SCOPE(ECS);
+
+    if (m_StagesDirty)
+        BuildStages();
+
+    m_World    = &world;
+    m_Timestep = timestep;
+
+    for (const std::vector<uint32_t>& stage : m_Stages)
+    {
+        if (m_Systems[stage[0]].Exclusive)
+        {
+            RunSystem(stage[0]);
+        }
+        else
+        {
+            World::ReadOnlyScope scope(world);
+
+            // The calling thread takes the first system rather than idling in Wait
+            JobCounter counter;
+            for (size_t i = 1; i < stage.size(); i++)
+            {
+                const uint32_t system = stage[i];
+                // Captures little enough for Job to store inline, so queueing a system doesn't allocate
+                JobSystem::Execute([this, system]() { RunSystem(system); }, &counter);
+            }
+            RunSystem(stage[0]);
+            JobSystem::Wait(counter);
+        }
+
+        for (uint32_t system : stage)
+            m_Commands[system]->Playback(world);
+    }
+}
+
+void SystemScheduler::BuildStages()
+{
+    // Each system goes in the stage after the last earlier system it conflicts with, so conflicting systems keep
+    // their order and everything else runs as early as it can
+    m_Stages.clear();
+    for (uint32_t i = 0; i < m_Systems.size(); i++)
+    {
+        System& system = m_Systems[i];
+        system.Stage   = 0;
+        for (uint32_t j = 0; j < i; j++)
+        {
+            if (Conflict(system, m_Systems[j]))
+                system.Stage = std::max(system.Stage, m_Systems[j].Stage + 1);
+        }
+
+        if (system.Stage == m_Stages.size())
+            m_Stages.emplace_back();
+        m_Stages[system.Stage].push_back(i);
+    }
+    m_StagesDirty = false;
+}
+
+void SystemScheduler::RunSystem(uint32_t system)
+{
+    const System& data = m_Systems[system];
+    NOC_PROFILE_SCOPE(data.Name);
+
+    SystemContext context(*m_World, *m_Commands[system], m_Timestep);
+    data.Update(context);
+}
+
+bool SystemScheduler::Conflict(const System& a, const System& b)
+{
+    if (a.Exclusive || b.Exclusive)
+        return true;
+    return (a.Writes & (b.Reads | b.Writes)).any() || (b.Writes & a.Reads).any();
+}
+
+} // namespace Noctis
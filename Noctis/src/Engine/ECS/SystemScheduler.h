@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Engine/Core/Timestep.h"
+#include "Engine/ECS/CommandBuffer.h"
+#include "Engine/ECS/World.h"
+
+namespace Noctis
+{
+
+// Handed to a system's update. Structural changes go through the system's command buffer, which is played back once
+// every system the system ran alongside has finished.
+class SystemContext
+{
+  public:
+    SystemContext(World& world, CommandBuffer& commands, Timestep timestep)
+        : m_World(world), m_Commands(commands), m_Timestep(timestep)
+    {
+    }
+
+    World& GetWorld() const { return m_World; }
+    CommandBuffer& GetCommands() const { return m_Commands; }
+    Timestep GetTimestep() const { return m_Timestep; }
+
+  private:
+    World& m_World;
+    CommandBuffer& m_Commands;
+    Timestep m_Timestep;
+};
+
+using SystemFn = std::function<void(SystemContext&)>;
+
+struct System
+{
+    // Must outlive the scheduler (a literal, or Profiler::InternName), it names the system's profiler scope
+    const char* Name = nullptr;
+    SystemFn Update;
+
+    ComponentMask Reads;
+    ComponentMask Writes;
+    // Runs alone and may make structural changes to the world directly
+    bool Exclusive = false;
+
+    // Filled in by the scheduler, systems in the same stage run in parallel
+    uint32_t Stage = 0;
+};
+
+class SystemScheduler;
+
+class SystemBuilder
+{
+  public:
+    SystemBuilder(SystemScheduler& scheduler, uint32_t system) : m_Scheduler(scheduler), m_System(system) {}
+
+    template <typename... Components> SystemBuilder& Read();
+    // Covers read-modify-write as well
+    template <typename... Components> SystemBuilder& Write();
+    SystemBuilder& SetExclusive();
+
+  private:
+    System& GetSystem();
+
+  private:
+    SystemScheduler& m_Scheduler;
+    uint32_t m_System;
+};
+
+// Runs systems over a World once per frame. Systems declare the components they read and write, and ones that don't
+// conflict (neither writes what the other reads or writes) run on the job system at the same time. Conflicting
+// systems run in the order they were added, as do the command buffer playbacks.
+//
+// Access is not checked: a system touching components it didn't declare races with the others.
+class SystemScheduler
+{
+  public:
+    SystemBuilder AddSystem(const char* name, SystemFn update);
+
+    void Update(World& world, Timestep timestep);
+
+    const std::vector<System>& GetSystems() const { return m_Systems; }
+    uint32_t GetStageCount() const { return static_cast<uint32_t>(m_Stages.size()); }
+
+  private:
+    void BuildStages();
+    void RunSystem(uint32_t system);
+
+    static bool Conflict(const System& a, const System& b);
+
+  private:
+    std::vector<System> m_Systems;
+    // Per system, CommandBuffer isn't movable
+    std::vector<Scope<CommandBuffer>> m_Commands;
+    // System indices of each stage, in the order they were added
+    std::vector<std::vector<uint32_t>> m_Stages;
+    bool m_StagesDirty = false;
+
+    // Of the Update in progress
+    World* m_World = nullptr;
+    Timestep m_Timestep;
+
+    friend class SystemBuilder;
+};
+
+template <typename... Components> SystemBuilder& SystemBuilder::Read()
+{
+    GetSystem().Reads |= MakeComponentMask<Components...>();
+    return *this;
+}
+
+template <typename... Components> SystemBuilder& SystemBuilder::Write()
+{
+    GetSystem().Writes |= MakeComponentMask<Components...>();
+    return *this;
+}
+
+} // namespace Noctis
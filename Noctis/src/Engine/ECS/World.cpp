@@ -0,0 +1,184 @@
+#include "World.h"
+
+namespace Noctis
+{
+
+Entity World::CreateEntity(const ComponentID* components, uint32_t count)
+{
+    AssertStructuralChangesAllowed();
+
+    ComponentMask mask;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        NOC_CORE_ASSERT(!mask.test(components[i]), "World::CreateEntity: duplicate component!");
+        mask.set(components[i]);
+    }
+
+    uint32_t index;
+    if (!m_FreeIndices.empty())
+    {
+        index = m_FreeIndices.back();
+        m_FreeIndices.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_Records.size());
+        m_Records.emplace_back();
+    }
+
+    EntityRecord& record = m_Records[index];
+    const Entity entity  = {index, record.Generation};
+    record.Owner         = GetArchetype(mask);
+    record.Row           = record.Owner->AddRow(entity);
+    m_EntityCount++;
+    return entity;
+}
+
+void World::DestroyEntity(Entity entity)
+{
+    AssertStructuralChangesAllowed();
+
+    EntityRecord& record = GetRecord(entity);
+    record.Owner->DestroyComponents(record.Row);
+    RemoveRow(record.Owner, record.Row);
+
+    record.Owner = nullptr;
+    record.Generation++;
+    m_FreeIndices.push_back(entity.Index);
+    m_EntityCount--;
+}
+
+bool World::IsAlive(Entity entity) const
+{
+    if (entity.Index >= m_Records.size())
+        return false;
+
+    const EntityRecord& record = m_Records[entity.Index];
+    return record.Owner && record.Generation == entity.Generation;
+}
+
+void* World::AddComponent(Entity entity, ComponentID component)
+{
+    EntityRecord& record = GetRecord(entity);
+
+    const uint32_t column = record.Owner->GetColumn(component);
+    if (column != Archetype::INVALID_COLUMN)
+    {
+        void* storage = record.Owner->GetComponent(record.Row, column);
+        ComponentRegistry::Destroy(component, storage);
+        return storage;
+    }
+
+    AssertStructuralChangesAllowed();
+
+    Archetype* source = record.Owner;
+    auto edge         = source->m_AddEdges.find(component);
+    if (edge == source->m_AddEdges.end())
+    {
+        Archetype* destination = GetArchetype(ComponentMask(source->GetMask()).set(component));
+        destination->m_RemoveEdges.emplace(component, source);
+        edge = source->m_AddEdges.emplace(component, destination).first;
+    }
+
+    MoveEntity(record, edge->second);
+    return record.Owner->GetComponent(record.Row, record.Owner->GetColumn(component));
+}
+
+void World::RemoveComponent(Entity entity, ComponentID component)
+{
+    EntityRecord& record = GetRecord(entity);
+    if (record.Owner->GetColumn(component) == Archetype::INVALID_COLUMN)
+        return;
+
+    AssertStructuralChangesAllowed();
+
+    Archetype* source = record.Owner;
+    auto edge         = source->m_RemoveEdges.find(component);
+    if (edge == source->m_RemoveEdges.end())
+    {
+        Archetype* destination = GetArchetype(ComponentMask(source->GetMask()).reset(component));
+        destination->m_AddEdges.emplace(component, source);
+        edge = source->m_RemoveEdges.emplace(component, destination).first;
+    }
+
+    MoveEntity(record, edge->second);
+}
+
+void* World::GetComponent(Entity entity, ComponentID component) const
+{
+    NOC_CORE_ASSERT(IsAlive(entity), "World: the entity has been destroyed!");
+
+    const EntityRecord& record = m_Records[entity.Index];
+    const uint32_t column      = record.Owner->GetColumn(component);
+    return column != Archetype::INVALID_COLUMN ? record.Owner->GetComponent(record.Row, column) : nullptr;
+}
+
+Archetype* World::GetArchetype(const ComponentMask& mask)
+{
+    auto it = m_ArchetypeLookup.find(mask);
+    if (it != m_ArchetypeLookup.end())
+        return it->second;
+
+    Archetype* archetype = m_Archetypes.emplace_back(CreateScope<Archetype>(mask)).get();
+    m_ArchetypeLookup.emplace(mask, archetype);
+    return archetype;
+}
+
+void World::MoveEntity(EntityRecord& record, Archetype* destination)
+{
+    Archetype* source    = record.Owner;
+    const uint32_t row   = record.Row;
+    const uint32_t moved = destination->AddRow(source->GetEntity(row));
+
+    for (uint32_t column = 0; column < source->GetComponents().size(); column++)
+    {
+        const ComponentID id  = source->GetComponents()[column];
+        const uint32_t target = destination->GetColumn(id);
+        void* component       = source->GetComponent(row, column);
+        if (target != Archetype::INVALID_COLUMN)
+            ComponentRegistry::Relocate(id, destination->GetComponent(moved, target), component);
+        else
+            ComponentRegistry::Destroy(id, component);
+    }
+
+    RemoveRow(source, row);
+    record.Owner = destination;
+    record.Row   = moved;
+}
+
+void World::RemoveRow(Archetype* archetype, uint32_t row)
+{
+    const Entity moved = archetype->RemoveRow(row);
+    if (moved.IsValid())
+        m_Records[moved.Index].Row = row;
+}
+
+World::EntityRecord& World::GetRecord(Entity entity)
+{
+    NOC_CORE_ASSERT(IsAlive(entity), "World: the entity has been destroyed!");
+    return m_Records[entity.Index];
+}
+
+const std::vector<Archetype*>& World::GetMatchingArchetypes(const ComponentMask& mask)
+{
+    // Queries can run on several threads at once, but archetypes are only created by structural changes, which
+    // can't happen while any query runs. The cached vector can be read without the lock once it is up to date.
+    std::lock_guard lock(m_QueryMutex);
+
+    QueryCache& query = m_Queries[mask];
+    for (; query.MatchedCount < m_Archetypes.size(); query.MatchedCount++)
+    {
+        Archetype* archetype = m_Archetypes[query.MatchedCount].get();
+        if ((archetype->GetMask() & mask) == mask)
+            query.Archetypes.push_back(archetype);
+    }
+    return query.Archetypes;
+}
+
+void World::AssertStructuralChangesAllowed() const
+{
+    NOC_CORE_ASSERT(m_ReadOnlyDepth.load(std::memory_order_relaxed) == 0,
+                    "World: structural change while iterating or running systems, go through a CommandBuffer!");
+}
+
+} // namespace Noctis
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/Memory/ScratchScope.h"
+#include "Engine/ECS/Archetype.h"
+
+#include <atomic>
+#include <mutex>
+#include <tuple>
+
+namespace Noctis
+{
+
+// One chunk's worth of entities matching a query, with a pointer to each queried component's array
+template <typename... Components> struct ChunkView
+{
+    const Entity* Entities = nullptr;
+    uint32_t Count         = 0;
+    std::tuple<Components*...> Arrays;
+
+    template <typename T> T* Get() const { return std::get<T*>(Arrays); }
+};
+
+// Entities and their components, stored by archetype in chunks so queries walk contiguous arrays.
+//
+// Structural changes (creating or destroying entities, adding or removing components) move entities between
+// archetypes and invalidate component references and chunk views. They can't be made while the world is iterated or
+// while systems run in parallel, record them in a CommandBuffer instead. Everything else is safe to call from several
+// threads as long as no two of them write the same component.
+class World
+{
+  public:
+    World() = default;
+
+    World(const World&)            = delete;
+    World& operator=(const World&) = delete;
+
+    // Each component type at most once
+    template <typename... Components> Entity CreateEntity(Components&&... components);
+    void DestroyEntity(Entity entity);
+    bool IsAlive(Entity entity) const;
+    uint32_t GetEntityCount() const { return m_EntityCount; }
+
+    // Replaces the component if the entity has it already, which isn't a structural change
+    template <typename T, typename... Args> T& AddComponent(Entity entity, Args&&... args);
+    template <typename T> void RemoveComponent(Entity entity);
+    template <typename T> bool HasComponent(Entity entity) const;
+    template <typename T> T& GetComponent(Entity entity);
+    // Null if the entity doesn't have the component
+    template <typename T> T* TryGetComponent(Entity entity);
+
+    // Queries visit every entity having all of Components. Declaring a component const documents that it is only
+    // read, SystemScheduler relies on the systems' declared access rather than on these types.
+    //
+    // func(Components&...) or func(Entity, Components&...), entity by entity
+    template <typename... Components, typename F> void Each(F&& func);
+    // Same as Each, with the chunks split across the job system. func must be safe to call concurrently.
+    template <typename... Components, typename F> void ParallelEach(F&& func);
+    // func(const ChunkView<Components...>&), chunk by chunk, for loops over whole arrays
+    template <typename... Components, typename F> void EachChunk(F&& func);
+
+  private:
+    struct EntityRecord
+    {
+        // Null once destroyed
+        Archetype* Owner    = nullptr;
+        uint32_t Row        = 0;
+        uint32_t Generation = 0;
+    };
+
+    struct QueryCache
+    {
+        std::vector<Archetype*> Archetypes;
+        // Archetypes are only ever added, the ones before this have been matched already
+        size_t MatchedCount = 0;
+    };
+
+    // Blocks structural changes while held
+    class ReadOnlyScope
+    {
+      public:
+        explicit ReadOnlyScope(World& world) : m_World(world) { m_World.m_ReadOnlyDepth.fetch_add(1); }
+        ~ReadOnlyScope() { m_World.m_ReadOnlyDepth.fetch_sub(1); }
+
+      private:
+        World& m_World;
+    };
+
+    // Type-erased versions of the templates, components are left for the caller to construct
+    Entity CreateEntity(const ComponentID* components, uint32_t count);
+    void* AddComponent(Entity entity, ComponentID component);
+    void RemoveComponent(Entity entity, ComponentID component);
+    void* GetComponent(Entity entity, ComponentID component) const;
+
+    Archetype* GetArchetype(const ComponentMask& mask);
+    // Moves the entity's row to another archetype, relocating the components both have and destroying the others
+    void MoveEntity(EntityRecord& record, Archetype* destination);
+    void RemoveRow(Archetype* archetype, uint32_t row);
+    EntityRecord& GetRecord(Entity entity);
+    const std::vector<Archetype*>& GetMatchingArchetypes(const ComponentMask& mask);
+    void AssertStructuralChangesAllowed() const;
+
+    template <typename... Components>
+    static ChunkView<Components...> MakeChunkView(const Archetype& archetype, const Chunk& chunk);
+    template <typename... Components, typename F> static void EachRow(const ChunkView<Components...>& view, F& func);
+
+  private:
+    std::vector<EntityRecord> m_Records;
+    std::vector<uint32_t> m_FreeIndices;
+    uint32_t m_EntityCount = 0;
+
+    std::vector<Scope<Archetype>> m_Archetypes;
+    std::unordered_map<ComponentMask, Archetype*> m_ArchetypeLookup;
+
+    std::unordered_map<ComponentMask, QueryCache> m_Queries;
+    std::mutex m_QueryMutex;
+
+    // Iterations in progress, plus one while the scheduler runs systems in parallel
+    std::atomic<uint32_t> m_ReadOnlyDepth = 0;
+
+    friend class CommandBuffer;
+    friend class SystemScheduler;
+};
+
+template <typename... Components> Entity World::CreateEntity(Components&&... components)
+{
+    const std::array<ComponentID, sizeof...(Components)> ids = {
+        ComponentRegistry::GetID<std::remove_cvref_t<Components>>()...};
+    const Entity entity = CreateEntity(ids.data(), static_cast<uint32_t>(ids.size()));
+
+    (new (GetComponent(entity, ComponentRegistry::GetID<std::remove_cvref_t<Components>>()))
+         std::remove_cvref_t<Components>(std::forward<Components>(components)),
+     ...);
+    return entity;
+}
+
+template <typename T, typename... Args> T& World::AddComponent(Entity entity, Args&&... args)
+{
+    // Built before the entity changes, the arguments may reference the component being replaced or ones being moved
+    T component(std::forward<Args>(args)...);
+    return *new (AddComponent(entity, ComponentRegistry::GetID<T>())) T(std::move(component));
+}
+
+template <typename T> void World::RemoveComponent(Entity entity)
+{
+    RemoveComponent(entity, ComponentRegistry::GetID<T>());
+}
+
+template <typename T> bool World::HasComponent(Entity entity) const
+{
+    return GetComponent(entity, ComponentRegistry::GetID<T>()) != nullptr;
+}
+
+template <typename T> T& World::GetComponent(Entity entity)
+{
+    void* component = GetComponent(entity, ComponentRegistry::GetID<T>());
+    NOC_CORE_ASSERT(component, "World::GetComponent: the entity doesn't have the component");
+    return *static_cast<T*>(component);
+}
+
+template <typename T> T* World::TryGetComponent(Entity entity)
+{
+    return static_cast<T*>(GetComponent(entity, ComponentRegistry::GetID<T>()));
+}
+
+template <typename... Components, typename F> void World::Each(F&& func)
+{
+    EachChunk<Components...>([&func](const ChunkView<Components...>& view) { EachRow(view, func); });
+}
+
+template <typename... Components, typename F> void World::ParallelEach(F&& func)
+{
+    static_assert(sizeof...(Components) > 0, "Queries need at least one component");
+
+    ReadOnlyScope scope(*this);
+    const std::vector<Archetype*>& archetypes = GetMatchingArchetypes(MakeComponentMask<Components...>());
+
+    // Chunks of all matching archetypes numbered one after the other, firstChunks[i] being archetype i's first
+    ScratchScope scratch;
+    std::pmr::vector<uint32_t> firstChunks(archetypes.size() + 1, 0, scratch.GetResource());
+    for (size_t i = 0; i < archetypes.size(); i++)
+        firstChunks[i + 1] = firstChunks[i] + archetypes[i]->GetChunkCount();
+
+    JobSystem::ParallelFor(firstChunks.back(), 0, [&](uint32_t begin, uint32_t end) {
+        size_t archetype = std::upper_bound(firstChunks.begin(), firstChunks.end(), begin) - firstChunks.begin() - 1;
+        for (uint32_t chunk = begin; chunk < end; chunk++)
+        {
+            while (chunk >= firstChunks[archetype + 1])
+                archetype++;
+
+            const Archetype& owner = *archetypes[archetype];
+            EachRow(MakeChunkView<Components...>(owner, owner.GetChunk(chunk - firstChunks[archetype])), func);
+        }
+    });
+}
+
+template <typename... Components, typename F> void World::EachChunk(F&& func)
+{
+    static_assert(sizeof...(Components) > 0, "Queries need at least one component");
+
+    ReadOnlyScope scope(*this);
+    for (const Archetype* archetype : GetMatchingArchetypes(MakeComponentMask<Components...>()))
+    {
+        for (uint32_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++)
+            func(MakeChunkView<Components...>(*archetype, archetype->GetChunk(chunk)));
+    }
+}
+
+template <typename... Components>
+ChunkView<Components...> World::MakeChunkView(const Archetype& archetype, const Chunk& chunk)
+{
+    ChunkView<Components...> view;
+    view.Entities = archetype.GetEntities(chunk);
+    view.Count    = chunk.Count;
+    view.Arrays   = {static_cast<Components*>(archetype.GetArray(
+        chunk, archetype.GetColumn(ComponentRegistry::GetID<std::remove_const_t<Components>>())))...};
+    return view;
+}
+
+template <typename... Components, typename F> void World::EachRow(const ChunkView<Components...>& view, F& func)
+{
+    for (uint32_t i = 0; i < view.Count; i++)
+    {
+        if constexpr (std::is_invocable_v<F&, Entity, Components&...>)
+            func(view.Entities[i], std::get<Components*>(view.Arrays)[i]...);
+        else
+            func(std::get<Components*>(view.Arrays)[i]...);
+    }
+}
+
+} // namespace Noctis
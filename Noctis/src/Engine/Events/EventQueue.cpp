@@ -0,0 +1,145 @@
+#include "EventQueue.h"
+
+#include <bit>
+
+namespace Noctis
+{
+
+EventQueue::EventQueue(uint32_t capacity)
+{
+    m_Events.resize(std::bit_ceil(std::max(capacity, 2u)));
+}
+
+void EventQueue::Push(const Event& event)
+{
+    if (TryCoalesce(event))
+    {
+        m_CoalescedCount++;
+        return;
+    }
+
+    if (m_Count == m_Events.size())
+        Grow();
+
+    At(m_Count) = ToQueuedEvent(event);
+    m_Count++;
+}
+
+void EventQueue::Flush(const EventCallbackFn& callback)
+{
+    NOC_PROFILE_FUNCTION();
+
+    for (uint32_t remaining = m_Count; remaining > 0; remaining--)
+    {
+        // Moved out first so callbacks can safely push into (and grow) the queue
+        QueuedEvent queued = std::move(At(0));
+        At(0)              = std::monostate{};
+        m_Head             = (m_Head + 1) & (m_Events.size() - 1);
+        m_Count--;
+
+        callback(GetEvent(queued));
+    }
+
+    m_CoalescedCount = 0;
+}
+
+QueuedEvent EventQueue::ToQueuedEvent(const Event& event)
+{
+    switch (event.GetEventType())
+    {
+        case EventType::WindowResize:
+            return static_cast<const WindowResizeEvent&>(event);
+        case EventType::WindowClose:
+            return static_cast<const WindowCloseEvent&>(event);
+        case EventType::AppTick:
+            return static_cast<const AppTickEvent&>(event);
+        case EventType::AppUpdate:
+            return static_cast<const AppUpdateEvent&>(event);
+        case EventType::AppRender:
+            return static_cast<const AppRenderEvent&>(event);
+        case EventType::KeyPressed:
+            return static_cast<const KeyPressedEvent&>(event);
+        case EventType::KeyReleased:
+            return static_cast<const KeyReleasedEvent&>(event);
+        case EventType::KeyTyped:
+            return static_cast<const KeyTypedEvent&>(event);
+        case EventType::MouseMoved:
+            return static_cast<const MouseMovedEvent&>(event);
+        case EventType::MouseScrolled:
+            return static_cast<const MouseScrolledEvent&>(event);
+        case EventType::MouseButtonPressed:
+            return static_cast<const MouseButtonPressedEvent&>(event);
+        case EventType::MouseButtonReleased:
+            return static_cast<const MouseButtonReleasedEvent&>(event);
+        default:
+            break;
+    }
+    NOC_CORE_ASSERT(false, "Event type cannot be queued!");
+    return std::monostate{};
+}
+
+Event& EventQueue::GetEvent(QueuedEvent& queued)
+{
+    NOC_CORE_ASSERT(!std::holds_alternative<std::monostate>(queued), "Empty event slot!");
+    return std::visit(
+        [](auto& event) -> Event& {
+            if constexpr (std::is_same_v<std::decay_t<decltype(event)>, std::monostate>)
+                std::abort();
+            else
+                return event;
+        },
+        queued);
+}
+
+bool EventQueue::TryCoalesce(const Event& event)
+{
+    const EventType type = event.GetEventType();
+    if (type != EventType::MouseMoved && type != EventType::MouseScrolled && type != EventType::WindowResize)
+        return false;
+
+    // Only the latest state of these matters, and they don't depend on each other's order. Anything else (buttons,
+    // keys, ...) is a barrier: a move before a click must still be delivered before it.
+    for (uint32_t i = m_Count; i > 0; i--)
+    {
+        QueuedEvent& queued        = At(i - 1);
+        const EventType queuedType = GetEvent(queued).GetEventType();
+
+        if (queuedType == type)
+        {
+            if (type == EventType::MouseScrolled)
+            {
+                const auto& previous = std::get<MouseScrolledEvent>(queued);
+                const auto& current  = static_cast<const MouseScrolledEvent&>(event);
+                queued               = MouseScrolledEvent(previous.GetXOffset() + current.GetXOffset(),
+                                                          previous.GetYOffset() + current.GetYOffset());
+            }
+            else
+            {
+                queued = ToQueuedEvent(event);
+            }
+            return true;
+        }
+
+        if (queuedType != EventType::MouseMoved && queuedType != EventType::MouseScrolled &&
+            queuedType != EventType::WindowResize)
+            break;
+    }
+
+    return false;
+}
+
+void EventQueue::Grow()
+{
+    NOC_PROFILE_FUNCTION();
+
+    std::vector<QueuedEvent> events(m_Events.size() * 2);
+    for (uint32_t i = 0; i < m_Count; i++)
+        events[i] = std::move(At(i));
+
+    m_Events = std::move(events);
+    m_Head   = 0;
+
+    NOC_CORE_WARN("EventQueue grew to {0} events", m_Events.size());
+}
+
+} // namespace Noctis
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Event.h"
+#include "ApplicationEvent.h"
+#include "KeyEvent.h"
+#include "MouseEvent.h"
+
+#include <variant>
+#include <vector>
+
+namespace Noctis
+{
+
+using QueuedEvent = std::variant<std::monostate, WindowResizeEvent, WindowCloseEvent, AppTickEvent, AppUpdateEvent,
+                                 AppRenderEvent, KeyPressedEvent, KeyReleasedEvent, KeyTypedEvent, MouseMovedEvent,
+                                 MouseScrolledEvent, MouseButtonPressedEvent, MouseButtonReleasedEvent>;
+
+// Collects the events of a frame by value in a reusable ring buffer, merging redundant ones, so they can be
+// dispatched as one batch instead of from inside the platform callbacks.
+class EventQueue
+{
+  public:
+    using EventCallbackFn = std::function<void(Event&)>;
+
+    explicit EventQueue(uint32_t capacity = 256);
+
+    void Push(const Event& event);
+    // Dispatches the events queued so far in order. Events pushed while flushing wait for the next flush.
+    void Flush(const EventCallbackFn& callback);
+
+    uint32_t GetSize() const { return m_Count; }
+    bool IsEmpty() const { return m_Count == 0; }
+
+    // Events merged into an already queued one since the last flush
+    uint32_t GetCoalescedCount() const { return m_CoalescedCount; }
+
+  private:
+    static QueuedEvent ToQueuedEvent(const Event& event);
+    static Event& GetEvent(QueuedEvent& queued);
+
+    bool TryCoalesce(const Event& event);
+    void Grow();
+
+    QueuedEvent& At(uint32_t index) { return m_Events[(m_Head + index) & (m_Events.size() - 1)]; }
+
+  private:
+    std::vector<QueuedEvent> m_Events;
+    uint32_t m_Head  = 0;
+    uint32_t m_Count = 0;
+
+    uint32_t m_CoalescedCount = 0;
+};
+
+} // namespace Noctis
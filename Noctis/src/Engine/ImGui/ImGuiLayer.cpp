@@ -21,6 +21,8 @@ ImGuiLayer::ImGuiLayer(Window& window)
 
 void ImGuiLayer::OnAttach()
 {
+    NOC_PROFILE_FUNCTION();
+
     // Setup Dear ImGui context
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
@@ -55,7 +57,7 @@ void ImGuiLayer::OnAttach()
     // init_info.Device                    = m_Context->GetDevice()->GetVkDevice();
     // init_info.QueueFamily               = m_Context->GetDevice()->GetQueueFamilyIndices().GraphicsFamily;
     // init_info.Queue                     = m_Context->GetDevice()->GetVkGraphicsQueue();
-    // init_info.PipelineCache             = VK_NULL_HANDLE;
+    // init_info.PipelineCache             = m_Context->GetDevice()->GetVkPipelineCache();
     // init_info.DescriptorPool            = m_Context->GetVkDescriptorPool();
     // init_info.RenderPass                = m_Context->GetSwapchain()->GetRenderPass();
     // init_info.Subpass                   = 0;
@@ -66,6 +68,8 @@ void ImGuiLayer::OnAttach()
 
 void ImGuiLayer::OnDetach()
 {
+    NOC_PROFILE_FUNCTION();
+
     ImGui_ImplVulkan_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -73,6 +77,8 @@ void ImGuiLayer::OnDetach()
 
 void ImGuiLayer::Begin()
 {
+    NOC_PROFILE_FUNCTION();
+
     // m_Context->BeginCommandBuffer();
     ImGui_ImplVulkan_NewFrame();
     ImGui_ImplGlfw_NewFrame();
@@ -81,6 +87,8 @@ void ImGuiLayer::Begin()
 
 void ImGuiLayer::End()
 {
+    NOC_PROFILE_FUNCTION();
+
     ImGuiIO& io      = ImGui::GetIO();
     Application& app = Application::Get();
     io.DisplaySize   = ImVec2((float)app.GetWindow().GetWidth(), (float)app.GetWindow().GetHeight());
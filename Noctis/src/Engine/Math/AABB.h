@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Engine/Math/Matrix.h"
+
+#include <limits>
+
+namespace Noctis
+{
+
+// Axis-aligned bounding box. Default constructed boxes are empty (inverted), so expanding one by a point or merging a
+// box into it yields exactly that point or box.
+struct AABB
+{
+    Vec3 Min = Vec3(std::numeric_limits<float>::max());
+    Vec3 Max = Vec3(-std::numeric_limits<float>::max());
+
+    constexpr AABB() = default;
+    constexpr AABB(const Vec3& min, const Vec3& max) : Min(min), Max(max) {}
+
+    bool IsEmpty() const { return Min.x > Max.x || Min.y > Max.y || Min.z > Max.z; }
+
+    Vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+    // Half the size along each axis
+    Vec3 GetExtents() const { return (Max - Min) * 0.5f; }
+
+    bool Contains(const Vec3& point) const
+    {
+        return point.x >= Min.x && point.x <= Max.x && point.y >= Min.y && point.y <= Max.y && point.z >= Min.z &&
+               point.z <= Max.z;
+    }
+
+    bool Intersects(const AABB& other) const
+    {
+        return Min.x <= other.Max.x && Max.x >= other.Min.x && Min.y <= other.Max.y && Max.y >= other.Min.y &&
+               Min.z <= other.Max.z && Max.z >= other.Min.z;
+    }
+
+    void Expand(const Vec3& point)
+    {
+        Min = Noctis::Min(Min, point);
+        Max = Noctis::Max(Max, point);
+    }
+
+    void Merge(const AABB& other)
+    {
+        Min = Noctis::Min(Min, other.Min);
+        Max = Noctis::Max(Max, other.Max);
+    }
+
+    // The box around this one's eight corners transformed by m, found from the transformed center and the extents
+    // projected on each axis rather than from the corners themselves. Affine transforms only.
+    AABB Transformed(const Mat4& m) const
+    {
+        if (IsEmpty())
+            return *this;
+
+        const Vec3 center  = GetCenter();
+        const Vec3 extents = GetExtents();
+
+        SIMD::Float4 c = SIMD::MulAdd(m[0].Load(), SIMD::Splat(center.x), m[3].Load());
+        c              = SIMD::MulAdd(m[1].Load(), SIMD::Splat(center.y), c);
+        c              = SIMD::MulAdd(m[2].Load(), SIMD::Splat(center.z), c);
+
+        SIMD::Float4 e = SIMD::Mul(SIMD::Abs(m[0].Load()), SIMD::Splat(extents.x));
+        e              = SIMD::MulAdd(SIMD::Abs(m[1].Load()), SIMD::Splat(extents.y), e);
+        e              = SIMD::MulAdd(SIMD::Abs(m[2].Load()), SIMD::Splat(extents.z), e);
+
+        return {Vec4(SIMD::Sub(c, e)).XYZ(), Vec4(SIMD::Add(c, e)).XYZ()};
+    }
+};
+
+} // namespace Noctis
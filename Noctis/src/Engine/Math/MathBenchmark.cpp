@@ -0,0 +1,108 @@
+#include "MathBenchmark.h"
+
+#include "Engine/Core/Timer.h"
+#include "Engine/Math/MathKernels.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace Noctis
+{
+
+namespace
+{
+
+// Best of the runs, in milliseconds
+template <typename F> float Measure(uint32_t iterations, F&& function)
+{
+    float best = std::numeric_limits<float>::max();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        Timer timer;
+        function();
+        best = std::min(best, timer.ElapsedMillis());
+    }
+    return best;
+}
+
+float MaxDifference(const float* a, const float* b, size_t count)
+{
+    float difference = 0.0f;
+    for (size_t i = 0; i < count; i++)
+        difference = std::max(difference, std::fabs(a[i] - b[i]));
+    return difference;
+}
+
+// Warnings, so Release builds, which compile info logging out, still show them
+void Report(const char* name, uint32_t count, float simdMillis, float scalarMillis, float difference)
+{
+    NOC_CORE_WARN("Math benchmark: {0} x{1}: {2:.3f} ms {3}, {4:.3f} ms scalar ({5:.2f}x), max difference {6}", name,
+                  count, simdMillis, SIMD::GetBackendName(), scalarMillis, scalarMillis / simdMillis, difference);
+}
+
+} // namespace
+
+void MathBenchmark::Run(uint32_t pointCount, uint32_t matrixCount, uint32_t iterations)
+{
+    NOC_PROFILE_FUNCTION();
+
+    NOC_CORE_ASSERT(pointCount > 0 && matrixCount > 0 && iterations > 0, "MathBenchmark::Run: nothing to measure");
+
+    // Fixed seed, so runs are comparable
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    // Points, x, y and z arrays back to back in one allocation
+    const Mat4 transform =
+        Mat4::Compose({1.0f, 2.0f, 3.0f}, Quat::FromAxisAngle(Normalize(Vec3(1.0f, 1.0f, 0.0f)), 0.7f), Vec3(2.0f));
+
+    std::vector<float> points(static_cast<size_t>(pointCount) * 3);
+    for (float& value : points)
+        value = distribution(random) * 100.0f;
+    std::vector<float> simdPoints(points.size());
+    std::vector<float> scalarPoints(points.size());
+
+    const float* x = points.data();
+    const float* y = x + pointCount;
+    const float* z = y + pointCount;
+
+    const float simdPointMillis = Measure(iterations, [&]() {
+        float* out = simdPoints.data();
+        MathKernels::TransformPoints(transform, x, y, z, out, out + pointCount, out + 2 * pointCount, pointCount);
+    });
+    const float scalarPointMillis = Measure(iterations, [&]() {
+        float* out = scalarPoints.data();
+        MathKernels::TransformPointsScalar(transform, x, y, z, out, out + pointCount, out + 2 * pointCount, pointCount);
+    });
+    Report("TransformPoints", pointCount, simdPointMillis, scalarPointMillis,
+           MaxDifference(simdPoints.data(), scalarPoints.data(), points.size()));
+
+    // Matrices
+    std::vector<Mat4> a(matrixCount);
+    std::vector<Mat4> b(matrixCount);
+    for (uint32_t i = 0; i < matrixCount; i++)
+    {
+        for (int column = 0; column < 4; column++)
+        {
+            for (int row = 0; row < 4; row++)
+            {
+                a[i][column][row] = distribution(random);
+                b[i][column][row] = distribution(random);
+            }
+        }
+    }
+    std::vector<Mat4> simdMatrices(matrixCount);
+    std::vector<Mat4> scalarMatrices(matrixCount);
+
+    const float simdMatrixMillis = Measure(iterations, [&]() {
+        MathKernels::MultiplyMatrices(a.data(), b.data(), simdMatrices.data(), matrixCount);
+    });
+    const float scalarMatrixMillis = Measure(iterations, [&]() {
+        MathKernels::MultiplyMatricesScalar(a.data(), b.data(), scalarMatrices.data(), matrixCount);
+    });
+    Report("MultiplyMatrices", matrixCount, simdMatrixMillis, scalarMatrixMillis,
+           MaxDifference(simdMatrices[0].Data(), scalarMatrices[0].Data(), static_cast<size_t>(matrixCount) * 16));
+}
+
+} // namespace Noctis
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Noctis
+{
+
+// Times the batched kernels against their scalar references on random data, logging the best of several runs of
+// each along with the largest difference between their results. The Editor runs it when started with
+// --benchmark-math.
+class MathBenchmark
+{
+  public:
+    static void Run(uint32_t pointCount = 1 << 20, uint32_t matrixCount = 1 << 16, uint32_t iterations = 20);
+};
+
+} // namespace Noctis
@@ -0,0 +1,169 @@
+#include "MathKernels.h"
+
+// The scalar references have to stay scalar, or -O3 vectorizes them and the benchmark compares SIMD against SIMD
+#if defined(__clang__)
+#define NOC_SCALAR_FUNCTION
+#define NOC_SCALAR_LOOP _Pragma("clang loop vectorize(disable) interleave(disable)")
+#elif defined(__GNUC__)
+#define NOC_SCALAR_FUNCTION __attribute__((optimize("no-tree-vectorize")))
+#define NOC_SCALAR_LOOP
+#else
+#define NOC_SCALAR_FUNCTION
+#define NOC_SCALAR_LOOP
+#endif
+
+namespace Noctis
+{
+
+namespace
+{
+
+#if NOC_MATH_AVX2
+__m256 MulAdd8(__m256 a, __m256 b, __m256 c)
+{
+#if defined(__FMA__)
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+#endif
+
+NOC_SCALAR_FUNCTION void TransformPointRange(const Mat4& m, const float* x, const float* y, const float* z,
+                                             float* outX, float* outY, float* outZ, size_t begin, size_t end)
+{
+    NOC_SCALAR_LOOP
+    for (size_t i = begin; i < end; i++)
+    {
+        const float px = x[i];
+        const float py = y[i];
+        const float pz = z[i];
+        outX[i]        = m[0].x * px + m[1].x * py + m[2].x * pz + m[3].x;
+        outY[i]        = m[0].y * px + m[1].y * py + m[2].y * pz + m[3].y;
+        outZ[i]        = m[0].z * px + m[1].z * py + m[2].z * pz + m[3].z;
+    }
+}
+
+NOC_SCALAR_FUNCTION void MultiplyMatrixRange(const Mat4* a, const Mat4* b, Mat4* out, size_t begin, size_t end)
+{
+    NOC_SCALAR_LOOP
+    for (size_t i = begin; i < end; i++)
+    {
+        // Copied first, out may be a or b
+        const Mat4 left  = a[i];
+        const Mat4 right = b[i];
+        for (int column = 0; column < 4; column++)
+        {
+            for (int row = 0; row < 4; row++)
+            {
+                out[i][column][row] = left[0][row] * right[column].x + left[1][row] * right[column].y +
+                                      left[2][row] * right[column].z + left[3][row] * right[column].w;
+            }
+        }
+    }
+}
+
+} // namespace
+
+void MathKernels::TransformPoints(const Mat4& m, const float* x, const float* y, const float* z, float* outX,
+                                  float* outY, float* outZ, size_t count)
+{
+    size_t i = 0;
+
+#if NOC_MATH_AVX2
+    {
+        __m256 c[4][3];
+        for (int column = 0; column < 4; column++)
+        {
+            for (int row = 0; row < 3; row++)
+                c[column][row] = _mm256_set1_ps(m[column][row]);
+        }
+
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 px = _mm256_loadu_ps(x + i);
+            const __m256 py = _mm256_loadu_ps(y + i);
+            const __m256 pz = _mm256_loadu_ps(z + i);
+
+            const auto transform = [&](int row) {
+                __m256 value = MulAdd8(c[0][row], px, c[3][row]);
+                value        = MulAdd8(c[1][row], py, value);
+                return MulAdd8(c[2][row], pz, value);
+            };
+            _mm256_storeu_ps(outX + i, transform(0));
+            _mm256_storeu_ps(outY + i, transform(1));
+            _mm256_storeu_ps(outZ + i, transform(2));
+        }
+    }
+#endif
+
+#if !NOC_MATH_SCALAR
+    // The whole array with SSE and NEON, the leftover half register after AVX2
+    SIMD::Float4 c[4][3];
+    for (int column = 0; column < 4; column++)
+    {
+        for (int row = 0; row < 3; row++)
+            c[column][row] = SIMD::Splat(m[column][row]);
+    }
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const SIMD::Float4 px = SIMD::Load(x + i);
+        const SIMD::Float4 py = SIMD::Load(y + i);
+        const SIMD::Float4 pz = SIMD::Load(z + i);
+
+        const auto transform = [&](int row) {
+            SIMD::Float4 value = SIMD::MulAdd(c[0][row], px, c[3][row]);
+            value              = SIMD::MulAdd(c[1][row], py, value);
+            return SIMD::MulAdd(c[2][row], pz, value);
+        };
+        SIMD::Store(outX + i, transform(0));
+        SIMD::Store(outY + i, transform(1));
+        SIMD::Store(outZ + i, transform(2));
+    }
+#endif
+
+    TransformPointRange(m, x, y, z, outX, outY, outZ, i, count);
+}
+
+void MathKernels::TransformPointsScalar(const Mat4& m, const float* x, const float* y, const float* z, float* outX,
+                                        float* outY, float* outZ, size_t count)
+{
+    TransformPointRange(m, x, y, z, outX, outY, outZ, 0, count);
+}
+
+void MathKernels::MultiplyMatrices(const Mat4* a, const Mat4* b, Mat4* out, size_t count)
+{
+#if NOC_MATH_AVX2
+    // Two columns of the result per register: each half multiplies the same columns of a by its own column of b
+    for (size_t i = 0; i < count; i++)
+    {
+        const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a[i][0].x));
+        const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a[i][1].x));
+        const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a[i][2].x));
+        const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&a[i][3].x));
+        for (int column = 0; column < 4; column += 2)
+        {
+            const __m256 columns = _mm256_loadu_ps(&b[i][column].x);
+
+            __m256 value = _mm256_mul_ps(a0, _mm256_shuffle_ps(columns, columns, 0x00));
+            value        = MulAdd8(a1, _mm256_shuffle_ps(columns, columns, 0x55), value);
+            value        = MulAdd8(a2, _mm256_shuffle_ps(columns, columns, 0xAA), value);
+            value        = MulAdd8(a3, _mm256_shuffle_ps(columns, columns, 0xFF), value);
+            _mm256_storeu_ps(&out[i][column].x, value);
+        }
+    }
+#elif !NOC_MATH_SCALAR
+    for (size_t i = 0; i < count; i++)
+        out[i] = a[i] * b[i];
+#else
+    MultiplyMatrixRange(a, b, out, 0, count);
+#endif
+}
+
+void MathKernels::MultiplyMatricesScalar(const Mat4* a, const Mat4* b, Mat4* out, size_t count)
+{
+    MultiplyMatrixRange(a, b, out, 0, count);
+}
+
+} // namespace Noctis
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Engine/Math/Matrix.h"
+
+#include <cstddef>
+
+namespace Noctis
+{
+
+// Transforms over whole arrays at once, for the per-frame work where one Mat4 at a time leaves most of a register
+// idle.
+//
+// Points are structure-of-arrays, separate x, y and z arrays, so every lane holds a different point and nothing needs
+// shuffling: eight points per iteration with AVX2, four with SSE and NEON. The Scalar variants are what a scalar
+// build runs, kept as the reference the SIMD paths are checked and benchmarked against (see MathBenchmark).
+class MathKernels
+{
+  public:
+    // out[i] = m * (x[i], y[i], z[i], 1), affine: the bottom row of m is ignored. The outputs may be the inputs.
+    static void TransformPoints(const Mat4& m, const float* x, const float* y, const float* z, float* outX,
+                                float* outY, float* outZ, size_t count);
+    static void TransformPointsScalar(const Mat4& m, const float* x, const float* y, const float* z, float* outX,
+                                      float* outY, float* outZ, size_t count);
+
+    // out[i] = a[i] * b[i]. out may be a or b.
+    static void MultiplyMatrices(const Mat4* a, const Mat4* b, Mat4* out, size_t count);
+    static void MultiplyMatricesScalar(const Mat4* a, const Mat4* b, Mat4* out, size_t count);
+};
+
+} // namespace Noctis
@@ -0,0 +1,236 @@
+#pragma once
+
+#include "Engine/Math/Quaternion.h"
+#include "Engine/Math/Vector.h"
+
+namespace Noctis
+{
+
+// Matrices are column-major and multiply column vectors (m * v), matching GLSL and the float[16] the renderers take.
+// Default constructed ones are the identity.
+
+struct Mat4;
+
+// Plain floats like Vec3, for normal matrices and other rotation-only work
+struct Mat3
+{
+    Vec3 Columns[3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+
+    constexpr Mat3() = default;
+    constexpr Mat3(const Vec3& c0, const Vec3& c1, const Vec3& c2) : Columns{c0, c1, c2} {}
+    // The upper-left 3x3
+    explicit Mat3(const Mat4& m);
+
+    static Mat3 Rotation(const Quat& q)
+    {
+        const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+        const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+        const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+        return {{1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy)},
+                {2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx)},
+                {2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy)}};
+    }
+
+    Vec3& operator[](int column) { return Columns[column]; }
+    const Vec3& operator[](int column) const { return Columns[column]; }
+};
+
+struct alignas(16) Mat4
+{
+    Vec4 Columns[4] = {{1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 0.0f},
+                       {0.0f, 0.0f, 0.0f, 1.0f}};
+
+    constexpr Mat4() = default;
+    constexpr Mat4(const Vec4& c0, const Vec4& c1, const Vec4& c2, const Vec4& c3) : Columns{c0, c1, c2, c3} {}
+
+    static Mat4 Translation(const Vec3& t)
+    {
+        Mat4 m;
+        m.Columns[3] = {t, 1.0f};
+        return m;
+    }
+
+    static Mat4 Scale(const Vec3& s)
+    {
+        return {{s.x, 0.0f, 0.0f, 0.0f}, {0.0f, s.y, 0.0f, 0.0f}, {0.0f, 0.0f, s.z, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}};
+    }
+
+    static Mat4 Rotation(const Quat& q)
+    {
+        const Mat3 r = Mat3::Rotation(q);
+        return {{r[0], 0.0f}, {r[1], 0.0f}, {r[2], 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}};
+    }
+
+    // Translation * Rotation * Scale, without the two matrix products
+    static Mat4 Compose(const Vec3& translation, const Quat& rotation, const Vec3& scale)
+    {
+        const Mat3 r = Mat3::Rotation(rotation);
+        return {{r[0] * scale.x, 0.0f}, {r[1] * scale.y, 0.0f}, {r[2] * scale.z, 0.0f}, {translation, 1.0f}};
+    }
+
+    // Projections are right-handed (the camera looks down -Z) and map depth to [0, 1] with Y pointing down in clip
+    // space, as Vulkan expects
+    static Mat4 Perspective(float fovY, float aspect, float nearPlane, float farPlane)
+    {
+        const float f = 1.0f / std::tan(fovY * 0.5f);
+        const float d = nearPlane - farPlane;
+        return {{f / aspect, 0.0f, 0.0f, 0.0f},
+                {0.0f, -f, 0.0f, 0.0f},
+                {0.0f, 0.0f, farPlane / d, -1.0f},
+                {0.0f, 0.0f, nearPlane * farPlane / d, 0.0f}};
+    }
+
+    static Mat4 Orthographic(float left, float right, float bottom, float top, float nearPlane, float farPlane)
+    {
+        const float w = right - left;
+        const float h = top - bottom;
+        const float d = farPlane - nearPlane;
+        return {{2.0f / w, 0.0f, 0.0f, 0.0f},
+                {0.0f, -2.0f / h, 0.0f, 0.0f},
+                {0.0f, 0.0f, -1.0f / d, 0.0f},
+                {-(right + left) / w, (top + bottom) / h, -nearPlane / d, 1.0f}};
+    }
+
+    static Mat4 LookAt(const Vec3& eye, const Vec3& target, const Vec3& up)
+    {
+        const Vec3 f = Normalize(target - eye);
+        const Vec3 s = Normalize(Cross(f, up));
+        const Vec3 u = Cross(s, f);
+        return {{s.x, u.x, -f.x, 0.0f},
+                {s.y, u.y, -f.y, 0.0f},
+                {s.z, u.z, -f.z, 0.0f},
+                {-Dot(s, eye), -Dot(u, eye), Dot(f, eye), 1.0f}};
+    }
+
+    // For the renderers' float[16] parameters
+    const float* Data() const { return &Columns[0].x; }
+
+    Vec4& operator[](int column) { return Columns[column]; }
+    const Vec4& operator[](int column) const { return Columns[column]; }
+};
+
+inline Mat3::Mat3(const Mat4& m) : Columns{m[0].XYZ(), m[1].XYZ(), m[2].XYZ()}
+{
+}
+
+// Mat3
+
+inline Vec3 operator*(const Mat3& m, const Vec3& v)
+{
+    return m[0] * v.x + m[1] * v.y + m[2] * v.z;
+}
+
+inline Mat3 operator*(const Mat3& a, const Mat3& b)
+{
+    return {a * b[0], a * b[1], a * b[2]};
+}
+
+inline Mat3 Transpose(const Mat3& m)
+{
+    return {{m[0].x, m[1].x, m[2].x}, {m[0].y, m[1].y, m[2].y}, {m[0].z, m[1].z, m[2].z}};
+}
+
+inline float Determinant(const Mat3& m)
+{
+    return Dot(m[0], Cross(m[1], m[2]));
+}
+
+inline Mat3 Inverse(const Mat3& m)
+{
+    // Rows of the inverse are the cross products of the columns, over the determinant
+    const Vec3 r0          = Cross(m[1], m[2]);
+    const Vec3 r1          = Cross(m[2], m[0]);
+    const Vec3 r2          = Cross(m[0], m[1]);
+    const float inverseDet = 1.0f / Dot(m[0], r0);
+    return Transpose(Mat3(r0 * inverseDet, r1 * inverseDet, r2 * inverseDet));
+}
+
+// Mat4
+
+inline Vec4 operator*(const Mat4& m, const Vec4& v)
+{
+    const SIMD::Float4 value = v.Load();
+
+    SIMD::Float4 result = SIMD::Mul(m[0].Load(), SIMD::SplatLane<0>(value));
+    result              = SIMD::MulAdd(m[1].Load(), SIMD::SplatLane<1>(value), result);
+    result              = SIMD::MulAdd(m[2].Load(), SIMD::SplatLane<2>(value), result);
+    result              = SIMD::MulAdd(m[3].Load(), SIMD::SplatLane<3>(value), result);
+    return Vec4(result);
+}
+
+inline Mat4 operator*(const Mat4& a, const Mat4& b)
+{
+    const SIMD::Float4 a0 = a[0].Load();
+    const SIMD::Float4 a1 = a[1].Load();
+    const SIMD::Float4 a2 = a[2].Load();
+    const SIMD::Float4 a3 = a[3].Load();
+
+    Mat4 result;
+    for (int i = 0; i < 4; i++)
+    {
+        const SIMD::Float4 column = b[i].Load();
+
+        SIMD::Float4 value = SIMD::Mul(a0, SIMD::SplatLane<0>(column));
+        value              = SIMD::MulAdd(a1, SIMD::SplatLane<1>(column), value);
+        value              = SIMD::MulAdd(a2, SIMD::SplatLane<2>(column), value);
+        value              = SIMD::MulAdd(a3, SIMD::SplatLane<3>(column), value);
+        result[i]          = Vec4(value);
+    }
+    return result;
+}
+
+// Affine, w is taken as 1 and the result isn't divided by anything
+inline Vec3 TransformPoint(const Mat4& m, const Vec3& p)
+{
+    return (m * Vec4(p, 1.0f)).XYZ();
+}
+
+inline Vec3 TransformDirection(const Mat4& m, const Vec3& d)
+{
+    return (m * Vec4(d, 0.0f)).XYZ();
+}
+
+inline Mat4 Transpose(const Mat4& m)
+{
+    Mat4 result;
+    for (int column = 0; column < 4; column++)
+    {
+        for (int row = 0; row < 4; row++)
+            result[column][row] = m[row][column];
+    }
+    return result;
+}
+
+// General inverse by cofactors, built from the 2x2 determinants of the first and last two columns. Rigid transforms
+// are cheaper to invert by hand: transpose the rotation and rotate the negated translation.
+inline Mat4 Inverse(const Mat4& m)
+{
+    const float* a = m.Data();
+
+    const float s0 = a[0] * a[5] - a[4] * a[1];
+    const float s1 = a[0] * a[6] - a[4] * a[2];
+    const float s2 = a[0] * a[7] - a[4] * a[3];
+    const float s3 = a[1] * a[6] - a[5] * a[2];
+    const float s4 = a[1] * a[7] - a[5] * a[3];
+    const float s5 = a[2] * a[7] - a[6] * a[3];
+
+    const float c5 = a[10] * a[15] - a[14] * a[11];
+    const float c4 = a[9] * a[15] - a[13] * a[11];
+    const float c3 = a[9] * a[14] - a[13] * a[10];
+    const float c2 = a[8] * a[15] - a[12] * a[11];
+    const float c1 = a[8] * a[14] - a[12] * a[10];
+    const float c0 = a[8] * a[13] - a[12] * a[9];
+
+    const float d = 1.0f / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+
+    return {{(a[5] * c5 - a[6] * c4 + a[7] * c3) * d, (-a[1] * c5 + a[2] * c4 - a[3] * c3) * d,
+             (a[13] * s5 - a[14] * s4 + a[15] * s3) * d, (-a[9] * s5 + a[10] * s4 - a[11] * s3) * d},
+            {(-a[4] * c5 + a[6] * c2 - a[7] * c1) * d, (a[0] * c5 - a[2] * c2 + a[3] * c1) * d,
+             (-a[12] * s5 + a[14] * s2 - a[15] * s1) * d, (a[8] * s5 - a[10] * s2 + a[11] * s1) * d},
+            {(a[4] * c4 - a[5] * c2 + a[7] * c0) * d, (-a[0] * c4 + a[1] * c2 - a[3] * c0) * d,
+             (a[12] * s4 - a[13] * s2 + a[15] * s0) * d, (-a[8] * s4 + a[9] * s2 - a[11] * s0) * d},
+            {(-a[4] * c3 + a[5] * c1 - a[6] * c0) * d, (a[0] * c3 - a[1] * c1 + a[2] * c0) * d,
+             (-a[12] * s3 + a[13] * s1 - a[14] * s0) * d, (a[8] * s3 - a[9] * s1 + a[10] * s0) * d}};
+}
+
+} // namespace Noctis
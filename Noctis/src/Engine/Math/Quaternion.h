@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Engine/Math/Vector.h"
+
+namespace Noctis
+{
+
+// Unit quaternions represent rotations. The product a * b rotates by b first, then by a.
+struct alignas(16) Quat
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float w = 1.0f;
+
+    constexpr Quat() = default;
+    constexpr Quat(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    explicit Quat(SIMD::Float4 v) { SIMD::Store(&x, v); }
+
+    // axis must be normalized, angle is in radians
+    static Quat FromAxisAngle(const Vec3& axis, float angle)
+    {
+        const float s = std::sin(angle * 0.5f);
+        return {axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f)};
+    }
+
+    SIMD::Float4 Load() const { return SIMD::Load(&x); }
+};
+
+inline Quat operator*(const Quat& a, const Quat& b)
+{
+    const SIMD::Float4 q = b.Load();
+    const SIMD::Float4 p = a.Load();
+
+    // a's w times b, then a's x, y and z times b's lanes reordered and signed to match the Hamilton product
+    SIMD::Float4 result = SIMD::Mul(SIMD::SplatLane<3>(p), q);
+
+    result = SIMD::MulAdd(SIMD::Mul(SIMD::SplatLane<0>(p), SIMD::Shuffle<3, 2, 1, 0>(q)),
+                          SIMD::Set(1.0f, -1.0f, 1.0f, -1.0f), result);
+    result = SIMD::MulAdd(SIMD::Mul(SIMD::SplatLane<1>(p), SIMD::Shuffle<2, 3, 0, 1>(q)),
+                          SIMD::Set(1.0f, 1.0f, -1.0f, -1.0f), result);
+    result = SIMD::MulAdd(SIMD::Mul(SIMD::SplatLane<2>(p), SIMD::Shuffle<1, 0, 3, 2>(q)),
+                          SIMD::Set(-1.0f, 1.0f, 1.0f, -1.0f), result);
+    return Quat(result);
+}
+
+// Rotates v, q must be normalized
+inline Vec3 operator*(const Quat& q, const Vec3& v)
+{
+    const Vec3 u(q.x, q.y, q.z);
+    const Vec3 t = Cross(u, v) * 2.0f;
+    return v + t * q.w + Cross(u, t);
+}
+
+inline bool operator==(const Quat& a, const Quat& b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+}
+
+inline float Dot(const Quat& a, const Quat& b)
+{
+    return SIMD::GetLane<0>(SIMD::Dot4(a.Load(), b.Load()));
+}
+
+inline float Length(const Quat& q)
+{
+    return std::sqrt(Dot(q, q));
+}
+
+inline Quat Normalize(const Quat& q)
+{
+    const SIMD::Float4 value = q.Load();
+    return Quat(SIMD::Div(value, SIMD::Sqrt(SIMD::Dot4(value, value))));
+}
+
+inline Quat Conjugate(const Quat& q)
+{
+    return {-q.x, -q.y, -q.z, q.w};
+}
+
+// The conjugate, scaled for quaternions that aren't normalized
+inline Quat Inverse(const Quat& q)
+{
+    const SIMD::Float4 value = SIMD::Mul(q.Load(), SIMD::Set(-1.0f, -1.0f, -1.0f, 1.0f));
+    return Quat(SIMD::Div(value, SIMD::Dot4(value, value)));
+}
+
+// Normalized linear interpolation along the shortest arc. Not constant speed, but cheaper than Slerp and close enough
+// for the small steps between animation keys.
+inline Quat Nlerp(const Quat& a, const Quat& b, float t)
+{
+    const SIMD::Float4 from = a.Load();
+    SIMD::Float4 to         = b.Load();
+    if (Dot(a, b) < 0.0f)
+        to = SIMD::Negate(to);
+    return Normalize(Quat(SIMD::MulAdd(SIMD::Sub(to, from), SIMD::Splat(t), from)));
+}
+
+// Constant speed interpolation along the shortest arc
+inline Quat Slerp(const Quat& a, const Quat& b, float t)
+{
+    float cosTheta  = Dot(a, b);
+    SIMD::Float4 to = b.Load();
+    if (cosTheta < 0.0f)
+    {
+        cosTheta = -cosTheta;
+        to       = SIMD::Negate(to);
+    }
+
+    // Nearly parallel, sin(theta) would divide by almost zero
+    if (cosTheta > 0.9995f)
+        return Nlerp(a, Quat(to), t);
+
+    const float theta    = std::acos(cosTheta);
+    const float sinTheta = std::sin(theta);
+    const float wa       = std::sin((1.0f - t) * theta) / sinTheta;
+    const float wb       = std::sin(t * theta) / sinTheta;
+    return Quat(SIMD::MulAdd(a.Load(), SIMD::Splat(wa), SIMD::Mul(to, SIMD::Splat(wb))));
+}
+
+} // namespace Noctis
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <cmath>
+
+// The backend is picked at compile time: SSE on x86 (SSE2 is always there on x86-64, SSE4.1 is used when the build
+// targets it and AVX2 widens the batched kernels to eight lanes), NEON on 64-bit ARM, and plain floats everywhere else
+// or when NOC_MATH_FORCE_SCALAR is defined (the NOC_MATH_SCALAR CMake option). It has to be the same in every
+// translation unit, so only ever set it for the whole build.
+#if defined(NOC_MATH_FORCE_SCALAR)
+#define NOC_MATH_SCALAR 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#define NOC_MATH_SSE 1
+#include <immintrin.h>
+#if defined(__SSE4_1__)
+#define NOC_MATH_SSE4 1
+#endif
+#if defined(__AVX2__)
+#define NOC_MATH_AVX2 1
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define NOC_MATH_NEON 1
+#include <arm_neon.h>
+#else
+#define NOC_MATH_SCALAR 1
+#endif
+
+namespace Noctis
+{
+
+// Four packed floats and the operations the math types are built from
+namespace SIMD
+{
+
+#if NOC_MATH_SSE
+using Float4 = __m128;
+#elif NOC_MATH_NEON
+using Float4 = float32x4_t;
+#else
+struct Float4
+{
+    float Lanes[4];
+};
+#endif
+
+inline const char* GetBackendName()
+{
+#if NOC_MATH_AVX2
+    return "AVX2";
+#elif NOC_MATH_SSE4
+    return "SSE4.1";
+#elif NOC_MATH_SSE
+    return "SSE2";
+#elif NOC_MATH_NEON
+    return "NEON";
+#else
+    return "Scalar";
+#endif
+}
+
+// Unaligned, which costs the same as an aligned access on anything recent
+inline Float4 Load(const float* p)
+{
+#if NOC_MATH_SSE
+    return _mm_loadu_ps(p);
+#elif NOC_MATH_NEON
+    return vld1q_f32(p);
+#else
+    return {{p[0], p[1], p[2], p[3]}};
+#endif
+}
+
+inline void Store(float* p, Float4 v)
+{
+#if NOC_MATH_SSE
+    _mm_storeu_ps(p, v);
+#elif NOC_MATH_NEON
+    vst1q_f32(p, v);
+#else
+    for (int i = 0; i < 4; i++)
+        p[i] = v.Lanes[i];
+#endif
+}
+
+inline Float4 Set(float x, float y, float z, float w)
+{
+#if NOC_MATH_SSE
+    return _mm_setr_ps(x, y, z, w);
+#elif NOC_MATH_NEON
+    const float lanes[4] = {x, y, z, w};
+    return vld1q_f32(lanes);
+#else
+    return {{x, y, z, w}};
+#endif
+}
+
+inline Float4 Splat(float s)
+{
+#if NOC_MATH_SSE
+    return _mm_set1_ps(s);
+#elif NOC_MATH_NEON
+    return vdupq_n_f32(s);
+#else
+    return {{s, s, s, s}};
+#endif
+}
+
+inline Float4 Add(Float4 a, Float4 b)
+{
+#if NOC_MATH_SSE
+    return _mm_add_ps(a, b);
+#elif NOC_MATH_NEON
+    return vaddq_f32(a, b);
+#else
+    return {{a.Lanes[0] + b.Lanes[0], a.Lanes[1] + b.Lanes[1], a.Lanes[2] + b.Lanes[2], a.Lanes[3] + b.Lanes[3]}};
+#endif
+}
+
+inline Float4 Sub(Float4 a, Float4 b)
+{
+#if NOC_MATH_SSE
+    return _mm_sub_ps(a, b);
+#elif NOC_MATH_NEON
+    return vsubq_f32(a, b);
+#else
+    return {{a.Lanes[0] - b.Lanes[0], a.Lanes[1] - b.Lanes[1], a.Lanes[2] - b.Lanes[2], a.Lanes[3] - b.Lanes[3]}};
+#endif
+}
+
+inline Float4 Mul(Float4 a, Float4 b)
+{
+#if NOC_MATH_SSE
+    return _mm_mul_ps(a, b);
+#elif NOC_MATH_NEON
+    return vmulq_f32(a, b);
+#else
+    return {{a.Lanes[0] * b.Lanes[0], a.Lanes[1] * b.Lanes[1], a.Lanes[2] * b.Lanes[2], a.Lanes[3] * b.Lanes[3]}};
+#endif
+}
+
+inline Float4 Div(Float4 a, Float4 b)
+{
+#if NOC_MATH_SSE
+    return _mm_div_ps(a, b);
+#elif NOC_MATH_NEON
+    return vdivq_f32(a, b);
+#else
+    return {{a.Lanes[0] / b.Lanes[0], a.Lanes[1] / b.Lanes[1], a.Lanes[2] / b.Lanes[2], a.Lanes[3] / b.Lanes[3]}};
+#endif
+}
+
+// a * b + c, fused where the target has FMA
+inline Float4 MulAdd(Float4 a, Float4 b, Float4 c)
+{
+#if NOC_MATH_SSE && defined(__FMA__)
+    return _mm_fmadd_ps(a, b, c);
+#elif NOC_MATH_NEON
+    return vfmaq_f32(c, a, b);
+#else
+    return Add(Mul(a, b), c);
+#endif
+}
+
+inline Float4 Min(Float4 a, Float4 b)
+{
+#if NOC_MATH_SSE
+    return _mm_min_ps(a, b);
+#elif NOC_MATH_NEON
+    return vminq_f32(a, b);
+#else
+    return {{std::fmin(a.Lanes[0], b.Lanes[0]), std::fmin(a.Lanes[1], b.Lanes[1]), std::fmin(a.Lanes[2], b.Lanes[2]),
+             std::fmin(a.Lanes[3], b.Lanes[3])}};
+#endif
+}
+
+inline Float4 Max(Float4 a, Float4 b)
+{
+#if NOC_MATH_SSE
+    return _mm_max_ps(a, b);
+#elif NOC_MATH_NEON
+    return vmaxq_f32(a, b);
+#else
+    return {{std::fmax(a.Lanes[0], b.Lanes[0]), std::fmax(a.Lanes[1], b.Lanes[1]), std::fmax(a.Lanes[2], b.Lanes[2]),
+             std::fmax(a.Lanes[3], b.Lanes[3])}};
+#endif
+}
+
+inline Float4 Abs(Float4 v)
+{
+#if NOC_MATH_SSE
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+#elif NOC_MATH_NEON
+    return vabsq_f32(v);
+#else
+    return {{std::fabs(v.Lanes[0]), std::fabs(v.Lanes[1]), std::fabs(v.Lanes[2]), std::fabs(v.Lanes[3])}};
+#endif
+}
+
+inline Float4 Negate(Float4 v)
+{
+#if NOC_MATH_SSE
+    return _mm_xor_ps(_mm_set1_ps(-0.0f), v);
+#elif NOC_MATH_NEON
+    return vnegq_f32(v);
+#else
+    return {{-v.Lanes[0], -v.Lanes[1], -v.Lanes[2], -v.Lanes[3]}};
+#endif
+}
+
+inline Float4 Sqrt(Float4 v)
+{
+#if NOC_MATH_SSE
+    return _mm_sqrt_ps(v);
+#elif NOC_MATH_NEON
+    return vsqrtq_f32(v);
+#else
+    return {{std::sqrt(v.Lanes[0]), std::sqrt(v.Lanes[1]), std::sqrt(v.Lanes[2]), std::sqrt(v.Lanes[3])}};
+#endif
+}
+
+// Result lane i is v's lane I, lane j is J, and so on
+template <int I, int J, int K, int L> inline Float4 Shuffle(Float4 v)
+{
+#if NOC_MATH_SSE
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(L, K, J, I));
+#elif NOC_MATH_NEON && defined(__clang__)
+    return __builtin_shufflevector(v, v, I, J, K, L);
+#elif NOC_MATH_NEON
+    return __builtin_shuffle(v, uint32x4_t{I, J, K, L});
+#else
+    return {{v.Lanes[I], v.Lanes[J], v.Lanes[K], v.Lanes[L]}};
+#endif
+}
+
+template <int I> inline Float4 SplatLane(Float4 v)
+{
+#if NOC_MATH_NEON
+    return vdupq_laneq_f32(v, I);
+#else
+    return Shuffle<I, I, I, I>(v);
+#endif
+}
+
+template <int I> inline float GetLane(Float4 v)
+{
+#if NOC_MATH_SSE
+    return _mm_cvtss_f32(SplatLane<I>(v));
+#elif NOC_MATH_NEON
+    return vgetq_lane_f32(v, I);
+#else
+    return v.Lanes[I];
+#endif
+}
+
+// The sum of all four products, in every lane
+inline Float4 Dot4(Float4 a, Float4 b)
+{
+#if NOC_MATH_SSE4
+    return _mm_dp_ps(a, b, 0xFF);
+#elif NOC_MATH_SSE
+    const Float4 products = _mm_mul_ps(a, b);
+    const Float4 pairs    = _mm_add_ps(products, Shuffle<2, 3, 0, 1>(products));
+    return _mm_add_ps(pairs, Shuffle<1, 0, 3, 2>(pairs));
+#elif NOC_MATH_NEON
+    return vdupq_n_f32(vaddvq_f32(vmulq_f32(a, b)));
+#else
+    return Splat(a.Lanes[0] * b.Lanes[0] + a.Lanes[1] * b.Lanes[1] + a.Lanes[2] * b.Lanes[2] +
+                 a.Lanes[3] * b.Lanes[3]);
+#endif
+}
+
+// The sum of the first three products, in every lane
+inline Float4 Dot3(Float4 a, Float4 b)
+{
+#if NOC_MATH_SSE4
+    return _mm_dp_ps(a, b, 0x7F);
+#elif NOC_MATH_SSE
+    return Dot4(a, _mm_and_ps(b, _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0))));
+#elif NOC_MATH_NEON
+    return vdupq_n_f32(vaddvq_f32(vsetq_lane_f32(0.0f, vmulq_f32(a, b), 3)));
+#else
+    return Splat(a.Lanes[0] * b.Lanes[0] + a.Lanes[1] * b.Lanes[1] + a.Lanes[2] * b.Lanes[2]);
+#endif
+}
+
+} // namespace SIMD
+
+} // namespace Noctis
@@ -0,0 +1,324 @@
+#pragma once
+
+#include "Engine/Math/SIMD.h"
+
+#include <cmath>
+
+namespace Noctis
+{
+
+// Vec2 and Vec3 are plain floats: they don't fill a register, and loading them into one costs more than the
+// arithmetic saves. Vec4 is 16-byte aligned and goes through SIMD. For many points, see MathKernels.
+
+struct Vec2
+{
+    float x = 0.0f;
+    float y = 0.0f;
+
+    constexpr Vec2() = default;
+    constexpr explicit Vec2(float s) : x(s), y(s) {}
+    constexpr Vec2(float x, float y) : x(x), y(y) {}
+
+    float& operator[](int i) { return (&x)[i]; }
+    float operator[](int i) const { return (&x)[i]; }
+
+    Vec2& operator+=(const Vec2& v) { return *this = {x + v.x, y + v.y}; }
+    Vec2& operator-=(const Vec2& v) { return *this = {x - v.x, y - v.y}; }
+    Vec2& operator*=(float s) { return *this = {x * s, y * s}; }
+    Vec2& operator/=(float s) { return *this = {x / s, y / s}; }
+};
+
+struct Vec3
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+
+    constexpr Vec3() = default;
+    constexpr explicit Vec3(float s) : x(s), y(s), z(s) {}
+    constexpr Vec3(float x, float y, float z) : x(x), y(y), z(z) {}
+    constexpr Vec3(const Vec2& v, float z) : x(v.x), y(v.y), z(z) {}
+
+    float& operator[](int i) { return (&x)[i]; }
+    float operator[](int i) const { return (&x)[i]; }
+
+    Vec3& operator+=(const Vec3& v) { return *this = {x + v.x, y + v.y, z + v.z}; }
+    Vec3& operator-=(const Vec3& v) { return *this = {x - v.x, y - v.y, z - v.z}; }
+    Vec3& operator*=(float s) { return *this = {x * s, y * s, z * s}; }
+    Vec3& operator/=(float s) { return *this = {x / s, y / s, z / s}; }
+};
+
+struct alignas(16) Vec4
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float w = 0.0f;
+
+    constexpr Vec4() = default;
+    constexpr explicit Vec4(float s) : x(s), y(s), z(s), w(s) {}
+    constexpr Vec4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    constexpr Vec4(const Vec3& v, float w) : x(v.x), y(v.y), z(v.z), w(w) {}
+    explicit Vec4(SIMD::Float4 v) { SIMD::Store(&x, v); }
+
+    SIMD::Float4 Load() const { return SIMD::Load(&x); }
+    Vec3 XYZ() const { return {x, y, z}; }
+
+    float& operator[](int i) { return (&x)[i]; }
+    float operator[](int i) const { return (&x)[i]; }
+
+    Vec4& operator+=(const Vec4& v) { return *this = Vec4(SIMD::Add(Load(), v.Load())); }
+    Vec4& operator-=(const Vec4& v) { return *this = Vec4(SIMD::Sub(Load(), v.Load())); }
+    Vec4& operator*=(float s) { return *this = Vec4(SIMD::Mul(Load(), SIMD::Splat(s))); }
+    Vec4& operator/=(float s) { return *this = Vec4(SIMD::Div(Load(), SIMD::Splat(s))); }
+};
+
+// Vec2
+
+inline Vec2 operator+(const Vec2& a, const Vec2& b)
+{
+    return {a.x + b.x, a.y + b.y};
+}
+
+inline Vec2 operator-(const Vec2& a, const Vec2& b)
+{
+    return {a.x - b.x, a.y - b.y};
+}
+
+inline Vec2 operator*(const Vec2& a, const Vec2& b)
+{
+    return {a.x * b.x, a.y * b.y};
+}
+
+inline Vec2 operator/(const Vec2& a, const Vec2& b)
+{
+    return {a.x / b.x, a.y / b.y};
+}
+
+inline Vec2 operator*(const Vec2& v, float s)
+{
+    return {v.x * s, v.y * s};
+}
+
+inline Vec2 operator*(float s, const Vec2& v)
+{
+    return v * s;
+}
+
+inline Vec2 operator/(const Vec2& v, float s)
+{
+    return {v.x / s, v.y / s};
+}
+
+inline Vec2 operator-(const Vec2& v)
+{
+    return {-v.x, -v.y};
+}
+
+inline bool operator==(const Vec2& a, const Vec2& b)
+{
+    return a.x == b.x && a.y == b.y;
+}
+
+inline float Dot(const Vec2& a, const Vec2& b)
+{
+    return a.x * b.x + a.y * b.y;
+}
+
+inline float Length(const Vec2& v)
+{
+    return std::sqrt(Dot(v, v));
+}
+
+inline Vec2 Normalize(const Vec2& v)
+{
+    return v / Length(v);
+}
+
+inline Vec2 Min(const Vec2& a, const Vec2& b)
+{
+    return {std::fmin(a.x, b.x), std::fmin(a.y, b.y)};
+}
+
+inline Vec2 Max(const Vec2& a, const Vec2& b)
+{
+    return {std::fmax(a.x, b.x), std::fmax(a.y, b.y)};
+}
+
+inline Vec2 Lerp(const Vec2& a, const Vec2& b, float t)
+{
+    return a + (b - a) * t;
+}
+
+// Vec3
+
+inline Vec3 operator+(const Vec3& a, const Vec3& b)
+{
+    return {a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+inline Vec3 operator-(const Vec3& a, const Vec3& b)
+{
+    return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+inline Vec3 operator*(const Vec3& a, const Vec3& b)
+{
+    return {a.x * b.x, a.y * b.y, a.z * b.z};
+}
+
+inline Vec3 operator/(const Vec3& a, const Vec3& b)
+{
+    return {a.x / b.x, a.y / b.y, a.z / b.z};
+}
+
+inline Vec3 operator*(const Vec3& v, float s)
+{
+    return {v.x * s, v.y * s, v.z * s};
+}
+
+inline Vec3 operator*(float s, const Vec3& v)
+{
+    return v * s;
+}
+
+inline Vec3 operator/(const Vec3& v, float s)
+{
+    return {v.x / s, v.y / s, v.z / s};
+}
+
+inline Vec3 operator-(const Vec3& v)
+{
+    return {-v.x, -v.y, -v.z};
+}
+
+inline bool operator==(const Vec3& a, const Vec3& b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+inline float Dot(const Vec3& a, const Vec3& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+inline Vec3 Cross(const Vec3& a, const Vec3& b)
+{
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+inline float Length(const Vec3& v)
+{
+    return std::sqrt(Dot(v, v));
+}
+
+inline Vec3 Normalize(const Vec3& v)
+{
+    return v / Length(v);
+}
+
+inline Vec3 Abs(const Vec3& v)
+{
+    return {std::fabs(v.x), std::fabs(v.y), std::fabs(v.z)};
+}
+
+inline Vec3 Min(const Vec3& a, const Vec3& b)
+{
+    return {std::fmin(a.x, b.x), std::fmin(a.y, b.y), std::fmin(a.z, b.z)};
+}
+
+inline Vec3 Max(const Vec3& a, const Vec3& b)
+{
+    return {std::fmax(a.x, b.x), std::fmax(a.y, b.y), std::fmax(a.z, b.z)};
+}
+
+inline Vec3 Lerp(const Vec3& a, const Vec3& b, float t)
+{
+    return a + (b - a) * t;
+}
+
+// Vec4
+
+inline Vec4 operator+(const Vec4& a, const Vec4& b)
+{
+    return Vec4(SIMD::Add(a.Load(), b.Load()));
+}
+
+inline Vec4 operator-(const Vec4& a, const Vec4& b)
+{
+    return Vec4(SIMD::Sub(a.Load(), b.Load()));
+}
+
+inline Vec4 operator*(const Vec4& a, const Vec4& b)
+{
+    return Vec4(SIMD::Mul(a.Load(), b.Load()));
+}
+
+inline Vec4 operator/(const Vec4& a, const Vec4& b)
+{
+    return Vec4(SIMD::Div(a.Load(), b.Load()));
+}
+
+inline Vec4 operator*(const Vec4& v, float s)
+{
+    return Vec4(SIMD::Mul(v.Load(), SIMD::Splat(s)));
+}
+
+inline Vec4 operator*(float s, const Vec4& v)
+{
+    return v * s;
+}
+
+inline Vec4 operator/(const Vec4& v, float s)
+{
+    return Vec4(SIMD::Div(v.Load(), SIMD::Splat(s)));
+}
+
+inline Vec4 operator-(const Vec4& v)
+{
+    return Vec4(SIMD::Negate(v.Load()));
+}
+
+inline bool operator==(const Vec4& a, const Vec4& b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+}
+
+inline float Dot(const Vec4& a, const Vec4& b)
+{
+    return SIMD::GetLane<0>(SIMD::Dot4(a.Load(), b.Load()));
+}
+
+inline float Length(const Vec4& v)
+{
+    return std::sqrt(Dot(v, v));
+}
+
+inline Vec4 Normalize(const Vec4& v)
+{
+    const SIMD::Float4 value = v.Load();
+    return Vec4(SIMD::Div(value, SIMD::Sqrt(SIMD::Dot4(value, value))));
+}
+
+inline Vec4 Abs(const Vec4& v)
+{
+    return Vec4(SIMD::Abs(v.Load()));
+}
+
+inline Vec4 Min(const Vec4& a, const Vec4& b)
+{
+    return Vec4(SIMD::Min(a.Load(), b.Load()));
+}
+
+inline Vec4 Max(const Vec4& a, const Vec4& b)
+{
+    return Vec4(SIMD::Max(a.Load(), b.Load()));
+}
+
+inline Vec4 Lerp(const Vec4& a, const Vec4& b, float t)
+{
+    const SIMD::Float4 from = a.Load();
+    return Vec4(SIMD::MulAdd(SIMD::Sub(b.Load(), from), SIMD::Splat(t), from));
+}
+
+} // namespace Noctis
@@ -0,0 +1,257 @@
+#include "MeshRenderer.h"
+
+#include "Engine/Renderer/RendererAPI.h"
+
+#include "Platform/Vulkan/VulkanMeshRenderer.h"
+
+#include <cmath>
+
+namespace Noctis
+{
+
+namespace
+{
+
+struct MeshRendererData
+{
+    Scope<MeshRendererAPI> API;
+
+    std::vector<MeshData> Meshes;
+    std::vector<MeshInstanceData> Instances;
+    std::vector<uint32_t> FreeInstances;
+    // Per instance, whether it is in Frame.DirtyInstances already
+    std::vector<bool> Dirty;
+
+    MeshRendererFrame Frame;
+    bool HasCamera = false;
+
+    MeshRendererStatistics Statistics;
+};
+
+MeshRendererData s_Data;
+
+Scope<MeshRendererAPI> CreateMeshRendererAPI()
+{
+    switch (RendererAPI::GetAPI())
+    {
+        case RendererAPI::API::None:
+            break;
+        case RendererAPI::API::Vulkan:
+            return CreateScope<VulkanMeshRenderer>();
+    }
+    NOC_CORE_ASSERT(false, "Unknown RendererAPI!");
+    return nullptr;
+}
+
+void ComputeBoundingSphere(const MeshVertex* vertices, uint32_t vertexCount, float sphere[4])
+{
+    float min[3] = {vertices[0].Position[0], vertices[0].Position[1], vertices[0].Position[2]};
+    float max[3] = {min[0], min[1], min[2]};
+    for (uint32_t i = 1; i < vertexCount; i++)
+    {
+        for (uint32_t axis = 0; axis < 3; axis++)
+        {
+            min[axis] = std::min(min[axis], vertices[i].Position[axis]);
+            max[axis] = std::max(max[axis], vertices[i].Position[axis]);
+        }
+    }
+
+    for (uint32_t axis = 0; axis < 3; axis++)
+        sphere[axis] = (min[axis] + max[axis]) * 0.5f;
+
+    float radiusSquared = 0.0f;
+    for (uint32_t i = 0; i < vertexCount; i++)
+    {
+        float distanceSquared = 0.0f;
+        for (uint32_t axis = 0; axis < 3; axis++)
+        {
+            const float d = vertices[i].Position[axis] - sphere[axis];
+            distanceSquared += d * d;
+        }
+        radiusSquared = std::max(radiusSquared, distanceSquared);
+    }
+    sphere[3] = std::sqrt(radiusSquared);
+}
+
+// Gribb-Hartmann: each plane is the last row of the matrix plus or minus another row. Depth is [0, 1], so the near
+// plane is the third row alone.
+void ExtractFrustumPlanes(const float m[16], float planes[6][4])
+{
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        const float row0 = m[i * 4 + 0];
+        const float row1 = m[i * 4 + 1];
+        const float row2 = m[i * 4 + 2];
+        const float row3 = m[i * 4 + 3];
+
+        planes[0][i] = row3 + row0;
+        planes[1][i] = row3 - row0;
+        planes[2][i] = row3 + row1;
+        planes[3][i] = row3 - row1;
+        planes[4][i] = row2;
+        planes[5][i] = row3 - row2;
+    }
+
+    for (uint32_t p = 0; p < 6; p++)
+    {
+        const float length =
+            std::sqrt(planes[p][0] * planes[p][0] + planes[p][1] * planes[p][1] + planes[p][2] * planes[p][2]);
+        if (length > 0.0f)
+        {
+            for (uint32_t i = 0; i < 4; i++)
+                planes[p][i] /= length;
+        }
+    }
+}
+
+} // namespace
+
+void MeshRenderer::Init()
+{
+    NOC_PROFILE_FUNCTION();
+
+    s_Data.API = CreateMeshRendererAPI();
+    s_Data.API->Init();
+}
+
+void MeshRenderer::Shutdown()
+{
+    NOC_PROFILE_FUNCTION();
+
+    s_Data.API->Shutdown();
+    s_Data = {};
+}
+
+uint32_t MeshRenderer::CreateMesh(const MeshVertex* vertices, uint32_t vertexCount, const uint32_t* indices,
+                                  uint32_t indexCount)
+{
+    NOC_CORE_ASSERT(vertexCount > 0 && indexCount > 0 && indexCount % 3 == 0, "Meshes must be triangle lists");
+
+    MeshRendererFrame& frame = s_Data.Frame;
+
+    MeshData& mesh    = s_Data.Meshes.emplace_back();
+    mesh.IndexCount   = indexCount;
+    mesh.FirstIndex   = frame.FirstIndex + static_cast<uint32_t>(frame.Indices.size());
+    mesh.VertexOffset = static_cast<int32_t>(frame.FirstVertex + frame.Vertices.size());
+    mesh.Padding      = 0;
+    ComputeBoundingSphere(vertices, vertexCount, mesh.BoundingSphere);
+
+    frame.Vertices.insert(frame.Vertices.end(), vertices, vertices + vertexCount);
+    frame.Indices.insert(frame.Indices.end(), indices, indices + indexCount);
+
+    s_Data.Statistics.MeshCount++;
+    return static_cast<uint32_t>(s_Data.Meshes.size() - 1);
+}
+
+uint32_t MeshRenderer::CreateInstance(uint32_t mesh, const float transform[16], const float color[4])
+{
+    NOC_CORE_ASSERT(mesh < s_Data.Meshes.size(), "MeshRenderer::CreateInstance: unknown mesh");
+
+    uint32_t index;
+    if (!s_Data.FreeInstances.empty())
+    {
+        index = s_Data.FreeInstances.back();
+        s_Data.FreeInstances.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(s_Data.Instances.size());
+        s_Data.Instances.emplace_back();
+        s_Data.Dirty.push_back(false);
+    }
+
+    MeshInstanceData& instance = s_Data.Instances[index];
+    std::copy(transform, transform + 16, instance.Transform);
+    std::copy(color, color + 4, instance.Color);
+    instance.Mesh = mesh;
+    std::fill(std::begin(instance.Padding), std::end(instance.Padding), 0u);
+    MarkDirty(index);
+
+    s_Data.Statistics.InstanceCount++;
+    return index;
+}
+
+void MeshRenderer::SetTransform(uint32_t instance, const float transform[16])
+{
+    NOC_CORE_ASSERT(instance < s_Data.Instances.size() && s_Data.Instances[instance].Mesh != INVALID_MESH,
+                    "MeshRenderer::SetTransform: unknown instance");
+
+    std::copy(transform, transform + 16, s_Data.Instances[instance].Transform);
+    MarkDirty(instance);
+}
+
+void MeshRenderer::SetColor(uint32_t instance, const float color[4])
+{
+    NOC_CORE_ASSERT(instance < s_Data.Instances.size() && s_Data.Instances[instance].Mesh != INVALID_MESH,
+                    "MeshRenderer::SetColor: unknown instance");
+
+    std::copy(color, color + 4, s_Data.Instances[instance].Color);
+    MarkDirty(instance);
+}
+
+void MeshRenderer::DestroyInstance(uint32_t instance)
+{
+    NOC_CORE_ASSERT(instance < s_Data.Instances.size() && s_Data.Instances[instance].Mesh != INVALID_MESH,
+                    "MeshRenderer::DestroyInstance: unknown instance");
+
+    s_Data.Instances[instance].Mesh = INVALID_MESH;
+    MarkDirty(instance);
+    s_Data.FreeInstances.push_back(instance);
+
+    s_Data.Statistics.InstanceCount--;
+}
+
+void MeshRenderer::SetCamera(const float viewProjection[16])
+{
+    std::copy(viewProjection, viewProjection + 16, s_Data.Frame.ViewProjection);
+    ExtractFrustumPlanes(viewProjection, s_Data.Frame.FrustumPlanes);
+    s_Data.HasCamera = true;
+}
+
+void MeshRenderer::Flush(bool rendered)
+{
+    NOC_PROFILE_FUNCTION();
+
+    if (!rendered || !s_Data.HasCamera)
+        return;
+
+    MeshRendererFrame& frame = s_Data.Frame;
+    frame.InstanceCount      = static_cast<uint32_t>(s_Data.Instances.size());
+    frame.MeshCount          = static_cast<uint32_t>(s_Data.Meshes.size());
+    frame.VertexCount        = frame.FirstVertex + static_cast<uint32_t>(frame.Vertices.size());
+    frame.IndexCount         = frame.FirstIndex + static_cast<uint32_t>(frame.Indices.size());
+    frame.Instances          = s_Data.Instances.data();
+    frame.Meshes             = s_Data.Meshes.data();
+
+    // Neighbouring instances end up in the same copy region
+    std::sort(frame.DirtyInstances.begin(), frame.DirtyInstances.end());
+    s_Data.Statistics.UpdatedInstances = static_cast<uint32_t>(frame.DirtyInstances.size());
+
+    s_Data.API->Render(frame);
+
+    for (uint32_t instance : frame.DirtyInstances)
+        s_Data.Dirty[instance] = false;
+    frame.DirtyInstances.clear();
+
+    frame.FirstMesh   = frame.MeshCount;
+    frame.FirstVertex = frame.VertexCount;
+    frame.FirstIndex  = frame.IndexCount;
+    frame.Vertices.clear();
+    frame.Indices.clear();
+}
+
+const MeshRendererStatistics& MeshRenderer::GetStatistics()
+{
+    return s_Data.Statistics;
+}
+
+void MeshRenderer::MarkDirty(uint32_t instance)
+{
+    if (s_Data.Dirty[instance])
+        return;
+
+    s_Data.Dirty[instance] = true;
+    s_Data.Frame.DirtyInstances.push_back(instance);
+}
+
+} // namespace Noctis
@@ -0,0 +1,123 @@
+#pragma once
+
+namespace Noctis
+{
+
+struct MeshVertex
+{
+    float Position[3];
+    float Normal[3];
+    float UV[2];
+};
+
+// One mesh instance as the GPU reads it (std430), indexed by gl_InstanceIndex
+struct MeshInstanceData
+{
+    // Column-major, object to world
+    float Transform[16];
+    float Color[4];
+    // MeshRenderer::INVALID_MESH for destroyed instances, which the culling pass skips
+    uint32_t Mesh;
+    uint32_t Padding[3];
+};
+
+// Where a mesh lives in the shared vertex and index buffers, as the GPU reads it (std430)
+struct MeshData
+{
+    uint32_t IndexCount;
+    uint32_t FirstIndex;
+    int32_t VertexOffset;
+    uint32_t Padding;
+    // Object space center and radius
+    float BoundingSphere[4];
+};
+
+struct MeshRendererStatistics
+{
+    uint32_t MeshCount     = 0;
+    uint32_t InstanceCount = 0;
+    // Instances uploaded by the last rendered frame
+    uint32_t UpdatedInstances = 0;
+};
+
+// Everything that changed since the last rendered frame, along with the camera to cull against
+struct MeshRendererFrame
+{
+    // Column-major, world to clip space
+    float ViewProjection[16];
+    // Normalized, pointing inwards: left, right, bottom, top, near, far
+    float FrustumPlanes[6][4];
+
+    // High-water marks, the GPU buffers must hold this many
+    uint32_t InstanceCount = 0;
+    uint32_t MeshCount     = 0;
+    uint32_t VertexCount   = 0;
+    uint32_t IndexCount    = 0;
+
+    // Sorted, indices into Instances
+    std::vector<uint32_t> DirtyInstances;
+    const MeshInstanceData* Instances = nullptr;
+
+    // Meshes created since the last rendered frame, their geometry is appended at FirstVertex and FirstIndex
+    uint32_t FirstMesh     = 0;
+    const MeshData* Meshes = nullptr;
+    uint32_t FirstVertex   = 0;
+    uint32_t FirstIndex    = 0;
+    std::vector<MeshVertex> Vertices;
+    std::vector<uint32_t> Indices;
+};
+
+class MeshRendererAPI
+{
+  public:
+    virtual ~MeshRendererAPI() = default;
+
+    virtual void Init()     = 0;
+    virtual void Shutdown() = 0;
+
+    // Called between BeginFrame and EndFrame. Copies what it needs, the frame can be cleared afterwards.
+    virtual void Render(const MeshRendererFrame& frame) = 0;
+};
+
+// GPU-driven mesh rendering. Instances live in GPU memory and only the ones that change are uploaded, a compute pass
+// culls them against the view frustum and the previous frame's depth, and a single indirect draw renders whatever
+// survived. The CPU cost of a frame grows with the number of changes, not with the number of instances.
+//
+// Occlusion culling tests against a depth pyramid built from the previous frame, so an object revealed by a fast
+// camera move may show up a frame late.
+//
+// Main thread only. Instances are drawn on top of the frame before Renderer2D, when a camera has been set.
+class MeshRenderer
+{
+  public:
+    static void Init();
+    static void Shutdown();
+
+    // Geometry can't be changed or freed once created. Returns the mesh's index.
+    static uint32_t CreateMesh(const MeshVertex* vertices, uint32_t vertexCount, const uint32_t* indices,
+                               uint32_t indexCount);
+
+    // transform: column-major 4x4 matrix. Returns the instance's index, reused once destroyed.
+    static uint32_t CreateInstance(uint32_t mesh, const float transform[16],
+                                   const float color[4] = DEFAULT_COLOR);
+    static void SetTransform(uint32_t instance, const float transform[16]);
+    static void SetColor(uint32_t instance, const float color[4]);
+    static void DestroyInstance(uint32_t instance);
+
+    // viewProjection: column-major 4x4 matrix, depth mapped to [0, 1]
+    static void SetCamera(const float viewProjection[16]);
+
+    // Called by Renderer::Render between BeginFrame and EndFrame. Changes of a skipped frame (rendered = false) are
+    // kept for the next one.
+    static void Flush(bool rendered);
+
+    static const MeshRendererStatistics& GetStatistics();
+
+    static constexpr uint32_t INVALID_MESH  = UINT32_MAX;
+    static constexpr float DEFAULT_COLOR[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+  private:
+    static void MarkDirty(uint32_t instance);
+};
+
+} // namespace Noctis
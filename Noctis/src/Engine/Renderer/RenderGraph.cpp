@@ -0,0 +1,503 @@
+#include "RenderGraph.h"
+
+namespace Noctis
+{
+
+namespace
+{
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+RenderGraphAccess& RenderGraphPassBuilder::AddAccess(RenderGraphResource resource, RenderGraphUsage usage)
+{
+    NOC_CORE_ASSERT(resource.IsValid() && resource.Index < m_Graph.m_Resources.size(), "Invalid render graph resource");
+
+    RenderGraphPass& pass = m_Graph.m_Passes[m_Pass];
+    for (RenderGraphAccess& access : pass.Accesses)
+    {
+        if (access.Resource != resource)
+            continue;
+
+        // Declaring a read and a write of the same resource makes it a read-modify-write
+        if (RenderGraph::IsWrite(usage))
+            access.Usage = usage;
+        NOC_CORE_ASSERT(access.Usage == usage || RenderGraph::IsWrite(access.Usage),
+                        "A pass can only use a resource in one way");
+        return access;
+    }
+
+    RenderGraphAccess& access = pass.Accesses.emplace_back();
+    access.Resource           = resource;
+    access.Usage              = usage;
+    return access;
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::Read(RenderGraphResource resource, RenderGraphUsage usage)
+{
+    NOC_CORE_ASSERT(!RenderGraph::IsWrite(usage), "Read with a write usage");
+    AddAccess(resource, usage);
+    return *this;
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::Write(RenderGraphResource resource, RenderGraphUsage usage)
+{
+    NOC_CORE_ASSERT(RenderGraph::IsWrite(usage), "Write with a read usage");
+    AddAccess(resource, usage);
+    return *this;
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::ClearColor(RenderGraphResource resource, float r, float g, float b,
+                                                           float a)
+{
+    RenderGraphAccess& access  = AddAccess(resource, RenderGraphUsage::ColorAttachment);
+    access.Clear               = true;
+    access.ClearValue.Color[0] = r;
+    access.ClearValue.Color[1] = g;
+    access.ClearValue.Color[2] = b;
+    access.ClearValue.Color[3] = a;
+    return *this;
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::ClearDepthStencil(RenderGraphResource resource, float depth,
+                                                                  uint32_t stencil)
+{
+    RenderGraphAccess& access              = AddAccess(resource, RenderGraphUsage::DepthStencilAttachment);
+    access.Clear                           = true;
+    access.ClearValue.DepthStencil.Depth   = depth;
+    access.ClearValue.DepthStencil.Stencil = stencil;
+    return *this;
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::SetSideEffects()
+{
+    m_Graph.m_Passes[m_Pass].HasSideEffects = true;
+    return *this;
+}
+
+RenderGraphPassBuilder& RenderGraphPassBuilder::SetParallelRecording()
+{
+    m_Graph.m_Passes[m_Pass].ParallelRecording = true;
+    return *this;
+}
+
+RenderGraphResource RenderGraph::AddResource(RenderGraphResourceData&& data)
+{
+    NOC_CORE_ASSERT(!m_Compiled, "Resources can't be added to a compiled render graph");
+
+    m_Resources.push_back(std::move(data));
+    return {static_cast<uint32_t>(m_Resources.size() - 1)};
+}
+
+RenderGraphResource RenderGraph::CreateTexture(std::string name, const RenderGraphTextureDesc& desc)
+{
+    RenderGraphResourceData data;
+    data.Name    = std::move(name);
+    data.Texture = desc;
+    return AddResource(std::move(data));
+}
+
+RenderGraphResource RenderGraph::CreateBuffer(std::string name, const RenderGraphBufferDesc& desc)
+{
+    RenderGraphResourceData data;
+    data.Name      = std::move(name);
+    data.IsTexture = false;
+    data.Buffer    = desc;
+    return AddResource(std::move(data));
+}
+
+RenderGraphResource RenderGraph::ImportTexture(std::string name, const RenderGraphTextureDesc& desc,
+                                               RenderGraphUsage initialUsage, RenderGraphUsage finalUsage)
+{
+    RenderGraphResourceData data;
+    data.Name         = std::move(name);
+    data.Texture      = desc;
+    data.Imported     = true;
+    data.InitialUsage = initialUsage;
+    data.FinalUsage   = finalUsage;
+    return AddResource(std::move(data));
+}
+
+RenderGraphResource RenderGraph::ImportBuffer(std::string name, const RenderGraphBufferDesc& desc,
+                                              RenderGraphUsage initialUsage, RenderGraphUsage finalUsage)
+{
+    RenderGraphResourceData data;
+    data.Name         = std::move(name);
+    data.IsTexture    = false;
+    data.Buffer       = desc;
+    data.Imported     = true;
+    data.InitialUsage = initialUsage;
+    data.FinalUsage   = finalUsage;
+    return AddResource(std::move(data));
+}
+
+RenderGraphPassBuilder RenderGraph::AddPass(const char* name, RenderGraphPassType type, RenderGraphExecuteFn execute)
+{
+    NOC_CORE_ASSERT(!m_Compiled, "Passes can't be added to a compiled render graph");
+
+    RenderGraphPass& pass = m_Passes.emplace_back();
+    pass.Name             = name;
+    pass.Type             = type;
+    pass.Execute          = std::move(execute);
+
+    return RenderGraphPassBuilder(*this, static_cast<uint32_t>(m_Passes.size() - 1));
+}
+
+void RenderGraph::Reset()
+{
+    m_Passes.clear();
+    m_Resources.clear();
+    m_FinalBarriers.clear();
+    m_HeapSizes.clear();
+    m_AliasedResources.clear();
+    m_Compiled = false;
+}
+
+void RenderGraph::Compile(const MemoryRequirementsFn& getRequirements)
+{
+    NOC_PROFILE_FUNCTION();
+    NOC_CORE_ASSERT(!m_Compiled, "Render graph compiled twice");
+
+    CullPasses();
+    ComputeLifetimes();
+    PlaceTransients(getRequirements);
+    BuildBarriers();
+
+    m_Compiled = true;
+}
+
+void RenderGraph::CullPasses()
+{
+    // Reference counting from the graph's outputs backwards: a pass survives as long as one of the resources it
+    // writes is read by a surviving pass, or is imported
+    std::vector<uint32_t> passRefs(m_Passes.size(), 0);
+    std::vector<uint32_t> resourceRefs(m_Resources.size(), 0);
+    std::vector<std::vector<uint32_t>> writers(m_Resources.size());
+
+    for (uint32_t i = 0; i < m_Passes.size(); i++)
+    {
+        for (const RenderGraphAccess& access : m_Passes[i].Accesses)
+        {
+            if (IsWrite(access.Usage))
+            {
+                passRefs[i]++;
+                writers[access.Resource.Index].push_back(i);
+            }
+            else
+            {
+                resourceRefs[access.Resource.Index]++;
+            }
+        }
+    }
+
+    std::vector<uint32_t> unreferenced;
+    auto cullPass = [&](uint32_t passIndex) {
+        RenderGraphPass& pass = m_Passes[passIndex];
+        pass.Culled           = true;
+        for (const RenderGraphAccess& access : pass.Accesses)
+        {
+            if (!IsWrite(access.Usage) && --resourceRefs[access.Resource.Index] == 0)
+                unreferenced.push_back(access.Resource.Index);
+        }
+    };
+
+    for (uint32_t i = 0; i < m_Passes.size(); i++)
+    {
+        if (passRefs[i] == 0 && !m_Passes[i].HasSideEffects)
+            cullPass(i);
+    }
+    for (uint32_t i = 0; i < m_Resources.size(); i++)
+    {
+        if (resourceRefs[i] == 0)
+            unreferenced.push_back(i);
+    }
+
+    while (!unreferenced.empty())
+    {
+        const uint32_t resource = unreferenced.back();
+        unreferenced.pop_back();
+
+        if (m_Resources[resource].Imported)
+            continue;
+
+        for (uint32_t writer : writers[resource])
+        {
+            RenderGraphPass& pass = m_Passes[writer];
+            if (pass.Culled || pass.HasSideEffects)
+                continue;
+            if (--passRefs[writer] == 0)
+                cullPass(writer);
+        }
+    }
+}
+
+void RenderGraph::ComputeLifetimes()
+{
+    for (uint32_t i = 0; i < m_Passes.size(); i++)
+    {
+        if (m_Passes[i].Culled)
+            continue;
+
+        for (const RenderGraphAccess& access : m_Passes[i].Accesses)
+        {
+            RenderGraphResourceData& resource = m_Resources[access.Resource.Index];
+            resource.UsageMask |= 1u << static_cast<uint32_t>(access.Usage);
+            resource.FirstPass = std::min(resource.FirstPass, i);
+            resource.LastPass  = std::max(resource.LastPass, i);
+        }
+    }
+}
+
+void RenderGraph::PlaceTransients(const MemoryRequirementsFn& getRequirements)
+{
+    m_AliasedResources.assign(m_Resources.size(), {});
+    if (!getRequirements)
+        return;
+
+    struct Placement
+    {
+        uint32_t Resource;
+        RenderGraphMemoryRequirements Requirements;
+    };
+
+    std::vector<Placement> transients;
+    for (uint32_t i = 0; i < m_Resources.size(); i++)
+    {
+        if (m_Resources[i].IsTransient())
+            transients.push_back({i, getRequirements({i})});
+    }
+
+    // Biggest first, the small ones then fill the gaps
+    std::stable_sort(transients.begin(), transients.end(), [](const Placement& a, const Placement& b) {
+        return a.Requirements.Size > b.Requirements.Size;
+    });
+
+    std::vector<const Placement*> placed;
+    std::vector<std::pair<uint64_t, uint64_t>> occupied;
+    for (const Placement& transient : transients)
+    {
+        RenderGraphResourceData& resource             = m_Resources[transient.Resource];
+        const RenderGraphMemoryRequirements& required = transient.Requirements;
+
+        auto livesAlongside = [&](const RenderGraphResourceData& other) {
+            return other.FirstPass <= resource.LastPass && resource.FirstPass <= other.LastPass;
+        };
+
+        // Memory ranges of everything alive at the same time, the resource goes into the first gap it fits
+        occupied.clear();
+        for (const Placement* other : placed)
+        {
+            const RenderGraphResourceData& otherResource = m_Resources[other->Resource];
+            if (otherResource.Heap == required.Heap && livesAlongside(otherResource))
+                occupied.emplace_back(otherResource.Offset, otherResource.Offset + other->Requirements.Size);
+        }
+        std::sort(occupied.begin(), occupied.end());
+
+        uint64_t offset = 0;
+        for (const auto& [begin, end] : occupied)
+        {
+            if (AlignUp(offset, required.Alignment) + required.Size <= begin)
+                break;
+            offset = std::max(offset, end);
+        }
+        offset = AlignUp(offset, required.Alignment);
+
+        resource.Heap   = required.Heap;
+        resource.Offset = offset;
+        if (m_HeapSizes.size() <= required.Heap)
+            m_HeapSizes.resize(required.Heap + 1, 0);
+        m_HeapSizes[required.Heap] = std::max(m_HeapSizes[required.Heap], offset + required.Size);
+
+        // Whichever of two resources sharing memory comes later has to wait for the other one to be done with it
+        for (const Placement* other : placed)
+        {
+            const RenderGraphResourceData& otherResource = m_Resources[other->Resource];
+            const bool sharesMemory                      = otherResource.Heap == resource.Heap &&
+                                                           otherResource.Offset < offset + required.Size &&
+                                                           offset < otherResource.Offset + other->Requirements.Size;
+            if (!sharesMemory)
+                continue;
+
+            if (otherResource.LastPass < resource.FirstPass)
+                m_AliasedResources[transient.Resource].push_back({other->Resource});
+            else
+                m_AliasedResources[other->Resource].push_back({transient.Resource});
+        }
+
+        placed.push_back(&transient);
+    }
+}
+
+void RenderGraph::BuildBarriers()
+{
+    struct ResourceState
+    {
+        // Layout the resource is in, None while its contents are undefined
+        RenderGraphUsage Layout = RenderGraphUsage::None;
+        // The last write (or layout transition), and the reads since
+        uint64_t WriteAccesses = 0;
+        uint64_t ReadAccesses  = 0;
+        // Accesses the last write has been made visible to
+        uint64_t VisibleAccesses      = 0;
+        bool Defined                  = false;
+        RenderGraphAccess* LastAccess = nullptr;
+    };
+
+    std::vector<ResourceState> states(m_Resources.size());
+    for (uint32_t i = 0; i < m_Resources.size(); i++)
+    {
+        const RenderGraphResourceData& resource = m_Resources[i];
+        if (!resource.Imported || resource.InitialUsage == RenderGraphUsage::None)
+            continue;
+
+        states[i].Layout        = resource.InitialUsage;
+        states[i].WriteAccesses = GetAccessBit(resource.InitialUsage, RenderGraphPassType::Graphics);
+        states[i].Defined       = true;
+    }
+
+    for (uint32_t i = 0; i < m_Passes.size(); i++)
+    {
+        RenderGraphPass& pass = m_Passes[i];
+        pass.Barriers.clear();
+        if (pass.Culled)
+            continue;
+
+        for (RenderGraphAccess& access : pass.Accesses)
+        {
+            const RenderGraphResourceData& resource = m_Resources[access.Resource.Index];
+            ResourceState& state                    = states[access.Resource.Index];
+            const uint64_t bit                      = GetAccessBit(access.Usage, pass.Type);
+
+            // Memory taken over from aliased resources has to be released by them first
+            uint64_t aliasWait = 0;
+            if (i == resource.FirstPass)
+            {
+                for (RenderGraphResource aliased : m_AliasedResources[access.Resource.Index])
+                    aliasWait |= states[aliased.Index].WriteAccesses | states[aliased.Index].ReadAccesses;
+            }
+
+            if (IsAttachment(access.Usage))
+            {
+                if (access.Clear)
+                    access.LoadOp = RenderGraphLoadOp::Clear;
+                else
+                    access.LoadOp = state.Defined ? RenderGraphLoadOp::Load : RenderGraphLoadOp::DontCare;
+            }
+
+            const bool transition = resource.IsTexture && state.Layout != access.Usage;
+            RenderGraphBarrier barrier;
+            barrier.Resource  = access.Resource;
+            barrier.DstAccess = bit;
+            barrier.OldUsage  = state.Defined ? state.Layout : RenderGraphUsage::None;
+            barrier.NewUsage  = access.Usage;
+
+            if (IsWrite(access.Usage))
+            {
+                barrier.SrcAccesses = state.WriteAccesses | state.ReadAccesses | aliasWait;
+                // Cleared attachments are overwritten entirely, their old contents can be discarded
+                if (access.Clear)
+                    barrier.OldUsage = RenderGraphUsage::None;
+                if (barrier.SrcAccesses != 0 || transition)
+                    pass.Barriers.push_back(barrier);
+
+                state.WriteAccesses   = bit;
+                state.ReadAccesses    = 0;
+                state.VisibleAccesses = bit;
+                state.Defined         = true;
+            }
+            else if (transition)
+            {
+                barrier.SrcAccesses = state.WriteAccesses | state.ReadAccesses | aliasWait;
+                pass.Barriers.push_back(barrier);
+
+                // Later accesses synchronize with the transition through this read
+                state.WriteAccesses   = bit;
+                state.ReadAccesses    = 0;
+                state.VisibleAccesses = bit;
+            }
+            else if ((state.VisibleAccesses & bit) == 0 && (state.WriteAccesses | aliasWait) != 0)
+            {
+                // Reads in the same layout share the barrier after the write, as long as it covered their stage
+                barrier.SrcAccesses = state.WriteAccesses | aliasWait;
+                pass.Barriers.push_back(barrier);
+
+                state.ReadAccesses |= bit;
+                state.VisibleAccesses |= bit;
+            }
+            else
+            {
+                state.ReadAccesses |= bit;
+                state.VisibleAccesses |= bit;
+            }
+
+            state.Layout     = access.Usage;
+            state.LastAccess = &access;
+        }
+    }
+
+    m_FinalBarriers.clear();
+    for (uint32_t i = 0; i < m_Resources.size(); i++)
+    {
+        const RenderGraphResourceData& resource = m_Resources[i];
+        ResourceState& state                    = states[i];
+
+        // Contents of transient resources die with the graph, their last attachment use doesn't need to store
+        if (resource.IsTransient() && state.LastAccess && IsAttachment(state.LastAccess->Usage))
+            state.LastAccess->StoreOp = RenderGraphStoreOp::DontCare;
+
+        if (!resource.Imported || resource.FinalUsage == RenderGraphUsage::None)
+            continue;
+
+        RenderGraphBarrier barrier;
+        barrier.Resource    = {i};
+        barrier.SrcAccesses = state.WriteAccesses | state.ReadAccesses;
+        barrier.DstAccess   = GetAccessBit(resource.FinalUsage, RenderGraphPassType::Graphics);
+        barrier.OldUsage    = state.Defined ? state.Layout : RenderGraphUsage::None;
+        barrier.NewUsage    = resource.FinalUsage;
+
+        const bool transition = resource.IsTexture && barrier.OldUsage != barrier.NewUsage;
+        if (barrier.SrcAccesses != 0 || transition)
+            m_FinalBarriers.push_back(barrier);
+    }
+}
+
+bool RenderGraph::IsWrite(RenderGraphUsage usage)
+{
+    switch (usage)
+    {
+        case RenderGraphUsage::ColorAttachment:
+        case RenderGraphUsage::DepthStencilAttachment:
+        case RenderGraphUsage::StorageWrite:
+        case RenderGraphUsage::TransferDst:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool RenderGraph::IsAttachment(RenderGraphUsage usage)
+{
+    return usage == RenderGraphUsage::ColorAttachment || usage == RenderGraphUsage::DepthStencilAttachment ||
+           usage == RenderGraphUsage::DepthStencilRead;
+}
+
+uint64_t RenderGraph::GetAccessBit(RenderGraphUsage usage, RenderGraphPassType type)
+{
+    static_assert(static_cast<uint32_t>(RenderGraphUsage::Count) * static_cast<uint32_t>(RenderGraphPassType::Count) <=
+                      64,
+                  "Accesses don't fit a 64-bit mask");
+    return 1ull << (static_cast<uint32_t>(usage) * static_cast<uint32_t>(RenderGraphPassType::Count) +
+                    static_cast<uint32_t>(type));
+}
+
+void RenderGraph::DecodeAccessBit(uint32_t bit, RenderGraphUsage& usage, RenderGraphPassType& type)
+{
+    usage = static_cast<RenderGraphUsage>(bit / static_cast<uint32_t>(RenderGraphPassType::Count));
+    type  = static_cast<RenderGraphPassType>(bit % static_cast<uint32_t>(RenderGraphPassType::Count));
+}
+
+} // namespace Noctis
@@ -0,0 +1,285 @@
+#pragma once
+
+namespace Noctis
+{
+
+enum class RenderGraphFormat
+{
+    Undefined = 0,
+    RGBA8,
+    BGRA8,
+    RGBA8_SRGB,
+    BGRA8_SRGB,
+    R8,
+    R32F,
+    RG16F,
+    RGBA16F,
+    RGBA32F,
+    Depth32F,
+    Depth24Stencil8
+};
+
+// How a pass accesses a resource. Together with the pass type the backend derives pipeline stages, access masks and
+// image layouts from it.
+enum class RenderGraphUsage : uint32_t
+{
+    None = 0,
+    ColorAttachment,
+    DepthStencilAttachment,
+    // Depth test without depth writes
+    DepthStencilRead,
+    // Sampled image or read only storage buffer
+    ShaderRead,
+    StorageRead,
+    // Covers read-modify-write as well
+    StorageWrite,
+    UniformBuffer,
+    VertexBuffer,
+    IndexBuffer,
+    IndirectBuffer,
+    TransferSrc,
+    TransferDst,
+    // Final usage of the swapchain image
+    Present,
+    Count
+};
+
+enum class RenderGraphPassType : uint32_t
+{
+    Graphics = 0,
+    Compute,
+    Transfer,
+    Count
+};
+
+enum class RenderGraphLoadOp
+{
+    Load = 0,
+    Clear,
+    DontCare
+};
+
+enum class RenderGraphStoreOp
+{
+    Store = 0,
+    DontCare
+};
+
+struct RenderGraphTextureDesc
+{
+    uint32_t Width           = 1;
+    uint32_t Height          = 1;
+    RenderGraphFormat Format = RenderGraphFormat::RGBA8;
+    uint32_t MipLevels       = 1;
+    uint32_t ArrayLayers     = 1;
+    uint32_t Samples         = 1;
+};
+
+struct RenderGraphBufferDesc
+{
+    uint64_t Size = 0;
+};
+
+struct RenderGraphResource
+{
+    uint32_t Index = UINT32_MAX;
+
+    bool IsValid() const { return Index != UINT32_MAX; }
+    bool operator==(const RenderGraphResource& other) const = default;
+};
+
+union RenderGraphClearValue
+{
+    float Color[4];
+    struct
+    {
+        float Depth;
+        uint32_t Stencil;
+    } DepthStencil;
+};
+
+struct RenderGraphAccess
+{
+    RenderGraphResource Resource;
+    RenderGraphUsage Usage = RenderGraphUsage::None;
+
+    // Attachments only
+    RenderGraphLoadOp LoadOp   = RenderGraphLoadOp::Load;
+    RenderGraphStoreOp StoreOp = RenderGraphStoreOp::Store;
+    RenderGraphClearValue ClearValue{};
+    bool Clear = false;
+};
+
+// Execution and memory dependency of an access on the accesses before it, with the image layout transition if the
+// usage changes. Accesses are bits from RenderGraph::GetAccessBit.
+struct RenderGraphBarrier
+{
+    RenderGraphResource Resource;
+    // 0 if there is nothing to wait for, in which case the barrier only has to be ordered after the first
+    // synchronization scope of the destination access (e.g. a swapchain acquire semaphore wait)
+    uint64_t SrcAccesses = 0;
+    uint64_t DstAccess   = 0;
+    // Current layout, None if the contents are undefined and can be discarded
+    RenderGraphUsage OldUsage = RenderGraphUsage::None;
+    RenderGraphUsage NewUsage = RenderGraphUsage::None;
+};
+
+class RenderGraphPassContext;
+using RenderGraphExecuteFn = std::function<void(RenderGraphPassContext&)>;
+
+struct RenderGraphPass
+{
+    // Must outlive the frame (a literal, or Profiler::InternName), it names the pass's GPU profiler region
+    const char* Name         = nullptr;
+    RenderGraphPassType Type = RenderGraphPassType::Graphics;
+    RenderGraphExecuteFn Execute;
+
+    std::vector<RenderGraphAccess> Accesses;
+    // Kept even when nothing reads its outputs, e.g. readbacks
+    bool HasSideEffects = false;
+    // Commands are recorded from several threads through the backend's pass context, the pass's own command list
+    // only stitches the results together
+    bool ParallelRecording = false;
+
+    // Filled in by Compile
+    bool Culled = false;
+    std::vector<RenderGraphBarrier> Barriers;
+};
+
+struct RenderGraphResourceData
+{
+    std::string Name;
+    bool IsTexture = true;
+    bool Imported  = false;
+    RenderGraphTextureDesc Texture;
+    RenderGraphBufferDesc Buffer;
+
+    // Imported resources only: the usage it is in when the graph starts, and the one it has to be left in
+    RenderGraphUsage InitialUsage = RenderGraphUsage::None;
+    RenderGraphUsage FinalUsage   = RenderGraphUsage::None;
+
+    // Filled in by Compile. Unused resources have no first pass and get no memory.
+    uint32_t UsageMask = 0;
+    uint32_t FirstPass = UINT32_MAX;
+    uint32_t LastPass  = 0;
+    uint32_t Heap      = 0;
+    uint64_t Offset    = 0;
+
+    bool IsUsed() const { return FirstPass != UINT32_MAX; }
+    bool IsTransient() const { return !Imported && IsUsed(); }
+};
+
+struct RenderGraphMemoryRequirements
+{
+    uint64_t Size      = 0;
+    uint64_t Alignment = 1;
+    // Resources are only aliased with others in the same heap, e.g. so images and buffers stay apart
+    uint32_t Heap = 0;
+};
+
+class RenderGraph;
+
+class RenderGraphPassBuilder
+{
+  public:
+    RenderGraphPassBuilder(RenderGraph& graph, uint32_t pass) : m_Graph(graph), m_Pass(pass) {}
+
+    RenderGraphPassBuilder& Read(RenderGraphResource resource, RenderGraphUsage usage);
+    RenderGraphPassBuilder& Write(RenderGraphResource resource, RenderGraphUsage usage);
+
+    RenderGraphPassBuilder& ClearColor(RenderGraphResource resource, float r, float g, float b, float a);
+    RenderGraphPassBuilder& ClearDepthStencil(RenderGraphResource resource, float depth, uint32_t stencil = 0);
+
+    RenderGraphPassBuilder& SetSideEffects();
+    RenderGraphPassBuilder& SetParallelRecording();
+
+  private:
+    RenderGraphAccess& AddAccess(RenderGraphResource resource, RenderGraphUsage usage);
+
+  private:
+    RenderGraph& m_Graph;
+    uint32_t m_Pass;
+};
+
+// Frame graph: passes declare the resources they read and write, and Compile works out the rest. Passes whose
+// results nobody uses are culled, barriers and layout transitions are derived from the declared usages (reads that
+// need no transition are batched behind a single barrier), attachment load and store ops skip memory traffic for
+// contents nobody needs, and transient resources whose lifetimes don't overlap share memory.
+//
+// Built every frame, passes run in the order they are added. Executing the compiled graph is up to the backend.
+class RenderGraph
+{
+  public:
+    using MemoryRequirementsFn = std::function<RenderGraphMemoryRequirements(RenderGraphResource)>;
+
+  public:
+    RenderGraphResource CreateTexture(std::string name, const RenderGraphTextureDesc& desc);
+    RenderGraphResource CreateBuffer(std::string name, const RenderGraphBufferDesc& desc);
+    // Resources living outside the graph, like the swapchain image. Writes to them are never culled. The backend
+    // binds the actual resource.
+    RenderGraphResource ImportTexture(std::string name, const RenderGraphTextureDesc& desc,
+                                      RenderGraphUsage initialUsage, RenderGraphUsage finalUsage);
+    RenderGraphResource ImportBuffer(std::string name, const RenderGraphBufferDesc& desc,
+                                     RenderGraphUsage initialUsage, RenderGraphUsage finalUsage);
+
+    RenderGraphPassBuilder AddPass(const char* name, RenderGraphPassType type, RenderGraphExecuteFn execute);
+
+    // getRequirements is called once for every transient resource that survives culling, and may create the
+    // backend resource while at it. Without it transient resources don't share memory.
+    void Compile(const MemoryRequirementsFn& getRequirements = {});
+    bool IsCompiled() const { return m_Compiled; }
+
+    void Reset();
+
+    const std::vector<RenderGraphPass>& GetPasses() const { return m_Passes; }
+    const RenderGraphResourceData& GetResource(RenderGraphResource resource) const
+    {
+        return m_Resources[resource.Index];
+    }
+    uint32_t GetResourceCount() const { return static_cast<uint32_t>(m_Resources.size()); }
+    // Barriers bringing imported resources into their final usage, after the last pass
+    const std::vector<RenderGraphBarrier>& GetFinalBarriers() const { return m_FinalBarriers; }
+    // Size of each heap transient resources are placed in
+    const std::vector<uint64_t>& GetHeapSizes() const { return m_HeapSizes; }
+
+    static bool IsWrite(RenderGraphUsage usage);
+    static bool IsAttachment(RenderGraphUsage usage);
+    static uint64_t GetAccessBit(RenderGraphUsage usage, RenderGraphPassType type);
+    static void DecodeAccessBit(uint32_t bit, RenderGraphUsage& usage, RenderGraphPassType& type);
+
+  private:
+    RenderGraphResource AddResource(RenderGraphResourceData&& data);
+
+    void CullPasses();
+    void ComputeLifetimes();
+    void PlaceTransients(const MemoryRequirementsFn& getRequirements);
+    void BuildBarriers();
+
+  private:
+    std::vector<RenderGraphPass> m_Passes;
+    std::vector<RenderGraphResourceData> m_Resources;
+    std::vector<RenderGraphBarrier> m_FinalBarriers;
+    std::vector<uint64_t> m_HeapSizes;
+    // Per resource, the accesses of the resources whose memory it takes over, which its first use has to wait for
+    std::vector<std::vector<RenderGraphResource>> m_AliasedResources;
+    bool m_Compiled = false;
+
+    friend class RenderGraphPassBuilder;
+};
+
+// Handed to a pass's execute function, the backend's subclass gives access to the command buffer and resources
+class RenderGraphPassContext
+{
+  public:
+    RenderGraphPassContext(const RenderGraph& graph, const RenderGraphPass& pass) : m_Graph(graph), m_Pass(pass) {}
+    virtual ~RenderGraphPassContext() = default;
+
+    const RenderGraph& GetGraph() const { return m_Graph; }
+    const RenderGraphPass& GetPass() const { return m_Pass; }
+
+  protected:
+    const RenderGraph& m_Graph;
+    const RenderGraphPass& m_Pass;
+};
+
+} // namespace Noctis
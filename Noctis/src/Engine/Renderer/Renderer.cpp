@@ -1,4 +1,7 @@
 #include "Renderer.h"
+#include "MeshRenderer.h"
+#include "Renderer2D.h"
+#include "ShaderCompiler.h"
 
 #include "Platform/Vulkan/VulkanContext.h"
 #include "Platform/Vulkan/VulkanRenderer.h"
@@ -25,23 +28,92 @@ static RendererAPI* InitRendererAPI()
 
 void Renderer::Init()
 {
+    NOC_PROFILE_FUNCTION();
+    NOC_MEMORY_SCOPE(Renderer);
+
     s_RendererAPI = InitRendererAPI();
 
     s_RendererAPI->Init();
+
+    ShaderCompiler::Init();
+    MeshRenderer::Init();
+    Renderer2D::Init();
+
+    MemoryTracker::SetDeviceMemoryQuery([]() { return s_RendererAPI->GetDeviceMemoryHeaps(); });
+}
+
+void Renderer::Shutdown()
+{
+    NOC_PROFILE_FUNCTION();
+    NOC_MEMORY_SCOPE(Renderer);
+
+    MemoryTracker::SetDeviceMemoryQuery(nullptr);
+
+    Renderer2D::Shutdown();
+    MeshRenderer::Shutdown();
+    ShaderCompiler::Shutdown();
+
+    s_RendererAPI->Shutdown();
+    delete s_RendererAPI;
+    s_RendererAPI = nullptr;
 }
 
 void Renderer::Render()
 {
-    s_RendererAPI->BeginFrame();
+    NOC_PROFILE_FUNCTION();
+    NOC_MEMORY_SCOPE(Renderer);
+
+    ShaderCompiler::CheckForChanges();
+
+    if (!s_RendererAPI->BeginFrame())
+    {
+        MeshRenderer::Flush(false);
+        Renderer2D::Flush(false);
+        return;
+    }
+
+    // Meshes first, 2D is drawn on top
+    MeshRenderer::Flush(true);
+    Renderer2D::Flush(true);
 
     s_RendererAPI->EndFrame();
 }
 
+void Renderer::OnWindowResize(uint32_t width, uint32_t height)
+{
+    s_RendererAPI->OnWindowResize(width, height);
+}
+
+void Renderer::SetPresentationSettings(const PresentationSettings& settings)
+{
+    s_RendererAPI->SetPresentationSettings(settings);
+}
+
+PresentationSettings Renderer::GetPresentationSettings()
+{
+    return s_RendererAPI->GetPresentationSettings();
+}
+
+void Renderer::SubmitResourceFree(std::function<void()>&& func)
+{
+    s_RendererAPI->SubmitResourceFree(std::move(func));
+}
+
+const std::vector<GPUTiming>& Renderer::GetGPUTimings()
+{
+    return s_RendererAPI->GetGPUTimings();
+}
+
 Ref<RendererContext> Renderer::GetContext()
 {
     return Application::Get().GetWindow().GetRenderContext();
 }
 
+RendererAPI& Renderer::GetRendererAPI()
+{
+    return *s_RendererAPI;
+}
+
 void RendererAPI::SetAPI(API api)
 {
     s_API = api;
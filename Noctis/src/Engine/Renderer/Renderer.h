@@ -15,7 +15,16 @@ class Renderer
 
     static void Render();
 
+    static void OnWindowResize(uint32_t width, uint32_t height);
+
+    static void SetPresentationSettings(const PresentationSettings& settings);
+    static PresentationSettings GetPresentationSettings();
+    static void SubmitResourceFree(std::function<void()>&& func);
+
+    static const std::vector<GPUTiming>& GetGPUTimings();
+
     static Ref<RendererContext> GetContext();
+    static RendererAPI& GetRendererAPI();
     static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
 };
 
@@ -0,0 +1,210 @@
+#include "Renderer2D.h"
+
+#include "Engine/Renderer/RendererAPI.h"
+
+#include "Platform/Vulkan/VulkanRenderer2D.h"
+
+namespace Noctis
+{
+
+namespace
+{
+
+struct Renderer2DData
+{
+    Scope<Renderer2DAPI> API;
+
+    Renderer2DFrame Frame;
+    bool InScene = false;
+
+    // Chunk the current batch writes to, and how many of its instances are taken
+    QuadInstance* Instances = nullptr;
+    uint32_t InstanceCount  = Renderer2D::QUADS_PER_CHUNK;
+
+    Renderer2DStatistics Statistics;
+    Renderer2DStatistics LastFrameStatistics;
+};
+
+Renderer2DData s_Data;
+
+Scope<Renderer2DAPI> CreateRenderer2DAPI()
+{
+    switch (RendererAPI::GetAPI())
+    {
+        case RendererAPI::API::None:
+            break;
+        case RendererAPI::API::Vulkan:
+            return CreateScope<VulkanRenderer2D>();
+    }
+    NOC_CORE_ASSERT(false, "Unknown RendererAPI!");
+    return nullptr;
+}
+
+uint32_t PackColor(const float color[4])
+{
+    uint32_t packed = 0;
+    for (uint32_t i = 0; i < 4; i++)
+        packed |= static_cast<uint32_t>(std::clamp(color[i], 0.0f, 1.0f) * 255.0f + 0.5f) << (i * 8);
+    return packed;
+}
+
+} // namespace
+
+void Renderer2D::Init()
+{
+    NOC_PROFILE_FUNCTION();
+
+    s_Data.API = CreateRenderer2DAPI();
+    s_Data.API->Init();
+}
+
+void Renderer2D::Shutdown()
+{
+    NOC_PROFILE_FUNCTION();
+
+    Flush(false);
+
+    s_Data.API->Shutdown();
+    s_Data.API.reset();
+}
+
+void Renderer2D::BeginScene(const float viewProjection[16])
+{
+    NOC_CORE_ASSERT(!s_Data.InScene, "Renderer2D::BeginScene called twice");
+
+    Renderer2DScene& scene = s_Data.Frame.Scenes.emplace_back();
+    std::copy(viewProjection, viewProjection + 16, scene.ViewProjection);
+
+    s_Data.InScene = true;
+    StartBatch();
+}
+
+void Renderer2D::EndScene()
+{
+    NOC_CORE_ASSERT(s_Data.InScene, "Renderer2D::EndScene called without BeginScene");
+    s_Data.InScene = false;
+}
+
+void Renderer2D::StartBatch()
+{
+    if (s_Data.InstanceCount == QUADS_PER_CHUNK)
+    {
+        s_Data.Frame.Chunks.push_back(s_Data.API->AcquireChunk(s_Data.Instances));
+        s_Data.InstanceCount = 0;
+    }
+
+    // A batch that never got a quad is reused rather than left behind as an empty draw
+    std::vector<Renderer2DBatch>& batches = s_Data.Frame.Batches;
+    if (batches.empty() || batches.back().InstanceCount != 0)
+        batches.emplace_back();
+
+    Renderer2DBatch& batch = batches.back();
+    batch.Scene            = static_cast<uint32_t>(s_Data.Frame.Scenes.size() - 1);
+    batch.Chunk            = s_Data.Frame.Chunks.back();
+    batch.FirstInstance    = s_Data.InstanceCount;
+    batch.InstanceCount    = 0;
+    batch.TextureCount     = 1;
+    batch.Textures[0]      = nullptr;
+}
+
+void Renderer2D::DrawQuad(const Quad2D& quad)
+{
+    NOC_CORE_ASSERT(s_Data.InScene, "Renderer2D::DrawQuad called outside of a scene");
+
+    if (s_Data.InstanceCount == QUADS_PER_CHUNK)
+        StartBatch();
+
+    Renderer2DBatch* batch = &s_Data.Frame.Batches.back();
+
+    uint32_t textureIndex = 0;
+    if (quad.Texture)
+    {
+        const auto begin = batch->Textures.begin();
+        textureIndex     = static_cast<uint32_t>(std::find(begin, begin + batch->TextureCount, quad.Texture) - begin);
+        if (textureIndex == batch->TextureCount)
+        {
+            if (batch->TextureCount == MAX_TEXTURE_SLOTS)
+            {
+                StartBatch();
+                batch        = &s_Data.Frame.Batches.back();
+                textureIndex = 1;
+            }
+            batch->Textures[batch->TextureCount++] = quad.Texture;
+        }
+    }
+
+    QuadInstance& instance = s_Data.Instances[s_Data.InstanceCount++];
+    std::copy(quad.Position, quad.Position + 3, instance.Position);
+    instance.Rotation = quad.Rotation;
+    std::copy(quad.Size, quad.Size + 2, instance.Size);
+    instance.Color        = PackColor(quad.Color);
+    instance.TextureIndex = textureIndex;
+    instance.UVRect[0]    = quad.UVMin[0];
+    instance.UVRect[1]    = quad.UVMin[1];
+    instance.UVRect[2]    = quad.UVMax[0];
+    instance.UVRect[3]    = quad.UVMax[1];
+
+    batch->InstanceCount++;
+    s_Data.Statistics.QuadCount++;
+}
+
+void Renderer2D::DrawRect(float x, float y, float width, float height, float r, float g, float b, float a)
+{
+    Quad2D quad;
+    quad.Position[0] = x;
+    quad.Position[1] = y;
+    quad.Size[0]     = width;
+    quad.Size[1]     = height;
+    quad.Color[0]    = r;
+    quad.Color[1]    = g;
+    quad.Color[2]    = b;
+    quad.Color[3]    = a;
+    DrawQuad(quad);
+}
+
+void Renderer2D::DrawSprite(float x, float y, float width, float height, const Texture2D& texture)
+{
+    Quad2D quad;
+    quad.Position[0] = x;
+    quad.Position[1] = y;
+    quad.Size[0]     = width;
+    quad.Size[1]     = height;
+    quad.Texture     = &texture;
+    DrawQuad(quad);
+}
+
+void Renderer2D::Flush(bool rendered)
+{
+    NOC_PROFILE_FUNCTION();
+
+    NOC_CORE_ASSERT(!s_Data.InScene, "Renderer2D::EndScene was not called before the frame was rendered");
+
+    Renderer2DFrame& frame = s_Data.Frame;
+    if (!frame.Batches.empty() && frame.Batches.back().InstanceCount == 0)
+        frame.Batches.pop_back();
+
+    if (rendered)
+    {
+        s_Data.Statistics.DrawCalls = static_cast<uint32_t>(frame.Batches.size());
+        s_Data.LastFrameStatistics  = s_Data.Statistics;
+        s_Data.API->Render(frame);
+    }
+    else if (!frame.Chunks.empty())
+    {
+        s_Data.API->ReleaseChunks(frame.Chunks);
+    }
+
+    frame.Scenes.clear();
+    frame.Batches.clear();
+    frame.Chunks.clear();
+    s_Data.Instances     = nullptr;
+    s_Data.InstanceCount = QUADS_PER_CHUNK;
+    s_Data.Statistics    = {};
+}
+
+const Renderer2DStatistics& Renderer2D::GetStatistics()
+{
+    return s_Data.LastFrameStatistics;
+}
+
+} // namespace Noctis
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Texture.h"
+
+namespace Noctis
+{
+
+struct Quad2D
+{
+    // Center of the quad, z only matters to the view projection
+    float Position[3] = {0.0f, 0.0f, 0.0f};
+    float Size[2]     = {1.0f, 1.0f};
+    // Radians, counter-clockwise around the center
+    float Rotation = 0.0f;
+    // Multiplied with the texture, linear RGBA
+    float Color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    // nullptr draws a plain colored quad. Must stay alive until the frame is rendered.
+    const Texture2D* Texture = nullptr;
+    float UVMin[2]           = {0.0f, 0.0f};
+    float UVMax[2]           = {1.0f, 1.0f};
+};
+
+// One quad as the GPU reads it, one instance of a four vertex triangle strip
+struct QuadInstance
+{
+    float Position[3];
+    float Rotation;
+    float Size[2];
+    // RGBA8, unpacked by the vertex fetch
+    uint32_t Color;
+    // Slot in the batch's texture table
+    uint32_t TextureIndex;
+    float UVRect[4];
+};
+
+struct Renderer2DStatistics
+{
+    uint32_t DrawCalls = 0;
+    uint32_t QuadCount = 0;
+};
+
+struct Renderer2DScene
+{
+    // Column-major, world to clip space
+    float ViewProjection[16];
+};
+
+// Quads sharing a scene, an instance chunk and a texture table: a single instanced draw
+struct Renderer2DBatch
+{
+    static constexpr uint32_t MAX_TEXTURES = 16;
+
+    uint32_t Scene         = 0;
+    uint32_t Chunk         = 0;
+    uint32_t FirstInstance = 0;
+    uint32_t InstanceCount = 0;
+    // Slot 0 is always the backend's white texture, used by untextured quads. Fixed size, so batches don't allocate.
+    std::array<const Texture2D*, MAX_TEXTURES> Textures = {};
+    uint32_t TextureCount                                = 1;
+};
+
+// Everything drawn in one frame. Cleared rather than freed between frames, so once the vectors have grown to what a
+// frame needs, drawing allocates nothing.
+struct Renderer2DFrame
+{
+    std::vector<Renderer2DScene> Scenes;
+    std::vector<Renderer2DBatch> Batches;
+    std::vector<uint32_t> Chunks;
+};
+
+class Renderer2DAPI
+{
+  public:
+    virtual ~Renderer2DAPI() = default;
+
+    virtual void Init()     = 0;
+    virtual void Shutdown() = 0;
+
+    // Persistently mapped room for Renderer2D::QUADS_PER_CHUNK instances, which the GPU doesn't use until the chunk
+    // is rendered
+    virtual uint32_t AcquireChunk(QuadInstance*& instances) = 0;
+    // Called between BeginFrame and EndFrame, records the frame into the render graph. The chunks are reused once
+    // the GPU is done with them.
+    virtual void Render(Renderer2DFrame& frame) = 0;
+    // For chunks of a frame that is never rendered
+    virtual void ReleaseChunks(const std::vector<uint32_t>& chunks) = 0;
+};
+
+// Batches quads and sprites into instanced draws, written straight into persistently mapped GPU memory. A batch ends
+// when its instance chunk is full or it runs out of texture slots, so a scene with a handful of textures costs a
+// handful of draw calls however many quads it has. Scenes are rendered on top of the frame in submission order.
+//
+// Main thread only. Draw between BeginScene and EndScene anywhere before Renderer::Render, typically in OnUpdate.
+class Renderer2D
+{
+  public:
+    static void Init();
+    static void Shutdown();
+
+    // viewProjection: column-major 4x4 matrix
+    static void BeginScene(const float viewProjection[16]);
+    static void EndScene();
+
+    static void DrawQuad(const Quad2D& quad);
+    static void DrawRect(float x, float y, float width, float height, float r, float g, float b, float a = 1.0f);
+    static void DrawSprite(float x, float y, float width, float height, const Texture2D& texture);
+
+    // Called by Renderer::Render between BeginFrame and EndFrame, or with rendered = false when the frame is skipped
+    static void Flush(bool rendered);
+
+    // Of the last rendered frame
+    static const Renderer2DStatistics& GetStatistics();
+
+    static constexpr uint32_t QUADS_PER_CHUNK   = 65536;
+    static constexpr uint32_t MAX_TEXTURE_SLOTS = Renderer2DBatch::MAX_TEXTURES;
+
+  private:
+    static void StartBatch();
+};
+
+} // namespace Noctis
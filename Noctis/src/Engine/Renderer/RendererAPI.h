@@ -1,8 +1,34 @@
 #pragma once
 
+#include "Engine/Debug/MemoryTracker.h"
+
 namespace Noctis
 {
 
+struct GPUTiming
+{
+    const char* Name;
+    float Milliseconds;
+};
+
+// Ordered from lowest latency to highest throughput. Modes the surface doesn't support fall back towards Fifo, which
+// is always available.
+enum class PresentMode
+{
+    Immediate   = 0,
+    Mailbox     = 1,
+    FifoRelaxed = 2,
+    Fifo        = 3
+};
+
+struct PresentationSettings
+{
+    PresentMode Mode        = PresentMode::Mailbox;
+    uint32_t FramesInFlight = 2;
+    // 0 uses the surface's minimum image count + 1, other values are clamped to what the surface supports
+    uint32_t SwapchainImageCount = 0;
+};
+
 class RendererAPI
 {
   public:
@@ -18,9 +44,26 @@ class RendererAPI
     virtual void Init()     = 0;
     virtual void Shutdown() = 0;
 
-    virtual void BeginFrame() = 0;
+    // Returns false when there is nothing to render into this frame (e.g. the swapchain is out of date), in which
+    // case EndFrame must not be called
+    virtual bool BeginFrame() = 0;
     virtual void EndFrame()   = 0;
 
+    virtual void OnWindowResize(uint32_t width, uint32_t height) = 0;
+
+    // Applied at the start of the next frame
+    virtual void SetPresentationSettings(const PresentationSettings& settings) = 0;
+    virtual PresentationSettings GetPresentationSettings() const               = 0;
+
+    // Runs func once the GPU can no longer be using anything recorded up to the current frame
+    virtual void SubmitResourceFree(std::function<void()>&& func) = 0;
+
+    // GPU time of each profiled region in the most recent frame whose results are available
+    virtual const std::vector<GPUTiming>& GetGPUTimings() const = 0;
+
+    // Device memory per heap, as seen by the renderer's allocator
+    virtual std::vector<DeviceMemoryHeap> GetDeviceMemoryHeaps() const = 0;
+
     static API GetAPI() { return s_API; }
     static void SetAPI(API api);
 
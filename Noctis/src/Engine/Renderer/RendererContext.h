@@ -13,6 +13,10 @@ class RendererContext
 
     virtual void Init()                              = 0;
     virtual void SetWindowHandle(GLFWwindow* window) = 0;
+    virtual void SetVSync(bool enabled)              = 0;
+
+    // Used without a window handle, frames are then rendered into offscreen images of this size
+    virtual void SetOffscreenExtent(uint32_t width, uint32_t height) = 0;
 
     static Ref<RendererContext> Create();
 };
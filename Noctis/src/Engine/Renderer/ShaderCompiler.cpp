@@ -0,0 +1,498 @@
+#include "ShaderCompiler.h"
+
+#include "Engine/Core/FileSystem.h"
+#include "Engine/Core/Hash.h"
+#include "Engine/Core/Timer.h"
+
+#include <shaderc/shaderc.hpp>
+
+#include <cstdio>
+#include <cstring>
+
+// Set from CMake to the revisions of the shaderc and glslang sources and the Vulkan SDK the library comes from
+#ifndef NOC_SHADERC_VERSION
+#define NOC_SHADERC_VERSION "unknown"
+#endif
+
+namespace Noctis
+{
+
+namespace
+{
+
+// Bump when the cache file layout or the way shaders are compiled changes
+constexpr uint32_t SHADER_CACHE_VERSION = 1;
+constexpr uint32_t SHADER_CACHE_MAGIC   = 0x4353504e; // "NPSC"
+
+struct ShaderCacheHeader
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint64_t Key;
+    uint32_t DependencyCount;
+    uint32_t WordCount;
+};
+
+// A file the compilation read, with the content it had and when it was last written at the time
+struct ShaderDependency
+{
+    std::filesystem::path Path;
+    uint64_t ContentHash;
+    std::filesystem::file_time_type WriteTime;
+};
+
+struct ShaderCompilerData
+{
+    std::filesystem::path CacheDirectory;
+    uint64_t CompilerHash = 0;
+
+    std::mutex Mutex;
+    std::unordered_map<uint64_t, Ref<CompiledShader>> Shaders;
+
+    Timer HotReloadTimer;
+    JobCounter ScanCounter;
+};
+
+ShaderCompilerData s_Data;
+
+std::filesystem::file_time_type GetWriteTime(const std::filesystem::path& path)
+{
+    std::error_code error;
+    const std::filesystem::file_time_type time = std::filesystem::last_write_time(path, error);
+    return error ? std::filesystem::file_time_type::min() : time;
+}
+
+// Resolves #include relative to the including file, standard includes fall back to the shader's own directory
+class ShaderIncluder : public shaderc::CompileOptions::IncluderInterface
+{
+  public:
+    ShaderIncluder(std::filesystem::path rootDirectory, std::vector<ShaderDependency>* dependencies)
+        : m_RootDirectory(std::move(rootDirectory)), m_Dependencies(dependencies)
+    {
+    }
+
+    shaderc_include_result* GetInclude(const char* requestedSource, shaderc_include_type type,
+                                       const char* requestingSource, size_t includeDepth) override
+    {
+        auto* include = new IncludeData();
+
+        std::filesystem::path path = std::filesystem::path(requestingSource).parent_path() / requestedSource;
+        if (type == shaderc_include_type_standard && !std::filesystem::exists(path))
+            path = m_RootDirectory / requestedSource;
+
+        const std::filesystem::file_time_type writeTime = GetWriteTime(path);
+        if (FileSystem::ReadTextFile(path, include->Content))
+        {
+            include->Name = path.lexically_normal().generic_string();
+            if (m_Dependencies)
+                m_Dependencies->push_back({path, Hash::FNV1a(include->Content), writeTime});
+        }
+        else
+        {
+            // An empty source name tells shaderc the include failed, the content is the error message
+            include->Content = "Cannot open include file " + path.generic_string();
+        }
+
+        include->Result.source_name        = include->Name.c_str();
+        include->Result.source_name_length = include->Name.size();
+        include->Result.content            = include->Content.c_str();
+        include->Result.content_length     = include->Content.size();
+        include->Result.user_data          = include;
+        return &include->Result;
+    }
+
+    void ReleaseInclude(shaderc_include_result* data) override { delete static_cast<IncludeData*>(data->user_data); }
+
+  private:
+    struct IncludeData
+    {
+        std::string Name;
+        std::string Content;
+        shaderc_include_result Result;
+    };
+
+    std::filesystem::path m_RootDirectory;
+    std::vector<ShaderDependency>* m_Dependencies;
+};
+
+shaderc_shader_kind GetShaderKind(ShaderStage stage, const std::filesystem::path& path)
+{
+    if (stage == ShaderStage::Auto)
+    {
+        static const std::unordered_map<std::string, ShaderStage> extensions = {
+            {".vert", ShaderStage::Vertex},      {".frag", ShaderStage::Fragment},
+            {".comp", ShaderStage::Compute},     {".geom", ShaderStage::Geometry},
+            {".tesc", ShaderStage::TessControl}, {".tese", ShaderStage::TessEvaluation}};
+
+        auto it = extensions.find(path.extension().string());
+        NOC_CORE_ASSERT(it != extensions.end(), "Can't deduce the shader stage from the file extension!");
+        stage = it != extensions.end() ? it->second : ShaderStage::Vertex;
+    }
+
+    switch (stage)
+    {
+        case ShaderStage::Auto:
+        case ShaderStage::Vertex:
+            return shaderc_vertex_shader;
+        case ShaderStage::Fragment:
+            return shaderc_fragment_shader;
+        case ShaderStage::Compute:
+            return shaderc_compute_shader;
+        case ShaderStage::Geometry:
+            return shaderc_geometry_shader;
+        case ShaderStage::TessControl:
+            return shaderc_tess_control_shader;
+        case ShaderStage::TessEvaluation:
+            return shaderc_tess_evaluation_shader;
+    }
+    return shaderc_vertex_shader;
+}
+
+bool IsHLSL(const std::filesystem::path& path)
+{
+    return path.extension() == ".hlsl";
+}
+
+uint64_t HashOptions(const std::filesystem::path& path, const ShaderCompileOptions& options)
+{
+    uint64_t hash = Hash::FNV1a(path.lexically_normal().generic_string());
+    hash          = Hash::Combine(hash, static_cast<uint64_t>(options.Stage));
+    hash          = Hash::Combine(hash, Hash::FNV1a(options.EntryPoint));
+    for (const auto& [name, value] : options.Defines)
+    {
+        hash = Hash::Combine(hash, Hash::FNV1a(name));
+        hash = Hash::Combine(hash, Hash::FNV1a(value));
+    }
+    hash = Hash::Combine(hash, options.Optimize);
+    hash = Hash::Combine(hash, options.GenerateDebugInfo);
+    return hash;
+}
+
+std::vector<uint32_t> CompileSource(const std::filesystem::path& path, const std::string& source,
+                                    const ShaderCompileOptions& options, std::vector<ShaderDependency>* dependencies)
+{
+    NOC_PROFILE_FUNCTION();
+
+    shaderc::CompileOptions compileOptions;
+    compileOptions.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_2);
+    compileOptions.SetSourceLanguage(IsHLSL(path) ? shaderc_source_language_hlsl : shaderc_source_language_glsl);
+    compileOptions.SetOptimizationLevel(options.Optimize ? shaderc_optimization_level_performance
+                                                         : shaderc_optimization_level_zero);
+    if (options.GenerateDebugInfo)
+        compileOptions.SetGenerateDebugInfo();
+    for (const auto& [name, value] : options.Defines)
+        compileOptions.AddMacroDefinition(name, value);
+    compileOptions.SetIncluder(CreateScope<ShaderIncluder>(path.parent_path(), dependencies));
+
+    // The compiler object is cheap, one per compilation keeps concurrent jobs independent
+    shaderc::Compiler compiler;
+    const std::string filename                 = path.generic_string();
+    const shaderc::SpvCompilationResult result = compiler.CompileGlslToSpv(
+        source, GetShaderKind(options.Stage, path), filename.c_str(), options.EntryPoint.c_str(), compileOptions);
+
+    if (result.GetCompilationStatus() != shaderc_compilation_status_success)
+    {
+        NOC_CORE_ERROR("Failed to compile shader {0}:\n{1}", filename, result.GetErrorMessage());
+        return {};
+    }
+
+    if (result.GetNumWarnings() > 0)
+        NOC_CORE_WARN("Shader {0}:\n{1}", filename, result.GetErrorMessage());
+
+    return std::vector<uint32_t>(result.cbegin(), result.cend());
+}
+
+// Cache hit only if every include still has the content the cached SPIR-V was compiled from
+bool ReadCache(const std::filesystem::path& cachePath, uint64_t key, std::vector<uint32_t>& spirv,
+               std::vector<ShaderDependency>& dependencies)
+{
+    std::vector<uint8_t> file;
+    if (!FileSystem::ReadFile(cachePath, file))
+        return false;
+
+    size_t offset = 0;
+    auto read     = [&](void* dst, size_t size) {
+        if (offset + size > file.size())
+            return false;
+        std::memcpy(dst, file.data() + offset, size);
+        offset += size;
+        return true;
+    };
+
+    // Sizes are checked against the file before anything is allocated from them, a corrupt file is only a miss
+    ShaderCacheHeader header;
+    if (!read(&header, sizeof(header)) || header.Magic != SHADER_CACHE_MAGIC ||
+        header.Version != SHADER_CACHE_VERSION || header.Key != key ||
+        sizeof(header) + static_cast<uint64_t>(header.WordCount) * sizeof(uint32_t) > file.size())
+        return false;
+
+    for (uint32_t i = 0; i < header.DependencyCount; i++)
+    {
+        uint32_t pathLength;
+        if (!read(&pathLength, sizeof(pathLength)) || pathLength > file.size() - offset)
+            return false;
+
+        std::string pathString(pathLength, '\0');
+        uint64_t contentHash;
+        if (!read(pathString.data(), pathLength) || !read(&contentHash, sizeof(contentHash)))
+            return false;
+
+        const std::filesystem::path path                = pathString;
+        const std::filesystem::file_time_type writeTime = GetWriteTime(path);
+
+        std::string content;
+        if (!FileSystem::ReadTextFile(path, content) || Hash::FNV1a(content) != contentHash)
+            return false;
+
+        dependencies.push_back({path, contentHash, writeTime});
+    }
+
+    spirv.resize(header.WordCount);
+    return read(spirv.data(), spirv.size() * sizeof(uint32_t)) && !spirv.empty();
+}
+
+void WriteCache(const std::filesystem::path& cachePath, uint64_t key, const std::vector<uint32_t>& spirv,
+                const std::vector<ShaderDependency>& dependencies)
+{
+    std::vector<uint8_t> file;
+    auto write = [&](const void* src, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(src);
+        file.insert(file.end(), bytes, bytes + size);
+    };
+
+    ShaderCacheHeader header{};
+    header.Magic           = SHADER_CACHE_MAGIC;
+    header.Version         = SHADER_CACHE_VERSION;
+    header.Key             = key;
+    header.DependencyCount = static_cast<uint32_t>(dependencies.size());
+    header.WordCount       = static_cast<uint32_t>(spirv.size());
+    write(&header, sizeof(header));
+
+    for (const ShaderDependency& dependency : dependencies)
+    {
+        const std::string path = dependency.Path.generic_string();
+        const uint32_t length  = static_cast<uint32_t>(path.size());
+        write(&length, sizeof(length));
+        write(path.data(), path.size());
+        write(&dependency.ContentHash, sizeof(dependency.ContentHash));
+    }
+
+    write(spirv.data(), spirv.size() * sizeof(uint32_t));
+
+    FileSystem::WriteFileAtomic(cachePath, file.data(), file.size());
+}
+
+} // namespace
+
+CompiledShader::CompiledShader(const std::filesystem::path& path, const ShaderCompileOptions& options)
+    : m_Path(path), m_Options(options)
+{
+}
+
+Ref<const std::vector<uint32_t>> CompiledShader::GetSPIRV() const
+{
+    std::lock_guard lock(m_Mutex);
+    return m_SPIRV;
+}
+
+void CompiledShader::SetSPIRV(Ref<const std::vector<uint32_t>> spirv, DependencyList dependencies)
+{
+    std::lock_guard lock(m_Mutex);
+    m_Dependencies = std::move(dependencies);
+    if (spirv)
+    {
+        m_SPIRV = std::move(spirv);
+        m_Version.fetch_add(1, std::memory_order_release);
+    }
+}
+
+void ShaderCompiler::Init(const std::filesystem::path& cacheDirectory)
+{
+    NOC_PROFILE_FUNCTION();
+
+    s_Data.CacheDirectory = cacheDirectory;
+
+    unsigned int spirvVersion  = 0;
+    unsigned int spirvRevision = 0;
+    shaderc_get_spv_version(&spirvVersion, &spirvRevision);
+
+    // The SPIR-V version is only what the compiler targets, a compiler upgrade keeping it must still miss the cache
+    uint64_t compilerHash = Hash::Combine(SHADER_CACHE_VERSION, Hash::FNV1a(NOC_SHADERC_VERSION));
+    compilerHash          = Hash::Combine(Hash::Combine(compilerHash, spirvVersion), spirvRevision);
+    s_Data.CompilerHash   = compilerHash;
+    s_Data.HotReloadTimer.Reset();
+
+    NOC_CORE_INFO("ShaderCompiler: shaderc {0}, SPIR-V {1}.{2}, cache in {3}", NOC_SHADERC_VERSION, spirvVersion >> 16,
+                  (spirvVersion >> 8) & 0xff, s_Data.CacheDirectory.string());
+}
+
+void ShaderCompiler::Shutdown()
+{
+    NOC_PROFILE_FUNCTION();
+
+    JobSystem::Wait(s_Data.ScanCounter);
+
+    // Waiting runs other jobs, which may load shaders themselves, so not under the lock
+    std::unordered_map<uint64_t, Ref<CompiledShader>> shaders;
+    {
+        std::lock_guard lock(s_Data.Mutex);
+        shaders.swap(s_Data.Shaders);
+    }
+    for (auto& [key, shader] : shaders)
+        shader->Wait();
+}
+
+Ref<CompiledShader> ShaderCompiler::Load(const std::filesystem::path& path, const ShaderCompileOptions& options)
+{
+    NOC_MEMORY_SCOPE(Assets);
+
+    const uint64_t key = HashOptions(path, options);
+
+    Ref<CompiledShader> shader;
+    {
+        std::lock_guard lock(s_Data.Mutex);
+        Ref<CompiledShader>& entry = s_Data.Shaders[key];
+        if (entry)
+            return entry;
+
+        entry  = CreateRef<CompiledShader>(path, options);
+        shader = entry;
+    }
+
+    QueueCompile(shader);
+    return shader;
+}
+
+std::vector<uint32_t> ShaderCompiler::Compile(const std::filesystem::path& path, const ShaderCompileOptions& options,
+                                              std::vector<std::filesystem::path>* dependencies)
+{
+    std::string source;
+    if (!FileSystem::ReadTextFile(path, source))
+    {
+        NOC_CORE_ERROR("Failed to read shader {0}", path.string());
+        return {};
+    }
+
+    std::vector<ShaderDependency> includes;
+    std::vector<uint32_t> spirv = CompileSource(path, source, options, &includes);
+
+    if (dependencies)
+    {
+        for (ShaderDependency& include : includes)
+            dependencies->push_back(std::move(include.Path));
+    }
+    return spirv;
+}
+
+void ShaderCompiler::CheckForChanges()
+{
+    if (s_Data.HotReloadTimer.Elapsed() < HOT_RELOAD_INTERVAL || !s_Data.ScanCounter.IsDone())
+        return;
+
+    s_Data.HotReloadTimer.Reset();
+    JobSystem::Execute(ScanForChanges, &s_Data.ScanCounter);
+}
+
+void ShaderCompiler::QueueCompile(const Ref<CompiledShader>& shader)
+{
+    // A change while the job runs is picked up by the next scan, the job records the write times from before it read
+    if (shader->m_Compiling.exchange(true))
+        return;
+
+    JobSystem::Execute(
+        [shader]() {
+            CompileJob(shader);
+            shader->m_Compiling = false;
+        },
+        &shader->m_Counter);
+}
+
+void ShaderCompiler::CompileJob(const Ref<CompiledShader>& shader)
+{
+    NOC_PROFILE_FUNCTION();
+
+    const std::filesystem::path& path = shader->GetPath();
+
+    // Taken before reading, so a save while the job runs still counts as a change
+    const std::filesystem::file_time_type writeTime = GetWriteTime(path);
+
+    std::string source;
+    if (!FileSystem::ReadTextFile(path, source))
+    {
+        NOC_CORE_ERROR("Failed to read shader {0}", path.string());
+        shader->SetSPIRV(nullptr, {{path, writeTime}});
+        return;
+    }
+
+    const uint64_t key =
+        Hash::Combine(Hash::Combine(HashOptions(path, shader->GetOptions()), Hash::FNV1a(source)), s_Data.CompilerHash);
+
+    char keyString[17];
+    std::snprintf(keyString, sizeof(keyString), "%016llx", static_cast<unsigned long long>(key));
+    const std::filesystem::path cachePath = s_Data.CacheDirectory / (std::string(keyString) + ".spv");
+
+    std::vector<uint32_t> spirv;
+    std::vector<ShaderDependency> includes;
+    const bool cached = ReadCache(cachePath, key, spirv, includes);
+    if (!cached)
+    {
+        includes.clear();
+        spirv = CompileSource(path, source, shader->GetOptions(), &includes);
+        if (!spirv.empty())
+            WriteCache(cachePath, key, spirv, includes);
+    }
+
+    CompiledShader::DependencyList dependencies = {{path, writeTime}};
+    for (ShaderDependency& include : includes)
+        dependencies.emplace_back(std::move(include.Path), include.WriteTime);
+
+    if (spirv.empty())
+    {
+        // Keep the previous SPIR-V, but watch the files so fixing the error triggers another attempt
+        shader->SetSPIRV(nullptr, std::move(dependencies));
+        return;
+    }
+
+    NOC_CORE_TRACE("Shader {0} {1}", path.string(), cached ? "loaded from cache" : "compiled");
+    shader->SetSPIRV(CreateRef<const std::vector<uint32_t>>(std::move(spirv)), std::move(dependencies));
+}
+
+void ShaderCompiler::ScanForChanges()
+{
+    NOC_PROFILE_FUNCTION();
+
+    std::vector<Ref<CompiledShader>> shaders;
+    {
+        std::lock_guard lock(s_Data.Mutex);
+        shaders.reserve(s_Data.Shaders.size());
+        for (auto& [key, shader] : s_Data.Shaders)
+            shaders.push_back(shader);
+    }
+
+    for (const Ref<CompiledShader>& shader : shaders)
+    {
+        if (shader->m_Compiling)
+            continue;
+
+        bool changed = false;
+        {
+            std::lock_guard lock(shader->m_Mutex);
+            for (const auto& [path, writeTime] : shader->m_Dependencies)
+            {
+                if (GetWriteTime(path) != writeTime)
+                {
+                    changed = true;
+                    break;
+                }
+            }
+        }
+
+        if (changed)
+        {
+            NOC_CORE_INFO("Shader {0} changed, recompiling", shader->GetPath().string());
+            QueueCompile(shader);
+        }
+    }
+}
+
+} // namespace Noctis
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Engine/Core/JobSystem.h"
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+
+namespace Noctis
+{
+
+enum class ShaderStage
+{
+    // Deduced from the file extension (.vert, .frag, .comp, .geom, .tesc, .tese)
+    Auto = 0,
+    Vertex,
+    Fragment,
+    Compute,
+    Geometry,
+    TessControl,
+    TessEvaluation
+};
+
+struct ShaderCompileOptions
+{
+    // Required for .hlsl files, which may contain any stage
+    ShaderStage Stage      = ShaderStage::Auto;
+    std::string EntryPoint = "main";
+    std::vector<std::pair<std::string, std::string>> Defines;
+    bool Optimize          = true;
+    bool GenerateDebugInfo = false;
+};
+
+// SPIR-V of a shader file, recompiled in the background whenever the file or one of its includes changes. The binary
+// is swapped atomically: holders of the old one keep it alive, pipelines compare GetVersion() to notice new ones.
+class CompiledShader
+{
+  public:
+    // The source and every file it includes, with the write times they were compiled from
+    using DependencyList = std::vector<std::pair<std::filesystem::path, std::filesystem::file_time_type>>;
+
+  public:
+    CompiledShader(const std::filesystem::path& path, const ShaderCompileOptions& options);
+
+    // nullptr until the first compilation finished, and stays so if it failed
+    Ref<const std::vector<uint32_t>> GetSPIRV() const;
+    // Bumped every time new SPIR-V is swapped in, 0 while nothing is available
+    uint64_t GetVersion() const { return m_Version.load(std::memory_order_acquire); }
+    bool IsReady() const { return GetVersion() != 0; }
+    // Blocks until pending compilations finished, helping with other jobs meanwhile
+    void Wait() { JobSystem::Wait(m_Counter); }
+
+    const std::filesystem::path& GetPath() const { return m_Path; }
+    const ShaderCompileOptions& GetOptions() const { return m_Options; }
+
+  private:
+    void SetSPIRV(Ref<const std::vector<uint32_t>> spirv, DependencyList dependencies);
+
+  private:
+    std::filesystem::path m_Path;
+    ShaderCompileOptions m_Options;
+
+    mutable std::mutex m_Mutex;
+    Ref<const std::vector<uint32_t>> m_SPIRV;
+    std::atomic<uint64_t> m_Version = 0;
+
+    DependencyList m_Dependencies;
+    std::atomic<bool> m_Compiling = false;
+    JobCounter m_Counter;
+
+    friend class ShaderCompiler;
+};
+
+// Compiles GLSL and HLSL to SPIR-V with shaderc on job threads. Results are cached on disk under a hash of the
+// source, its includes, the defines and options, and the compiler version, so unchanged shaders are never rebuilt.
+class ShaderCompiler
+{
+  public:
+    static void Init(const std::filesystem::path& cacheDirectory = "cache/shaders");
+    // Waits for compilations still running
+    static void Shutdown();
+
+    // Returns immediately, the SPIR-V shows up once the cache lookup or compilation job finished. Loading the same
+    // file with the same options again returns the same shader.
+    static Ref<CompiledShader> Load(const std::filesystem::path& path, const ShaderCompileOptions& options = {});
+
+    // Synchronous compilation, no caching. Returns an empty vector on failure and logs the errors.
+    static std::vector<uint32_t> Compile(const std::filesystem::path& path, const ShaderCompileOptions& options,
+                                         std::vector<std::filesystem::path>* dependencies = nullptr);
+
+    // Queues recompilation of shaders whose files changed on disk. Cheap enough to call every frame: the file
+    // system is checked from a job at most every HOT_RELOAD_INTERVAL seconds.
+    static void CheckForChanges();
+
+    static constexpr float HOT_RELOAD_INTERVAL = 0.5f;
+
+  private:
+    static void QueueCompile(const Ref<CompiledShader>& shader);
+    static void CompileJob(const Ref<CompiledShader>& shader);
+    static void ScanForChanges();
+};
+
+} // namespace Noctis
@@ -0,0 +1,26 @@
+#include "Texture.h"
+
+#include "Engine/Renderer/RendererAPI.h"
+
+#include "Platform/Vulkan/VulkanTexture.h"
+
+namespace Noctis
+{
+
+Ref<Texture2D> Texture2D::Create(uint32_t width, uint32_t height, const void* pixels)
+{
+    NOC_MEMORY_SCOPE(Assets);
+
+    switch (RendererAPI::GetAPI())
+    {
+        case RendererAPI::API::None:
+            NOC_CORE_ASSERT(false, "RendererAPI::None is not supported!");
+            return nullptr;
+        case RendererAPI::API::Vulkan:
+            return CreateRef<VulkanTexture2D>(width, height, pixels);
+    }
+    NOC_CORE_ASSERT(false, "Unknown RendererAPI!")
+    return nullptr;
+}
+
+} // namespace Noctis
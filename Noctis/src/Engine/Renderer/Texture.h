@@ -0,0 +1,18 @@
+#pragma once
+
+namespace Noctis
+{
+
+class Texture2D
+{
+  public:
+    virtual ~Texture2D() = default;
+
+    virtual uint32_t GetWidth() const  = 0;
+    virtual uint32_t GetHeight() const = 0;
+
+    // pixels are tightly packed 8 bit sRGB RGBA rows. The upload is asynchronous, pixels can be freed on return.
+    static Ref<Texture2D> Create(uint32_t width, uint32_t height, const void* pixels);
+};
+
+} // namespace Noctis
@@ -0,0 +1,367 @@
+#include "TransformHierarchy.h"
+
+#include "Engine/Core/JobSystem.h"
+
+namespace Noctis
+{
+
+TransformHandle TransformHierarchy::CreateNode(TransformHandle parent, const Vec3& translation, const Quat& rotation,
+                                               const Vec3& scale)
+{
+    NOC_CORE_ASSERT(!parent.IsValid() || IsAlive(parent), "TransformHierarchy: the parent has been destroyed!");
+    const uint32_t parentIndex = parent.IsValid() ? parent.Index : INVALID_INDEX;
+
+    uint32_t index;
+    if (!m_FreeIndices.empty())
+    {
+        index = m_FreeIndices.back();
+        m_FreeIndices.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_Records.size());
+        m_Records.emplace_back();
+    }
+
+    NodeRecord& record = m_Records[index];
+    record.Slot        = static_cast<uint32_t>(m_NodeIndices.size());
+    Link(index, parentIndex);
+
+    m_Translations.push_back(translation);
+    m_Rotations.push_back(rotation);
+    m_Scales.push_back(scale);
+    m_WorldMatrices.emplace_back();
+    m_ParentSlots.push_back(INVALID_INDEX);
+    m_NodeIndices.push_back(index);
+    m_LocalDirty.push_back(1);
+    m_WorldChanged.push_back(0);
+
+    m_StructureDirty = true;
+    m_NodeCount++;
+    return {index, record.Generation};
+}
+
+void TransformHierarchy::DestroyNode(TransformHandle node)
+{
+    NOC_CORE_ASSERT(IsAlive(node), "TransformHierarchy: the node has been destroyed!");
+    Unlink(node.Index);
+    DestroySubtree(node.Index);
+    m_StructureDirty = true;
+}
+
+bool TransformHierarchy::IsAlive(TransformHandle node) const
+{
+    if (node.Index >= m_Records.size())
+        return false;
+
+    const NodeRecord& record = m_Records[node.Index];
+    return record.Slot != INVALID_INDEX && record.Generation == node.Generation;
+}
+
+void TransformHierarchy::SetParent(TransformHandle node, TransformHandle parent)
+{
+    NodeRecord& record = GetRecord(node);
+    if (parent.IsValid())
+    {
+        NOC_CORE_ASSERT(IsAlive(parent), "TransformHierarchy: the parent has been destroyed!");
+        for (uint32_t ancestor = parent.Index; ancestor != INVALID_INDEX; ancestor = m_Records[ancestor].Parent)
+            NOC_CORE_ASSERT(ancestor != node.Index, "TransformHierarchy::SetParent: parenting under a descendant!");
+    }
+
+    Unlink(node.Index);
+    Link(node.Index, parent.IsValid() ? parent.Index : INVALID_INDEX);
+    m_StructureDirty = true;
+    MarkDirty(record);
+}
+
+TransformHandle TransformHierarchy::GetParent(TransformHandle node) const
+{
+    const uint32_t parent = GetRecord(node).Parent;
+    return parent != INVALID_INDEX ? TransformHandle{parent, m_Records[parent].Generation} : TransformHandle();
+}
+
+void TransformHierarchy::SetLocalTransform(TransformHandle node, const Vec3& translation, const Quat& rotation,
+                                           const Vec3& scale)
+{
+    const NodeRecord& record    = GetRecord(node);
+    m_Translations[record.Slot] = translation;
+    m_Rotations[record.Slot]    = rotation;
+    m_Scales[record.Slot]       = scale;
+    MarkDirty(record);
+}
+
+void TransformHierarchy::SetLocalTranslation(TransformHandle node, const Vec3& translation)
+{
+    const NodeRecord& record    = GetRecord(node);
+    m_Translations[record.Slot] = translation;
+    MarkDirty(record);
+}
+
+void TransformHierarchy::SetLocalRotation(TransformHandle node, const Quat& rotation)
+{
+    const NodeRecord& record = GetRecord(node);
+    m_Rotations[record.Slot] = rotation;
+    MarkDirty(record);
+}
+
+void TransformHierarchy::SetLocalScale(TransformHandle node, const Vec3& scale)
+{
+    const NodeRecord& record = GetRecord(node);
+    m_Scales[record.Slot]    = scale;
+    MarkDirty(record);
+}
+
+const Vec3& TransformHierarchy::GetLocalTranslation(TransformHandle node) const
+{
+    return m_Translations[GetRecord(node).Slot];
+}
+
+const Quat& TransformHierarchy::GetLocalRotation(TransformHandle node) const
+{
+    return m_Rotations[GetRecord(node).Slot];
+}
+
+const Vec3& TransformHierarchy::GetLocalScale(TransformHandle node) const
+{
+    return m_Scales[GetRecord(node).Slot];
+}
+
+const Mat4& TransformHierarchy::GetWorldMatrix(TransformHandle node) const
+{
+    return m_WorldMatrices[GetRecord(node).Slot];
+}
+
+bool TransformHierarchy::HasWorldChanged(TransformHandle node) const
+{
+    return m_WorldChanged[GetRecord(node).Slot] != 0;
+}
+
+void TransformHierarchy::Update()
+{
+    NOC_PROFILE_FUNCTION();
+    NOC_MEMORY_SCOPE(Scene);
+
+    if (m_StructureDirty)
+        Rebuild();
+
+    for (const SlotRange& range : m_ChangedRanges)
+        std::fill(m_WorldChanged.begin() + range.Begin, m_WorldChanged.begin() + range.End, 0);
+    m_ChangedRanges.clear();
+
+    if (m_DirtySlots.empty())
+        return;
+
+    // Slot order is level order
+    std::sort(m_DirtySlots.begin(), m_DirtySlots.end());
+
+    size_t dirty   = 0;
+    uint32_t level = static_cast<uint32_t>(
+        std::upper_bound(m_LevelStarts.begin(), m_LevelStarts.end(), m_DirtySlots.front()) - m_LevelStarts.begin() - 1);
+    m_LevelRanges.clear();
+    for (; level < GetDepthCount() && (dirty < m_DirtySlots.size() || !m_LevelRanges.empty()); level++)
+    {
+        // Dirty nodes under a changed parent are in the range of its children already
+        for (; dirty < m_DirtySlots.size() && m_DirtySlots[dirty] < m_LevelStarts[level + 1]; dirty++)
+        {
+            const uint32_t slot   = m_DirtySlots[dirty];
+            const uint32_t parent = m_ParentSlots[slot];
+            if (parent == INVALID_INDEX || !m_WorldChanged[parent])
+                m_LevelRanges.push_back({slot, slot + 1});
+        }
+
+        UpdateLevel();
+
+        m_NextRanges.clear();
+        for (const SlotRange& range : m_LevelRanges)
+        {
+            m_ChangedRanges.push_back(range);
+
+            const SlotRange children = {m_ChildStarts[range.Begin], m_ChildStarts[range.End]};
+            if (children.Begin != children.End)
+                m_NextRanges.push_back(children);
+        }
+        std::swap(m_LevelRanges, m_NextRanges);
+    }
+
+    m_DirtySlots.clear();
+}
+
+TransformHierarchy::NodeRecord& TransformHierarchy::GetRecord(TransformHandle node)
+{
+    NOC_CORE_ASSERT(IsAlive(node), "TransformHierarchy: the node has been destroyed!");
+    return m_Records[node.Index];
+}
+
+const TransformHierarchy::NodeRecord& TransformHierarchy::GetRecord(TransformHandle node) const
+{
+    NOC_CORE_ASSERT(IsAlive(node), "TransformHierarchy: the node has been destroyed!");
+    return m_Records[node.Index];
+}
+
+void TransformHierarchy::Link(uint32_t node, uint32_t parent)
+{
+    NodeRecord& record = m_Records[node];
+    uint32_t& first    = parent != INVALID_INDEX ? m_Records[parent].FirstChild : m_FirstRoot;
+
+    record.Parent      = parent;
+    record.PrevSibling = INVALID_INDEX;
+    record.NextSibling = first;
+    record.Depth       = parent != INVALID_INDEX ? m_Records[parent].Depth + 1 : 0;
+    if (first != INVALID_INDEX)
+        m_Records[first].PrevSibling = node;
+    first = node;
+}
+
+void TransformHierarchy::Unlink(uint32_t node)
+{
+    NodeRecord& record = m_Records[node];
+    if (record.PrevSibling != INVALID_INDEX)
+        m_Records[record.PrevSibling].NextSibling = record.NextSibling;
+    else if (record.Parent != INVALID_INDEX)
+        m_Records[record.Parent].FirstChild = record.NextSibling;
+    else
+        m_FirstRoot = record.NextSibling;
+
+    if (record.NextSibling != INVALID_INDEX)
+        m_Records[record.NextSibling].PrevSibling = record.PrevSibling;
+
+    record.Parent      = INVALID_INDEX;
+    record.PrevSibling = INVALID_INDEX;
+    record.NextSibling = INVALID_INDEX;
+}
+
+void TransformHierarchy::DestroySubtree(uint32_t node)
+{
+    std::vector<uint32_t> stack = {node};
+    while (!stack.empty())
+    {
+        const uint32_t index = stack.back();
+        stack.pop_back();
+
+        NodeRecord& record = m_Records[index];
+        for (uint32_t child = record.FirstChild; child != INVALID_INDEX; child = m_Records[child].NextSibling)
+            stack.push_back(child);
+
+        // The slot is left behind until the next rebuild
+        m_NodeIndices[record.Slot] = INVALID_INDEX;
+
+        record = {.Generation = record.Generation + 1};
+        m_FreeIndices.push_back(index);
+        m_NodeCount--;
+    }
+}
+
+void TransformHierarchy::MarkDirty(const NodeRecord& record)
+{
+    // Slots are stale after structural changes, the rebuild collects the dirty ones instead
+    if (!m_LocalDirty[record.Slot] && !m_StructureDirty)
+        m_DirtySlots.push_back(record.Slot);
+    m_LocalDirty[record.Slot] = 1;
+}
+
+void TransformHierarchy::Rebuild()
+{
+    NOC_PROFILE_FUNCTION();
+
+    // Breadth first from the roots, which visits depths in increasing order and appends siblings together
+    std::vector<uint32_t> order;
+    order.reserve(m_NodeCount);
+    m_ChildStarts.resize(m_NodeCount + 1);
+    for (uint32_t root = m_FirstRoot; root != INVALID_INDEX; root = m_Records[root].NextSibling)
+        order.push_back(root);
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        m_ChildStarts[i] = static_cast<uint32_t>(order.size());
+        for (uint32_t child = m_Records[order[i]].FirstChild; child != INVALID_INDEX;
+             child = m_Records[child].NextSibling)
+            order.push_back(child);
+    }
+    NOC_CORE_ASSERT(order.size() == m_NodeCount, "TransformHierarchy: nodes unreachable from the roots!");
+    m_ChildStarts[m_NodeCount] = m_NodeCount;
+
+    std::vector<Vec3> translations(order.size());
+    std::vector<Quat> rotations(order.size());
+    std::vector<Vec3> scales(order.size());
+    std::vector<Mat4> worldMatrices(order.size());
+    std::vector<uint32_t> parentSlots(order.size());
+    std::vector<uint8_t> localDirty(order.size());
+
+    m_LevelStarts.assign(1, 0);
+    m_DirtySlots.clear();
+    for (uint32_t slot = 0; slot < order.size(); slot++)
+    {
+        NodeRecord& record    = m_Records[order[slot]];
+        const uint32_t parent = record.Parent;
+        record.Depth          = parent != INVALID_INDEX ? m_Records[parent].Depth + 1 : 0;
+        // Parents come first, so theirs has been moved already
+        parentSlots[slot] = parent != INVALID_INDEX ? m_Records[parent].Slot : INVALID_INDEX;
+
+        while (m_LevelStarts.size() <= record.Depth + 1)
+            m_LevelStarts.push_back(slot);
+        m_LevelStarts.back() = slot + 1;
+
+        translations[slot]  = m_Translations[record.Slot];
+        rotations[slot]     = m_Rotations[record.Slot];
+        scales[slot]        = m_Scales[record.Slot];
+        worldMatrices[slot] = m_WorldMatrices[record.Slot];
+        localDirty[slot]    = m_LocalDirty[record.Slot];
+        if (localDirty[slot])
+            m_DirtySlots.push_back(slot);
+
+        record.Slot = slot;
+    }
+
+    m_Translations  = std::move(translations);
+    m_Rotations     = std::move(rotations);
+    m_Scales        = std::move(scales);
+    m_WorldMatrices = std::move(worldMatrices);
+    m_ParentSlots   = std::move(parentSlots);
+    m_NodeIndices   = std::move(order);
+    m_LocalDirty    = std::move(localDirty);
+    // Cleared rather than moved, the changed ranges refer to the old slots
+    m_WorldChanged.assign(m_NodeIndices.size(), 0);
+    m_ChangedRanges.clear();
+
+    m_StructureDirty = false;
+}
+
+void TransformHierarchy::UpdateLevel()
+{
+    uint32_t count = 0;
+    for (const SlotRange& range : m_LevelRanges)
+        count += range.End - range.Begin;
+
+    if (count <= PARALLEL_BATCH_SIZE)
+    {
+        for (const SlotRange& range : m_LevelRanges)
+            UpdateRange(range.Begin, range.End);
+        return;
+    }
+
+    // The ranges don't overlap, a range's nodes only read the level above
+    m_Batches.clear();
+    for (const SlotRange& range : m_LevelRanges)
+    {
+        for (uint32_t begin = range.Begin; begin < range.End; begin += PARALLEL_BATCH_SIZE)
+            m_Batches.push_back({begin, std::min(begin + PARALLEL_BATCH_SIZE, range.End)});
+    }
+    JobSystem::ParallelFor(static_cast<uint32_t>(m_Batches.size()), 1, [this](uint32_t first, uint32_t last) {
+        for (uint32_t i = first; i < last; i++)
+            UpdateRange(m_Batches[i].Begin, m_Batches[i].End);
+    });
+}
+
+void TransformHierarchy::UpdateRange(uint32_t begin, uint32_t end)
+{
+    // Every node in the range moves: either its local transform was set or its parent changed
+    for (uint32_t slot = begin; slot < end; slot++)
+    {
+        const uint32_t parent = m_ParentSlots[slot];
+        const Mat4 local      = Mat4::Compose(m_Translations[slot], m_Rotations[slot], m_Scales[slot]);
+        m_WorldMatrices[slot] = parent != INVALID_INDEX ? m_WorldMatrices[parent] * local : local;
+        m_LocalDirty[slot]    = 0;
+        m_WorldChanged[slot]  = 1;
+    }
+}
+
+} // namespace Noctis
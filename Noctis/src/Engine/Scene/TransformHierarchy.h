@@ -0,0 +1,138 @@
+#pragma once
+
+#include "Engine/Math/Matrix.h"
+#include "Engine/Math/Quaternion.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Noctis
+{
+
+// Handle to a node of a TransformHierarchy, generations tell handles of destroyed nodes apart like Entity's do
+struct TransformHandle
+{
+    uint32_t Index      = UINT32_MAX;
+    uint32_t Generation = 0;
+
+    bool IsValid() const { return Index != UINT32_MAX; }
+    bool operator==(const TransformHandle& other) const = default;
+};
+
+// Scene graph of local translation/rotation/scale transforms and the world matrices they compose to.
+//
+// Node data is stored as arrays sorted breadth first, so every parent comes before its children and the nodes of a
+// level only depend on levels already done. The children of neighbouring nodes are neighbours too, which makes what
+// a changed node drags along one contiguous range per level: Update only visits the nodes whose local transform was
+// set and their descendants, level by level, splitting large levels across the job system. A static scene with one
+// moving node costs that node's subtree, and a frame where nothing moved returns straight away.
+//
+// Structural changes (creating, destroying and reparenting nodes) only link nodes up, the arrays are re-sorted by the
+// next Update, so batches of them cost one rebuild. World matrices and HasWorldChanged are as of the last Update.
+class TransformHierarchy
+{
+  public:
+    static constexpr uint32_t PARALLEL_BATCH_SIZE = 2048;
+
+    TransformHierarchy() = default;
+
+    TransformHierarchy(const TransformHierarchy&)            = delete;
+    TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+    // An invalid parent makes a root
+    TransformHandle CreateNode(TransformHandle parent = {}, const Vec3& translation = Vec3(),
+                               const Quat& rotation = Quat(), const Vec3& scale = Vec3(1.0f));
+    // Destroys the node's children along with it
+    void DestroyNode(TransformHandle node);
+    bool IsAlive(TransformHandle node) const;
+    uint32_t GetNodeCount() const { return m_NodeCount; }
+
+    // Keeps the local transform, so the node moves with its new parent. An invalid parent makes it a root.
+    void SetParent(TransformHandle node, TransformHandle parent);
+    TransformHandle GetParent(TransformHandle node) const;
+
+    void SetLocalTransform(TransformHandle node, const Vec3& translation, const Quat& rotation, const Vec3& scale);
+    void SetLocalTranslation(TransformHandle node, const Vec3& translation);
+    void SetLocalRotation(TransformHandle node, const Quat& rotation);
+    void SetLocalScale(TransformHandle node, const Vec3& scale);
+    const Vec3& GetLocalTranslation(TransformHandle node) const;
+    const Quat& GetLocalRotation(TransformHandle node) const;
+    const Vec3& GetLocalScale(TransformHandle node) const;
+
+    const Mat4& GetWorldMatrix(TransformHandle node) const;
+    // Whether the last Update recomputed the node's world matrix, for consumers uploading only what moved
+    bool HasWorldChanged(TransformHandle node) const;
+
+    void Update();
+
+    uint32_t GetDepthCount() const { return static_cast<uint32_t>(m_LevelStarts.size()) - 1; }
+
+  private:
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    // Links between nodes, by handle index, so they survive the arrays being re-sorted
+    struct NodeRecord
+    {
+        uint32_t Parent      = INVALID_INDEX;
+        uint32_t FirstChild  = INVALID_INDEX;
+        uint32_t PrevSibling = INVALID_INDEX;
+        uint32_t NextSibling = INVALID_INDEX;
+        // Position in the sorted arrays, INVALID_INDEX once destroyed
+        uint32_t Slot       = INVALID_INDEX;
+        uint32_t Depth      = 0;
+        uint32_t Generation = 0;
+    };
+
+    NodeRecord& GetRecord(TransformHandle node);
+    const NodeRecord& GetRecord(TransformHandle node) const;
+    void Link(uint32_t node, uint32_t parent);
+    void Unlink(uint32_t node);
+    void DestroySubtree(uint32_t node);
+    void MarkDirty(const NodeRecord& record);
+    // Re-sorts the arrays breadth first from the roots, dropping the slots of destroyed nodes
+    void Rebuild();
+    // Recomputes m_LevelRanges, which are all on one level
+    void UpdateLevel();
+    void UpdateRange(uint32_t begin, uint32_t end);
+
+  private:
+    std::vector<NodeRecord> m_Records;
+    std::vector<uint32_t> m_FreeIndices;
+    // Roots are linked as siblings of this one
+    uint32_t m_FirstRoot = INVALID_INDEX;
+    uint32_t m_NodeCount = 0;
+
+    // Sorted by depth once rebuilt, new nodes are appended until then
+    std::vector<Vec3> m_Translations;
+    std::vector<Quat> m_Rotations;
+    std::vector<Vec3> m_Scales;
+    std::vector<Mat4> m_WorldMatrices;
+    std::vector<uint32_t> m_ParentSlots;
+    // The children of a slot are the slots from its entry up to the next one's, plus the end
+    std::vector<uint32_t> m_ChildStarts = {0};
+    std::vector<uint32_t> m_NodeIndices;
+    // Bytes rather than vector<bool> so jobs can write neighbouring nodes
+    std::vector<uint8_t> m_LocalDirty;
+    std::vector<uint8_t> m_WorldChanged;
+
+    // First slot of each depth, plus the end
+    std::vector<uint32_t> m_LevelStarts = {0};
+    bool m_StructureDirty               = false;
+
+    struct SlotRange
+    {
+        uint32_t Begin;
+        uint32_t End;
+    };
+
+    // Slots whose local transform was set since the last Update, rebuilt along with the arrays
+    std::vector<uint32_t> m_DirtySlots;
+    // What the last Update recomputed, its HasWorldChanged flags are cleared by the next one
+    std::vector<SlotRange> m_ChangedRanges;
+    // Scratch for Update: the ranges of the level being recomputed, those of the next one and job-sized pieces
+    std::vector<SlotRange> m_LevelRanges;
+    std::vector<SlotRange> m_NextRanges;
+    std::vector<SlotRange> m_Batches;
+};
+
+} // namespace Noctis
@@ -3,15 +3,40 @@
 #include "Engine/Core/Base.h"
 
 #include "Engine/Core/Application.h"
+#include "Engine/Core/JobSystem.h"
 #include "Engine/Core/Layer.h"
 #include "Engine/Core/Log.h"
 
+#include "Engine/Core/Memory/FrameAllocator.h"
+#include "Engine/Core/Memory/LinearAllocator.h"
+#include "Engine/Core/Memory/PoolAllocator.h"
+#include "Engine/Core/Memory/ScratchScope.h"
+
 #include "Engine/Core/KeyCodes.h"
 #include "Engine/Core/MouseCodes.h"
 
+#include "Engine/Debug/MemoryTracker.h"
+
+#include "Engine/ECS/CommandBuffer.h"
+#include "Engine/ECS/SystemScheduler.h"
+#include "Engine/ECS/World.h"
+
 #include "Engine/Events/Event.h"
 #include "Engine/Events/ApplicationEvent.h"
 #include "Engine/Events/KeyEvent.h"
 #include "Engine/Events/MouseEvent.h"
 
-#include "Engine/ImGui/ImGuiLayer.h"
\ No newline at end of file
+#include "Engine/ImGui/ImGuiLayer.h"
+
+#include "Engine/Math/AABB.h"
+#include "Engine/Math/MathBenchmark.h"
+#include "Engine/Math/MathKernels.h"
+#include "Engine/Math/Matrix.h"
+#include "Engine/Math/Quaternion.h"
+#include "Engine/Math/Vector.h"
+
+#include "Engine/Renderer/MeshRenderer.h"
+#include "Engine/Renderer/Renderer2D.h"
+#include "Engine/Renderer/Texture.h"
+
+#include "Engine/Scene/TransformHierarchy.h"
@@ -1,6 +1,8 @@
 #include "MacOSWindow.h"
 
 #include "Engine/Events/ApplicationEvent.h"
+#include "Engine/Events/KeyEvent.h"
+#include "Engine/Events/MouseEvent.h"
 
 #include "Platform/Vulkan/VulkanContext.h"
 
@@ -14,11 +16,6 @@ static void GLFWErrorCallback(int error, const char* description)
     NOC_CORE_ERROR("GLFW Error ({0}): {1}", error, description);
 }
 
-Window* Window::Create(const WindowProps& props)
-{
-    return new MacOSWindow(props);
-}
-
 MacOSWindow::MacOSWindow(const WindowProps& props)
 {
     MacOSWindow::Init(props);
@@ -31,6 +28,8 @@ MacOSWindow::~MacOSWindow()
 
 void MacOSWindow::Init(const WindowProps& props)
 {
+    NOC_PROFILE_FUNCTION();
+
     m_Data.Title  = props.Title;
     m_Data.Width  = props.Width;
     m_Data.Height = props.Height;
@@ -60,15 +59,14 @@ void MacOSWindow::Init(const WindowProps& props)
     SetVSync(true);
 
     // Set GLFW callbacks
-    // TODO: GLFW callbacks?
     glfwSetWindowSizeCallback(m_Window, [](GLFWwindow* window, int width, int height) {
         WindowData& data = *static_cast<WindowData*>(glfwGetWindowUserPointer(window));
 
         data.Width  = width;
         data.Height = height;
 
-        // WindowResizeEvent event(width, height);
-        // data.EventCallback(event);
+        WindowResizeEvent event(width, height);
+        data.EventCallback(event);
     });
 
     glfwSetWindowCloseCallback(m_Window, [](GLFWwindow* window) {
@@ -76,22 +74,100 @@ void MacOSWindow::Init(const WindowProps& props)
         WindowCloseEvent event;
         data.EventCallback(event);
     });
+
+    glfwSetKeyCallback(m_Window, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
+        WindowData& data = *static_cast<WindowData*>(glfwGetWindowUserPointer(window));
+
+        switch (action)
+        {
+            case GLFW_PRESS: {
+                KeyPressedEvent event(static_cast<KeyCode>(key), false);
+                data.EventCallback(event);
+                break;
+            }
+            case GLFW_RELEASE: {
+                KeyReleasedEvent event(static_cast<KeyCode>(key));
+                data.EventCallback(event);
+                break;
+            }
+            case GLFW_REPEAT: {
+                KeyPressedEvent event(static_cast<KeyCode>(key), true);
+                data.EventCallback(event);
+                break;
+            }
+        }
+    });
+
+    glfwSetCharCallback(m_Window, [](GLFWwindow* window, unsigned int keycode) {
+        WindowData& data = *static_cast<WindowData*>(glfwGetWindowUserPointer(window));
+        KeyTypedEvent event(static_cast<KeyCode>(keycode));
+        data.EventCallback(event);
+    });
+
+    glfwSetMouseButtonCallback(m_Window, [](GLFWwindow* window, int button, int action, int mods) {
+        WindowData& data = *static_cast<WindowData*>(glfwGetWindowUserPointer(window));
+
+        switch (action)
+        {
+            case GLFW_PRESS: {
+                MouseButtonPressedEvent event(static_cast<MouseCode>(button));
+                data.EventCallback(event);
+                break;
+            }
+            case GLFW_RELEASE: {
+                MouseButtonReleasedEvent event(static_cast<MouseCode>(button));
+                data.EventCallback(event);
+                break;
+            }
+        }
+    });
+
+    glfwSetScrollCallback(m_Window, [](GLFWwindow* window, double xOffset, double yOffset) {
+        WindowData& data = *static_cast<WindowData*>(glfwGetWindowUserPointer(window));
+        MouseScrolledEvent event(static_cast<float>(xOffset), static_cast<float>(yOffset));
+        data.EventCallback(event);
+    });
+
+    glfwSetCursorPosCallback(m_Window, [](GLFWwindow* window, double x, double y) {
+        WindowData& data = *static_cast<WindowData*>(glfwGetWindowUserPointer(window));
+        MouseMovedEvent event(static_cast<float>(x), static_cast<float>(y));
+        data.EventCallback(event);
+    });
 }
 
 void MacOSWindow::Shutdown()
 {
+    NOC_PROFILE_FUNCTION();
+
     glfwDestroyWindow(m_Window);
 }
 
 void MacOSWindow::OnUpdate()
 {
+    NOC_PROFILE_FUNCTION();
+
     glfwPollEvents();
     // glfwSwapBuffers(m_Window);
 }
 
+void MacOSWindow::WaitEvents()
+{
+    NOC_PROFILE_FUNCTION();
+
+    glfwWaitEvents();
+}
+
+void MacOSWindow::WaitEventsTimeout(float seconds)
+{
+    NOC_PROFILE_FUNCTION();
+
+    glfwWaitEventsTimeout(seconds);
+}
+
 void MacOSWindow::SetVSync(const bool enabled)
 {
     m_Data.VSync = enabled;
+    m_RendererContext->SetVSync(enabled);
 }
 
 bool MacOSWindow::IsVSync() const
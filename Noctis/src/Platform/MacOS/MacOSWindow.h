@@ -18,6 +18,9 @@ class MacOSWindow : public Window
 
     void OnUpdate() override;
 
+    void WaitEvents() override;
+    void WaitEventsTimeout(float seconds) override;
+
     unsigned int GetWidth() const override { return m_Data.Width; }
     unsigned int GetHeight() const override { return m_Data.Height; }
 
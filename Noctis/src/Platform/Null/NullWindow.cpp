@@ -0,0 +1,34 @@
+#include "NullWindow.h"
+
+#include <thread>
+
+namespace Noctis
+{
+
+NullWindow::NullWindow(const WindowProps& props) : m_Width(props.Width), m_Height(props.Height)
+{
+    NOC_PROFILE_FUNCTION();
+
+    NOC_CORE_INFO("Creating headless window ({0}, {1})", props.Width, props.Height);
+
+    m_RendererContext = RendererContext::Create();
+    m_RendererContext->SetWindowHandle(nullptr);
+    m_RendererContext->SetOffscreenExtent(props.Width, props.Height);
+    m_RendererContext->Init();
+}
+
+void NullWindow::WaitEventsTimeout(float seconds)
+{
+    NOC_PROFILE_FUNCTION();
+
+    // No events will ever arrive, this only keeps the frame rate limit working
+    std::this_thread::sleep_for(std::chrono::duration<float>(seconds));
+}
+
+void NullWindow::SetVSync(bool enabled)
+{
+    m_VSync = enabled;
+    m_RendererContext->SetVSync(enabled);
+}
+
+} // namespace Noctis
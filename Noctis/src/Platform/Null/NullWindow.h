@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Engine/Core/Window.h"
+
+#include "Engine/Renderer/RendererContext.h"
+
+namespace Noctis
+{
+
+// A window that never shows up and never produces events. Its renderer context draws into offscreen images, so
+// the application runs unchanged without a display.
+class NullWindow : public Window
+{
+  public:
+    explicit NullWindow(const WindowProps& props);
+    ~NullWindow() override = default;
+
+    void OnUpdate() override {}
+
+    void WaitEvents() override {}
+    void WaitEventsTimeout(float seconds) override;
+
+    unsigned int GetWidth() const override { return m_Width; }
+    unsigned int GetHeight() const override { return m_Height; }
+
+    // Window attributes
+    void SetEventCallback(const EventCallbackFn& callback) override {}
+    void SetVSync(bool enabled) override;
+    bool IsVSync() const override { return m_VSync; }
+
+    void* GetNativeWindow() const override { return nullptr; }
+
+    Ref<RendererContext> GetRenderContext() override { return m_RendererContext; }
+
+  private:
+    Ref<RendererContext> m_RendererContext;
+
+    unsigned int m_Width;
+    unsigned int m_Height;
+    bool m_VSync = false;
+};
+
+} // namespace Noctis
@@ -0,0 +1,569 @@
+#include "VulkanAllocator.h"
+
+#include <bit>
+
+namespace Noctis
+{
+
+// A device memory block carved up by a binary buddy allocator. Every sub-block is a power of two and naturally aligned,
+// so any alignment up to the allocation size comes for free, and allocating or freeing walks at most one path down or
+// up the tree.
+class VulkanMemoryBlock
+{
+  public:
+    VulkanMemoryBlock(VkDeviceMemory memory, VkDeviceSize size, void* mapped)
+        : m_Memory(memory), m_Size(size), m_MappedData(mapped)
+    {
+        m_LevelCount = static_cast<uint32_t>(std::countr_zero(size / MIN_SIZE)) + 1;
+        m_FreeLists.resize(m_LevelCount);
+        m_FreeListIndex.assign((size_t(1) << m_LevelCount) - 1, INVALID_INDEX);
+
+        PushFree(0, 0);
+    }
+
+    // Returns false if no sub-block is large enough, size is rounded up to the allocated size
+    bool Allocate(VkDeviceSize& size, VkDeviceSize alignment, VkDeviceSize& offset)
+    {
+        const VkDeviceSize blockSize = std::bit_ceil(std::max({size, alignment, MIN_SIZE}));
+        if (blockSize > m_Size)
+            return false;
+
+        const uint32_t level = GetLevel(blockSize);
+
+        // Smallest free sub-block that fits, then split it down to the requested size
+        uint32_t current = level;
+        while (m_FreeLists[current].empty())
+        {
+            if (current == 0)
+                return false;
+            current--;
+        }
+
+        uint32_t node = m_FreeLists[current].back();
+        RemoveFree(node, current);
+
+        for (; current < level; current++)
+        {
+            PushFree(node * 2 + 2, current + 1);
+            node = node * 2 + 1;
+        }
+
+        offset = (node - ((1u << level) - 1)) * blockSize;
+        size   = blockSize;
+        m_Used += blockSize;
+        m_AllocationCount++;
+        return true;
+    }
+
+    void Free(VkDeviceSize offset, VkDeviceSize size)
+    {
+        uint32_t level = GetLevel(size);
+        uint32_t node  = static_cast<uint32_t>((1u << level) - 1 + offset / size);
+
+        m_Used -= size;
+        m_AllocationCount--;
+
+        // Merge with the buddy for as long as it is free too
+        while (level > 0)
+        {
+            const uint32_t buddy = (node & 1) ? node + 1 : node - 1;
+            if (m_FreeListIndex[buddy] == INVALID_INDEX)
+                break;
+
+            RemoveFree(buddy, level);
+            node = (node - 1) / 2;
+            level--;
+        }
+
+        PushFree(node, level);
+    }
+
+    bool IsEmpty() const { return m_AllocationCount == 0; }
+    uint32_t GetAllocationCount() const { return m_AllocationCount; }
+
+    VkDeviceMemory GetMemory() const { return m_Memory; }
+    VkDeviceSize GetSize() const { return m_Size; }
+    VkDeviceSize GetUsed() const { return m_Used; }
+    void* GetMappedData() const { return m_MappedData; }
+
+    static constexpr VkDeviceSize MIN_SIZE = 1024;
+
+  private:
+    uint32_t GetLevel(VkDeviceSize blockSize) const
+    {
+        return static_cast<uint32_t>(std::countr_zero(m_Size) - std::countr_zero(blockSize));
+    }
+
+    void PushFree(uint32_t node, uint32_t level)
+    {
+        m_FreeListIndex[node] = static_cast<uint32_t>(m_FreeLists[level].size());
+        m_FreeLists[level].push_back(node);
+    }
+
+    // Swap-remove, the free lists are unordered
+    void RemoveFree(uint32_t node, uint32_t level)
+    {
+        std::vector<uint32_t>& list = m_FreeLists[level];
+        const uint32_t index        = m_FreeListIndex[node];
+
+        list[index]                  = list.back();
+        m_FreeListIndex[list[index]] = index;
+        list.pop_back();
+        m_FreeListIndex[node] = INVALID_INDEX;
+    }
+
+  private:
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    VkDeviceMemory m_Memory;
+    VkDeviceSize m_Size;
+    void* m_MappedData;
+
+    uint32_t m_LevelCount;
+    // Free nodes per level, level 0 being the whole block. Nodes are numbered like a binary heap.
+    std::vector<std::vector<uint32_t>> m_FreeLists;
+    std::vector<uint32_t> m_FreeListIndex;
+
+    VkDeviceSize m_Used        = 0;
+    uint32_t m_AllocationCount = 0;
+};
+
+VulkanAllocator::VulkanAllocator(const VulkanDevice& device, VkDeviceSize preferredBlockSize) : m_Device(device)
+{
+    NOC_PROFILE_FUNCTION();
+
+    vkGetPhysicalDeviceMemoryProperties(m_Device.GetVkPhysicalDevice(), &m_MemoryProperties);
+
+    m_BufferImageGranularity = m_Device.GetProperties().limits.bufferImageGranularity;
+    m_MaxAllocationCount     = m_Device.GetProperties().limits.maxMemoryAllocationCount;
+
+    m_MemoryTypes.resize(m_MemoryProperties.memoryTypeCount);
+    for (uint32_t i = 0; i < m_MemoryProperties.memoryTypeCount; i++)
+    {
+        // Small heaps (e.g. the 256MB host visible VRAM window) get smaller blocks so one block can't exhaust them
+        const VkDeviceSize heapSize = m_MemoryProperties.memoryHeaps[m_MemoryProperties.memoryTypes[i].heapIndex].size;
+        const VkDeviceSize limit    = std::bit_floor(std::max<VkDeviceSize>(heapSize / 8, VulkanMemoryBlock::MIN_SIZE));
+
+        m_MemoryTypes[i].BlockSize = std::min(std::bit_ceil(preferredBlockSize), limit);
+    }
+}
+
+VulkanAllocator::~VulkanAllocator()
+{
+    NOC_PROFILE_FUNCTION();
+
+    for (MemoryTypeData& memoryType : m_MemoryTypes)
+    {
+        for (const Scope<VulkanMemoryBlock>& block : memoryType.Blocks)
+        {
+            if (!block->IsEmpty())
+                NOC_CORE_WARN("VulkanAllocator destroyed with {0} bytes still allocated", block->GetUsed());
+            FreeDeviceMemory(block->GetMemory(), block->GetMappedData() != nullptr);
+        }
+
+        if (memoryType.DedicatedCount > 0 || memoryType.LinearPoolCount > 0)
+            NOC_CORE_WARN("VulkanAllocator destroyed with {0} dedicated allocations and {1} linear pools alive",
+                          memoryType.DedicatedCount, memoryType.LinearPoolCount);
+    }
+}
+
+VulkanAllocation VulkanAllocator::Allocate(const VkMemoryRequirements& requirements, MemoryUsage usage,
+                                           bool optimalImage)
+{
+    return AllocateInternal(requirements, usage, optimalImage, false, VK_NULL_HANDLE, VK_NULL_HANDLE);
+}
+
+VulkanAllocation VulkanAllocator::AllocateBuffer(VkBuffer buffer, MemoryUsage usage)
+{
+    VkBufferMemoryRequirementsInfo2 info{};
+    info.sType  = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2;
+    info.buffer = buffer;
+
+    VkMemoryDedicatedRequirements dedicated{};
+    dedicated.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+    VkMemoryRequirements2 requirements{};
+    requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    requirements.pNext = &dedicated;
+
+    vkGetBufferMemoryRequirements2(m_Device.GetVkDevice(), &info, &requirements);
+
+    const bool prefersDedicated = dedicated.prefersDedicatedAllocation || dedicated.requiresDedicatedAllocation;
+    VulkanAllocation allocation =
+        AllocateInternal(requirements.memoryRequirements, usage, false, prefersDedicated, buffer, VK_NULL_HANDLE);
+    if (allocation.IsValid())
+        VK_CHECK_RESULT(vkBindBufferMemory(m_Device.GetVkDevice(), buffer, allocation.Memory, allocation.Offset));
+
+    return allocation;
+}
+
+VulkanAllocation VulkanAllocator::AllocateImage(VkImage image, MemoryUsage usage)
+{
+    VkImageMemoryRequirementsInfo2 info{};
+    info.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2;
+    info.image = image;
+
+    VkMemoryDedicatedRequirements dedicated{};
+    dedicated.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+    VkMemoryRequirements2 requirements{};
+    requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    requirements.pNext = &dedicated;
+
+    vkGetImageMemoryRequirements2(m_Device.GetVkDevice(), &info, &requirements);
+
+    // Linear images are rare enough that treating every image as optimal costs nothing worth tracking
+    const bool prefersDedicated = dedicated.prefersDedicatedAllocation || dedicated.requiresDedicatedAllocation;
+    VulkanAllocation allocation =
+        AllocateInternal(requirements.memoryRequirements, usage, true, prefersDedicated, VK_NULL_HANDLE, image);
+    if (allocation.IsValid())
+        VK_CHECK_RESULT(vkBindImageMemory(m_Device.GetVkDevice(), image, allocation.Memory, allocation.Offset));
+
+    return allocation;
+}
+
+VulkanAllocation VulkanAllocator::AllocateInternal(const VkMemoryRequirements& requirements, MemoryUsage usage,
+                                                   bool optimalImage, bool prefersDedicated, VkBuffer dedicatedBuffer,
+                                                   VkImage dedicatedImage)
+{
+    NOC_PROFILE_FUNCTION();
+
+    VkDeviceSize size      = requirements.size;
+    VkDeviceSize alignment = requirements.alignment;
+
+    // Buddy sub-blocks are aligned to their size, so rounding optimal images up to the granularity keeps them on pages
+    // of their own
+    if (optimalImage)
+        size = std::max(size, m_BufferImageGranularity);
+
+    const std::vector<uint32_t> memoryTypes = FindMemoryTypes(requirements.memoryTypeBits, usage);
+    NOC_CORE_ASSERT(!memoryTypes.empty(), "No memory type fits the requirements!");
+
+    std::lock_guard lock(m_Mutex);
+
+    for (uint32_t memoryTypeIndex : memoryTypes)
+    {
+        // Resources that would take up a large part of a block aren't worth the internal fragmentation
+        const bool dedicated = prefersDedicated || size > m_MemoryTypes[memoryTypeIndex].BlockSize / 2;
+
+        VulkanAllocation allocation = dedicated
+                                          ? AllocateDedicated(memoryTypeIndex, size, dedicatedBuffer, dedicatedImage)
+                                          : AllocateFromBlocks(memoryTypeIndex, size, alignment);
+        if (allocation.IsValid())
+            return allocation;
+    }
+
+    NOC_CORE_ERROR("VulkanAllocator: out of device memory allocating {0} bytes", requirements.size);
+    return {};
+}
+
+VulkanAllocation VulkanAllocator::AllocateFromBlocks(uint32_t memoryTypeIndex, VkDeviceSize size,
+                                                     VkDeviceSize alignment)
+{
+    MemoryTypeData& memoryType = m_MemoryTypes[memoryTypeIndex];
+
+    VulkanAllocation allocation;
+    allocation.MemoryTypeIndex = memoryTypeIndex;
+
+    auto allocateFrom = [&](VulkanMemoryBlock& block) {
+        VkDeviceSize allocatedSize = size;
+        if (!block.Allocate(allocatedSize, alignment, allocation.Offset))
+            return false;
+
+        allocation.Memory = block.GetMemory();
+        allocation.Size   = allocatedSize;
+        allocation.Block  = &block;
+        if (block.GetMappedData())
+            allocation.MappedData = static_cast<uint8_t*>(block.GetMappedData()) + allocation.Offset;
+        return true;
+    };
+
+    for (const Scope<VulkanMemoryBlock>& block : memoryType.Blocks)
+    {
+        if (allocateFrom(*block))
+            return allocation;
+    }
+
+    void* mapped                = nullptr;
+    const VkDeviceMemory memory = AllocateDeviceMemory(memoryTypeIndex, memoryType.BlockSize, nullptr, &mapped);
+    if (memory == VK_NULL_HANDLE)
+        return {};
+
+    memoryType.Blocks.push_back(CreateScope<VulkanMemoryBlock>(memory, memoryType.BlockSize, mapped));
+    if (!allocateFrom(*memoryType.Blocks.back()))
+        return {};
+
+    return allocation;
+}
+
+VulkanAllocation VulkanAllocator::AllocateDedicated(uint32_t memoryTypeIndex, VkDeviceSize size, VkBuffer buffer,
+                                                    VkImage image)
+{
+    VkMemoryDedicatedAllocateInfo dedicatedInfo{};
+    dedicatedInfo.sType  = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+    dedicatedInfo.buffer = buffer;
+    dedicatedInfo.image  = image;
+
+    const bool hasResource = buffer != VK_NULL_HANDLE || image != VK_NULL_HANDLE;
+
+    VulkanAllocation allocation;
+    allocation.Memory = AllocateDeviceMemory(memoryTypeIndex, size, hasResource ? &dedicatedInfo : nullptr,
+                                             &allocation.MappedData);
+    if (!allocation.IsValid())
+        return {};
+
+    allocation.Size            = size;
+    allocation.MemoryTypeIndex = memoryTypeIndex;
+    allocation.Dedicated       = true;
+
+    m_MemoryTypes[memoryTypeIndex].DedicatedBytes += size;
+    m_MemoryTypes[memoryTypeIndex].DedicatedCount++;
+
+    return allocation;
+}
+
+void VulkanAllocator::Free(VulkanAllocation& allocation)
+{
+    if (!allocation.IsValid())
+        return;
+
+    NOC_PROFILE_FUNCTION();
+
+    std::lock_guard lock(m_Mutex);
+
+    MemoryTypeData& memoryType = m_MemoryTypes[allocation.MemoryTypeIndex];
+
+    if (allocation.Dedicated)
+    {
+        FreeDeviceMemory(allocation.Memory, allocation.MappedData != nullptr);
+        memoryType.DedicatedBytes -= allocation.Size;
+        memoryType.DedicatedCount--;
+    }
+    else if (allocation.Block)
+    {
+        allocation.Block->Free(allocation.Offset, allocation.Size);
+
+        // Keep one empty block around so a resource being recreated doesn't round-trip to the driver
+        if (allocation.Block->IsEmpty())
+        {
+            uint32_t emptyBlocks = 0;
+            for (const Scope<VulkanMemoryBlock>& block : memoryType.Blocks)
+                emptyBlocks += block->IsEmpty() ? 1 : 0;
+
+            if (emptyBlocks > 1)
+            {
+                auto it = std::find_if(memoryType.Blocks.begin(), memoryType.Blocks.end(),
+                                       [&](const Scope<VulkanMemoryBlock>& block) {
+                                           return block.get() == allocation.Block;
+                                       });
+                FreeDeviceMemory((*it)->GetMemory(), (*it)->GetMappedData() != nullptr);
+                memoryType.Blocks.erase(it);
+            }
+        }
+    }
+
+    // Linear pool allocations are released by resetting their pool
+    allocation = {};
+}
+
+Scope<VulkanLinearPool> VulkanAllocator::CreateLinearPool(VkDeviceSize size, MemoryUsage usage,
+                                                          uint32_t memoryTypeBits)
+{
+    NOC_PROFILE_FUNCTION();
+
+    std::lock_guard lock(m_Mutex);
+
+    for (uint32_t memoryTypeIndex : FindMemoryTypes(memoryTypeBits, usage))
+    {
+        void* mapped                = nullptr;
+        const VkDeviceMemory memory = AllocateDeviceMemory(memoryTypeIndex, size, nullptr, &mapped);
+        if (memory == VK_NULL_HANDLE)
+            continue;
+
+        m_MemoryTypes[memoryTypeIndex].LinearPoolBytes += size;
+        m_MemoryTypes[memoryTypeIndex].LinearPoolCount++;
+
+        return Scope<VulkanLinearPool>(new VulkanLinearPool(*this, memoryTypeIndex, memory, size, mapped));
+    }
+
+    NOC_CORE_ERROR("VulkanAllocator: out of device memory creating a {0} byte linear pool", size);
+    return nullptr;
+}
+
+void VulkanAllocator::OnLinearPoolDestroyed(const VulkanLinearPool& pool)
+{
+    std::lock_guard lock(m_Mutex);
+
+    FreeDeviceMemory(pool.m_Memory, pool.m_MappedData != nullptr);
+    m_MemoryTypes[pool.m_MemoryTypeIndex].LinearPoolBytes -= pool.m_Size;
+    m_MemoryTypes[pool.m_MemoryTypeIndex].LinearPoolCount--;
+}
+
+std::vector<VulkanHeapStatistics> VulkanAllocator::GetHeapStatistics() const
+{
+    std::vector<VulkanHeapStatistics> statistics(m_MemoryProperties.memoryHeapCount);
+    for (uint32_t i = 0; i < m_MemoryProperties.memoryHeapCount; i++)
+    {
+        statistics[i].HeapSize    = m_MemoryProperties.memoryHeaps[i].size;
+        statistics[i].DeviceLocal = m_MemoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+    }
+
+    std::lock_guard lock(m_Mutex);
+
+    for (uint32_t i = 0; i < m_MemoryProperties.memoryTypeCount; i++)
+    {
+        const MemoryTypeData& memoryType = m_MemoryTypes[i];
+        VulkanHeapStatistics& heap       = statistics[m_MemoryProperties.memoryTypes[i].heapIndex];
+
+        for (const Scope<VulkanMemoryBlock>& block : memoryType.Blocks)
+        {
+            heap.AllocatedBytes += block->GetSize();
+            heap.UsedBytes += block->GetUsed();
+            heap.AllocationCount += block->GetAllocationCount();
+            heap.BlockCount++;
+        }
+
+        // A linear pool counts as used in full, its contents change every frame
+        heap.AllocatedBytes += memoryType.DedicatedBytes + memoryType.LinearPoolBytes;
+        heap.UsedBytes += memoryType.DedicatedBytes + memoryType.LinearPoolBytes;
+        heap.AllocationCount += memoryType.DedicatedCount;
+        heap.DedicatedCount += memoryType.DedicatedCount;
+        heap.LinearPoolCount += memoryType.LinearPoolCount;
+    }
+
+    return statistics;
+}
+
+std::vector<uint32_t> VulkanAllocator::FindMemoryTypes(uint32_t memoryTypeBits, MemoryUsage usage) const
+{
+    VkMemoryPropertyFlags required  = 0;
+    VkMemoryPropertyFlags preferred = 0;
+    VkMemoryPropertyFlags avoided   = 0;
+
+    switch (usage)
+    {
+        case MemoryUsage::GPUOnly:
+            preferred = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            avoided   = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+            break;
+        case MemoryUsage::CPUToGPU:
+            required  = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            preferred = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            break;
+        case MemoryUsage::CPUOnly:
+            required = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            avoided  = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            break;
+        case MemoryUsage::GPUToCPU:
+            required  = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+            preferred = VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+            break;
+    }
+
+    // Cost = number of preferred flags missing plus avoided flags present, lowest first
+    std::vector<std::pair<uint32_t, uint32_t>> candidates;
+    for (uint32_t i = 0; i < m_MemoryProperties.memoryTypeCount; i++)
+    {
+        const VkMemoryPropertyFlags flags = m_MemoryProperties.memoryTypes[i].propertyFlags;
+        if (!(memoryTypeBits & (1u << i)) || (flags & required) != required)
+            continue;
+
+        const uint32_t cost = std::popcount(preferred & ~flags) + std::popcount(avoided & flags);
+        candidates.emplace_back(cost, i);
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<uint32_t> memoryTypes;
+    memoryTypes.reserve(candidates.size());
+    for (const auto& [cost, index] : candidates)
+        memoryTypes.push_back(index);
+
+    return memoryTypes;
+}
+
+bool VulkanAllocator::IsHostVisible(uint32_t memoryTypeIndex) const
+{
+    return m_MemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+}
+
+VkDeviceMemory VulkanAllocator::AllocateDeviceMemory(uint32_t memoryTypeIndex, VkDeviceSize size, const void* next,
+                                                     void** mapped)
+{
+    NOC_PROFILE_FUNCTION();
+
+    if (m_DeviceAllocationCount.load(std::memory_order_relaxed) >= m_MaxAllocationCount)
+    {
+        NOC_CORE_ERROR("VulkanAllocator: maxMemoryAllocationCount ({0}) reached", m_MaxAllocationCount);
+        return VK_NULL_HANDLE;
+    }
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.pNext           = next;
+    allocInfo.allocationSize  = size;
+    allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    if (vkAllocateMemory(m_Device.GetVkDevice(), &allocInfo, nullptr, &memory) != VK_SUCCESS)
+        return VK_NULL_HANDLE;
+
+    m_DeviceAllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    // Host visible memory stays mapped, mapping is far too slow to do per access
+    *mapped = nullptr;
+    if (IsHostVisible(memoryTypeIndex))
+        VK_CHECK_RESULT(vkMapMemory(m_Device.GetVkDevice(), memory, 0, VK_WHOLE_SIZE, 0, mapped));
+
+    return memory;
+}
+
+void VulkanAllocator::FreeDeviceMemory(VkDeviceMemory memory, bool mapped)
+{
+    if (mapped)
+        vkUnmapMemory(m_Device.GetVkDevice(), memory);
+
+    vkFreeMemory(m_Device.GetVkDevice(), memory, nullptr);
+    m_DeviceAllocationCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+VulkanLinearPool::VulkanLinearPool(VulkanAllocator& allocator, uint32_t memoryTypeIndex, VkDeviceMemory memory,
+                                   VkDeviceSize size, void* mapped)
+    : m_Allocator(allocator), m_MemoryTypeIndex(memoryTypeIndex), m_Memory(memory), m_Size(size), m_MappedData(mapped)
+{
+}
+
+VulkanLinearPool::~VulkanLinearPool()
+{
+    m_Allocator.OnLinearPoolDestroyed(*this);
+}
+
+VulkanAllocation VulkanLinearPool::Allocate(const VkMemoryRequirements& requirements)
+{
+    if (!(requirements.memoryTypeBits & (1u << m_MemoryTypeIndex)))
+        return {};
+
+    const VkDeviceSize alignment = std::max<VkDeviceSize>(requirements.alignment, 1);
+    const VkDeviceSize offset    = (m_Offset + alignment - 1) / alignment * alignment;
+    if (offset + requirements.size > m_Size)
+        return {};
+
+    m_Offset = offset + requirements.size;
+
+    VulkanAllocation allocation;
+    allocation.Memory          = m_Memory;
+    allocation.Offset          = offset;
+    allocation.Size            = requirements.size;
+    allocation.MemoryTypeIndex = m_MemoryTypeIndex;
+    if (m_MappedData)
+        allocation.MappedData = static_cast<uint8_t*>(m_MappedData) + offset;
+
+    return allocation;
+}
+
+void VulkanLinearPool::Reset()
+{
+    m_Offset = 0;
+}
+
+} // namespace Noctis
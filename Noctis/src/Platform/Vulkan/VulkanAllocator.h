@@ -0,0 +1,158 @@
+#pragma once
+
+#include "VulkanDevice.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace Noctis
+{
+
+enum class MemoryUsage
+{
+    // Device local, never touched by the CPU (render targets, static meshes, textures)
+    GPUOnly = 0,
+    // Written by the CPU every frame and read by the GPU, device local if the device has host visible VRAM
+    CPUToGPU = 1,
+    // Staging memory for uploads, kept out of device local heaps
+    CPUOnly = 2,
+    // Written by the GPU and read back on the CPU, cached when possible
+    GPUToCPU = 3
+};
+
+class VulkanMemoryBlock;
+class VulkanLinearPool;
+
+struct VulkanAllocation
+{
+    VkDeviceMemory Memory = VK_NULL_HANDLE;
+    VkDeviceSize Offset   = 0;
+    VkDeviceSize Size     = 0;
+    // Host visible memory is mapped for its whole lifetime, nullptr otherwise
+    void* MappedData = nullptr;
+
+    // Bookkeeping for VulkanAllocator::Free. Linear pool allocations have neither a block nor a dedicated memory.
+    VulkanMemoryBlock* Block = nullptr;
+    uint32_t MemoryTypeIndex = 0;
+    bool Dedicated           = false;
+
+    bool IsValid() const { return Memory != VK_NULL_HANDLE; }
+};
+
+struct VulkanHeapStatistics
+{
+    VkDeviceSize HeapSize = 0;
+    bool DeviceLocal      = false;
+
+    // Memory obtained from the driver, and how much of it is handed out
+    VkDeviceSize AllocatedBytes = 0;
+    VkDeviceSize UsedBytes      = 0;
+
+    uint32_t BlockCount      = 0;
+    uint32_t DedicatedCount  = 0;
+    uint32_t LinearPoolCount = 0;
+    uint32_t AllocationCount = 0;
+};
+
+// Sub-allocates device memory so resources don't each cost a vkAllocateMemory call, whose count is limited
+// (maxMemoryAllocationCount can be as low as 4096). Long-lived resources come from large per memory type blocks managed
+// by a buddy allocator, big or driver-preferred resources get dedicated allocations, and per-frame data can use
+// linear pools that are reset wholesale. Thread safe.
+//
+// Freeing does not wait for the GPU: free through Renderer::SubmitResourceFree when a frame may still use the memory.
+class VulkanAllocator
+{
+  public:
+    explicit VulkanAllocator(const VulkanDevice& device, VkDeviceSize preferredBlockSize = DEFAULT_BLOCK_SIZE);
+    ~VulkanAllocator();
+
+    VulkanAllocator(const VulkanAllocator&)            = delete;
+    VulkanAllocator& operator=(const VulkanAllocator&) = delete;
+
+    // optimalImage must be set for VK_IMAGE_TILING_OPTIMAL images, so they never share a bufferImageGranularity page
+    // with linear resources. Returns an invalid allocation if no memory is left.
+    VulkanAllocation Allocate(const VkMemoryRequirements& requirements, MemoryUsage usage, bool optimalImage = false);
+    // Query the requirements (including the driver's dedicated allocation preference), allocate and bind
+    VulkanAllocation AllocateBuffer(VkBuffer buffer, MemoryUsage usage);
+    VulkanAllocation AllocateImage(VkImage image, MemoryUsage usage);
+    void Free(VulkanAllocation& allocation);
+
+    // memoryTypeBits restricts the memory types the pool may use, pass VkMemoryRequirements::memoryTypeBits of a
+    // representative resource
+    Scope<VulkanLinearPool> CreateLinearPool(VkDeviceSize size, MemoryUsage usage, uint32_t memoryTypeBits = ~0u);
+
+    std::vector<VulkanHeapStatistics> GetHeapStatistics() const;
+    uint32_t GetDeviceAllocationCount() const { return m_DeviceAllocationCount.load(std::memory_order_relaxed); }
+
+    static constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = 64ull * 1024 * 1024;
+
+  private:
+    struct MemoryTypeData
+    {
+        std::vector<Scope<VulkanMemoryBlock>> Blocks;
+        VkDeviceSize BlockSize = 0;
+
+        VkDeviceSize DedicatedBytes  = 0;
+        uint32_t DedicatedCount      = 0;
+        VkDeviceSize LinearPoolBytes = 0;
+        uint32_t LinearPoolCount     = 0;
+    };
+
+    VulkanAllocation AllocateInternal(const VkMemoryRequirements& requirements, MemoryUsage usage, bool optimalImage,
+                                      bool prefersDedicated, VkBuffer dedicatedBuffer, VkImage dedicatedImage);
+    VulkanAllocation AllocateFromBlocks(uint32_t memoryTypeIndex, VkDeviceSize size, VkDeviceSize alignment);
+    VulkanAllocation AllocateDedicated(uint32_t memoryTypeIndex, VkDeviceSize size, VkBuffer buffer, VkImage image);
+
+    // Memory types for usage that are allowed by memoryTypeBits, best first
+    std::vector<uint32_t> FindMemoryTypes(uint32_t memoryTypeBits, MemoryUsage usage) const;
+    bool IsHostVisible(uint32_t memoryTypeIndex) const;
+
+    VkDeviceMemory AllocateDeviceMemory(uint32_t memoryTypeIndex, VkDeviceSize size, const void* next, void** mapped);
+    void FreeDeviceMemory(VkDeviceMemory memory, bool mapped);
+
+    void OnLinearPoolDestroyed(const VulkanLinearPool& pool);
+
+  private:
+    const VulkanDevice& m_Device;
+    VkPhysicalDeviceMemoryProperties m_MemoryProperties;
+    VkDeviceSize m_BufferImageGranularity;
+    uint32_t m_MaxAllocationCount;
+
+    mutable std::mutex m_Mutex;
+    std::vector<MemoryTypeData> m_MemoryTypes;
+    std::atomic<uint32_t> m_DeviceAllocationCount = 0;
+
+    friend class VulkanLinearPool;
+};
+
+// Bump allocator over a single device memory allocation, for data that lives for one frame. Keep one pool per frame
+// in flight and Reset it once that frame's fence has signalled; individual allocations are never freed.
+class VulkanLinearPool
+{
+  public:
+    ~VulkanLinearPool();
+
+    // Returns an invalid allocation when the pool is full or the requirements don't allow its memory type
+    VulkanAllocation Allocate(const VkMemoryRequirements& requirements);
+    void Reset();
+
+    VkDeviceSize GetSize() const { return m_Size; }
+    VkDeviceSize GetUsed() const { return m_Offset; }
+
+  private:
+    VulkanLinearPool(VulkanAllocator& allocator, uint32_t memoryTypeIndex, VkDeviceMemory memory, VkDeviceSize size,
+                     void* mapped);
+
+  private:
+    VulkanAllocator& m_Allocator;
+    uint32_t m_MemoryTypeIndex;
+    VkDeviceMemory m_Memory;
+    VkDeviceSize m_Size;
+    void* m_MappedData;
+
+    VkDeviceSize m_Offset = 0;
+
+    friend class VulkanAllocator;
+};
+
+} // namespace Noctis
@@ -0,0 +1,202 @@
+#include "VulkanBindlessTable.h"
+
+#include "Engine/Renderer/Renderer.h"
+
+namespace Noctis
+{
+
+namespace
+{
+
+constexpr VkDescriptorType DESCRIPTOR_TYPES[] = {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_DESCRIPTOR_TYPE_SAMPLER,
+                                                 VK_DESCRIPTOR_TYPE_STORAGE_BUFFER};
+
+const char* GetResourceTypeName(BindlessResourceType type)
+{
+    switch (type)
+    {
+        case BindlessResourceType::SampledImage:
+            return "sampled image";
+        case BindlessResourceType::Sampler:
+            return "sampler";
+        case BindlessResourceType::StorageBuffer:
+            return "storage buffer";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+VulkanBindlessTable::VulkanBindlessTable(const VulkanDevice& device, VulkanLayoutCache& layoutCache)
+    : m_Device(device), m_Slots(CreateRef<Slots>())
+{
+    NOC_PROFILE_FUNCTION();
+
+    NOC_CORE_ASSERT(device.SupportsBindless(), "Bindless descriptors are not supported by this device");
+
+    // Every array is visible to all stages, so each one counts against the per stage limits too
+    const auto& limits = device.GetDescriptorIndexingProperties();
+
+    m_Capacities[0] = std::min({MAX_SAMPLED_IMAGES, limits.maxDescriptorSetUpdateAfterBindSampledImages,
+                                limits.maxPerStageDescriptorUpdateAfterBindSampledImages});
+    m_Capacities[1] = std::min({MAX_SAMPLERS, limits.maxDescriptorSetUpdateAfterBindSamplers,
+                                limits.maxPerStageDescriptorUpdateAfterBindSamplers});
+    m_Capacities[2] = std::min({MAX_STORAGE_BUFFERS, limits.maxDescriptorSetUpdateAfterBindStorageBuffers,
+                                limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers});
+
+    std::vector<VkDescriptorPoolSize> poolSizes;
+    for (uint32_t i = 0; i < RESOURCE_TYPE_COUNT; i++)
+    {
+        VkDescriptorSetLayoutBinding binding{};
+        binding.binding         = i;
+        binding.descriptorType  = DESCRIPTOR_TYPES[i];
+        binding.descriptorCount = m_Capacities[i];
+        binding.stageFlags      = VK_SHADER_STAGE_ALL;
+        m_LayoutDesc.Bindings.push_back(binding);
+        m_LayoutDesc.BindingFlags.push_back(VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+                                            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                                            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT);
+
+        poolSizes.push_back({DESCRIPTOR_TYPES[i], m_Capacities[i]});
+    }
+    m_LayoutDesc.Flags    = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    m_DescriptorSetLayout = layoutCache.GetDescriptorSetLayout(m_LayoutDesc);
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    poolInfo.maxSets       = 1;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes    = poolSizes.data();
+    VK_CHECK_RESULT(vkCreateDescriptorPool(device.GetVkDevice(), &poolInfo, nullptr, &m_DescriptorPool));
+
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool     = m_DescriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts        = &m_DescriptorSetLayout;
+    VK_CHECK_RESULT(vkAllocateDescriptorSets(device.GetVkDevice(), &allocInfo, &m_DescriptorSet));
+
+    NOC_CORE_INFO("Bindless table: {0} sampled images, {1} samplers, {2} storage buffers", m_Capacities[0],
+                  m_Capacities[1], m_Capacities[2]);
+}
+
+VulkanBindlessTable::~VulkanBindlessTable()
+{
+    // The set layout belongs to the layout cache
+    vkDestroyDescriptorPool(m_Device.GetVkDevice(), m_DescriptorPool, nullptr);
+}
+
+uint32_t VulkanBindlessTable::AddImage(VkImageView imageView, VkImageLayout layout)
+{
+    const uint32_t index = AllocateIndex(BindlessResourceType::SampledImage);
+    if (index == INVALID_INDEX)
+        return index;
+
+    VkDescriptorImageInfo imageInfo{};
+    imageInfo.imageView   = imageView;
+    imageInfo.imageLayout = layout;
+    Write(BindlessResourceType::SampledImage, index, &imageInfo, nullptr);
+    return index;
+}
+
+uint32_t VulkanBindlessTable::AddSampler(VkSampler sampler)
+{
+    const uint32_t index = AllocateIndex(BindlessResourceType::Sampler);
+    if (index == INVALID_INDEX)
+        return index;
+
+    VkDescriptorImageInfo imageInfo{};
+    imageInfo.sampler = sampler;
+    Write(BindlessResourceType::Sampler, index, &imageInfo, nullptr);
+    return index;
+}
+
+uint32_t VulkanBindlessTable::AddStorageBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+{
+    const uint32_t index = AllocateIndex(BindlessResourceType::StorageBuffer);
+    if (index == INVALID_INDEX)
+        return index;
+
+    VkDescriptorBufferInfo bufferInfo{};
+    bufferInfo.buffer = buffer;
+    bufferInfo.offset = offset;
+    bufferInfo.range  = range;
+    Write(BindlessResourceType::StorageBuffer, index, nullptr, &bufferInfo);
+    return index;
+}
+
+void VulkanBindlessTable::Remove(BindlessResourceType type, uint32_t index)
+{
+    if (index == INVALID_INDEX)
+        return;
+
+    // The stale descriptor stays in the set, which is fine for a partially bound array as long as no shader reads it
+    Renderer::SubmitResourceFree([slots = m_Slots, type, index]() {
+        std::lock_guard lock(slots->Mutex);
+        slots->Free[static_cast<size_t>(type)].push_back(index);
+    });
+}
+
+void VulkanBindlessTable::ApplyTo(PipelineLayoutDesc& desc) const
+{
+    if (desc.SetLayouts.size() <= BINDLESS_SET)
+        return;
+
+    for (const VkDescriptorSetLayoutBinding& binding : desc.SetLayouts[BINDLESS_SET].Bindings)
+    {
+        if (binding.binding >= RESOURCE_TYPE_COUNT || binding.descriptorType != DESCRIPTOR_TYPES[binding.binding])
+            NOC_CORE_ERROR("Bindless table: set {0} binding {1} doesn't match the table's layout", BINDLESS_SET,
+                           binding.binding);
+    }
+    desc.SetLayouts[BINDLESS_SET] = m_LayoutDesc;
+}
+
+void VulkanBindlessTable::Bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint,
+                               VkPipelineLayout layout) const
+{
+    vkCmdBindDescriptorSets(commandBuffer, bindPoint, layout, BINDLESS_SET, 1, &m_DescriptorSet, 0, nullptr);
+}
+
+uint32_t VulkanBindlessTable::AllocateIndex(BindlessResourceType type)
+{
+    const size_t typeIndex = static_cast<size_t>(type);
+
+    std::lock_guard lock(m_Slots->Mutex);
+
+    std::vector<uint32_t>& free = m_Slots->Free[typeIndex];
+    if (!free.empty())
+    {
+        const uint32_t index = free.back();
+        free.pop_back();
+        return index;
+    }
+
+    if (m_Slots->Next[typeIndex] == m_Capacities[typeIndex])
+    {
+        NOC_CORE_ERROR("Bindless table: out of {0} slots ({1})", GetResourceTypeName(type), m_Capacities[typeIndex]);
+        return INVALID_INDEX;
+    }
+    return m_Slots->Next[typeIndex]++;
+}
+
+void VulkanBindlessTable::Write(BindlessResourceType type, uint32_t index, const VkDescriptorImageInfo* imageInfo,
+                                const VkDescriptorBufferInfo* bufferInfo)
+{
+    VkWriteDescriptorSet write{};
+    write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet          = m_DescriptorSet;
+    write.dstBinding      = static_cast<uint32_t>(type);
+    write.dstArrayElement = index;
+    write.descriptorCount = 1;
+    write.descriptorType  = DESCRIPTOR_TYPES[static_cast<size_t>(type)];
+    write.pImageInfo      = imageInfo;
+    write.pBufferInfo     = bufferInfo;
+
+    // Update-after-bind lets other slots be written while the set is in use, but writes to the set itself still
+    // need external synchronization
+    std::lock_guard lock(m_Slots->Mutex);
+    vkUpdateDescriptorSets(m_Device.GetVkDevice(), 1, &write, 0, nullptr);
+}
+
+} // namespace Noctis
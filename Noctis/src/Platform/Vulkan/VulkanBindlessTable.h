@@ -0,0 +1,87 @@
+#pragma once
+
+#include "VulkanDevice.h"
+#include "VulkanLayoutCache.h"
+
+#include <mutex>
+
+namespace Noctis
+{
+
+// Binding numbers in the table's set, mirrored by assets/shaders/include/Bindless.glsl
+enum class BindlessResourceType
+{
+    SampledImage  = 0,
+    Sampler       = 1,
+    StorageBuffer = 2
+};
+
+// One descriptor set holding every sampled image, sampler and storage buffer registered with it. It is bound once per
+// command buffer at BINDLESS_SET, and shaders index its arrays with the indices handed out here instead of binding
+// descriptors per draw. The set is update-after-bind and partially bound: registering a resource never disturbs
+// command buffers in flight, and removed indices are reused only once the GPU is done with the current frame.
+//
+// Only created on devices that support descriptor indexing, see VulkanDevice::SupportsBindless.
+class VulkanBindlessTable
+{
+  public:
+    VulkanBindlessTable(const VulkanDevice& device, VulkanLayoutCache& layoutCache);
+    ~VulkanBindlessTable();
+
+    VulkanBindlessTable(const VulkanBindlessTable&)            = delete;
+    VulkanBindlessTable& operator=(const VulkanBindlessTable&) = delete;
+
+    // Thread safe. Return INVALID_INDEX when the table is full.
+    uint32_t AddImage(VkImageView imageView, VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    uint32_t AddSampler(VkSampler sampler);
+    uint32_t AddStorageBuffer(VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+
+    // Main thread only, the index goes through Renderer::SubmitResourceFree before it is handed out again. The
+    // resource itself may be destroyed in the same frame.
+    void Remove(BindlessResourceType type, uint32_t index);
+
+    // Replaces the reflected BINDLESS_SET of a pipeline layout with the table's layout, which the table can then be
+    // bound to. Pipelines that don't declare the set are left alone.
+    void ApplyTo(PipelineLayoutDesc& desc) const;
+    void Bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout layout) const;
+
+    VkDescriptorSetLayout GetDescriptorSetLayout() const { return m_DescriptorSetLayout; }
+    VkDescriptorSet GetDescriptorSet() const { return m_DescriptorSet; }
+    uint32_t GetCapacity(BindlessResourceType type) const { return m_Capacities[static_cast<size_t>(type)]; }
+
+    static constexpr uint32_t BINDLESS_SET  = 0;
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    // Upper bounds, the device's update-after-bind limits may lower them
+    static constexpr uint32_t MAX_SAMPLED_IMAGES  = 16384;
+    static constexpr uint32_t MAX_SAMPLERS        = 256;
+    static constexpr uint32_t MAX_STORAGE_BUFFERS = 16384;
+
+  private:
+    static constexpr size_t RESOURCE_TYPE_COUNT = 3;
+
+    // Shared with the resource free callbacks handing indices back
+    struct Slots
+    {
+        std::mutex Mutex;
+        std::array<std::vector<uint32_t>, RESOURCE_TYPE_COUNT> Free;
+        std::array<uint32_t, RESOURCE_TYPE_COUNT> Next{};
+    };
+
+    uint32_t AllocateIndex(BindlessResourceType type);
+    void Write(BindlessResourceType type, uint32_t index, const VkDescriptorImageInfo* imageInfo,
+               const VkDescriptorBufferInfo* bufferInfo);
+
+  private:
+    const VulkanDevice& m_Device;
+
+    std::array<uint32_t, RESOURCE_TYPE_COUNT> m_Capacities{};
+    DescriptorSetLayoutDesc m_LayoutDesc;
+    VkDescriptorSetLayout m_DescriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool m_DescriptorPool           = VK_NULL_HANDLE;
+    VkDescriptorSet m_DescriptorSet             = VK_NULL_HANDLE;
+
+    Ref<Slots> m_Slots;
+};
+
+} // namespace Noctis
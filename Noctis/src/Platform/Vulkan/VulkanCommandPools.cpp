@@ -0,0 +1,115 @@
+#include "VulkanCommandPools.h"
+
+#include "Engine/Core/JobSystem.h"
+
+namespace Noctis
+{
+
+VulkanCommandPools::VulkanCommandPools(const VulkanDevice& device, uint32_t queueFamilyIndex, uint32_t framesInFlight)
+    : m_Device(device), m_ThreadCount(JobSystem::GetThreadCount())
+{
+    NOC_PROFILE_FUNCTION();
+
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = queueFamilyIndex;
+
+    m_Pools.resize(framesInFlight * m_ThreadCount);
+    for (PoolData& pool : m_Pools)
+        VK_CHECK_RESULT(vkCreateCommandPool(m_Device.GetVkDevice(), &poolInfo, nullptr, &pool.Pool));
+}
+
+VulkanCommandPools::~VulkanCommandPools()
+{
+    NOC_PROFILE_FUNCTION();
+
+    // Destroying a pool frees its command buffers
+    for (PoolData& pool : m_Pools)
+        vkDestroyCommandPool(m_Device.GetVkDevice(), pool.Pool, nullptr);
+    m_Pools.clear();
+}
+
+void VulkanCommandPools::BeginFrame(uint32_t frameIndex)
+{
+    NOC_PROFILE_FUNCTION();
+
+    m_CurrentFrame = frameIndex;
+
+    for (uint32_t thread = 0; thread < m_ThreadCount; thread++)
+    {
+        PoolData& pool = m_Pools[m_CurrentFrame * m_ThreadCount + thread];
+        if (pool.Used[0] == 0 && pool.Used[1] == 0)
+            continue;
+
+        VK_CHECK_RESULT(vkResetCommandPool(m_Device.GetVkDevice(), pool.Pool, 0));
+        pool.Used[0] = 0;
+        pool.Used[1] = 0;
+    }
+}
+
+VkCommandBuffer VulkanCommandPools::Allocate(VkCommandBufferLevel level)
+{
+    const uint32_t thread = JobSystem::GetThreadIndex();
+    NOC_CORE_ASSERT(thread < m_ThreadCount, "Command buffers can only be allocated on job system threads");
+
+    PoolData& pool                               = m_Pools[m_CurrentFrame * m_ThreadCount + thread];
+    const uint32_t index                         = level == VK_COMMAND_BUFFER_LEVEL_PRIMARY ? 0 : 1;
+    std::vector<VkCommandBuffer>& commandBuffers = pool.CommandBuffers[index];
+
+    if (pool.Used[index] == commandBuffers.size())
+    {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool        = pool.Pool;
+        allocInfo.level              = level;
+        allocInfo.commandBufferCount = 1;
+
+        VK_CHECK_RESULT(vkAllocateCommandBuffers(m_Device.GetVkDevice(), &allocInfo, &commandBuffers.emplace_back()));
+    }
+
+    return commandBuffers[pool.Used[index]++];
+}
+
+void VulkanCommandPools::RecordParallel(VkCommandBuffer primary, const VkCommandBufferInheritanceInfo* inheritance,
+                                        uint32_t count, uint32_t batchSize, const RecordFn& record)
+{
+    NOC_PROFILE_FUNCTION();
+
+    if (count == 0)
+        return;
+
+    if (batchSize == 0)
+        batchSize = (count + m_ThreadCount - 1) / m_ThreadCount;
+    const uint32_t batchCount = (count + batchSize - 1) / batchSize;
+
+    VkCommandBufferInheritanceInfo noRenderPass{};
+    noRenderPass.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags            = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.pInheritanceInfo = inheritance ? inheritance : &noRenderPass;
+    if (inheritance && inheritance->renderPass != VK_NULL_HANDLE)
+        beginInfo.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+
+    m_Secondaries.assign(batchCount, VK_NULL_HANDLE);
+    JobSystem::ParallelFor(batchCount, 1, [&](uint32_t first, uint32_t last) {
+        for (uint32_t batch = first; batch < last; batch++)
+        {
+            const uint32_t begin          = batch * batchSize;
+            const uint32_t end            = std::min(begin + batchSize, count);
+            VkCommandBuffer commandBuffer = Allocate(VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+
+            VK_CHECK_RESULT(vkBeginCommandBuffer(commandBuffer, &beginInfo));
+            record(commandBuffer, begin, end);
+            VK_CHECK_RESULT(vkEndCommandBuffer(commandBuffer));
+
+            m_Secondaries[batch] = commandBuffer;
+        }
+    });
+
+    vkCmdExecuteCommands(primary, batchCount, m_Secondaries.data());
+}
+
+} // namespace Noctis
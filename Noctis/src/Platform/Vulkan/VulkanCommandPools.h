@@ -0,0 +1,56 @@
+#pragma once
+
+#include "VulkanDevice.h"
+
+namespace Noctis
+{
+
+// One command pool per job system thread per frame in flight, so threads can allocate and record command buffers
+// without locking. A frame slot's pools are reset as a whole once its submission is done, which is cheaper than
+// resetting command buffers one by one, and the command buffers are kept around to be handed out again.
+class VulkanCommandPools
+{
+  public:
+    using RecordFn = std::function<void(VkCommandBuffer commandBuffer, uint32_t begin, uint32_t end)>;
+
+  public:
+    VulkanCommandPools(const VulkanDevice& device, uint32_t queueFamilyIndex, uint32_t framesInFlight);
+    ~VulkanCommandPools();
+
+    VulkanCommandPools(const VulkanCommandPools&)            = delete;
+    VulkanCommandPools& operator=(const VulkanCommandPools&) = delete;
+
+    // The frame slot's previous submission must be complete
+    void BeginFrame(uint32_t frameIndex);
+
+    // From the calling thread's pool, valid until the frame slot comes around again. Must be called from a job
+    // system thread.
+    VkCommandBuffer Allocate(VkCommandBufferLevel level);
+
+    // Splits [0, count) into batches of batchSize items, records record(commandBuffer, begin, end) for each batch into
+    // its own secondary command buffer on the job system, then executes them in primary in batch order, so the result
+    // doesn't depend on which thread recorded what. inheritance describes the render pass the secondaries continue,
+    // nullptr outside of one. batchSize == 0 gives every thread one batch.
+    void RecordParallel(VkCommandBuffer primary, const VkCommandBufferInheritanceInfo* inheritance, uint32_t count,
+                        uint32_t batchSize, const RecordFn& record);
+
+  private:
+    struct PoolData
+    {
+        VkCommandPool Pool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> CommandBuffers[2];
+        uint32_t Used[2] = {0, 0};
+    };
+
+  private:
+    const VulkanDevice& m_Device;
+
+    uint32_t m_ThreadCount  = 0;
+    uint32_t m_CurrentFrame = 0;
+    // Indexed by frame * thread count + thread
+    std::vector<PoolData> m_Pools;
+    // Reused by RecordParallel, only ever touched by the thread recording the primary
+    std::vector<VkCommandBuffer> m_Secondaries;
+};
+
+} // namespace Noctis
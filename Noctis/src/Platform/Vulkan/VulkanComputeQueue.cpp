@@ -0,0 +1,182 @@
+#include "VulkanComputeQueue.h"
+
+namespace Noctis
+{
+
+VulkanComputeQueue::VulkanComputeQueue(const VulkanDevice& device, uint32_t framesInFlight) : m_Device(device)
+{
+    NOC_PROFILE_FUNCTION();
+
+    auto vkDevice = m_Device.GetVkDevice();
+
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = m_Device.GetQueueFamilyIndices().ComputeFamily;
+    VK_CHECK_RESULT(vkCreateCommandPool(vkDevice, &poolInfo, nullptr, &m_CommandPool));
+
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool        = m_CommandPool;
+    allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = 1;
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+    m_Frames.resize(framesInFlight);
+    for (FrameData& frame : m_Frames)
+    {
+        for (StageData& stage : frame.Stages)
+        {
+            VK_CHECK_RESULT(vkAllocateCommandBuffers(vkDevice, &allocInfo, &stage.CommandBuffer));
+            VK_CHECK_RESULT(vkCreateSemaphore(vkDevice, &semaphoreInfo, nullptr, &stage.FinishedSemaphore));
+        }
+        VK_CHECK_RESULT(vkCreateSemaphore(vkDevice, &semaphoreInfo, nullptr, &frame.GraphicsFinishedSemaphore));
+        VK_CHECK_RESULT(vkCreateFence(vkDevice, &fenceInfo, nullptr, &frame.Fence));
+    }
+
+    NOC_CORE_INFO("Compute queue: {0}", IsAsync() ? "async" : "shared with graphics");
+}
+
+VulkanComputeQueue::~VulkanComputeQueue()
+{
+    NOC_PROFILE_FUNCTION();
+
+    auto vkDevice = m_Device.GetVkDevice();
+
+    {
+        std::lock_guard lock(m_Device.GetQueueMutex());
+        vkQueueWaitIdle(m_Device.GetVkComputeQueue());
+    }
+
+    for (FrameData& frame : m_Frames)
+    {
+        for (StageData& stage : frame.Stages)
+            vkDestroySemaphore(vkDevice, stage.FinishedSemaphore, nullptr);
+        vkDestroySemaphore(vkDevice, frame.GraphicsFinishedSemaphore, nullptr);
+        vkDestroyFence(vkDevice, frame.Fence, nullptr);
+    }
+    m_Frames.clear();
+
+    vkDestroyCommandPool(vkDevice, m_CommandPool, nullptr);
+}
+
+void VulkanComputeQueue::BeginFrame(uint32_t frameIndex)
+{
+    NOC_PROFILE_FUNCTION();
+
+    m_CurrentFrame   = frameIndex;
+    FrameData& frame = m_Frames[m_CurrentFrame];
+
+    // Normally long done: the graphics work that waited for it is covered by the frame fence
+    vkWaitForFences(m_Device.GetVkDevice(), 1, &frame.Fence, VK_TRUE, UINT64_MAX);
+
+    for (StageData& stage : frame.Stages)
+    {
+        stage.GraphicsStages = 0;
+        stage.Recording      = false;
+    }
+}
+
+VkCommandBuffer VulkanComputeQueue::GetCommandBuffer(Stage stage, VkPipelineStageFlags graphicsWaitStage)
+{
+    StageData& data = m_Frames[m_CurrentFrame].Stages[static_cast<uint32_t>(stage)];
+    data.GraphicsStages |= graphicsWaitStage;
+
+    if (!data.Recording)
+    {
+        vkResetCommandBuffer(data.CommandBuffer, 0);
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        VK_CHECK_RESULT(vkBeginCommandBuffer(data.CommandBuffer, &beginInfo));
+
+        data.Recording = true;
+    }
+
+    return data.CommandBuffer;
+}
+
+void VulkanComputeQueue::SubmitBeforeGraphics(std::vector<VkSemaphore>& waitSemaphores,
+                                              std::vector<VkPipelineStageFlags>& waitStages)
+{
+    NOC_PROFILE_FUNCTION();
+
+    FrameData& frame        = m_Frames[m_CurrentFrame];
+    StageData& before       = frame.Stages[static_cast<uint32_t>(Stage::BeforeGraphics)];
+    const bool hasAfterWork = frame.Stages[static_cast<uint32_t>(Stage::AfterGraphics)].Recording;
+
+    if (m_PendingSemaphore != VK_NULL_HANDLE)
+    {
+        waitSemaphores.push_back(m_PendingSemaphore);
+        waitStages.push_back(m_PendingWaitStages);
+        m_PendingSemaphore = VK_NULL_HANDLE;
+    }
+
+    if (!before.Recording)
+        return;
+
+    // The frame's last compute submission carries the fence
+    Submit(before, VK_NULL_HANDLE, hasAfterWork ? VK_NULL_HANDLE : frame.Fence);
+
+    waitSemaphores.push_back(before.FinishedSemaphore);
+    waitStages.push_back(before.GraphicsStages);
+}
+
+VkSemaphore VulkanComputeQueue::GetGraphicsFinishedSemaphore() const
+{
+    const FrameData& frame = m_Frames[m_CurrentFrame];
+    return frame.Stages[static_cast<uint32_t>(Stage::AfterGraphics)].Recording ? frame.GraphicsFinishedSemaphore
+                                                                               : VK_NULL_HANDLE;
+}
+
+void VulkanComputeQueue::SubmitAfterGraphics()
+{
+    NOC_PROFILE_FUNCTION();
+
+    FrameData& frame = m_Frames[m_CurrentFrame];
+    StageData& after = frame.Stages[static_cast<uint32_t>(Stage::AfterGraphics)];
+    if (!after.Recording)
+        return;
+
+    Submit(after, frame.GraphicsFinishedSemaphore, frame.Fence);
+
+    m_PendingSemaphore  = after.FinishedSemaphore;
+    m_PendingWaitStages = after.GraphicsStages;
+}
+
+void VulkanComputeQueue::Submit(StageData& stage, VkSemaphore waitSemaphore, VkFence fence)
+{
+    VK_CHECK_RESULT(vkEndCommandBuffer(stage.CommandBuffer));
+
+    const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.waitSemaphoreCount   = waitSemaphore != VK_NULL_HANDLE ? 1 : 0;
+    submitInfo.pWaitSemaphores      = &waitSemaphore;
+    submitInfo.pWaitDstStageMask    = &waitStage;
+    submitInfo.commandBufferCount   = 1;
+    submitInfo.pCommandBuffers      = &stage.CommandBuffer;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores    = &stage.FinishedSemaphore;
+
+    if (fence != VK_NULL_HANDLE)
+        vkResetFences(m_Device.GetVkDevice(), 1, &fence);
+
+    {
+        NOC_PROFILE_SCOPE("vkQueueSubmit");
+        std::lock_guard lock(m_Device.GetQueueMutex());
+        VK_CHECK_RESULT(vkQueueSubmit(m_Device.GetVkComputeQueue(), 1, &submitInfo, fence));
+    }
+
+    stage.Recording = false;
+}
+
+} // namespace Noctis
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "VulkanDevice.h"
+
+namespace Noctis
+{
+
+// Records compute work that runs on the async compute queue next to the frame's graphics work. On devices without a
+// separate compute family the same submissions go to the graphics queue, so callers never need two code paths.
+//
+// Work recorded for BeforeGraphics is submitted ahead of the frame's graphics submission, which waits for it at the
+// requested stage: everything the frame does before that stage (shadow maps, depth prepass...) overlaps it. Work
+// recorded for AfterGraphics starts once the frame's graphics work is done and overlaps the next frame up to its
+// requested stage.
+//
+// Resources accessed on both queues should be created with VK_SHARING_MODE_CONCURRENT between the graphics and
+// compute families, the semaphores only order the work.
+class VulkanComputeQueue
+{
+  public:
+    enum class Stage
+    {
+        BeforeGraphics = 0,
+        AfterGraphics  = 1
+    };
+
+  public:
+    VulkanComputeQueue(const VulkanDevice& device, uint32_t framesInFlight);
+    ~VulkanComputeQueue();
+
+    // Waits for the compute work this frame slot submitted last time around, then recycles its command buffers
+    void BeginFrame(uint32_t frameIndex);
+
+    // Begins the command buffer on first use in the frame. graphicsWaitStage is the first graphics stage that
+    // consumes the results.
+    VkCommandBuffer GetCommandBuffer(Stage stage, VkPipelineStageFlags graphicsWaitStage);
+
+    // Called by the renderer around its graphics submission. SubmitBeforeGraphics appends the semaphores the graphics
+    // submission waits on, GetGraphicsFinishedSemaphore returns the one it has to signal (VK_NULL_HANDLE when no
+    // AfterGraphics work was recorded).
+    void SubmitBeforeGraphics(std::vector<VkSemaphore>& waitSemaphores, std::vector<VkPipelineStageFlags>& waitStages);
+    VkSemaphore GetGraphicsFinishedSemaphore() const;
+    void SubmitAfterGraphics();
+
+    bool IsAsync() const { return m_Device.HasAsyncComputeQueue(); }
+
+  private:
+    struct StageData
+    {
+        VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+        // Signalled when the compute work is done, waited on by a graphics submission
+        VkSemaphore FinishedSemaphore       = VK_NULL_HANDLE;
+        VkPipelineStageFlags GraphicsStages = 0;
+        bool Recording                      = false;
+    };
+
+    struct FrameData
+    {
+        StageData Stages[2];
+        VkSemaphore GraphicsFinishedSemaphore = VK_NULL_HANDLE;
+        // Signalled by the frame's last compute submission
+        VkFence Fence = VK_NULL_HANDLE;
+    };
+
+    void Submit(StageData& stage, VkSemaphore waitSemaphore, VkFence fence);
+
+  private:
+    const VulkanDevice& m_Device;
+    VkCommandPool m_CommandPool = VK_NULL_HANDLE;
+
+    std::vector<FrameData> m_Frames;
+    uint32_t m_CurrentFrame = 0;
+
+    // AfterGraphics work of the previous frame, the next graphics submission waits for it
+    VkSemaphore m_PendingSemaphore           = VK_NULL_HANDLE;
+    VkPipelineStageFlags m_PendingWaitStages = 0;
+};
+
+} // namespace Noctis
@@ -6,6 +6,8 @@
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 
+#include <cstring>
+
 namespace Noctis
 {
 
@@ -15,10 +17,17 @@ VulkanContext::VulkanContext()
 
 VulkanContext::~VulkanContext()
 {
+    NOC_PROFILE_FUNCTION();
+
     m_Swapchain.reset();
+    m_Uploader.reset();
+    m_BindlessTable.reset();
+    m_LayoutCache.reset();
+    m_Allocator.reset();
     m_Device.reset();
 
-    vkDestroySurfaceKHR(s_Instance, m_Surface, nullptr);
+    if (m_Surface != VK_NULL_HANDLE)
+        vkDestroySurfaceKHR(s_Instance, m_Surface, nullptr);
     m_Surface = VK_NULL_HANDLE;
 
     m_DebugUtils.DestroyDebugUtils(s_Instance, m_DebugUtils.GetDebugMessenger(), nullptr);
@@ -29,21 +38,53 @@ VulkanContext::~VulkanContext()
 
 void VulkanContext::Init()
 {
+    NOC_PROFILE_FUNCTION();
+
     s_Instance = CreateInstance();
     NOC_CORE_INFO("Vulkan instance created");
 
     m_DebugUtils.SetupDebugUtils(s_Instance);
 
-    CreateSurface();
+    // Headless contexts have no surface, the swapchain then manages offscreen images instead
+    if (!IsHeadless())
+        CreateSurface();
 
     m_Device.reset(new VulkanDevice(s_Instance, m_Surface));
 
-    m_Swapchain.reset(new VulkanSwapchain(*m_Device, m_Surface));
-    m_Swapchain->CreateSwapchain(1280, 720);
+    m_Allocator   = CreateRef<VulkanAllocator>(*m_Device);
+    m_Uploader    = CreateRef<VulkanUploader>(*m_Device, *m_Allocator);
+    m_LayoutCache = CreateRef<VulkanLayoutCache>(*m_Device);
+    if (m_Device->SupportsBindless())
+        m_BindlessTable = CreateRef<VulkanBindlessTable>(*m_Device, *m_LayoutCache);
+
+    m_Swapchain.reset(new VulkanSwapchain(*m_Device, *m_Allocator, m_Surface));
+
+    if (IsHeadless())
+    {
+        m_Swapchain->CreateSwapchain(m_OffscreenExtent.width, m_OffscreenExtent.height);
+        return;
+    }
+
+    int width, height;
+    glfwGetFramebufferSize(m_WindowHandle, &width, &height);
+    m_Swapchain->CreateSwapchain(static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+}
+
+void VulkanContext::SetOffscreenExtent(uint32_t width, uint32_t height)
+{
+    m_OffscreenExtent = {width, height};
+}
+
+void VulkanContext::SetVSync(bool enabled)
+{
+    // Mailbox doesn't tear either, but unlike Fifo it never blocks on the display
+    m_Swapchain->SetPresentMode(enabled ? PresentMode::Mailbox : PresentMode::Immediate);
 }
 
 VkInstance VulkanContext::CreateInstance()
 {
+    NOC_PROFILE_FUNCTION();
+
     // Vulkan application info
     VkApplicationInfo appInfo  = {};
     appInfo.sType              = VK_STRUCTURE_TYPE_APPLICATION_INFO;
@@ -57,23 +98,52 @@ VkInstance VulkanContext::CreateInstance()
     VkInstanceCreateInfo createInfo{};
     createInfo.sType            = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
     createInfo.pApplicationInfo = &appInfo;
-    createInfo.flags |= VK_INSTANCE_CREATE_ENUMERATE_PORTABILITY_BIT_KHR;
 
-    // TODO: Platform specific extensions
-    uint32_t glfwExtensionCount = 0;
-    const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-
-    std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
-    extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
-    extensions.push_back(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME);
-    extensions.push_back("VK_MVK_macos_surface");
-    extensions.push_back("VK_KHR_get_physical_device_properties2");
+    uint32_t availableExtensionCount = 0;
+    vkEnumerateInstanceExtensionProperties(nullptr, &availableExtensionCount, nullptr);
+    std::vector<VkExtensionProperties> availableExtensions(availableExtensionCount);
+    vkEnumerateInstanceExtensionProperties(nullptr, &availableExtensionCount, availableExtensions.data());
+
+    // Surface extensions are only needed with a window, GLFW isn't even initialized when headless
+    std::vector<const char*> extensions;
+    if (!IsHeadless())
+    {
+        uint32_t glfwExtensionCount = 0;
+        const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+        extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    }
+
+    // The rest is optional, software drivers like lavapipe on a headless Linux box don't have the macOS ones
+    auto addIfAvailable = [&](const char* name) {
+        if (!IsInstanceExtensionAvailable(availableExtensions, name))
+            return false;
+        extensions.push_back(name);
+        return true;
+    };
+
+    addIfAvailable(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    if (addIfAvailable(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME))
+        createInfo.flags |= VK_INSTANCE_CREATE_ENUMERATE_PORTABILITY_BIT_KHR;
+    if (!IsHeadless())
+        addIfAvailable("VK_MVK_macos_surface");
+    addIfAvailable("VK_KHR_get_physical_device_properties2");
 
     createInfo.enabledExtensionCount   = static_cast<uint32_t>(extensions.size());
     createInfo.ppEnabledExtensionNames = extensions.data();
 
+    uint32_t layerCount = 0;
+    vkEnumerateInstanceLayerProperties(&layerCount, nullptr);
+    std::vector<VkLayerProperties> availableLayers(layerCount);
+    vkEnumerateInstanceLayerProperties(&layerCount, availableLayers.data());
+
     std::vector<const char*> layers;
-    layers.push_back("VK_LAYER_KHRONOS_validation");
+    for (const VkLayerProperties& layer : availableLayers)
+    {
+        if (std::strcmp(layer.layerName, "VK_LAYER_KHRONOS_validation") == 0)
+            layers.push_back("VK_LAYER_KHRONOS_validation");
+    }
+    if (layers.empty())
+        NOC_CORE_WARN("VK_LAYER_KHRONOS_validation is not available, running without validation");
 
     createInfo.enabledLayerCount   = layers.size();
     createInfo.ppEnabledLayerNames = layers.data();
@@ -85,8 +155,21 @@ VkInstance VulkanContext::CreateInstance()
     return instance;
 }
 
+bool VulkanContext::IsInstanceExtensionAvailable(const std::vector<VkExtensionProperties>& available,
+                                                 const char* name)
+{
+    for (const VkExtensionProperties& extension : available)
+    {
+        if (std::strcmp(extension.extensionName, name) == 0)
+            return true;
+    }
+    return false;
+}
+
 void VulkanContext::CreateSurface()
 {
+    NOC_PROFILE_FUNCTION();
+
     if (glfwCreateWindowSurface(s_Instance, m_WindowHandle, nullptr, &m_Surface))
         NOC_CORE_ERROR("Error creating window surface!");
 }
@@ -2,9 +2,13 @@
 
 #include "Engine/Renderer/Renderer.h"
 
+#include "Platform/Vulkan/VulkanAllocator.h"
+#include "Platform/Vulkan/VulkanBindlessTable.h"
 #include "Platform/Vulkan/VulkanDebugUtils.h"
 #include "Platform/Vulkan/VulkanDevice.h"
+#include "Platform/Vulkan/VulkanLayoutCache.h"
 #include "Platform/Vulkan/VulkanSwapchain.h"
+#include "Platform/Vulkan/VulkanUploader.h"
 
 struct GLFWwindow;
 
@@ -20,9 +24,18 @@ class VulkanContext : public RendererContext
     void Init() override;
 
     Ref<VulkanDevice> GetDevice() { return m_Device; }
+    Ref<VulkanAllocator> GetAllocator() { return m_Allocator; }
+    Ref<VulkanUploader> GetUploader() { return m_Uploader; }
+    Ref<VulkanLayoutCache> GetLayoutCache() { return m_LayoutCache; }
+    // Null on devices without descriptor indexing
+    Ref<VulkanBindlessTable> GetBindlessTable() { return m_BindlessTable; }
     Ref<VulkanSwapchain> GetSwapchain() { return m_Swapchain; }
 
     void SetWindowHandle(GLFWwindow* window) override { m_WindowHandle = window; }
+    void SetVSync(bool enabled) override;
+    void SetOffscreenExtent(uint32_t width, uint32_t height) override;
+
+    bool IsHeadless() const { return m_WindowHandle == nullptr; }
 
     static VkInstance GetInstance() { return s_Instance; }
 
@@ -32,14 +45,21 @@ class VulkanContext : public RendererContext
     VkInstance CreateInstance();
     void CreateSurface();
 
+    static bool IsInstanceExtensionAvailable(const std::vector<VkExtensionProperties>& available, const char* name);
+
   private:
     inline static VkInstance s_Instance;
 
-    GLFWwindow* m_WindowHandle;
+    GLFWwindow* m_WindowHandle   = nullptr;
+    VkExtent2D m_OffscreenExtent = {1280, 720};
 
-    VkSurfaceKHR m_Surface;
+    VkSurfaceKHR m_Surface = VK_NULL_HANDLE;
     VulkanDebugUtils m_DebugUtils;
     Ref<VulkanDevice> m_Device;
+    Ref<VulkanAllocator> m_Allocator;
+    Ref<VulkanUploader> m_Uploader;
+    Ref<VulkanLayoutCache> m_LayoutCache;
+    Ref<VulkanBindlessTable> m_BindlessTable;
     Ref<VulkanSwapchain> m_Swapchain;
 };
 
@@ -1,22 +1,61 @@
 #include "VulkanDevice.h"
 
+#include "Engine/Core/FileSystem.h"
+#include "Engine/Core/Hash.h"
+
+#include <cstring>
+
 namespace Noctis
 {
 
+namespace
+{
+
+// Written ahead of the driver's cache data. The driver validates its own header, but only against the device and
+// cache UUID: the driver UUID and data hash also catch driver updates and truncated or corrupted files.
+struct PipelineCacheFileHeader
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t VendorID;
+    uint32_t DeviceID;
+    uint32_t DriverVersion;
+    uint8_t PipelineCacheUUID[VK_UUID_SIZE];
+    uint8_t DriverUUID[VK_UUID_SIZE];
+    uint64_t DataSize;
+    uint64_t DataHash;
+};
+
+constexpr uint32_t PIPELINE_CACHE_MAGIC   = 0x4843504e; // "NPCH"
+constexpr uint32_t PIPELINE_CACHE_VERSION = 1;
+
+} // namespace
+
 VulkanDevice::VulkanDevice(VkInstance& instance, VkSurfaceKHR& surface) : m_Instance(instance), m_Surface(surface)
 {
+    NOC_PROFILE_FUNCTION();
+
     PickPhysicalDevice();
     CreateLogicalDevice();
+    CreatePipelineCache();
 }
 
 VulkanDevice::~VulkanDevice()
 {
+    NOC_PROFILE_FUNCTION();
+
+    JobSystem::Wait(m_PipelineCacheSaveCounter);
+    SavePipelineCache();
+    vkDestroyPipelineCache(m_Device, m_PipelineCache, nullptr);
+
     vkDestroyDevice(m_Device, nullptr);
     m_Device = VK_NULL_HANDLE;
 }
 
 void VulkanDevice::PickPhysicalDevice()
 {
+    NOC_PROFILE_FUNCTION();
+
     uint32_t deviceCount = 0;
     vkEnumeratePhysicalDevices(m_Instance, &deviceCount, nullptr);
     NOC_CORE_ASSERT(deviceCount != 0, "Failed to find GPUs with Vulkan support!");
@@ -38,8 +77,8 @@ void VulkanDevice::PickPhysicalDevice()
     NOC_CORE_ASSERT(m_PhysicalDevice != VK_NULL_HANDLE, "Failed to find a suitable GPU!");
 
     // Query and log physical device details
-    VkPhysicalDeviceProperties deviceProperties;
-    vkGetPhysicalDeviceProperties(m_PhysicalDevice, &deviceProperties);
+    vkGetPhysicalDeviceProperties(m_PhysicalDevice, &m_Properties);
+    const VkPhysicalDeviceProperties& deviceProperties = m_Properties;
 
     VkPhysicalDeviceFeatures deviceFeatures;
     vkGetPhysicalDeviceFeatures(m_PhysicalDevice, &deviceFeatures);
@@ -51,14 +90,31 @@ void VulkanDevice::PickPhysicalDevice()
     NOC_CORE_INFO("  Device Name: {0}", deviceProperties.deviceName);
     NOC_CORE_INFO("  Device Type: {0}", DeviceTypeToString(deviceProperties.deviceType));
     NOC_CORE_INFO("  Driver Version: {0}", deviceProperties.driverVersion);
+
+    m_DescriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+
+    VkPhysicalDeviceIDProperties idProperties{};
+    idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+    // Vulkan 1.2 structures can only be chained on 1.2 devices
+    if (m_Properties.apiVersion >= VK_API_VERSION_1_2)
+        idProperties.pNext = &m_DescriptorIndexingProperties;
+
+    VkPhysicalDeviceProperties2 properties2{};
+    properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties2.pNext = &idProperties;
+    vkGetPhysicalDeviceProperties2(m_PhysicalDevice, &properties2);
+    std::memcpy(m_DriverUUID, idProperties.driverUUID, VK_UUID_SIZE);
 }
 
 void VulkanDevice::CreateLogicalDevice()
 {
+    NOC_PROFILE_FUNCTION();
+
     QueueFamilyIndices indices = FindQueueFamilies(m_PhysicalDevice);
 
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-    std::set<uint32_t> uniqueQueueFamilies = {indices.GraphicsFamily, indices.PresentFamily};
+    std::set<uint32_t> uniqueQueueFamilies = {indices.GraphicsFamily, indices.PresentFamily, indices.TransferFamily,
+                                              indices.ComputeFamily};
 
     float queuePriority = 1.0f;
     for (uint32_t queueFamily : uniqueQueueFamilies)
@@ -71,17 +127,71 @@ void VulkanDevice::CreateLogicalDevice()
         queueCreateInfos.push_back(queueCreateInfo);
     }
 
-    VkPhysicalDeviceFeatures deviceFeatures = {};
-    deviceFeatures.samplerAnisotropy        = VK_TRUE;
+    VkPhysicalDeviceVulkan12Features supported12{};
+    supported12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+    const bool hasVulkan12 = m_Properties.apiVersion >= VK_API_VERSION_1_2;
+
+    VkPhysicalDeviceFeatures2 supported{};
+    supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    supported.pNext = hasVulkan12 ? &supported12 : nullptr;
+    vkGetPhysicalDeviceFeatures2(m_PhysicalDevice, &supported);
+
+    VkPhysicalDeviceVulkan12Features enabled12{};
+    enabled12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+    VkPhysicalDeviceFeatures2 enabled{};
+    enabled.sType                      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    enabled.pNext                      = hasVulkan12 ? &enabled12 : nullptr;
+    enabled.features.samplerAnisotropy = VK_TRUE;
+
+    // Everything the bindless table needs: non-uniformly indexed, partially bound arrays updated while in use. The
+    // aggregate descriptorIndexing bit isn't required, some devices expose these features without it.
+    m_BindlessSupported = supported12.runtimeDescriptorArray && supported12.descriptorBindingPartiallyBound &&
+                          supported12.descriptorBindingVariableDescriptorCount &&
+                          supported12.descriptorBindingUpdateUnusedWhilePending &&
+                          supported12.descriptorBindingSampledImageUpdateAfterBind &&
+                          supported12.descriptorBindingStorageBufferUpdateAfterBind &&
+                          supported12.shaderSampledImageArrayNonUniformIndexing &&
+                          supported12.shaderStorageBufferArrayNonUniformIndexing;
+    if (m_BindlessSupported)
+    {
+        enabled12.runtimeDescriptorArray                        = VK_TRUE;
+        enabled12.descriptorBindingPartiallyBound               = VK_TRUE;
+        enabled12.descriptorBindingVariableDescriptorCount      = VK_TRUE;
+        enabled12.descriptorBindingUpdateUnusedWhilePending     = VK_TRUE;
+        enabled12.descriptorBindingSampledImageUpdateAfterBind  = VK_TRUE;
+        enabled12.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+        enabled12.shaderSampledImageArrayNonUniformIndexing     = VK_TRUE;
+        enabled12.shaderStorageBufferArrayNonUniformIndexing    = VK_TRUE;
+    }
 
-    std::vector<const char*> deviceExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME, "VK_KHR_portability_subset"};
+    // GPU-driven rendering: one indirect draw per instance, picked out by firstInstance, see VulkanMeshRenderer
+    m_MultiDrawIndirectSupported = supported.features.multiDrawIndirect && supported.features.drawIndirectFirstInstance;
+    if (m_MultiDrawIndirectSupported)
+    {
+        enabled.features.multiDrawIndirect         = VK_TRUE;
+        enabled.features.drawIndirectFirstInstance = VK_TRUE;
+    }
+    m_DrawIndirectCountSupported = supported12.drawIndirectCount;
+    if (m_DrawIndirectCountSupported)
+        enabled12.drawIndirectCount = VK_TRUE;
+
+    // Without a surface (headless) there is nothing to present to
+    std::vector<const char*> deviceExtensions;
+    if (m_Surface != VK_NULL_HANDLE)
+        deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+    // Must be enabled when the implementation exposes it (MoltenVK), most drivers don't
+    if (IsExtensionSupported(m_PhysicalDevice, "VK_KHR_portability_subset"))
+        deviceExtensions.push_back("VK_KHR_portability_subset");
 
     VkDeviceCreateInfo createInfo = {};
     createInfo.sType              = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    // Features come through the pNext chain, so pEnabledFeatures stays null
+    createInfo.pNext = &enabled;
 
     createInfo.queueCreateInfoCount    = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos       = queueCreateInfos.data();
-    createInfo.pEnabledFeatures        = &deviceFeatures;
     createInfo.enabledExtensionCount   = static_cast<uint32_t>(deviceExtensions.size());
     createInfo.ppEnabledExtensionNames = deviceExtensions.data();
 
@@ -90,8 +200,120 @@ void VulkanDevice::CreateLogicalDevice()
 
     vkGetDeviceQueue(m_Device, indices.GraphicsFamily, 0, &m_GraphicsQueue);
     vkGetDeviceQueue(m_Device, indices.PresentFamily, 0, &m_PresentQueue);
+    vkGetDeviceQueue(m_Device, indices.TransferFamily, 0, &m_TransferQueue);
+    vkGetDeviceQueue(m_Device, indices.ComputeFamily, 0, &m_ComputeQueue);
 
     NOC_CORE_INFO("Logical device created");
+    NOC_CORE_INFO("  Queue families: graphics {0}, present {1}, transfer {2}, compute {3}", indices.GraphicsFamily,
+                  indices.PresentFamily, indices.TransferFamily, indices.ComputeFamily);
+    NOC_CORE_INFO("  Bindless descriptors: {0}", m_BindlessSupported ? "supported" : "unsupported");
+    NOC_CORE_INFO("  Multi-draw indirect: {0}, with count: {1}", m_MultiDrawIndirectSupported ? "yes" : "no",
+                  m_DrawIndirectCountSupported ? "yes" : "no");
+}
+
+void VulkanDevice::CreatePipelineCache()
+{
+    NOC_PROFILE_FUNCTION();
+
+    const std::vector<uint8_t> data = LoadPipelineCacheData();
+
+    VkPipelineCacheCreateInfo createInfo{};
+    createInfo.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.initialDataSize = data.size();
+    createInfo.pInitialData    = data.data();
+
+    if (vkCreatePipelineCache(m_Device, &createInfo, nullptr, &m_PipelineCache) != VK_SUCCESS)
+    {
+        NOC_CORE_WARN("Pipeline cache data was rejected by the driver, starting with an empty cache");
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData    = nullptr;
+        VK_CHECK_RESULT(vkCreatePipelineCache(m_Device, &createInfo, nullptr, &m_PipelineCache));
+    }
+
+    m_PipelineCacheSavedSize = data.size();
+    NOC_CORE_INFO("Pipeline cache: loaded {0} bytes", data.size());
+}
+
+std::vector<uint8_t> VulkanDevice::LoadPipelineCacheData()
+{
+    std::vector<uint8_t> file;
+    if (!FileSystem::ReadFile(PIPELINE_CACHE_PATH, file))
+        return {};
+
+    auto discard = [](const char* reason) {
+        NOC_CORE_WARN("Discarding pipeline cache {0}: {1}", PIPELINE_CACHE_PATH, reason);
+        std::error_code error;
+        std::filesystem::remove(PIPELINE_CACHE_PATH, error);
+        return std::vector<uint8_t>();
+    };
+
+    PipelineCacheFileHeader header;
+    if (file.size() < sizeof(header))
+        return discard("truncated header");
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (header.Magic != PIPELINE_CACHE_MAGIC || header.Version != PIPELINE_CACHE_VERSION)
+        return discard("unknown format");
+
+    // A different GPU or driver makes the cache useless rather than corrupt, but it is replaced all the same
+    if (header.VendorID != m_Properties.vendorID || header.DeviceID != m_Properties.deviceID ||
+        header.DriverVersion != m_Properties.driverVersion ||
+        std::memcmp(header.PipelineCacheUUID, m_Properties.pipelineCacheUUID, VK_UUID_SIZE) != 0 ||
+        std::memcmp(header.DriverUUID, m_DriverUUID, VK_UUID_SIZE) != 0)
+        return discard("written by a different device or driver");
+
+    if (file.size() - sizeof(header) != header.DataSize)
+        return discard("truncated data");
+
+    std::vector<uint8_t> data(file.begin() + sizeof(header), file.end());
+    if (Hash::FNV1a(data.data(), data.size()) != header.DataHash)
+        return discard("checksum mismatch");
+
+    return data;
+}
+
+void VulkanDevice::SavePipelineCache()
+{
+    NOC_PROFILE_FUNCTION();
+
+    std::lock_guard lock(m_PipelineCacheSaveMutex);
+
+    size_t size = 0;
+    VK_CHECK_RESULT(vkGetPipelineCacheData(m_Device, m_PipelineCache, &size, nullptr));
+    if (size == m_PipelineCacheSavedSize)
+        return;
+
+    // Header and cache data in one buffer, the file is written in one go
+    std::vector<uint8_t> file(sizeof(PipelineCacheFileHeader) + size);
+    uint8_t* data = file.data() + sizeof(PipelineCacheFileHeader);
+    VK_CHECK_RESULT(vkGetPipelineCacheData(m_Device, m_PipelineCache, &size, data));
+    file.resize(sizeof(PipelineCacheFileHeader) + size);
+
+    PipelineCacheFileHeader header{};
+    header.Magic         = PIPELINE_CACHE_MAGIC;
+    header.Version       = PIPELINE_CACHE_VERSION;
+    header.VendorID      = m_Properties.vendorID;
+    header.DeviceID      = m_Properties.deviceID;
+    header.DriverVersion = m_Properties.driverVersion;
+    header.DataSize      = size;
+    header.DataHash      = Hash::FNV1a(data, size);
+    std::memcpy(header.PipelineCacheUUID, m_Properties.pipelineCacheUUID, VK_UUID_SIZE);
+    std::memcpy(header.DriverUUID, m_DriverUUID, VK_UUID_SIZE);
+    std::memcpy(file.data(), &header, sizeof(header));
+
+    if (!FileSystem::WriteFileAtomic(PIPELINE_CACHE_PATH, file.data(), file.size()))
+        return;
+
+    m_PipelineCacheSavedSize = size;
+    NOC_CORE_TRACE("Pipeline cache: saved {0} bytes", size);
+}
+
+void VulkanDevice::SavePipelineCacheAsync()
+{
+    if (!m_PipelineCacheSaveCounter.IsDone())
+        return;
+
+    JobSystem::Execute([this]() { SavePipelineCache(); }, &m_PipelineCacheSaveCounter);
 }
 
 bool VulkanDevice::IsDeviceSuitable(VkPhysicalDevice device)
@@ -127,8 +349,12 @@ QueueFamilyIndices VulkanDevice::FindQueueFamilies(VkPhysicalDevice device)
             indices.GraphicsFamily         = i;
             indices.GraphicsFamilyHasValue = true;
         }
+        // Headless "presentation" only retires offscreen images, which the graphics queue can do
         VkBool32 presentSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_Surface, &presentSupport);
+        if (m_Surface != VK_NULL_HANDLE)
+            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_Surface, &presentSupport);
+        else
+            presentSupport = queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT ? VK_TRUE : VK_FALSE;
         if (queueFamily.queueCount > 0 && presentSupport)
         {
             indices.PresentFamily         = i;
@@ -140,9 +366,73 @@ QueueFamilyIndices VulkanDevice::FindQueueFamilies(VkPhysicalDevice device)
         i++;
     }
 
+    // Transfer-only families map to the DMA engines, uploads there run beside graphics work instead of in front of
+    // it. A compute family is the next best thing, graphics is the fallback.
+    indices.TransferFamily     = indices.GraphicsFamily;
+    uint32_t bestTransferScore = 0;
+    for (uint32_t family = 0; family < queueFamilyCount; family++)
+    {
+        const VkQueueFlags flags = queueFamilies[family].queueFlags;
+        if (queueFamilies[family].queueCount == 0 || !(flags & VK_QUEUE_TRANSFER_BIT) || flags & VK_QUEUE_GRAPHICS_BIT)
+            continue;
+
+        const uint32_t score = flags & VK_QUEUE_COMPUTE_BIT ? 1 : 2;
+        if (score > bestTransferScore)
+        {
+            indices.TransferFamily = family;
+            bestTransferScore      = score;
+        }
+    }
+
+    // Async compute needs a compute family without graphics, ideally not the one uploads go through
+    indices.ComputeFamily     = indices.GraphicsFamily;
+    uint32_t bestComputeScore = 0;
+    for (uint32_t family = 0; family < queueFamilyCount; family++)
+    {
+        const VkQueueFlags flags = queueFamilies[family].queueFlags;
+        if (queueFamilies[family].queueCount == 0 || !(flags & VK_QUEUE_COMPUTE_BIT) || flags & VK_QUEUE_GRAPHICS_BIT)
+            continue;
+
+        const uint32_t score = family != indices.TransferFamily ? 2 : 1;
+        if (score > bestComputeScore)
+        {
+            indices.ComputeFamily = family;
+            bestComputeScore      = score;
+        }
+    }
+
     return indices;
 }
 
+bool VulkanDevice::IsExtensionSupported(VkPhysicalDevice device, const char* name)
+{
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+
+    std::vector<VkExtensionProperties> extensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, extensions.data());
+
+    for (const auto& extension : extensions)
+    {
+        if (std::strcmp(extension.extensionName, name) == 0)
+            return true;
+    }
+    return false;
+}
+
+uint32_t VulkanDevice::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const
+{
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &memoryProperties);
+
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+    {
+        if ((typeFilter & (1 << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+            return i;
+    }
+    return UINT32_MAX;
+}
+
 std::string VulkanDevice::DeviceTypeToString(VkPhysicalDeviceType type)
 {
     switch (type)
@@ -2,6 +2,10 @@
 
 #include "Vulkan.h"
 
+#include "Engine/Core/JobSystem.h"
+
+#include <mutex>
+
 namespace Noctis
 {
 
@@ -9,6 +13,9 @@ struct QueueFamilyIndices
 {
     uint32_t GraphicsFamily;
     uint32_t PresentFamily;
+    // Both fall back to the graphics family on devices without a separate one
+    uint32_t TransferFamily;
+    uint32_t ComputeFamily;
     bool GraphicsFamilyHasValue = false;
     bool PresentFamilyHasValue  = false;
     bool IsComplete() const { return GraphicsFamilyHasValue && PresentFamilyHasValue; }
@@ -22,17 +29,59 @@ class VulkanDevice
 
     VkDevice GetVkDevice() const { return m_Device; }
     VkPhysicalDevice GetVkPhysicalDevice() const { return m_PhysicalDevice; }
+    const VkPhysicalDeviceProperties& GetProperties() const { return m_Properties; }
     VkQueue GetVkGraphicsQueue() const { return m_GraphicsQueue; }
     VkQueue GetVkPresentQueue() const { return m_PresentQueue; }
+    VkQueue GetVkTransferQueue() const { return m_TransferQueue; }
+    VkQueue GetVkComputeQueue() const { return m_ComputeQueue; }
+    bool HasDedicatedTransferQueue() const
+    {
+        return m_QueueFamilyIndices.TransferFamily != m_QueueFamilyIndices.GraphicsFamily;
+    }
+    bool HasAsyncComputeQueue() const
+    {
+        return m_QueueFamilyIndices.ComputeFamily != m_QueueFamilyIndices.GraphicsFamily;
+    }
     QueueFamilyIndices GetQueueFamilyIndices() const { return m_QueueFamilyIndices; }
+    // Descriptor indexing with update-after-bind, see VulkanBindlessTable
+    bool SupportsBindless() const { return m_BindlessSupported; }
+    const VkPhysicalDeviceDescriptorIndexingProperties& GetDescriptorIndexingProperties() const
+    {
+        return m_DescriptorIndexingProperties;
+    }
+    // multiDrawIndirect with drawIndirectFirstInstance
+    bool SupportsMultiDrawIndirect() const { return m_MultiDrawIndirectSupported; }
+    // vkCmdDrawIndexedIndirectCount, core in Vulkan 1.2
+    bool SupportsDrawIndirectCount() const { return m_DrawIndirectCountSupported; }
+    // Pass to every vkCreate*Pipelines call, it is persisted to PIPELINE_CACHE_PATH between runs
+    VkPipelineCache GetVkPipelineCache() const { return m_PipelineCache; }
+
+    // Held around vkQueueSubmit and vkQueuePresentKHR: queues need external synchronization, and the graphics queue
+    // doubles as the transfer queue on some devices
+    std::mutex& GetQueueMutex() const { return m_QueueMutex; }
+
+    // Index of a memory type allowed by typeFilter with all the requested properties, UINT32_MAX if there is none
+    uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+
+    // Writes the pipeline cache to disk if pipelines were added since the last save. The file is replaced atomically,
+    // so a crash mid-save leaves the previous cache intact.
+    void SavePipelineCache();
+    // Same, on a job thread. Does nothing while a save is still running.
+    void SavePipelineCacheAsync();
+
+    static constexpr const char* PIPELINE_CACHE_PATH = "cache/PipelineCache.bin";
 
   private:
     void CreateLogicalDevice();
+    void CreatePipelineCache();
+    // Cache data from disk, empty if the file is missing or doesn't match this device and driver
+    std::vector<uint8_t> LoadPipelineCacheData();
 
     void PickPhysicalDevice();
     bool IsDeviceSuitable(VkPhysicalDevice device);
     QueueFamilyIndices FindQueueFamilies(VkPhysicalDevice device);
     QueueFamilyIndices FindPhysicalQueueFamilies() { return FindQueueFamilies(m_PhysicalDevice); }
+    bool IsExtensionSupported(VkPhysicalDevice device, const char* name);
 
     std::string DeviceTypeToString(VkPhysicalDeviceType type);
     std::string GetVendorName(const VkPhysicalDeviceProperties& props);
@@ -41,10 +90,24 @@ class VulkanDevice
     VkInstance m_Instance;
     VkDevice m_Device;
     VkPhysicalDevice m_PhysicalDevice = VK_NULL_HANDLE;
+    VkPhysicalDeviceProperties m_Properties;
+    VkPhysicalDeviceDescriptorIndexingProperties m_DescriptorIndexingProperties{};
+    bool m_BindlessSupported          = false;
+    bool m_MultiDrawIndirectSupported = false;
+    bool m_DrawIndirectCountSupported = false;
 
     VkSurfaceKHR m_Surface;
     VkQueue m_GraphicsQueue;
     VkQueue m_PresentQueue;
+    VkQueue m_TransferQueue;
+    VkQueue m_ComputeQueue;
+    mutable std::mutex m_QueueMutex;
+
+    VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+    uint8_t m_DriverUUID[VK_UUID_SIZE];
+    std::mutex m_PipelineCacheSaveMutex;
+    size_t m_PipelineCacheSavedSize = 0;
+    JobCounter m_PipelineCacheSaveCounter;
     QueueFamilyIndices m_QueueFamilyIndices;
 };
 
@@ -0,0 +1,153 @@
+#include "VulkanGPUProfiler.h"
+
+namespace Noctis
+{
+
+VulkanGPUProfiler::VulkanGPUProfiler(const VulkanDevice& device, uint32_t framesInFlight, uint32_t maxRegions)
+    : m_Device(device), m_MaxRegions(maxRegions)
+{
+    NOC_PROFILE_FUNCTION();
+
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(m_Device.GetVkPhysicalDevice(), &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(m_Device.GetVkPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+    const uint32_t validBits = queueFamilies[m_Device.GetQueueFamilyIndices().GraphicsFamily].timestampValidBits;
+    m_TimestampPeriod        = m_Device.GetProperties().limits.timestampPeriod;
+    m_Supported              = validBits > 0 && m_TimestampPeriod > 0.0f;
+    if (!m_Supported)
+    {
+        NOC_CORE_WARN("GPU timestamps are not supported on the graphics queue, GPU profiling disabled");
+        return;
+    }
+    m_TimestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+
+    VkQueryPoolCreateInfo queryPoolInfo{};
+    queryPoolInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolInfo.queryCount = m_MaxRegions * 2;
+
+    m_Frames.resize(framesInFlight);
+    for (FrameQueries& frame : m_Frames)
+    {
+        VK_CHECK_RESULT(vkCreateQueryPool(m_Device.GetVkDevice(), &queryPoolInfo, nullptr, &frame.QueryPool));
+        frame.Regions.reserve(m_MaxRegions);
+    }
+
+    m_Results.reserve(m_MaxRegions * 4);
+    m_Timings.reserve(m_MaxRegions);
+}
+
+VulkanGPUProfiler::~VulkanGPUProfiler()
+{
+    for (FrameQueries& frame : m_Frames)
+        vkDestroyQueryPool(m_Device.GetVkDevice(), frame.QueryPool, nullptr);
+    m_Frames.clear();
+}
+
+void VulkanGPUProfiler::BeginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex)
+{
+    NOC_PROFILE_FUNCTION();
+
+    if (!m_Supported)
+        return;
+
+    m_CurrentFrame = frameIndex;
+    CollectResults(frameIndex);
+
+    FrameQueries& frame = m_Frames[frameIndex];
+    vkCmdResetQueryPool(commandBuffer, frame.QueryPool, 0, m_MaxRegions * 2);
+    frame.Regions.clear();
+    frame.Submitted = false;
+
+    BeginRegion(commandBuffer, "Frame");
+}
+
+void VulkanGPUProfiler::EndFrame(VkCommandBuffer commandBuffer)
+{
+    EndRegion(commandBuffer, 0);
+}
+
+void VulkanGPUProfiler::OnSubmit()
+{
+    if (!m_Supported)
+        return;
+
+    FrameQueries& frame = m_Frames[m_CurrentFrame];
+    frame.SubmitTime    = Profiler::GetTimestamp();
+    frame.Submitted     = true;
+}
+
+uint32_t VulkanGPUProfiler::BeginRegion(VkCommandBuffer commandBuffer, const char* name)
+{
+    if (!m_Supported)
+        return UINT32_MAX;
+
+    FrameQueries& frame = m_Frames[m_CurrentFrame];
+    if (frame.Regions.size() >= m_MaxRegions)
+        return UINT32_MAX;
+
+    const uint32_t region = static_cast<uint32_t>(frame.Regions.size());
+    frame.Regions.push_back(name);
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.QueryPool, region * 2);
+    return region;
+}
+
+void VulkanGPUProfiler::EndRegion(VkCommandBuffer commandBuffer, uint32_t region)
+{
+    if (!m_Supported || region == UINT32_MAX)
+        return;
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_Frames[m_CurrentFrame].QueryPool,
+                        region * 2 + 1);
+}
+
+void VulkanGPUProfiler::CollectResults(uint32_t frameIndex)
+{
+    FrameQueries& frame = m_Frames[frameIndex];
+    if (!frame.Submitted || frame.Regions.empty())
+        return;
+    frame.Submitted = false;
+
+    // Each query yields its value followed by an availability word. Without the WAIT flag this never blocks, a
+    // region that somehow isn't available yet is just skipped.
+    const uint32_t queryCount = static_cast<uint32_t>(frame.Regions.size()) * 2;
+    m_Results.resize(queryCount * 2);
+    const VkResult result =
+        vkGetQueryPoolResults(m_Device.GetVkDevice(), frame.QueryPool, 0, queryCount,
+                              m_Results.size() * sizeof(uint64_t), m_Results.data(), 2 * sizeof(uint64_t),
+                              VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    if (result != VK_SUCCESS && result != VK_NOT_READY)
+    {
+        VK_CHECK_RESULT(result);
+        return;
+    }
+
+    m_Timings.clear();
+
+    const uint64_t frameStart = m_Results[0] & m_TimestampMask;
+    for (uint32_t region = 0; region < frame.Regions.size(); region++)
+    {
+        const uint64_t* query = &m_Results[region * 4];
+        if (query[1] == 0 || query[3] == 0)
+            continue;
+
+        const uint64_t begin = query[0] & m_TimestampMask;
+        const uint64_t end   = query[2] & m_TimestampMask;
+
+        const double durationNs = static_cast<double>((end - begin) & m_TimestampMask) * m_TimestampPeriod;
+        m_Timings.push_back({frame.Regions[region], static_cast<float>(durationNs / 1000000.0)});
+
+        // GPU and CPU clocks aren't calibrated against each other, so the frame is placed at its submit time
+        if (Profiler::IsSessionActive())
+        {
+            const double offsetNs = static_cast<double>((begin - frameStart) & m_TimestampMask) * m_TimestampPeriod;
+            Profiler::RecordGPUScope(frame.Regions[region], frame.SubmitTime + static_cast<int64_t>(offsetNs),
+                                     static_cast<int64_t>(durationNs));
+        }
+    }
+}
+
+} // namespace Noctis
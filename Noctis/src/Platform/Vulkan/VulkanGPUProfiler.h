@@ -0,0 +1,60 @@
+#pragma once
+
+#include "VulkanDevice.h"
+
+#include "Engine/Renderer/RendererAPI.h"
+
+namespace Noctis
+{
+
+// Times named regions of the frame's command buffer with timestamp queries. Each frame in flight has its own query
+// pool, which is read back once that frame's fence has been waited on, so reading results never stalls.
+class VulkanGPUProfiler
+{
+  public:
+    VulkanGPUProfiler(const VulkanDevice& device, uint32_t framesInFlight, uint32_t maxRegions = 64);
+    ~VulkanGPUProfiler();
+
+    // Collects the results this frame slot recorded last time around and resets its queries. Must be called outside
+    // a render pass, after the slot's fence has signalled.
+    void BeginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+    void EndFrame(VkCommandBuffer commandBuffer);
+    // Call right after the frame's command buffer is submitted, anchors GPU times to the CPU clock for the profiler
+    void OnSubmit();
+
+    // name must outlive the profiler session (a literal, or Profiler::InternName)
+    uint32_t BeginRegion(VkCommandBuffer commandBuffer, const char* name);
+    void EndRegion(VkCommandBuffer commandBuffer, uint32_t region);
+
+    bool IsSupported() const { return m_Supported; }
+
+    // Timings of the most recent frame whose results are available, the whole frame first
+    const std::vector<GPUTiming>& GetTimings() const { return m_Timings; }
+
+  private:
+    void CollectResults(uint32_t frameIndex);
+
+  private:
+    struct FrameQueries
+    {
+        VkQueryPool QueryPool = VK_NULL_HANDLE;
+        std::vector<const char*> Regions;
+        int64_t SubmitTime = 0;
+        // A frame can begin and never be submitted, its reset never ran and its queries must not be read
+        bool Submitted = false;
+    };
+
+    const VulkanDevice& m_Device;
+    bool m_Supported         = false;
+    float m_TimestampPeriod  = 1.0f;
+    uint64_t m_TimestampMask = ~0ull;
+
+    uint32_t m_MaxRegions;
+    std::vector<FrameQueries> m_Frames;
+    uint32_t m_CurrentFrame = 0;
+
+    std::vector<uint64_t> m_Results;
+    std::vector<GPUTiming> m_Timings;
+};
+
+} // namespace Noctis
@@ -0,0 +1,142 @@
+#include "VulkanLayoutCache.h"
+
+#include "Engine/Core/Hash.h"
+
+namespace Noctis
+{
+
+bool VulkanLayoutCache::PipelineLayoutKey::operator==(const PipelineLayoutKey& other) const
+{
+    if (SetLayouts != other.SetLayouts || PushConstantRanges.size() != other.PushConstantRanges.size())
+        return false;
+
+    for (size_t i = 0; i < PushConstantRanges.size(); i++)
+    {
+        const VkPushConstantRange& a = PushConstantRanges[i];
+        const VkPushConstantRange& b = other.PushConstantRanges[i];
+        if (a.stageFlags != b.stageFlags || a.offset != b.offset || a.size != b.size)
+            return false;
+    }
+    return true;
+}
+
+size_t VulkanLayoutCache::PipelineLayoutKeyHash::operator()(const PipelineLayoutKey& key) const
+{
+    uint64_t hash = Hash::OFFSET_BASIS;
+    for (VkDescriptorSetLayout setLayout : key.SetLayouts)
+        hash = Hash::Combine(hash, reinterpret_cast<uint64_t>(setLayout));
+    for (const VkPushConstantRange& range : key.PushConstantRanges)
+    {
+        hash = Hash::Combine(hash, range.stageFlags);
+        hash = Hash::Combine(hash, range.offset);
+        hash = Hash::Combine(hash, range.size);
+    }
+    return hash;
+}
+
+VulkanLayoutCache::VulkanLayoutCache(const VulkanDevice& device) : m_Device(device)
+{
+}
+
+VulkanLayoutCache::~VulkanLayoutCache()
+{
+    NOC_PROFILE_FUNCTION();
+
+    auto vkDevice = m_Device.GetVkDevice();
+
+    for (auto& [key, layout] : m_PipelineLayouts)
+        vkDestroyPipelineLayout(vkDevice, layout, nullptr);
+    for (auto& [desc, layout] : m_DescriptorSetLayouts)
+        vkDestroyDescriptorSetLayout(vkDevice, layout, nullptr);
+
+    m_PipelineLayouts.clear();
+    m_DescriptorSetLayouts.clear();
+}
+
+VkDescriptorSetLayout VulkanLayoutCache::GetDescriptorSetLayout(const DescriptorSetLayoutDesc& desc)
+{
+    NOC_CORE_ASSERT(desc.BindingFlags.empty() || desc.BindingFlags.size() == desc.Bindings.size(),
+                    "Binding flags must be given for every binding or none");
+
+    std::lock_guard lock(m_Mutex);
+
+    auto it = m_DescriptorSetLayouts.find(desc);
+    if (it != m_DescriptorSetLayouts.end())
+        return it->second;
+
+    NOC_PROFILE_FUNCTION();
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+    bindingFlagsInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    bindingFlagsInfo.bindingCount  = static_cast<uint32_t>(desc.BindingFlags.size());
+    bindingFlagsInfo.pBindingFlags = desc.BindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext        = desc.BindingFlags.empty() ? nullptr : &bindingFlagsInfo;
+    layoutInfo.flags        = desc.Flags;
+    layoutInfo.bindingCount = static_cast<uint32_t>(desc.Bindings.size());
+    layoutInfo.pBindings    = desc.Bindings.data();
+
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+    VK_CHECK_RESULT(vkCreateDescriptorSetLayout(m_Device.GetVkDevice(), &layoutInfo, nullptr, &layout));
+
+    m_DescriptorSetLayouts.emplace(desc, layout);
+    return layout;
+}
+
+VkPipelineLayout VulkanLayoutCache::GetPipelineLayout(const PipelineLayoutDesc& desc)
+{
+    std::vector<VkDescriptorSetLayout> setLayouts;
+    setLayouts.reserve(desc.SetLayouts.size());
+    for (const DescriptorSetLayoutDesc& setLayout : desc.SetLayouts)
+        setLayouts.push_back(GetDescriptorSetLayout(setLayout));
+
+    return GetPipelineLayout(setLayouts, desc.PushConstantRanges);
+}
+
+VkPipelineLayout VulkanLayoutCache::GetPipelineLayout(const std::vector<VkDescriptorSetLayout>& setLayouts,
+                                                      const std::vector<VkPushConstantRange>& pushConstantRanges)
+{
+    PipelineLayoutKey key{setLayouts, pushConstantRanges};
+
+    std::lock_guard lock(m_Mutex);
+
+    auto it = m_PipelineLayouts.find(key);
+    if (it != m_PipelineLayouts.end())
+        return it->second;
+
+    NOC_PROFILE_FUNCTION();
+
+    VkPipelineLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.setLayoutCount         = static_cast<uint32_t>(setLayouts.size());
+    layoutInfo.pSetLayouts            = setLayouts.data();
+    layoutInfo.pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size());
+    layoutInfo.pPushConstantRanges    = pushConstantRanges.data();
+
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    VK_CHECK_RESULT(vkCreatePipelineLayout(m_Device.GetVkDevice(), &layoutInfo, nullptr, &layout));
+
+    m_PipelineLayouts.emplace(std::move(key), layout);
+    return layout;
+}
+
+VkPipelineLayout VulkanLayoutCache::GetPipelineLayout(const std::vector<const VulkanShaderReflection*>& stages)
+{
+    return GetPipelineLayout(VulkanShaderReflection::CreatePipelineLayoutDesc(stages));
+}
+
+uint32_t VulkanLayoutCache::GetDescriptorSetLayoutCount() const
+{
+    std::lock_guard lock(m_Mutex);
+    return static_cast<uint32_t>(m_DescriptorSetLayouts.size());
+}
+
+uint32_t VulkanLayoutCache::GetPipelineLayoutCount() const
+{
+    std::lock_guard lock(m_Mutex);
+    return static_cast<uint32_t>(m_PipelineLayouts.size());
+}
+
+} // namespace Noctis
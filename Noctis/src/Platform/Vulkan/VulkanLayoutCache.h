@@ -0,0 +1,62 @@
+#pragma once
+
+#include "VulkanDevice.h"
+#include "VulkanShaderReflection.h"
+
+#include <mutex>
+
+namespace Noctis
+{
+
+// Hash-consed descriptor set and pipeline layouts: equal descriptions always return the same handle, so pipelines
+// built from the same reflected interface share layouts and stay compatible for descriptor set binding. Handles
+// live as long as the cache and must not be destroyed by callers. Thread safe.
+class VulkanLayoutCache
+{
+  public:
+    VulkanLayoutCache(const VulkanDevice& device);
+    ~VulkanLayoutCache();
+
+    VulkanLayoutCache(const VulkanLayoutCache&)            = delete;
+    VulkanLayoutCache& operator=(const VulkanLayoutCache&) = delete;
+
+    VkDescriptorSetLayout GetDescriptorSetLayout(const DescriptorSetLayoutDesc& desc);
+
+    VkPipelineLayout GetPipelineLayout(const PipelineLayoutDesc& desc);
+    VkPipelineLayout GetPipelineLayout(const std::vector<VkDescriptorSetLayout>& setLayouts,
+                                       const std::vector<VkPushConstantRange>& pushConstantRanges);
+    // Reflects and merges the stages of a pipeline
+    VkPipelineLayout GetPipelineLayout(const std::vector<const VulkanShaderReflection*>& stages);
+
+    uint32_t GetDescriptorSetLayoutCount() const;
+    uint32_t GetPipelineLayoutCount() const;
+
+  private:
+    struct DescriptorSetLayoutDescHash
+    {
+        size_t operator()(const DescriptorSetLayoutDesc& desc) const { return desc.GetHash(); }
+    };
+
+    struct PipelineLayoutKey
+    {
+        std::vector<VkDescriptorSetLayout> SetLayouts;
+        std::vector<VkPushConstantRange> PushConstantRanges;
+
+        bool operator==(const PipelineLayoutKey& other) const;
+    };
+
+    struct PipelineLayoutKeyHash
+    {
+        size_t operator()(const PipelineLayoutKey& key) const;
+    };
+
+  private:
+    const VulkanDevice& m_Device;
+
+    mutable std::mutex m_Mutex;
+    std::unordered_map<DescriptorSetLayoutDesc, VkDescriptorSetLayout, DescriptorSetLayoutDescHash>
+        m_DescriptorSetLayouts;
+    std::unordered_map<PipelineLayoutKey, VkPipelineLayout, PipelineLayoutKeyHash> m_PipelineLayouts;
+};
+
+} // namespace Noctis
@@ -0,0 +1,996 @@
+#include "VulkanMeshRenderer.h"
+#include "VulkanRenderer.h"
+#include "VulkanShaderReflection.h"
+
+#include <cstring>
+
+namespace Noctis
+{
+
+namespace
+{
+
+constexpr const char* CULL_SHADER_PATH     = "assets/shaders/MeshCull.comp";
+constexpr const char* PYRAMID_SHADER_PATH  = "assets/shaders/DepthPyramid.comp";
+constexpr const char* VERTEX_SHADER_PATH   = "assets/shaders/Mesh.vert";
+constexpr const char* FRAGMENT_SHADER_PATH = "assets/shaders/Mesh.frag";
+
+constexpr uint32_t DRAW_COMMAND_SIZE = sizeof(VkDrawIndexedIndirectCommand);
+
+VkShaderModule CreateShaderModule(VkDevice device, const std::vector<uint32_t>& spirv)
+{
+    VkShaderModuleCreateInfo moduleInfo{};
+    moduleInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    moduleInfo.codeSize = spirv.size() * sizeof(uint32_t);
+    moduleInfo.pCode    = spirv.data();
+
+    VkShaderModule module = VK_NULL_HANDLE;
+    VK_CHECK_RESULT(vkCreateShaderModule(device, &moduleInfo, nullptr, &module));
+    return module;
+}
+
+uint32_t FloorPowerOfTwo(uint32_t value)
+{
+    uint32_t result = 1;
+    while (result * 2 <= value)
+        result *= 2;
+    return result;
+}
+
+void RecordMemoryBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStages, VkAccessFlags srcAccess,
+                         VkPipelineStageFlags dstStages, VkAccessFlags dstAccess)
+{
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+    vkCmdPipelineBarrier(commandBuffer, srcStages, dstStages, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+} // namespace
+
+void VulkanMeshRenderer::Init()
+{
+    NOC_PROFILE_FUNCTION();
+
+    m_Context   = VulkanContext::Get();
+    m_FreeLists = CreateRef<FreeLists>();
+
+    // Every instance is its own indirect draw, told apart by firstInstance
+    m_Supported = m_Context->GetDevice()->SupportsMultiDrawIndirect();
+    if (!m_Supported)
+    {
+        NOC_CORE_ERROR("MeshRenderer: multiDrawIndirect and drawIndirectFirstInstance are required, meshes won't be "
+                       "drawn");
+        return;
+    }
+
+    LoadProgram(m_CullProgram, {CULL_SHADER_PATH});
+    LoadProgram(m_PyramidProgram, {PYRAMID_SHADER_PATH});
+    LoadProgram(m_DrawProgram, {VERTEX_SHADER_PATH, FRAGMENT_SHADER_PATH});
+
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter    = VK_FILTER_NEAREST;
+    samplerInfo.minFilter    = VK_FILTER_NEAREST;
+    samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.maxLod       = VK_LOD_CLAMP_NONE;
+    VK_CHECK_RESULT(vkCreateSampler(m_Context->GetDevice()->GetVkDevice(), &samplerInfo, nullptr, &m_PyramidSampler));
+
+    const VkBufferUsageFlags transfer = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    const VkBufferUsageFlags storage  = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | transfer;
+    const VkBufferUsageFlags indirect = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | storage;
+
+    m_VertexBuffer   = CreateBuffer(MIN_BUFFER_SIZE, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | transfer);
+    m_IndexBuffer    = CreateBuffer(MIN_BUFFER_SIZE, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | transfer);
+    m_MeshBuffer     = CreateBuffer(MIN_BUFFER_SIZE, storage);
+    m_InstanceBuffer = CreateBuffer(MIN_BUFFER_SIZE, storage);
+    m_DrawBuffer     = CreateBuffer(MIN_BUFFER_SIZE, indirect);
+    m_CountBuffer    = CreateBuffer(sizeof(uint32_t), indirect);
+    m_CullBuffer     = CreateBuffer(sizeof(CullData), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | transfer);
+}
+
+void VulkanMeshRenderer::Shutdown()
+{
+    NOC_PROFILE_FUNCTION();
+
+    if (!m_Supported)
+    {
+        m_Context.reset();
+        return;
+    }
+
+    auto vkDevice = m_Context->GetDevice()->GetVkDevice();
+
+    // Staging buffers and pools are handed back by the renderer's free queue, which isn't flushed before the device
+    // is idle
+    vkDeviceWaitIdle(vkDevice);
+
+    for (auto& [renderPass, pipeline] : m_DrawPipelines)
+        vkDestroyPipeline(vkDevice, pipeline, nullptr);
+    m_DrawPipelines.clear();
+    vkDestroyPipeline(vkDevice, m_CullPipeline, nullptr);
+    vkDestroyPipeline(vkDevice, m_PyramidPipeline, nullptr);
+
+    for (Buffer* buffer : {&m_VertexBuffer, &m_IndexBuffer, &m_MeshBuffer, &m_InstanceBuffer, &m_DrawBuffer,
+                           &m_CountBuffer, &m_CullBuffer})
+    {
+        vkDestroyBuffer(vkDevice, buffer->Buffer, nullptr);
+        m_Context->GetAllocator()->Free(buffer->Allocation);
+    }
+    for (Buffer& buffer : m_StagingBuffers)
+    {
+        vkDestroyBuffer(vkDevice, buffer.Buffer, nullptr);
+        m_Context->GetAllocator()->Free(buffer.Allocation);
+    }
+    m_StagingBuffers.clear();
+
+    for (VkDescriptorPool pool : m_DescriptorPools)
+        vkDestroyDescriptorPool(vkDevice, pool, nullptr);
+    m_DescriptorPools.clear();
+
+    for (VkImageView view : m_PyramidLevelViews)
+        vkDestroyImageView(vkDevice, view, nullptr);
+    vkDestroyImageView(vkDevice, m_PyramidView, nullptr);
+    vkDestroyImage(vkDevice, m_PyramidImage, nullptr);
+    m_Context->GetAllocator()->Free(m_PyramidAllocation);
+    vkDestroySampler(vkDevice, m_PyramidSampler, nullptr);
+
+    m_FreeLists.reset();
+    m_Context.reset();
+}
+
+void VulkanMeshRenderer::LoadProgram(Program& program, const std::vector<const char*>& paths)
+{
+    for (const char* path : paths)
+        program.Shaders.push_back(ShaderCompiler::Load(path));
+    for (const Ref<CompiledShader>& shader : program.Shaders)
+        shader->Wait();
+    UpdatePipelineLayout(program);
+}
+
+void VulkanMeshRenderer::UpdatePipelineLayout(Program& program)
+{
+    program.Versions.clear();
+
+    std::vector<VulkanShaderReflection> reflections;
+    reflections.reserve(program.Shaders.size());
+    for (const Ref<CompiledShader>& shader : program.Shaders)
+    {
+        program.Versions.push_back(shader->GetVersion());
+
+        auto spirv = shader->GetSPIRV();
+        NOC_CORE_ASSERT(spirv, "MeshRenderer shaders failed to compile");
+        reflections.emplace_back(*spirv);
+    }
+
+    std::vector<const VulkanShaderReflection*> stages;
+    for (const VulkanShaderReflection& reflection : reflections)
+        stages.push_back(&reflection);
+
+    const PipelineLayoutDesc desc = VulkanShaderReflection::CreatePipelineLayoutDesc(stages);
+    NOC_CORE_ASSERT(desc.SetLayouts.size() == 1 && desc.PushConstantRanges.size() <= 1,
+                    "MeshRenderer shaders must use one descriptor set");
+
+    auto layoutCache            = m_Context->GetLayoutCache();
+    program.DescriptorSetLayout = layoutCache->GetDescriptorSetLayout(desc.SetLayouts[0]);
+    program.PipelineLayout      = layoutCache->GetPipelineLayout(desc);
+    program.PushConstantStages  = desc.PushConstantRanges.empty() ? 0 : desc.PushConstantRanges[0].stageFlags;
+    if (reflections[0].GetStage() == VK_SHADER_STAGE_COMPUTE_BIT)
+        program.LocalSize = reflections[0].GetLocalSize();
+}
+
+bool VulkanMeshRenderer::IsOutdated(const Program& program) const
+{
+    for (size_t i = 0; i < program.Shaders.size(); i++)
+    {
+        if (program.Shaders[i]->GetVersion() != program.Versions[i])
+            return true;
+    }
+    return false;
+}
+
+VkPipeline VulkanMeshRenderer::CreateComputePipeline(const Program& program)
+{
+    NOC_PROFILE_FUNCTION();
+
+    auto vkDevice = m_Context->GetDevice()->GetVkDevice();
+
+    VkShaderModule module = CreateShaderModule(vkDevice, *program.Shaders[0]->GetSPIRV());
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType        = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = module;
+    pipelineInfo.stage.pName  = "main";
+    pipelineInfo.layout       = program.PipelineLayout;
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VK_CHECK_RESULT(vkCreateComputePipelines(vkDevice, m_Context->GetDevice()->GetVkPipelineCache(), 1, &pipelineInfo,
+                                             nullptr, &pipeline));
+
+    vkDestroyShaderModule(vkDevice, module, nullptr);
+    return pipeline;
+}
+
+VkPipeline VulkanMeshRenderer::GetDrawPipeline(VkRenderPass renderPass)
+{
+    auto it = m_DrawPipelines.find(renderPass);
+    if (it != m_DrawPipelines.end())
+        return it->second;
+
+    NOC_PROFILE_FUNCTION();
+
+    auto vkDevice = m_Context->GetDevice()->GetVkDevice();
+
+    VkShaderModule vertexModule   = CreateShaderModule(vkDevice, *m_DrawProgram.Shaders[0]->GetSPIRV());
+    VkShaderModule fragmentModule = CreateShaderModule(vkDevice, *m_DrawProgram.Shaders[1]->GetSPIRV());
+
+    VkPipelineShaderStageCreateInfo stages[2]{};
+    stages[0].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage  = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = vertexModule;
+    stages[0].pName  = "main";
+    stages[1].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = fragmentModule;
+    stages[1].pName  = "main";
+
+    VkVertexInputBindingDescription binding{};
+    binding.binding   = 0;
+    binding.stride    = sizeof(MeshVertex);
+    binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    const VkVertexInputAttributeDescription attributes[] = {
+        {0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(MeshVertex, Position)},
+        {1, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(MeshVertex, Normal)},
+        {2, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(MeshVertex, UV)},
+    };
+
+    VkPipelineVertexInputStateCreateInfo vertexInput{};
+    vertexInput.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInput.vertexBindingDescriptionCount   = 1;
+    vertexInput.pVertexBindingDescriptions      = &binding;
+    vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(std::size(attributes));
+    vertexInput.pVertexAttributeDescriptions    = attributes;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewport{};
+    viewport.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewport.viewportCount = 1;
+    viewport.scissorCount  = 1;
+
+    // Winding depends on the handedness of the caller's projection, so nothing is culled
+    VkPipelineRasterizationStateCreateInfo rasterization{};
+    rasterization.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterization.cullMode    = VK_CULL_MODE_NONE;
+    rasterization.frontFace   = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    rasterization.lineWidth   = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo multisample{};
+    multisample.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.sType            = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable  = VK_TRUE;
+    depthStencil.depthWriteEnable = VK_TRUE;
+    depthStencil.depthCompareOp   = VK_COMPARE_OP_LESS;
+
+    VkPipelineColorBlendAttachmentState blendAttachment{};
+    blendAttachment.colorWriteMask =
+        VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+    VkPipelineColorBlendStateCreateInfo colorBlend{};
+    colorBlend.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlend.attachmentCount = 1;
+    colorBlend.pAttachments    = &blendAttachment;
+
+    const VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = static_cast<uint32_t>(std::size(dynamicStates));
+    dynamicState.pDynamicStates    = dynamicStates;
+
+    VkGraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount          = 2;
+    pipelineInfo.pStages             = stages;
+    pipelineInfo.pVertexInputState   = &vertexInput;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState      = &viewport;
+    pipelineInfo.pRasterizationState = &rasterization;
+    pipelineInfo.pMultisampleState   = &multisample;
+    pipelineInfo.pDepthStencilState  = &depthStencil;
+    pipelineInfo.pColorBlendState    = &colorBlend;
+    pipelineInfo.pDynamicState       = &dynamicState;
+    pipelineInfo.layout              = m_DrawProgram.PipelineLayout;
+    pipelineInfo.renderPass          = renderPass;
+    pipelineInfo.subpass             = 0;
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VK_CHECK_RESULT(vkCreateGraphicsPipelines(vkDevice, m_Context->GetDevice()->GetVkPipelineCache(), 1, &pipelineInfo,
+                                              nullptr, &pipeline));
+
+    vkDestroyShaderModule(vkDevice, vertexModule, nullptr);
+    vkDestroyShaderModule(vkDevice, fragmentModule, nullptr);
+
+    m_DrawPipelines.emplace(renderPass, pipeline);
+    return pipeline;
+}
+
+void VulkanMeshRenderer::DestroyDrawPipelines()
+{
+    // Frames in flight may still be using them
+    auto vkDevice = m_Context->GetDevice()->GetVkDevice();
+    Renderer::SubmitResourceFree([vkDevice, pipelines = std::move(m_DrawPipelines)]() {
+        for (auto& [renderPass, pipeline] : pipelines)
+            vkDestroyPipeline(vkDevice, pipeline, nullptr);
+    });
+    m_DrawPipelines.clear();
+}
+
+void VulkanMeshRenderer::DestroyPipelines()
+{
+    DestroyDrawPipelines();
+
+    auto vkDevice = m_Context->GetDevice()->GetVkDevice();
+    Renderer::SubmitResourceFree([vkDevice, cull = m_CullPipeline, pyramid = m_PyramidPipeline]() {
+        vkDestroyPipeline(vkDevice, cull, nullptr);
+        vkDestroyPipeline(vkDevice, pyramid, nullptr);
+    });
+    m_CullPipeline    = VK_NULL_HANDLE;
+    m_PyramidPipeline = VK_NULL_HANDLE;
+}
+
+VulkanMeshRenderer::Buffer VulkanMeshRenderer::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage,
+                                                            MemoryUsage memoryUsage)
+{
+    NOC_PROFILE_FUNCTION();
+
+    Buffer buffer;
+    buffer.Size = size;
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size        = size;
+    bufferInfo.usage       = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VK_CHECK_RESULT(vkCreateBuffer(m_Context->GetDevice()->GetVkDevice(), &bufferInfo, nullptr, &buffer.Buffer));
+
+    buffer.Allocation = m_Context->GetAllocator()->AllocateBuffer(buffer.Buffer, memoryUsage);
+    NOC_CORE_ASSERT(buffer.Allocation.IsValid(), "Out of memory for MeshRenderer buffers");
+    return buffer;
+}
+
+void VulkanMeshRenderer::DestroyBuffer(Buffer& buffer)
+{
+    Renderer::SubmitResourceFree([vkBuffer = buffer.Buffer, allocation = buffer.Allocation]() mutable {
+        auto context = VulkanContext::Get();
+        vkDestroyBuffer(context->GetDevice()->GetVkDevice(), vkBuffer, nullptr);
+        context->GetAllocator()->Free(allocation);
+    });
+    buffer = {};
+}
+
+void VulkanMeshRenderer::Reserve(Buffer& buffer, VkDeviceSize size, VkBufferUsageFlags usage, bool keepContents)
+{
+    if (buffer.Size >= size)
+        return;
+
+    VkDeviceSize capacity = buffer.Size;
+    while (capacity < size)
+        capacity *= 2;
+
+    Buffer grown = CreateBuffer(capacity, usage | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    if (keepContents)
+        m_GrowCopies.push_back({buffer.Buffer, grown.Buffer, {0, 0, buffer.Size}});
+
+    // The old buffer stays alive until this frame's copy out of it is done
+    DestroyBuffer(buffer);
+    buffer = grown;
+}
+
+uint32_t VulkanMeshRenderer::AcquireStagingBuffer(VkDeviceSize size)
+{
+    std::vector<uint32_t>& free = m_FreeLists->StagingBuffers;
+
+    auto it = std::find_if(free.begin(), free.end(),
+                           [&](uint32_t index) { return m_StagingBuffers[index].Size >= size; });
+    if (it != free.end())
+    {
+        const uint32_t index = *it;
+        free.erase(it);
+        return index;
+    }
+
+    VkDeviceSize capacity = MIN_STAGING_SIZE;
+    while (capacity < size)
+        capacity *= 2;
+
+    m_StagingBuffers.push_back(CreateBuffer(capacity, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, MemoryUsage::CPUOnly));
+    NOC_CORE_ASSERT(m_StagingBuffers.back().Allocation.MappedData, "MeshRenderer staging memory isn't host visible");
+    return static_cast<uint32_t>(m_StagingBuffers.size() - 1);
+}
+
+void VulkanMeshRenderer::Stage(const void* data, VkDeviceSize size, const Buffer& destination, VkDeviceSize offset)
+{
+    const Buffer& staging = m_StagingBuffers[m_StagingBuffer];
+    std::memcpy(static_cast<uint8_t*>(staging.Allocation.MappedData) + m_StagingUsed, data, size);
+
+    m_Copies.push_back({staging.Buffer, destination.Buffer, {m_StagingUsed, offset, size}});
+    m_StagingUsed += size;
+}
+
+void VulkanMeshRenderer::UpdatePyramid(VkExtent2D extent)
+{
+    if (m_PyramidImage != VK_NULL_HANDLE && extent.width == m_DepthExtent.width &&
+        extent.height == m_DepthExtent.height)
+        return;
+
+    NOC_PROFILE_FUNCTION();
+
+    if (m_PyramidImage != VK_NULL_HANDLE)
+        DestroyPyramid();
+
+    auto vkDevice = m_Context->GetDevice()->GetVkDevice();
+
+    m_DepthExtent   = extent;
+    m_PyramidExtent = {FloorPowerOfTwo(std::max(extent.width, 1u)), FloorPowerOfTwo(std::max(extent.height, 1u))};
+
+    uint32_t levels = 1;
+    while (levels < MAX_PYRAMID_LEVELS && (std::max(m_PyramidExtent.width, m_PyramidExtent.height) >> levels) > 0)
+        levels++;
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+    imageInfo.format        = VK_FORMAT_R32_SFLOAT;
+    imageInfo.extent        = {m_PyramidExtent.width, m_PyramidExtent.height, 1};
+    imageInfo.mipLevels     = levels;
+    imageInfo.arrayLayers   = 1;
+    imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage         = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+    imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VK_CHECK_RESULT(vkCreateImage(vkDevice, &imageInfo, nullptr, &m_PyramidImage));
+
+    m_PyramidAllocation = m_Context->GetAllocator()->AllocateImage(m_PyramidImage, MemoryUsage::GPUOnly);
+    NOC_CORE_ASSERT(m_PyramidAllocation.IsValid(), "Out of memory for the depth pyramid");
+
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image                           = m_PyramidImage;
+    viewInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format                          = VK_FORMAT_R32_SFLOAT;
+    viewInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.baseMipLevel   = 0;
+    viewInfo.subresourceRange.levelCount     = levels;
+    viewInfo.subresourceRange.baseArrayLayer = 0;
+    viewInfo.subresourceRange.layerCount     = 1;
+    VK_CHECK_RESULT(vkCreateImageView(vkDevice, &viewInfo, nullptr, &m_PyramidView));
+
+    // Storage image descriptors see a single level
+    m_PyramidLevelViews.resize(levels);
+    viewInfo.subresourceRange.levelCount = 1;
+    for (uint32_t level = 0; level < levels; level++)
+    {
+        viewInfo.subresourceRange.baseMipLevel = level;
+        VK_CHECK_RESULT(vkCreateImageView(vkDevice, &viewInfo, nullptr, &m_PyramidLevelViews[level]));
+    }
+
+    m_PyramidValid       = false;
+    m_PyramidHasContents = false;
+}
+
+void VulkanMeshRenderer::DestroyPyramid()
+{
+    Renderer::SubmitResourceFree([image = m_PyramidImage, view = m_PyramidView, levelViews = m_PyramidLevelViews,
+                                  allocation = m_PyramidAllocation]() mutable {
+        auto context  = VulkanContext::Get();
+        auto vkDevice = context->GetDevice()->GetVkDevice();
+
+        for (VkImageView levelView : levelViews)
+            vkDestroyImageView(vkDevice, levelView, nullptr);
+        vkDestroyImageView(vkDevice, view, nullptr);
+        vkDestroyImage(vkDevice, image, nullptr);
+        context->GetAllocator()->Free(allocation);
+    });
+
+    m_PyramidImage = VK_NULL_HANDLE;
+    m_PyramidView  = VK_NULL_HANDLE;
+    m_PyramidLevelViews.clear();
+    m_PyramidAllocation = {};
+}
+
+uint32_t VulkanMeshRenderer::AcquireDescriptorPool()
+{
+    auto vkDevice = m_Context->GetDevice()->GetVkDevice();
+
+    if (!m_FreeLists->DescriptorPools.empty())
+    {
+        const uint32_t index = m_FreeLists->DescriptorPools.back();
+        m_FreeLists->DescriptorPools.pop_back();
+        VK_CHECK_RESULT(vkResetDescriptorPool(vkDevice, m_DescriptorPools[index], 0));
+        return index;
+    }
+
+    NOC_PROFILE_FUNCTION();
+
+    // One frame's sets: culling, drawing, and one per pyramid level
+    const VkDescriptorPoolSize poolSizes[] = {
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5},
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1},
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 + MAX_PYRAMID_LEVELS},
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 2 * MAX_PYRAMID_LEVELS},
+    };
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets       = 2 + MAX_PYRAMID_LEVELS;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(std::size(poolSizes));
+    poolInfo.pPoolSizes    = poolSizes;
+
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    VK_CHECK_RESULT(vkCreateDescriptorPool(vkDevice, &poolInfo, nullptr, &pool));
+
+    m_DescriptorPools.push_back(pool);
+    return static_cast<uint32_t>(m_DescriptorPools.size() - 1);
+}
+
+void VulkanMeshRenderer::AllocateDescriptorSets()
+{
+    NOC_PROFILE_FUNCTION();
+
+    auto vkDevice = m_Context->GetDevice()->GetVkDevice();
+
+    const uint32_t levels = static_cast<uint32_t>(m_PyramidLevelViews.size());
+
+    std::vector<VkDescriptorSetLayout> setLayouts(2 + levels, m_PyramidProgram.DescriptorSetLayout);
+    setLayouts[0] = m_CullProgram.DescriptorSetLayout;
+    setLayouts[1] = m_DrawProgram.DescriptorSetLayout;
+
+    std::vector<VkDescriptorSet> sets(setLayouts.size());
+
+    m_DescriptorPool = AcquireDescriptorPool();
+
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool     = m_DescriptorPools[m_DescriptorPool];
+    allocInfo.descriptorSetCount = static_cast<uint32_t>(setLayouts.size());
+    allocInfo.pSetLayouts        = setLayouts.data();
+    VK_CHECK_RESULT(vkAllocateDescriptorSets(vkDevice, &allocInfo, sets.data()));
+
+    m_CullSet = sets[0];
+    m_DrawSet = sets[1];
+    m_PyramidSets.assign(sets.begin() + 2, sets.end());
+
+    // Reserved up front, writes point into these
+    std::vector<VkDescriptorBufferInfo> bufferInfos;
+    std::vector<VkDescriptorImageInfo> imageInfos;
+    std::vector<VkWriteDescriptorSet> writes;
+    bufferInfos.reserve(6);
+    imageInfos.reserve(1 + 2 * levels);
+
+    auto writeBuffer = [&](VkDescriptorSet set, uint32_t binding, VkDescriptorType type, const Buffer& buffer) {
+        bufferInfos.push_back({buffer.Buffer, 0, VK_WHOLE_SIZE});
+
+        VkWriteDescriptorSet& write = writes.emplace_back();
+        write.sType                 = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet                = set;
+        write.dstBinding            = binding;
+        write.descriptorCount       = 1;
+        write.descriptorType        = type;
+        write.pBufferInfo           = &bufferInfos.back();
+    };
+    auto writeImage = [&](VkDescriptorSet set, uint32_t binding, VkDescriptorType type, VkSampler sampler,
+                          VkImageView view, VkImageLayout layout) {
+        imageInfos.push_back({sampler, view, layout});
+
+        VkWriteDescriptorSet& write = writes.emplace_back();
+        write.sType                 = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet                = set;
+        write.dstBinding            = binding;
+        write.descriptorCount       = 1;
+        write.descriptorType        = type;
+        write.pImageInfo            = &imageInfos.back();
+    };
+
+    writeBuffer(m_CullSet, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, m_MeshBuffer);
+    writeBuffer(m_CullSet, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, m_InstanceBuffer);
+    writeBuffer(m_CullSet, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, m_DrawBuffer);
+    writeBuffer(m_CullSet, 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, m_CountBuffer);
+    writeBuffer(m_CullSet, 4, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, m_CullBuffer);
+    writeImage(m_CullSet, 5, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_PyramidSampler, m_PyramidView,
+               VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    writeBuffer(m_DrawSet, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, m_InstanceBuffer);
+
+    // The depth buffer (binding 0) is only known once the graph is executed, see BuildPyramid
+    for (uint32_t level = 0; level < levels; level++)
+    {
+        const VkImageView source = m_PyramidLevelViews[level == 0 ? 0 : level - 1];
+        writeImage(m_PyramidSets[level], 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_NULL_HANDLE, source,
+                   VK_IMAGE_LAYOUT_GENERAL);
+        writeImage(m_PyramidSets[level], 2, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_NULL_HANDLE,
+                   m_PyramidLevelViews[level], VK_IMAGE_LAYOUT_GENERAL);
+    }
+
+    vkUpdateDescriptorSets(vkDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+}
+
+void VulkanMeshRenderer::Render(const MeshRendererFrame& frame)
+{
+    if (!m_Supported)
+        return;
+
+    NOC_PROFILE_FUNCTION();
+
+    // Picked up at the start of a frame, so all of the frame's pipelines are built from one version
+    if (IsOutdated(m_CullProgram) || IsOutdated(m_PyramidProgram) || IsOutdated(m_DrawProgram))
+    {
+        DestroyPipelines();
+        UpdatePipelineLayout(m_CullProgram);
+        UpdatePipelineLayout(m_PyramidProgram);
+        UpdatePipelineLayout(m_DrawProgram);
+    }
+    // The executor was recreated, the cached render pass handles may have been reused by different render passes
+    VulkanRenderer& renderer = VulkanRenderer::Get();
+    if (renderer.GetRenderPassGeneration() != m_RenderPassGeneration)
+    {
+        DestroyDrawPipelines();
+        m_RenderPassGeneration = renderer.GetRenderPassGeneration();
+    }
+    if (m_CullPipeline == VK_NULL_HANDLE)
+    {
+        m_CullPipeline    = CreateComputePipeline(m_CullProgram);
+        m_PyramidPipeline = CreateComputePipeline(m_PyramidProgram);
+    }
+
+    UpdatePyramid(m_Context->GetSwapchain()->GetVkSwapchainExtent());
+
+    m_InstanceCount = frame.InstanceCount;
+    std::copy(frame.ViewProjection, frame.ViewProjection + 16, m_ViewProjection);
+
+    m_GrowCopies.clear();
+    m_Copies.clear();
+
+    Reserve(m_VertexBuffer, VkDeviceSize(frame.VertexCount) * sizeof(MeshVertex), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            true);
+    Reserve(m_IndexBuffer, VkDeviceSize(frame.IndexCount) * sizeof(uint32_t), VK_BUFFER_USAGE_INDEX_BUFFER_BIT, true);
+    Reserve(m_MeshBuffer, VkDeviceSize(frame.MeshCount) * sizeof(MeshData), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, true);
+    Reserve(m_InstanceBuffer, VkDeviceSize(frame.InstanceCount) * sizeof(MeshInstanceData),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, true);
+    // Rewritten by every culling pass
+    Reserve(m_DrawBuffer, VkDeviceSize(frame.InstanceCount) * DRAW_COMMAND_SIZE,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, false);
+
+    // Everything the frame changed goes through one staging buffer
+    const VkDeviceSize stagingSize = sizeof(CullData) + frame.DirtyInstances.size() * sizeof(MeshInstanceData) +
+                                     (frame.MeshCount - frame.FirstMesh) * sizeof(MeshData) +
+                                     frame.Vertices.size() * sizeof(MeshVertex) +
+                                     frame.Indices.size() * sizeof(uint32_t);
+
+    m_StagingBuffer = AcquireStagingBuffer(stagingSize);
+    m_StagingUsed   = 0;
+
+    CullData cull{};
+    std::copy(&frame.FrustumPlanes[0][0], &frame.FrustumPlanes[0][0] + 24, &cull.FrustumPlanes[0][0]);
+    std::copy(m_PreviousViewProjection, m_PreviousViewProjection + 16, cull.PreviousViewProjection);
+    cull.PyramidSize[0]   = static_cast<float>(m_PyramidExtent.width);
+    cull.PyramidSize[1]   = static_cast<float>(m_PyramidExtent.height);
+    cull.PyramidLevels    = static_cast<uint32_t>(m_PyramidLevelViews.size());
+    cull.InstanceCount    = frame.InstanceCount;
+    cull.OcclusionEnabled = m_PyramidValid ? 1 : 0;
+    Stage(&cull, sizeof(cull), m_CullBuffer, 0);
+
+    // Runs of consecutive instances are copied in one go
+    const std::vector<uint32_t>& dirty = frame.DirtyInstances;
+    for (size_t first = 0; first < dirty.size();)
+    {
+        size_t last = first;
+        while (last + 1 < dirty.size() && dirty[last + 1] == dirty[last] + 1)
+            last++;
+
+        Stage(&frame.Instances[dirty[first]], (last - first + 1) * sizeof(MeshInstanceData), m_InstanceBuffer,
+              VkDeviceSize(dirty[first]) * sizeof(MeshInstanceData));
+        first = last + 1;
+    }
+    if (frame.MeshCount > frame.FirstMesh)
+    {
+        Stage(&frame.Meshes[frame.FirstMesh], (frame.MeshCount - frame.FirstMesh) * sizeof(MeshData), m_MeshBuffer,
+              VkDeviceSize(frame.FirstMesh) * sizeof(MeshData));
+    }
+    if (!frame.Vertices.empty())
+    {
+        Stage(frame.Vertices.data(), frame.Vertices.size() * sizeof(MeshVertex), m_VertexBuffer,
+              VkDeviceSize(frame.FirstVertex) * sizeof(MeshVertex));
+        Stage(frame.Indices.data(), frame.Indices.size() * sizeof(uint32_t), m_IndexBuffer,
+              VkDeviceSize(frame.FirstIndex) * sizeof(uint32_t));
+    }
+
+    AllocateDescriptorSets();
+
+    Renderer::SubmitResourceFree([freeLists = m_FreeLists, staging = m_StagingBuffer, pool = m_DescriptorPool]() {
+        freeLists->StagingBuffers.push_back(staging);
+        freeLists->DescriptorPools.push_back(pool);
+    });
+
+    RenderGraph& graph                  = renderer.GetRenderGraph();
+    VulkanRenderGraphExecutor& executor = renderer.GetRenderGraphExecutor();
+
+    // Kept in the same usage between frames, so the next frame's first access waits for this one's last
+    auto importBuffer = [&](const char* name, const Buffer& buffer, RenderGraphUsage usage) {
+        RenderGraphBufferDesc desc;
+        desc.Size = buffer.Size;
+
+        const RenderGraphResource resource = graph.ImportBuffer(name, desc, usage, usage);
+        executor.BindBuffer(resource, buffer.Buffer);
+        return resource;
+    };
+    auto isWritten = [&](const Buffer& buffer) {
+        auto writes = [&](const BufferCopy& copy) { return copy.Destination == buffer.Buffer; };
+        return std::any_of(m_Copies.begin(), m_Copies.end(), writes) ||
+               std::any_of(m_GrowCopies.begin(), m_GrowCopies.end(), writes);
+    };
+
+    const RenderGraphResource vertices  = importBuffer("Mesh Vertices", m_VertexBuffer, RenderGraphUsage::VertexBuffer);
+    const RenderGraphResource indices   = importBuffer("Mesh Indices", m_IndexBuffer, RenderGraphUsage::IndexBuffer);
+    const RenderGraphResource meshes    = importBuffer("Meshes", m_MeshBuffer, RenderGraphUsage::StorageRead);
+    const RenderGraphResource instances = importBuffer("Instances", m_InstanceBuffer, RenderGraphUsage::StorageRead);
+    const RenderGraphResource draws     = importBuffer("Draws", m_DrawBuffer, RenderGraphUsage::IndirectBuffer);
+    const RenderGraphResource drawCount = importBuffer("Draw Count", m_CountBuffer, RenderGraphUsage::IndirectBuffer);
+    const RenderGraphResource cullData  = importBuffer("Cull Data", m_CullBuffer, RenderGraphUsage::UniformBuffer);
+
+    const bool drawIndirectCount = m_Context->GetDevice()->SupportsDrawIndirectCount();
+
+    RenderGraphPassBuilder upload = graph.AddPass("Mesh Upload", RenderGraphPassType::Transfer,
+                                                  [this](RenderGraphPassContext& context) {
+                                                      Upload(static_cast<VulkanRenderGraphPassContext&>(context));
+                                                  });
+    for (auto [resource, buffer] : {std::pair{vertices, &m_VertexBuffer}, std::pair{indices, &m_IndexBuffer},
+                                    std::pair{meshes, &m_MeshBuffer}, std::pair{instances, &m_InstanceBuffer},
+                                    std::pair{cullData, &m_CullBuffer}})
+    {
+        if (isWritten(*buffer))
+            upload.Write(resource, RenderGraphUsage::TransferDst);
+    }
+
+    // Nothing to cull, the pyramid goes stale
+    if (m_InstanceCount == 0)
+    {
+        m_PyramidValid = false;
+        return;
+    }
+
+    upload.Write(drawCount, RenderGraphUsage::TransferDst);
+    if (!drawIndirectCount)
+        upload.Write(draws, RenderGraphUsage::TransferDst);
+
+    RenderGraphTextureDesc pyramidDesc;
+    pyramidDesc.Width     = m_PyramidExtent.width;
+    pyramidDesc.Height    = m_PyramidExtent.height;
+    pyramidDesc.Format    = RenderGraphFormat::R32F;
+    pyramidDesc.MipLevels = static_cast<uint32_t>(m_PyramidLevelViews.size());
+
+    const RenderGraphResource pyramid =
+        graph.ImportTexture("Depth Pyramid", pyramidDesc,
+                            m_PyramidHasContents ? RenderGraphUsage::ShaderRead : RenderGraphUsage::None,
+                            RenderGraphUsage::ShaderRead);
+    executor.BindImage(pyramid, m_PyramidImage, m_PyramidView, VK_FORMAT_R32_SFLOAT);
+
+    RenderGraphTextureDesc depthDesc;
+    depthDesc.Width  = m_DepthExtent.width;
+    depthDesc.Height = m_DepthExtent.height;
+    depthDesc.Format = RenderGraphFormat::Depth32F;
+    m_Depth          = graph.CreateTexture("Mesh Depth", depthDesc);
+
+    graph
+        .AddPass("Mesh Cull", RenderGraphPassType::Compute,
+                 [this](RenderGraphPassContext& context) {
+                     Cull(static_cast<VulkanRenderGraphPassContext&>(context));
+                 })
+        .Read(meshes, RenderGraphUsage::StorageRead)
+        .Read(instances, RenderGraphUsage::StorageRead)
+        .Read(cullData, RenderGraphUsage::UniformBuffer)
+        .Read(pyramid, RenderGraphUsage::ShaderRead)
+        .Write(draws, RenderGraphUsage::StorageWrite)
+        .Write(drawCount, RenderGraphUsage::StorageWrite);
+
+    graph
+        .AddPass("Mesh Draw", RenderGraphPassType::Graphics,
+                 [this](RenderGraphPassContext& context) {
+                     Draw(static_cast<VulkanRenderGraphPassContext&>(context));
+                 })
+        .Read(draws, RenderGraphUsage::IndirectBuffer)
+        .Read(drawCount, RenderGraphUsage::IndirectBuffer)
+        .Read(vertices, RenderGraphUsage::VertexBuffer)
+        .Read(indices, RenderGraphUsage::IndexBuffer)
+        .Read(instances, RenderGraphUsage::StorageRead)
+        .Write(renderer.GetBackbuffer(), RenderGraphUsage::ColorAttachment)
+        .ClearDepthStencil(m_Depth, 1.0f);
+
+    graph
+        .AddPass("Depth Pyramid", RenderGraphPassType::Compute,
+                 [this](RenderGraphPassContext& context) {
+                     BuildPyramid(static_cast<VulkanRenderGraphPassContext&>(context));
+                 })
+        .Read(m_Depth, RenderGraphUsage::ShaderRead)
+        .Write(pyramid, RenderGraphUsage::StorageWrite);
+
+    // The next frame culls against this frame's depth, seen through this frame's camera
+    std::copy(m_ViewProjection, m_ViewProjection + 16, m_PreviousViewProjection);
+    m_PyramidValid       = true;
+    m_PyramidHasContents = true;
+}
+
+void VulkanMeshRenderer::Upload(VulkanRenderGraphPassContext& context)
+{
+    NOC_PROFILE_FUNCTION();
+
+    VkCommandBuffer commandBuffer = context.GetCommandBuffer();
+
+    auto copyBuffers = [commandBuffer](const std::vector<BufferCopy>& copies) {
+        std::vector<VkBufferCopy> regions;
+        for (size_t i = 0; i < copies.size(); i++)
+        {
+            regions.push_back(copies[i].Region);
+
+            // Copies between the same pair of buffers share a command
+            const bool last = i + 1 == copies.size() || copies[i + 1].Source != copies[i].Source ||
+                              copies[i + 1].Destination != copies[i].Destination;
+            if (last)
+            {
+                vkCmdCopyBuffer(commandBuffer, copies[i].Source, copies[i].Destination,
+                                static_cast<uint32_t>(regions.size()), regions.data());
+                regions.clear();
+            }
+        }
+    };
+
+    // Grown buffers take over their predecessors' contents before any of it is overwritten. The old buffers are
+    // outside the graph, so the wait for their last writes is on us.
+    if (!m_GrowCopies.empty())
+    {
+        RecordMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_WRITE_BIT,
+                            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+        copyBuffers(m_GrowCopies);
+        RecordMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+    }
+    copyBuffers(m_Copies);
+
+    if (m_InstanceCount == 0)
+        return;
+
+    vkCmdFillBuffer(commandBuffer, m_CountBuffer.Buffer, 0, sizeof(uint32_t), 0);
+    if (!m_Context->GetDevice()->SupportsDrawIndirectCount())
+        vkCmdFillBuffer(commandBuffer, m_DrawBuffer.Buffer, 0, VkDeviceSize(m_InstanceCount) * DRAW_COMMAND_SIZE, 0);
+}
+
+void VulkanMeshRenderer::Cull(VulkanRenderGraphPassContext& context)
+{
+    NOC_PROFILE_FUNCTION();
+
+    VkCommandBuffer commandBuffer = context.GetCommandBuffer();
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_CullPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_CullProgram.PipelineLayout, 0, 1,
+                            &m_CullSet, 0, nullptr);
+
+    const uint32_t groupSize = m_CullProgram.LocalSize[0];
+    vkCmdDispatch(commandBuffer, (m_InstanceCount + groupSize - 1) / groupSize, 1, 1);
+}
+
+void VulkanMeshRenderer::Draw(VulkanRenderGraphPassContext& context)
+{
+    NOC_PROFILE_FUNCTION();
+
+    VkCommandBuffer commandBuffer = context.GetCommandBuffer();
+    const VkExtent2D extent       = context.GetExtent();
+
+    VkViewport viewport{};
+    viewport.width    = static_cast<float>(extent.width);
+    viewport.height   = static_cast<float>(extent.height);
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+    VkRect2D scissor{};
+    scissor.extent = extent;
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, GetDrawPipeline(context.GetRenderPass()));
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_DrawProgram.PipelineLayout, 0, 1,
+                            &m_DrawSet, 0, nullptr);
+    vkCmdPushConstants(commandBuffer, m_DrawProgram.PipelineLayout, m_DrawProgram.PushConstantStages, 0,
+                       sizeof(m_ViewProjection), m_ViewProjection);
+
+    const VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_VertexBuffer.Buffer, &offset);
+    vkCmdBindIndexBuffer(commandBuffer, m_IndexBuffer.Buffer, 0, VK_INDEX_TYPE_UINT32);
+
+    // Instances beyond the limit aren't drawn, in practice it is 2^32 - 1 wherever multiDrawIndirect is supported
+    const uint32_t maxDrawCount =
+        std::min(m_InstanceCount, m_Context->GetDevice()->GetProperties().limits.maxDrawIndirectCount);
+
+    if (m_Context->GetDevice()->SupportsDrawIndirectCount())
+    {
+        vkCmdDrawIndexedIndirectCount(commandBuffer, m_DrawBuffer.Buffer, 0, m_CountBuffer.Buffer, 0, maxDrawCount,
+                                      DRAW_COMMAND_SIZE);
+    }
+    else
+    {
+        // Entries past the culling pass's count were cleared to zero, which draws nothing
+        vkCmdDrawIndexedIndirect(commandBuffer, m_DrawBuffer.Buffer, 0, maxDrawCount, DRAW_COMMAND_SIZE);
+    }
+}
+
+void VulkanMeshRenderer::BuildPyramid(VulkanRenderGraphPassContext& context)
+{
+    NOC_PROFILE_FUNCTION();
+
+    VkCommandBuffer commandBuffer = context.GetCommandBuffer();
+
+    // Every level's set needs a valid depth descriptor, though only level 0 reads it
+    std::vector<VkDescriptorImageInfo> depthInfos(m_PyramidSets.size());
+    std::vector<VkWriteDescriptorSet> writes(m_PyramidSets.size());
+    for (size_t i = 0; i < m_PyramidSets.size(); i++)
+    {
+        depthInfos[i].sampler     = m_PyramidSampler;
+        depthInfos[i].imageView   = context.GetImageView(m_Depth);
+        depthInfos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        writes[i].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet          = m_PyramidSets[i];
+        writes[i].dstBinding      = 0;
+        writes[i].descriptorCount = 1;
+        writes[i].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[i].pImageInfo      = &depthInfos[i];
+    }
+    vkUpdateDescriptorSets(m_Context->GetDevice()->GetVkDevice(), static_cast<uint32_t>(writes.size()), writes.data(),
+                           0, nullptr);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_PyramidPipeline);
+
+    const uint32_t groupWidth  = m_PyramidProgram.LocalSize[0];
+    const uint32_t groupHeight = m_PyramidProgram.LocalSize[1];
+
+    PyramidLevelConstants constants{};
+    constants.SourceSize[0] = m_DepthExtent.width;
+    constants.SourceSize[1] = m_DepthExtent.height;
+    for (uint32_t level = 0; level < m_PyramidSets.size(); level++)
+    {
+        constants.DestinationSize[0] = std::max(m_PyramidExtent.width >> level, 1u);
+        constants.DestinationSize[1] = std::max(m_PyramidExtent.height >> level, 1u);
+        constants.Level              = level;
+
+        // Each level reads the one written before it
+        if (level > 0)
+        {
+            RecordMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+        }
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_PyramidProgram.PipelineLayout, 0, 1,
+                                &m_PyramidSets[level], 0, nullptr);
+        vkCmdPushConstants(commandBuffer, m_PyramidProgram.PipelineLayout, m_PyramidProgram.PushConstantStages, 0,
+                           sizeof(constants), &constants);
+        vkCmdDispatch(commandBuffer, (constants.DestinationSize[0] + groupWidth - 1) / groupWidth,
+                      (constants.DestinationSize[1] + groupHeight - 1) / groupHeight, 1);
+
+        constants.SourceSize[0] = constants.DestinationSize[0];
+        constants.SourceSize[1] = constants.DestinationSize[1];
+    }
+}
+
+} // namespace Noctis
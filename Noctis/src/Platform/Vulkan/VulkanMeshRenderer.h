@@ -0,0 +1,162 @@
+#pragma once
+
+#include "VulkanContext.h"
+#include "VulkanRenderGraph.h"
+
+#include "Engine/Renderer/MeshRenderer.h"
+#include "Engine/Renderer/ShaderCompiler.h"
+
+namespace Noctis
+{
+
+// Four render graph passes per frame: an upload of whatever changed, a compute pass culling every instance and
+// appending the survivors' draw commands, one vkCmdDrawIndexedIndirectCount drawing them, and the reduction of the
+// frame's depth into the pyramid the next frame's culling tests against. Without drawIndirectCount the draw command
+// buffer is cleared every frame and drawn in full, culled entries being empty draws.
+class VulkanMeshRenderer : public MeshRendererAPI
+{
+  public:
+    void Init() override;
+    void Shutdown() override;
+
+    void Render(const MeshRendererFrame& frame) override;
+
+  private:
+    struct Buffer
+    {
+        VkBuffer Buffer = VK_NULL_HANDLE;
+        VulkanAllocation Allocation;
+        VkDeviceSize Size = 0;
+    };
+
+    // Shaders of one pipeline and the layouts reflected from them
+    struct Program
+    {
+        std::vector<Ref<CompiledShader>> Shaders;
+        std::vector<uint64_t> Versions;
+        VkDescriptorSetLayout DescriptorSetLayout = VK_NULL_HANDLE;
+        VkPipelineLayout PipelineLayout           = VK_NULL_HANDLE;
+        VkShaderStageFlags PushConstantStages     = 0;
+        // Compute shaders only
+        std::array<uint32_t, 3> LocalSize{1, 1, 1};
+    };
+
+    // Mirrors the Cull block of MeshCull.comp (std140)
+    struct CullData
+    {
+        float FrustumPlanes[6][4];
+        float PreviousViewProjection[16];
+        float PyramidSize[2];
+        uint32_t PyramidLevels;
+        uint32_t InstanceCount;
+        uint32_t OcclusionEnabled;
+        uint32_t Padding[3];
+    };
+
+    struct PyramidLevelConstants
+    {
+        uint32_t SourceSize[2];
+        uint32_t DestinationSize[2];
+        uint32_t Level;
+    };
+
+    struct BufferCopy
+    {
+        VkBuffer Source;
+        VkBuffer Destination;
+        VkBufferCopy Region;
+    };
+
+    // Shared with the resource free callbacks handing staging buffers and pools back, which may run after Shutdown
+    struct FreeLists
+    {
+        std::vector<uint32_t> StagingBuffers;
+        std::vector<uint32_t> DescriptorPools;
+    };
+
+    void LoadProgram(Program& program, const std::vector<const char*>& paths);
+    void UpdatePipelineLayout(Program& program);
+    bool IsOutdated(const Program& program) const;
+    VkPipeline CreateComputePipeline(const Program& program);
+    VkPipeline GetDrawPipeline(VkRenderPass renderPass);
+    void DestroyDrawPipelines();
+    void DestroyPipelines();
+
+    Buffer CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, MemoryUsage memoryUsage = MemoryUsage::GPUOnly);
+    void DestroyBuffer(Buffer& buffer);
+    // Grows the buffer to at least size bytes, copying its contents over in the upload pass if keepContents is set
+    void Reserve(Buffer& buffer, VkDeviceSize size, VkBufferUsageFlags usage, bool keepContents);
+    uint32_t AcquireStagingBuffer(VkDeviceSize size);
+    void Stage(const void* data, VkDeviceSize size, const Buffer& destination, VkDeviceSize offset);
+
+    void UpdatePyramid(VkExtent2D extent);
+    void DestroyPyramid();
+
+    uint32_t AcquireDescriptorPool();
+    void AllocateDescriptorSets();
+
+    void Upload(VulkanRenderGraphPassContext& context);
+    void Cull(VulkanRenderGraphPassContext& context);
+    void Draw(VulkanRenderGraphPassContext& context);
+    void BuildPyramid(VulkanRenderGraphPassContext& context);
+
+    static constexpr uint32_t MAX_PYRAMID_LEVELS   = 16;
+    static constexpr VkDeviceSize MIN_BUFFER_SIZE  = 64 * 1024;
+    static constexpr VkDeviceSize MIN_STAGING_SIZE = 256 * 1024;
+
+  private:
+    Ref<VulkanContext> m_Context;
+    bool m_Supported = false;
+
+    Program m_CullProgram;
+    Program m_PyramidProgram;
+    Program m_DrawProgram;
+    VkPipeline m_CullPipeline    = VK_NULL_HANDLE;
+    VkPipeline m_PyramidPipeline = VK_NULL_HANDLE;
+    // One per render pass the meshes were drawn in
+    std::unordered_map<VkRenderPass, VkPipeline> m_DrawPipelines;
+    // The executor's render pass generation the draw pipelines were built for
+    uint64_t m_RenderPassGeneration = 0;
+
+    // Geometry of every mesh, in shared buffers so a single draw covers all of them
+    Buffer m_VertexBuffer;
+    Buffer m_IndexBuffer;
+    Buffer m_MeshBuffer;
+    Buffer m_InstanceBuffer;
+    Buffer m_DrawBuffer;
+    Buffer m_CountBuffer;
+    Buffer m_CullBuffer;
+
+    // Farthest depth of the previous frame, a power of two rounded down from the frame's extent
+    VkImage m_PyramidImage    = VK_NULL_HANDLE;
+    VkImageView m_PyramidView = VK_NULL_HANDLE;
+    VulkanAllocation m_PyramidAllocation;
+    // One per level, for storage image descriptors
+    std::vector<VkImageView> m_PyramidLevelViews;
+    VkSampler m_PyramidSampler = VK_NULL_HANDLE;
+    VkExtent2D m_PyramidExtent{};
+    VkExtent2D m_DepthExtent{};
+    // Valid if the previous rendered frame built it, m_PreviousViewProjection being that frame's camera
+    bool m_PyramidValid       = false;
+    bool m_PyramidHasContents = false;
+    float m_PreviousViewProjection[16]{};
+
+    std::vector<Buffer> m_StagingBuffers;
+    std::vector<VkDescriptorPool> m_DescriptorPools;
+    Ref<FreeLists> m_FreeLists;
+
+    // The frame being rendered
+    uint32_t m_InstanceCount = 0;
+    float m_ViewProjection[16]{};
+    std::vector<BufferCopy> m_GrowCopies;
+    std::vector<BufferCopy> m_Copies;
+    VkDescriptorSet m_CullSet = VK_NULL_HANDLE;
+    VkDescriptorSet m_DrawSet = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> m_PyramidSets;
+    RenderGraphResource m_Depth;
+    uint32_t m_DescriptorPool  = 0;
+    uint32_t m_StagingBuffer   = 0;
+    VkDeviceSize m_StagingUsed = 0;
+};
+
+} // namespace Noctis
@@ -0,0 +1,785 @@
+#include "VulkanRenderGraph.h"
+
+#include "Engine/Core/Hash.h"
+#include "Engine/Renderer/Renderer.h"
+
+namespace Noctis
+{
+
+namespace
+{
+
+struct AccessInfo
+{
+    VkPipelineStageFlags Stages = 0;
+    VkAccessFlags Access        = 0;
+    VkImageLayout Layout        = VK_IMAGE_LAYOUT_UNDEFINED;
+};
+
+VkPipelineStageFlags GetShaderStages(RenderGraphPassType type)
+{
+    switch (type)
+    {
+        case RenderGraphPassType::Graphics:
+            return VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        case RenderGraphPassType::Compute:
+            return VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        default:
+            return VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    }
+}
+
+AccessInfo GetAccessInfo(RenderGraphUsage usage, RenderGraphPassType type)
+{
+    switch (usage)
+    {
+        case RenderGraphUsage::None:
+            return {VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, VK_IMAGE_LAYOUT_UNDEFINED};
+        case RenderGraphUsage::ColorAttachment:
+            return {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                    VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+        case RenderGraphUsage::DepthStencilAttachment:
+            return {VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+        case RenderGraphUsage::DepthStencilRead:
+            return {VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL};
+        case RenderGraphUsage::ShaderRead:
+            return {GetShaderStages(type), VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+        case RenderGraphUsage::StorageRead:
+            return {GetShaderStages(type), VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL};
+        case RenderGraphUsage::StorageWrite:
+            return {GetShaderStages(type), VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                    VK_IMAGE_LAYOUT_GENERAL};
+        case RenderGraphUsage::UniformBuffer:
+            return {GetShaderStages(type), VK_ACCESS_UNIFORM_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED};
+        case RenderGraphUsage::VertexBuffer:
+            return {VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED};
+        case RenderGraphUsage::IndexBuffer:
+            return {VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED};
+        case RenderGraphUsage::IndirectBuffer:
+            return {VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+                    VK_IMAGE_LAYOUT_UNDEFINED};
+        case RenderGraphUsage::TransferSrc:
+            return {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL};
+        case RenderGraphUsage::TransferDst:
+            return {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL};
+        case RenderGraphUsage::Present:
+            return {VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR};
+        default:
+            break;
+    }
+    NOC_CORE_ASSERT(false, "Unknown render graph usage");
+    return {};
+}
+
+VkImageLayout GetImageLayout(RenderGraphUsage usage)
+{
+    // Layouts don't depend on the pass type
+    return GetAccessInfo(usage, RenderGraphPassType::Graphics).Layout;
+}
+
+// Stages and access of every access in a mask. Only writes need to be made available, so reads contribute stages only.
+AccessInfo GetAccessMaskInfo(uint64_t accesses, bool source)
+{
+    AccessInfo info;
+    for (uint32_t bit = 0; bit < 64; bit++)
+    {
+        if ((accesses & (1ull << bit)) == 0)
+            continue;
+
+        RenderGraphUsage usage;
+        RenderGraphPassType type;
+        RenderGraph::DecodeAccessBit(bit, usage, type);
+
+        const AccessInfo access = GetAccessInfo(usage, type);
+        info.Stages |= access.Stages;
+        if (!source || RenderGraph::IsWrite(usage))
+            info.Access |= access.Access;
+    }
+    return info;
+}
+
+VkFormat GetVkFormat(RenderGraphFormat format)
+{
+    switch (format)
+    {
+        case RenderGraphFormat::Undefined:
+            return VK_FORMAT_UNDEFINED;
+        case RenderGraphFormat::RGBA8:
+            return VK_FORMAT_R8G8B8A8_UNORM;
+        case RenderGraphFormat::BGRA8:
+            return VK_FORMAT_B8G8R8A8_UNORM;
+        case RenderGraphFormat::RGBA8_SRGB:
+            return VK_FORMAT_R8G8B8A8_SRGB;
+        case RenderGraphFormat::BGRA8_SRGB:
+            return VK_FORMAT_B8G8R8A8_SRGB;
+        case RenderGraphFormat::R8:
+            return VK_FORMAT_R8_UNORM;
+        case RenderGraphFormat::R32F:
+            return VK_FORMAT_R32_SFLOAT;
+        case RenderGraphFormat::RG16F:
+            return VK_FORMAT_R16G16_SFLOAT;
+        case RenderGraphFormat::RGBA16F:
+            return VK_FORMAT_R16G16B16A16_SFLOAT;
+        case RenderGraphFormat::RGBA32F:
+            return VK_FORMAT_R32G32B32A32_SFLOAT;
+        case RenderGraphFormat::Depth32F:
+            return VK_FORMAT_D32_SFLOAT;
+        case RenderGraphFormat::Depth24Stencil8:
+            return VK_FORMAT_D24_UNORM_S8_UINT;
+    }
+    return VK_FORMAT_UNDEFINED;
+}
+
+VkImageAspectFlags GetAspectMask(VkFormat format)
+{
+    switch (format)
+    {
+        case VK_FORMAT_D16_UNORM:
+        case VK_FORMAT_D32_SFLOAT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT;
+        case VK_FORMAT_D24_UNORM_S8_UINT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        default:
+            return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+}
+
+bool HasUsage(uint32_t usageMask, RenderGraphUsage usage)
+{
+    return (usageMask & (1u << static_cast<uint32_t>(usage))) != 0;
+}
+
+VkImageUsageFlags GetImageUsage(uint32_t usageMask)
+{
+    VkImageUsageFlags usage = 0;
+    if (HasUsage(usageMask, RenderGraphUsage::ColorAttachment))
+        usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    if (HasUsage(usageMask, RenderGraphUsage::DepthStencilAttachment) ||
+        HasUsage(usageMask, RenderGraphUsage::DepthStencilRead))
+        usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    if (HasUsage(usageMask, RenderGraphUsage::ShaderRead))
+        usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+    if (HasUsage(usageMask, RenderGraphUsage::StorageRead) || HasUsage(usageMask, RenderGraphUsage::StorageWrite))
+        usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+    if (HasUsage(usageMask, RenderGraphUsage::TransferSrc))
+        usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    if (HasUsage(usageMask, RenderGraphUsage::TransferDst))
+        usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    return usage;
+}
+
+VkBufferUsageFlags GetBufferUsage(uint32_t usageMask)
+{
+    VkBufferUsageFlags usage = 0;
+    if (HasUsage(usageMask, RenderGraphUsage::ShaderRead) || HasUsage(usageMask, RenderGraphUsage::StorageRead) ||
+        HasUsage(usageMask, RenderGraphUsage::StorageWrite))
+        usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    if (HasUsage(usageMask, RenderGraphUsage::UniformBuffer))
+        usage |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    if (HasUsage(usageMask, RenderGraphUsage::VertexBuffer))
+        usage |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    if (HasUsage(usageMask, RenderGraphUsage::IndexBuffer))
+        usage |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+    if (HasUsage(usageMask, RenderGraphUsage::IndirectBuffer))
+        usage |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+    if (HasUsage(usageMask, RenderGraphUsage::TransferSrc))
+        usage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    if (HasUsage(usageMask, RenderGraphUsage::TransferDst))
+        usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    return usage;
+}
+
+VkSampleCountFlagBits GetSampleCount(const RenderGraphResourceData& resource)
+{
+    return static_cast<VkSampleCountFlagBits>(resource.Texture.Samples);
+}
+
+VkImageCreateInfo GetImageCreateInfo(const RenderGraphResourceData& resource)
+{
+    const RenderGraphTextureDesc& desc = resource.Texture;
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+    imageInfo.format        = GetVkFormat(desc.Format);
+    imageInfo.extent        = {desc.Width, desc.Height, 1};
+    imageInfo.mipLevels     = desc.MipLevels;
+    imageInfo.arrayLayers   = desc.ArrayLayers;
+    imageInfo.samples       = GetSampleCount(resource);
+    imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage         = GetImageUsage(resource.UsageMask);
+    imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    return imageInfo;
+}
+
+VkBufferCreateInfo GetBufferCreateInfo(const RenderGraphResourceData& resource)
+{
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size        = resource.Buffer.Size;
+    bufferInfo.usage       = GetBufferUsage(resource.UsageMask);
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    return bufferInfo;
+}
+
+VkAttachmentLoadOp GetLoadOp(RenderGraphLoadOp loadOp)
+{
+    switch (loadOp)
+    {
+        case RenderGraphLoadOp::Clear:
+            return VK_ATTACHMENT_LOAD_OP_CLEAR;
+        case RenderGraphLoadOp::DontCare:
+            return VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        default:
+            return VK_ATTACHMENT_LOAD_OP_LOAD;
+    }
+}
+
+VkAttachmentStoreOp GetStoreOp(RenderGraphStoreOp storeOp)
+{
+    return storeOp == RenderGraphStoreOp::DontCare ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
+}
+
+} // namespace
+
+VkImage VulkanRenderGraphPassContext::GetImage(RenderGraphResource resource) const
+{
+    return m_Executor.GetImage(resource);
+}
+
+VkImageView VulkanRenderGraphPassContext::GetImageView(RenderGraphResource resource) const
+{
+    return m_Executor.GetImageView(resource);
+}
+
+VkBuffer VulkanRenderGraphPassContext::GetBuffer(RenderGraphResource resource) const
+{
+    return m_Executor.GetBuffer(resource);
+}
+
+void VulkanRenderGraphPassContext::RecordParallel(uint32_t count, uint32_t batchSize,
+                                                  const VulkanCommandPools::RecordFn& record)
+{
+    NOC_CORE_ASSERT(m_Pass.ParallelRecording, "The pass was not declared with parallel recording");
+
+    VkCommandBufferInheritanceInfo inheritance{};
+    inheritance.sType       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance.renderPass  = m_RenderPass;
+    inheritance.subpass     = 0;
+    inheritance.framebuffer = m_Framebuffer;
+
+    m_CommandPools.RecordParallel(m_CommandBuffer, &inheritance, count, batchSize, record);
+}
+
+VulkanRenderGraphExecutor::VulkanRenderGraphExecutor(const VulkanDevice& device, VulkanAllocator& allocator,
+                                                     VulkanCommandPools& commandPools, uint32_t framesInFlight)
+    : m_Device(device), m_Allocator(allocator), m_CommandPools(commandPools)
+{
+    m_Frames.resize(framesInFlight);
+}
+
+VulkanRenderGraphExecutor::~VulkanRenderGraphExecutor()
+{
+    NOC_PROFILE_FUNCTION();
+
+    for (FrameData& frame : m_Frames)
+        DestroyTransients(frame);
+
+    for (auto& [key, renderPass] : m_RenderPasses)
+        vkDestroyRenderPass(m_Device.GetVkDevice(), renderPass, nullptr);
+    m_RenderPasses.clear();
+}
+
+void VulkanRenderGraphExecutor::BindImage(RenderGraphResource resource, VkImage image, VkImageView view,
+                                          VkFormat format)
+{
+    m_BoundImages[resource.Index] = {image, view, format};
+}
+
+void VulkanRenderGraphExecutor::BindBuffer(RenderGraphResource resource, VkBuffer buffer)
+{
+    m_BoundBuffers[resource.Index] = buffer;
+}
+
+uint64_t VulkanRenderGraphExecutor::GetResourceKey(const RenderGraphResourceData& resource)
+{
+    uint64_t key = Hash::Combine(Hash::OFFSET_BASIS, resource.IsTexture);
+    key          = Hash::Combine(key, resource.UsageMask);
+    if (resource.IsTexture)
+    {
+        const RenderGraphTextureDesc& desc = resource.Texture;
+        key                                = Hash::Combine(key, desc.Width);
+        key                                = Hash::Combine(key, desc.Height);
+        key                                = Hash::Combine(key, static_cast<uint64_t>(desc.Format));
+        key                                = Hash::Combine(key, desc.MipLevels);
+        key                                = Hash::Combine(key, desc.ArrayLayers);
+        key                                = Hash::Combine(key, desc.Samples);
+    }
+    else
+    {
+        key = Hash::Combine(key, resource.Buffer.Size);
+    }
+    return key;
+}
+
+RenderGraphMemoryRequirements VulkanRenderGraphExecutor::GetMemoryRequirements(const RenderGraph& graph,
+                                                                               RenderGraphResource resource)
+{
+    const RenderGraphResourceData& data = graph.GetResource(resource);
+    const uint64_t key                  = GetResourceKey(data);
+
+    auto it = m_Requirements.find(key);
+    if (it == m_Requirements.end())
+    {
+        // Requirements only depend on the creation parameters, a throwaway resource answers for all later ones
+        auto vkDevice = m_Device.GetVkDevice();
+
+        RequirementsData requirements;
+        if (data.IsTexture)
+        {
+            const VkImageCreateInfo imageInfo = GetImageCreateInfo(data);
+            VkImage image                     = VK_NULL_HANDLE;
+            VK_CHECK_RESULT(vkCreateImage(vkDevice, &imageInfo, nullptr, &image));
+            vkGetImageMemoryRequirements(vkDevice, image, &requirements.Requirements);
+            vkDestroyImage(vkDevice, image, nullptr);
+        }
+        else
+        {
+            const VkBufferCreateInfo bufferInfo = GetBufferCreateInfo(data);
+            VkBuffer buffer                     = VK_NULL_HANDLE;
+            VK_CHECK_RESULT(vkCreateBuffer(vkDevice, &bufferInfo, nullptr, &buffer));
+            vkGetBufferMemoryRequirements(vkDevice, buffer, &requirements.Requirements);
+            vkDestroyBuffer(vkDevice, buffer, nullptr);
+        }
+
+        const std::pair<bool, uint32_t> kind(data.IsTexture, requirements.Requirements.memoryTypeBits);
+        auto kindIt       = std::find(m_HeapKinds.begin(), m_HeapKinds.end(), kind);
+        requirements.Heap = static_cast<uint32_t>(kindIt - m_HeapKinds.begin());
+        if (kindIt == m_HeapKinds.end())
+            m_HeapKinds.push_back(kind);
+
+        it = m_Requirements.emplace(key, requirements).first;
+    }
+
+    const RequirementsData& requirements = it->second;
+    return {requirements.Requirements.size, requirements.Requirements.alignment, requirements.Heap};
+}
+
+void VulkanRenderGraphExecutor::PrepareTransients(const RenderGraph& graph, FrameData& frame)
+{
+    NOC_PROFILE_FUNCTION();
+
+    uint64_t signature = Hash::OFFSET_BASIS;
+    for (uint32_t i = 0; i < graph.GetResourceCount(); i++)
+    {
+        const RenderGraphResourceData& resource = graph.GetResource({i});
+        if (!resource.IsTransient())
+            continue;
+
+        signature = Hash::Combine(signature, i);
+        signature = Hash::Combine(signature, GetResourceKey(resource));
+        signature = Hash::Combine(signature, resource.Heap);
+        signature = Hash::Combine(signature, resource.Offset);
+    }
+    for (uint64_t heapSize : graph.GetHeapSizes())
+        signature = Hash::Combine(signature, heapSize);
+
+    if (signature == frame.Signature && frame.Images.size() == graph.GetResourceCount())
+        return;
+
+    DestroyTransients(frame);
+    frame.Signature = signature;
+
+    auto vkDevice = m_Device.GetVkDevice();
+
+    const std::vector<uint64_t>& heapSizes = graph.GetHeapSizes();
+    frame.Heaps.resize(heapSizes.size());
+    for (uint32_t i = 0; i < heapSizes.size(); i++)
+    {
+        if (heapSizes[i] == 0)
+            continue;
+
+        VkMemoryRequirements requirements{};
+        requirements.size           = heapSizes[i];
+        requirements.memoryTypeBits = m_HeapKinds[i].second;
+        // Offsets are aligned for every resource in the heap, only the heap itself needs the strictest alignment
+        requirements.alignment = 1;
+        for (const auto& [key, data] : m_Requirements)
+        {
+            if (data.Heap == i)
+                requirements.alignment = std::max(requirements.alignment, data.Requirements.alignment);
+        }
+
+        frame.Heaps[i] = m_Allocator.Allocate(requirements, MemoryUsage::GPUOnly, m_HeapKinds[i].first);
+        NOC_CORE_ASSERT(frame.Heaps[i].IsValid(), "Out of memory for transient render graph resources");
+    }
+
+    frame.Images.assign(graph.GetResourceCount(), {});
+    frame.Buffers.assign(graph.GetResourceCount(), VK_NULL_HANDLE);
+
+    for (uint32_t i = 0; i < graph.GetResourceCount(); i++)
+    {
+        const RenderGraphResourceData& resource = graph.GetResource({i});
+        if (!resource.IsTransient())
+            continue;
+
+        const VulkanAllocation& heap = frame.Heaps[resource.Heap];
+        if (!resource.IsTexture)
+        {
+            const VkBufferCreateInfo bufferInfo = GetBufferCreateInfo(resource);
+            VK_CHECK_RESULT(vkCreateBuffer(vkDevice, &bufferInfo, nullptr, &frame.Buffers[i]));
+            VK_CHECK_RESULT(vkBindBufferMemory(vkDevice, frame.Buffers[i], heap.Memory, heap.Offset + resource.Offset));
+            continue;
+        }
+
+        const VkImageCreateInfo imageInfo = GetImageCreateInfo(resource);
+        ImageData& image                  = frame.Images[i];
+        image.Format                      = imageInfo.format;
+        VK_CHECK_RESULT(vkCreateImage(vkDevice, &imageInfo, nullptr, &image.Image));
+        VK_CHECK_RESULT(vkBindImageMemory(vkDevice, image.Image, heap.Memory, heap.Offset + resource.Offset));
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image                           = image.Image;
+        viewInfo.viewType                        = imageInfo.arrayLayers > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY
+                                                                             : VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format                          = imageInfo.format;
+        viewInfo.subresourceRange.aspectMask     = GetAspectMask(imageInfo.format);
+        viewInfo.subresourceRange.baseMipLevel   = 0;
+        viewInfo.subresourceRange.levelCount     = imageInfo.mipLevels;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount     = imageInfo.arrayLayers;
+        VK_CHECK_RESULT(vkCreateImageView(vkDevice, &viewInfo, nullptr, &image.View));
+    }
+}
+
+void VulkanRenderGraphExecutor::DestroyTransients(FrameData& frame)
+{
+    auto vkDevice = m_Device.GetVkDevice();
+
+    for (auto& [key, framebuffer] : frame.Framebuffers)
+        vkDestroyFramebuffer(vkDevice, framebuffer, nullptr);
+    frame.Framebuffers.clear();
+
+    for (ImageData& image : frame.Images)
+    {
+        if (image.View != VK_NULL_HANDLE)
+            vkDestroyImageView(vkDevice, image.View, nullptr);
+        if (image.Image != VK_NULL_HANDLE)
+            vkDestroyImage(vkDevice, image.Image, nullptr);
+    }
+    frame.Images.clear();
+
+    for (VkBuffer buffer : frame.Buffers)
+    {
+        if (buffer != VK_NULL_HANDLE)
+            vkDestroyBuffer(vkDevice, buffer, nullptr);
+    }
+    frame.Buffers.clear();
+
+    for (VulkanAllocation& heap : frame.Heaps)
+    {
+        if (heap.IsValid())
+            m_Allocator.Free(heap);
+    }
+    frame.Heaps.clear();
+    frame.Signature = 0;
+}
+
+void VulkanRenderGraphExecutor::ReleaseFramebuffers()
+{
+    for (FrameData& frame : m_Frames)
+    {
+        Renderer::SubmitResourceFree(
+            [device = m_Device.GetVkDevice(), framebuffers = std::move(frame.Framebuffers)]() {
+                for (auto& [key, framebuffer] : framebuffers)
+                    vkDestroyFramebuffer(device, framebuffer, nullptr);
+            });
+        frame.Framebuffers.clear();
+    }
+}
+
+void VulkanRenderGraphExecutor::Execute(RenderGraph& graph, VkCommandBuffer commandBuffer, uint32_t frameIndex,
+                                        VulkanGPUProfiler* profiler)
+{
+    NOC_PROFILE_FUNCTION();
+
+    graph.Compile([&](RenderGraphResource resource) { return GetMemoryRequirements(graph, resource); });
+
+    FrameData& frame = m_Frames[frameIndex];
+    PrepareTransients(graph, frame);
+
+    m_Images.assign(graph.GetResourceCount(), {});
+    m_Buffers.assign(graph.GetResourceCount(), VK_NULL_HANDLE);
+    for (uint32_t i = 0; i < graph.GetResourceCount(); i++)
+    {
+        const RenderGraphResourceData& resource = graph.GetResource({i});
+        if (!resource.IsUsed())
+            continue;
+
+        if (resource.Imported)
+        {
+            NOC_CORE_ASSERT(resource.IsTexture ? m_BoundImages.contains(i) : m_BoundBuffers.contains(i),
+                            "Imported render graph resource was not bound");
+            if (resource.IsTexture)
+                m_Images[i] = m_BoundImages[i];
+            else
+                m_Buffers[i] = m_BoundBuffers[i];
+        }
+        else
+        {
+            m_Images[i]  = frame.Images[i];
+            m_Buffers[i] = frame.Buffers[i];
+        }
+    }
+
+    for (const RenderGraphPass& pass : graph.GetPasses())
+    {
+        if (pass.Culled)
+            continue;
+
+        RecordBarriers(commandBuffer, graph, pass.Barriers);
+
+        const uint32_t region = profiler ? profiler->BeginRegion(commandBuffer, pass.Name) : 0;
+
+        RenderPassData renderPass;
+        if (pass.Type == RenderGraphPassType::Graphics)
+            renderPass = BeginRenderPass(commandBuffer, graph, pass, frame);
+
+        if (pass.Execute)
+        {
+            VulkanRenderGraphPassContext context(graph, pass, *this, m_CommandPools, commandBuffer,
+                                                 renderPass.RenderPass, renderPass.Framebuffer, renderPass.Extent);
+            pass.Execute(context);
+        }
+
+        if (renderPass.RenderPass != VK_NULL_HANDLE)
+            vkCmdEndRenderPass(commandBuffer);
+
+        if (profiler)
+            profiler->EndRegion(commandBuffer, region);
+    }
+
+    RecordBarriers(commandBuffer, graph, graph.GetFinalBarriers());
+
+    m_BoundImages.clear();
+    m_BoundBuffers.clear();
+}
+
+void VulkanRenderGraphExecutor::RecordBarriers(VkCommandBuffer commandBuffer, const RenderGraph& graph,
+                                               const std::vector<RenderGraphBarrier>& barriers)
+{
+    if (barriers.empty())
+        return;
+
+    VkPipelineStageFlags srcStages = 0;
+    VkPipelineStageFlags dstStages = 0;
+    VkMemoryBarrier memoryBarrier{};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    std::vector<VkImageMemoryBarrier> imageBarriers;
+
+    for (const RenderGraphBarrier& barrier : barriers)
+    {
+        const AccessInfo src = GetAccessMaskInfo(barrier.SrcAccesses, true);
+        const AccessInfo dst = GetAccessMaskInfo(barrier.DstAccess, false);
+
+        // Nothing to wait for: chaining on the destination stages still orders the barrier after e.g. the
+        // swapchain acquire semaphore wait, unlike TOP_OF_PIPE
+        srcStages |= src.Stages != 0 ? src.Stages : dst.Stages;
+        dstStages |= dst.Stages;
+
+        const RenderGraphResourceData& resource = graph.GetResource(barrier.Resource);
+        if (!resource.IsTexture)
+        {
+            // Buffers need no layout transitions, one global barrier covers all of them
+            memoryBarrier.srcAccessMask |= src.Access;
+            memoryBarrier.dstAccessMask |= dst.Access;
+            continue;
+        }
+
+        const ImageData& image = m_Images[barrier.Resource.Index];
+
+        VkImageMemoryBarrier& imageBarrier           = imageBarriers.emplace_back();
+        imageBarrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        imageBarrier.srcAccessMask                   = src.Access;
+        imageBarrier.dstAccessMask                   = dst.Access;
+        imageBarrier.oldLayout                       = GetImageLayout(barrier.OldUsage);
+        imageBarrier.newLayout                       = GetImageLayout(barrier.NewUsage);
+        imageBarrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.image                           = image.Image;
+        imageBarrier.subresourceRange.aspectMask     = GetAspectMask(image.Format);
+        imageBarrier.subresourceRange.baseMipLevel   = 0;
+        imageBarrier.subresourceRange.levelCount     = VK_REMAINING_MIP_LEVELS;
+        imageBarrier.subresourceRange.baseArrayLayer = 0;
+        imageBarrier.subresourceRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+    }
+
+    const bool hasMemoryBarrier = memoryBarrier.srcAccessMask != 0 || memoryBarrier.dstAccessMask != 0;
+    vkCmdPipelineBarrier(commandBuffer, srcStages, dstStages, 0, hasMemoryBarrier ? 1 : 0, &memoryBarrier, 0,
+                         nullptr, static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+}
+
+VkRenderPass VulkanRenderGraphExecutor::GetRenderPass(const RenderGraph& graph, const RenderGraphPass& pass)
+{
+    uint64_t key = Hash::OFFSET_BASIS;
+    for (const RenderGraphAccess& access : pass.Accesses)
+    {
+        if (!RenderGraph::IsAttachment(access.Usage))
+            continue;
+
+        key = Hash::Combine(key, m_Images[access.Resource.Index].Format);
+        key = Hash::Combine(key, graph.GetResource(access.Resource).Texture.Samples);
+        key = Hash::Combine(key, static_cast<uint64_t>(access.Usage));
+        key = Hash::Combine(key, static_cast<uint64_t>(access.LoadOp));
+        key = Hash::Combine(key, static_cast<uint64_t>(access.StoreOp));
+    }
+
+    auto it = m_RenderPasses.find(key);
+    if (it != m_RenderPasses.end())
+        return it->second;
+
+    NOC_PROFILE_FUNCTION();
+
+    std::vector<VkAttachmentDescription> attachments;
+    std::vector<VkAttachmentReference> colorReferences;
+    VkAttachmentReference depthReference{};
+    bool hasDepth = false;
+
+    for (const RenderGraphAccess& access : pass.Accesses)
+    {
+        if (!RenderGraph::IsAttachment(access.Usage))
+            continue;
+
+        // The graph's barriers transition the images, the render pass keeps them in the layout it found them in
+        const VkImageLayout layout        = GetImageLayout(access.Usage);
+        const VkAttachmentLoadOp loadOp   = GetLoadOp(access.LoadOp);
+        const VkAttachmentStoreOp storeOp = GetStoreOp(access.StoreOp);
+
+        VkAttachmentDescription& attachment = attachments.emplace_back();
+        attachment.format                   = m_Images[access.Resource.Index].Format;
+        attachment.samples                  = GetSampleCount(graph.GetResource(access.Resource));
+        attachment.loadOp                   = loadOp;
+        attachment.storeOp                  = storeOp;
+        attachment.stencilLoadOp            = loadOp;
+        attachment.stencilStoreOp           = storeOp;
+        attachment.initialLayout            = layout;
+        attachment.finalLayout              = layout;
+
+        const VkAttachmentReference reference = {static_cast<uint32_t>(attachments.size() - 1), layout};
+        if (access.Usage == RenderGraphUsage::ColorAttachment)
+        {
+            colorReferences.push_back(reference);
+        }
+        else
+        {
+            NOC_CORE_ASSERT(!hasDepth, "A pass can only have one depth attachment");
+            depthReference = reference;
+            hasDepth       = true;
+        }
+    }
+
+    VkSubpassDescription subpass{};
+    subpass.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount    = static_cast<uint32_t>(colorReferences.size());
+    subpass.pColorAttachments       = colorReferences.data();
+    subpass.pDepthStencilAttachment = hasDepth ? &depthReference : nullptr;
+
+    VkRenderPassCreateInfo renderPassInfo{};
+    renderPassInfo.sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+    renderPassInfo.pAttachments    = attachments.data();
+    renderPassInfo.subpassCount    = 1;
+    renderPassInfo.pSubpasses      = &subpass;
+
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    VK_CHECK_RESULT(vkCreateRenderPass(m_Device.GetVkDevice(), &renderPassInfo, nullptr, &renderPass));
+
+    m_RenderPasses.emplace(key, renderPass);
+    return renderPass;
+}
+
+VulkanRenderGraphExecutor::RenderPassData VulkanRenderGraphExecutor::BeginRenderPass(VkCommandBuffer commandBuffer,
+                                                                                     const RenderGraph& graph,
+                                                                                     const RenderGraphPass& pass,
+                                                                                     FrameData& frame)
+{
+    RenderPassData data;
+
+    std::vector<VkImageView> views;
+    for (const RenderGraphAccess& access : pass.Accesses)
+    {
+        if (!RenderGraph::IsAttachment(access.Usage))
+            continue;
+
+        const RenderGraphTextureDesc& desc = graph.GetResource(access.Resource).Texture;
+        if (views.empty())
+            data.Extent = {desc.Width, desc.Height};
+        NOC_CORE_ASSERT(desc.Width == data.Extent.width && desc.Height == data.Extent.height,
+                        "Attachments of a pass must have the same size");
+
+        views.push_back(m_Images[access.Resource.Index].View);
+
+        VkClearValue& clearValue = data.ClearValues.emplace_back();
+        if (access.Usage == RenderGraphUsage::ColorAttachment)
+        {
+            std::copy(std::begin(access.ClearValue.Color), std::end(access.ClearValue.Color),
+                      clearValue.color.float32);
+        }
+        else
+        {
+            clearValue.depthStencil.depth   = access.ClearValue.DepthStencil.Depth;
+            clearValue.depthStencil.stencil = access.ClearValue.DepthStencil.Stencil;
+        }
+    }
+
+    // Compute-like work in a graphics pass (e.g. only binding vertex buffers for a later pass) needs no render pass
+    if (views.empty())
+        return data;
+
+    data.RenderPass = GetRenderPass(graph, pass);
+
+    uint64_t framebufferKey = Hash::Combine(Hash::OFFSET_BASIS, reinterpret_cast<uint64_t>(data.RenderPass));
+    framebufferKey          = Hash::Combine(framebufferKey, data.Extent.width);
+    framebufferKey          = Hash::Combine(framebufferKey, data.Extent.height);
+    for (VkImageView view : views)
+        framebufferKey = Hash::Combine(framebufferKey, reinterpret_cast<uint64_t>(view));
+
+    VkFramebuffer& framebuffer = frame.Framebuffers[framebufferKey];
+    if (framebuffer == VK_NULL_HANDLE)
+    {
+        VkFramebufferCreateInfo framebufferInfo{};
+        framebufferInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass      = data.RenderPass;
+        framebufferInfo.attachmentCount = static_cast<uint32_t>(views.size());
+        framebufferInfo.pAttachments    = views.data();
+        framebufferInfo.width           = data.Extent.width;
+        framebufferInfo.height          = data.Extent.height;
+        framebufferInfo.layers          = 1;
+        VK_CHECK_RESULT(vkCreateFramebuffer(m_Device.GetVkDevice(), &framebufferInfo, nullptr, &framebuffer));
+    }
+    data.Framebuffer = framebuffer;
+
+    VkRenderPassBeginInfo renderPassInfo{};
+    renderPassInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassInfo.renderPass        = data.RenderPass;
+    renderPassInfo.framebuffer       = data.Framebuffer;
+    renderPassInfo.renderArea.extent = data.Extent;
+    renderPassInfo.clearValueCount   = static_cast<uint32_t>(data.ClearValues.size());
+    renderPassInfo.pClearValues      = data.ClearValues.data();
+
+    // A subpass is recorded either inline or entirely through secondary command buffers
+    const VkSubpassContents contents =
+        pass.ParallelRecording ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE;
+    vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, contents);
+
+    return data;
+}
+
+} // namespace Noctis
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "VulkanAllocator.h"
+#include "VulkanCommandPools.h"
+#include "VulkanDevice.h"
+#include "VulkanGPUProfiler.h"
+
+#include "Engine/Renderer/RenderGraph.h"
+
+namespace Noctis
+{
+
+class VulkanRenderGraphExecutor;
+
+class VulkanRenderGraphPassContext : public RenderGraphPassContext
+{
+  public:
+    VulkanRenderGraphPassContext(const RenderGraph& graph, const RenderGraphPass& pass,
+                                 const VulkanRenderGraphExecutor& executor, VulkanCommandPools& commandPools,
+                                 VkCommandBuffer commandBuffer, VkRenderPass renderPass, VkFramebuffer framebuffer,
+                                 VkExtent2D extent)
+        : RenderGraphPassContext(graph, pass), m_Executor(executor), m_CommandPools(commandPools),
+          m_CommandBuffer(commandBuffer), m_RenderPass(renderPass), m_Framebuffer(framebuffer), m_Extent(extent)
+    {
+    }
+
+    VkCommandBuffer GetCommandBuffer() const { return m_CommandBuffer; }
+    // Graphics passes with attachments are recorded inside this render pass, pipelines have to be compatible with it
+    VkRenderPass GetRenderPass() const { return m_RenderPass; }
+    VkExtent2D GetExtent() const { return m_Extent; }
+
+    VkImage GetImage(RenderGraphResource resource) const;
+    VkImageView GetImageView(RenderGraphResource resource) const;
+    VkBuffer GetBuffer(RenderGraphResource resource) const;
+
+    // Passes with parallel recording only: records [0, count) in batches on the job system, into secondary command
+    // buffers continuing the pass's render pass. They inherit no state, every batch binds its own pipeline and sets
+    // its own viewport.
+    void RecordParallel(uint32_t count, uint32_t batchSize, const VulkanCommandPools::RecordFn& record);
+
+  private:
+    const VulkanRenderGraphExecutor& m_Executor;
+    VulkanCommandPools& m_CommandPools;
+    VkCommandBuffer m_CommandBuffer;
+    VkRenderPass m_RenderPass;
+    VkFramebuffer m_Framebuffer;
+    VkExtent2D m_Extent;
+};
+
+// Records a compiled render graph into a command buffer. Transient resources are placed in a few memory heaps per
+// frame in flight, and kept as long as the graph's transient resources and their placement don't change, so a graph
+// built the same way every frame creates nothing after the first frames. Render passes are cached for the
+// executor's lifetime, framebuffers per frame in flight.
+class VulkanRenderGraphExecutor
+{
+  public:
+    VulkanRenderGraphExecutor(const VulkanDevice& device, VulkanAllocator& allocator, VulkanCommandPools& commandPools,
+                              uint32_t framesInFlight);
+    ~VulkanRenderGraphExecutor();
+
+    VulkanRenderGraphExecutor(const VulkanRenderGraphExecutor&)            = delete;
+    VulkanRenderGraphExecutor& operator=(const VulkanRenderGraphExecutor&) = delete;
+
+    // The actual resources behind imported ones, for the next Execute
+    void BindImage(RenderGraphResource resource, VkImage image, VkImageView view, VkFormat format);
+    void BindBuffer(RenderGraphResource resource, VkBuffer buffer);
+
+    // Compiles the graph and records it. The frame slot's previous submission must be complete.
+    void Execute(RenderGraph& graph, VkCommandBuffer commandBuffer, uint32_t frameIndex,
+                 VulkanGPUProfiler* profiler = nullptr);
+
+    // Call when bound image views are about to be destroyed (e.g. on swapchain recreation), framebuffers referencing
+    // them are released once the frames in flight are done with them
+    void ReleaseFramebuffers();
+
+    VkImage GetImage(RenderGraphResource resource) const { return m_Images[resource.Index].Image; }
+    VkImageView GetImageView(RenderGraphResource resource) const { return m_Images[resource.Index].View; }
+    VkBuffer GetBuffer(RenderGraphResource resource) const { return m_Buffers[resource.Index]; }
+
+  private:
+    struct ImageData
+    {
+        VkImage Image    = VK_NULL_HANDLE;
+        VkImageView View = VK_NULL_HANDLE;
+        VkFormat Format  = VK_FORMAT_UNDEFINED;
+    };
+
+    struct RequirementsData
+    {
+        VkMemoryRequirements Requirements{};
+        uint32_t Heap = 0;
+    };
+
+    // Transient resources of one frame in flight, indexed by graph resource
+    struct FrameData
+    {
+        uint64_t Signature = 0;
+        std::vector<VulkanAllocation> Heaps;
+        std::vector<ImageData> Images;
+        std::vector<VkBuffer> Buffers;
+        std::unordered_map<uint64_t, VkFramebuffer> Framebuffers;
+    };
+
+    struct RenderPassData
+    {
+        VkRenderPass RenderPass   = VK_NULL_HANDLE;
+        VkFramebuffer Framebuffer = VK_NULL_HANDLE;
+        VkExtent2D Extent{};
+        std::vector<VkClearValue> ClearValues;
+    };
+
+    RenderGraphMemoryRequirements GetMemoryRequirements(const RenderGraph& graph, RenderGraphResource resource);
+    void PrepareTransients(const RenderGraph& graph, FrameData& frame);
+    void DestroyTransients(FrameData& frame);
+
+    void RecordBarriers(VkCommandBuffer commandBuffer, const RenderGraph& graph,
+                        const std::vector<RenderGraphBarrier>& barriers);
+    RenderPassData BeginRenderPass(VkCommandBuffer commandBuffer, const RenderGraph& graph,
+                                   const RenderGraphPass& pass, FrameData& frame);
+    VkRenderPass GetRenderPass(const RenderGraph& graph, const RenderGraphPass& pass);
+
+    static uint64_t GetResourceKey(const RenderGraphResourceData& resource);
+
+  private:
+    const VulkanDevice& m_Device;
+    VulkanAllocator& m_Allocator;
+    VulkanCommandPools& m_CommandPools;
+
+    std::vector<FrameData> m_Frames;
+
+    // Per graph resource, for the graph being executed
+    std::vector<ImageData> m_Images;
+    std::vector<VkBuffer> m_Buffers;
+    std::unordered_map<uint32_t, ImageData> m_BoundImages;
+    std::unordered_map<uint32_t, VkBuffer> m_BoundBuffers;
+
+    std::unordered_map<uint64_t, RequirementsData> m_Requirements;
+    // Memory kinds transient resources are grouped by: images or buffers, and the allowed memory types
+    std::vector<std::pair<bool, uint32_t>> m_HeapKinds;
+    std::unordered_map<uint64_t, VkRenderPass> m_RenderPasses;
+};
+
+} // namespace Noctis
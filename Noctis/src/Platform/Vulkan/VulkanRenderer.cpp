@@ -5,68 +5,64 @@ namespace Noctis
 
 void VulkanRenderer::Init()
 {
+    NOC_PROFILE_FUNCTION();
+
     NOC_CORE_INFO("Initializing Vulkan Renderer API");
 
     m_Context = VulkanContext::Get();
 
-    CreateCommandPool();
-    CreateCommandBuffers();
     CreateSyncObjects();
 
-    CreateRenderPass();
-    CreateFramebuffers();
+    m_ResourceFreeQueues.resize(m_FramesInFlight);
+
+    CreateFrameObjects();
 
     NOC_CORE_INFO("Vulkan Renderer API initialized successfully");
 }
 
 void VulkanRenderer::Shutdown()
 {
+    NOC_PROFILE_FUNCTION();
+
     const auto device = m_Context->GetDevice()->GetVkDevice();
 
     vkDeviceWaitIdle(device);
 
-    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-    {
-        vkDestroySemaphore(device, m_ImageAvailableSemaphores[i], nullptr);
-        vkDestroySemaphore(device, m_RenderFinishedSemaphores[i], nullptr);
-        vkDestroyFence(device, m_InFlightFences[i], nullptr);
-    }
+    m_GPUProfiler.reset();
+    m_ComputeQueue.reset();
+    m_RenderGraphExecutor.reset();
+    m_RenderGraph.Reset();
 
-    vkDestroyCommandPool(device, m_CommandPool, nullptr);
-    m_CommandPool = nullptr;
-}
+    for (uint32_t i = 0; i < m_FramesInFlight; i++)
+        FlushResourceFreeQueue(i);
 
-void VulkanRenderer::CreateCommandPool()
-{
-    QueueFamilyIndices indices = m_Context->GetDevice()->GetQueueFamilyIndices();
+    DestroySyncObjects();
 
-    VkCommandPoolCreateInfo poolInfo{};
-    poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    poolInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-    poolInfo.queueFamilyIndex = indices.GraphicsFamily;
-
-    VK_CHECK_RESULT(vkCreateCommandPool(m_Context->GetDevice()->GetVkDevice(), &poolInfo, nullptr, &m_CommandPool));
+    m_CommandPools.reset();
 }
 
-void VulkanRenderer::CreateCommandBuffers()
+void VulkanRenderer::CreateFrameObjects()
 {
-    m_CommandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    NOC_PROFILE_FUNCTION();
 
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.commandPool        = m_CommandPool;
-    allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandBufferCount = static_cast<uint32_t>(m_CommandBuffers.size());
+    auto device = m_Context->GetDevice();
 
-    VK_CHECK_RESULT(
-        vkAllocateCommandBuffers(m_Context->GetDevice()->GetVkDevice(), &allocInfo, m_CommandBuffers.data()));
+    m_CommandPools = CreateScope<VulkanCommandPools>(*device, device->GetQueueFamilyIndices().GraphicsFamily,
+                                                     m_FramesInFlight);
+    m_GPUProfiler  = CreateScope<VulkanGPUProfiler>(*device, m_FramesInFlight);
+    m_ComputeQueue = CreateScope<VulkanComputeQueue>(*device, m_FramesInFlight);
+    m_RenderGraphExecutor =
+        CreateScope<VulkanRenderGraphExecutor>(*device, *m_Context->GetAllocator(), *m_CommandPools, m_FramesInFlight);
+    m_RenderPassGeneration++;
 }
 
 void VulkanRenderer::CreateSyncObjects()
 {
-    m_ImageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-    m_RenderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-    m_InFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+    NOC_PROFILE_FUNCTION();
+
+    m_ImageAvailableSemaphores.resize(m_FramesInFlight);
+    m_RenderFinishedSemaphores.resize(m_FramesInFlight);
+    m_InFlightFences.resize(m_FramesInFlight);
 
     VkSemaphoreCreateInfo semaphoreInfo{};
     semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
@@ -77,7 +73,7 @@ void VulkanRenderer::CreateSyncObjects()
 
     auto device = m_Context->GetDevice()->GetVkDevice();
 
-    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    for (size_t i = 0; i < m_FramesInFlight; i++)
     {
         VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &m_ImageAvailableSemaphores[i]));
         VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &m_RenderFinishedSemaphores[i]));
@@ -85,128 +81,256 @@ void VulkanRenderer::CreateSyncObjects()
     }
 }
 
-void VulkanRenderer::CreateRenderPass()
+void VulkanRenderer::DestroySyncObjects()
 {
-    VkAttachmentDescription attachment{};
-    attachment.loadOp        = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    attachment.finalLayout   = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-    attachment.storeOp       = VK_ATTACHMENT_STORE_OP_STORE;
-    attachment.samples       = VK_SAMPLE_COUNT_1_BIT;
-    attachment.format        = m_Context->GetSwapchain()->GetVkSwapchainImageFormat();
+    auto device = m_Context->GetDevice()->GetVkDevice();
 
-    VkAttachmentReference colorAttachmentReference{};
-    colorAttachmentReference.attachment = 0;
-    colorAttachmentReference.layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    for (size_t i = 0; i < m_InFlightFences.size(); i++)
+    {
+        vkDestroySemaphore(device, m_ImageAvailableSemaphores[i], nullptr);
+        vkDestroySemaphore(device, m_RenderFinishedSemaphores[i], nullptr);
+        vkDestroyFence(device, m_InFlightFences[i], nullptr);
+    }
+    m_ImageAvailableSemaphores.clear();
+    m_RenderFinishedSemaphores.clear();
+    m_InFlightFences.clear();
+}
 
-    VkSubpassDescription subpass{};
-    subpass.colorAttachmentCount = 1;
-    subpass.pColorAttachments    = &colorAttachmentReference;
+void VulkanRenderer::RecreateFrameResources(uint32_t framesInFlight)
+{
+    NOC_PROFILE_FUNCTION();
+
+    auto device = m_Context->GetDevice()->GetVkDevice();
+
+    // A one-off wait when the setting changes, the semaphores and command buffers of every slot are about to go away.
+    // The fences don't cover pending presents still waiting on the render finished semaphores, so idle the device.
+    vkDeviceWaitIdle(device);
 
-    VkRenderPassCreateInfo renderPassInfo{};
-    renderPassInfo.sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    renderPassInfo.attachmentCount = 1;
-    renderPassInfo.pAttachments    = &attachment;
-    renderPassInfo.subpassCount    = 1;
-    renderPassInfo.pSubpasses      = &subpass;
+    for (uint32_t i = 0; i < m_FramesInFlight; i++)
+        FlushResourceFreeQueue(i);
+
+    m_GPUProfiler.reset();
+    m_ComputeQueue.reset();
+    m_RenderGraphExecutor.reset();
+    DestroySyncObjects();
+    m_CommandPools.reset();
+
+    m_FramesInFlight = framesInFlight;
+    m_CurrentFrame   = 0;
+
+    CreateSyncObjects();
+    m_ResourceFreeQueues.resize(m_FramesInFlight);
+    CreateFrameObjects();
 
-    VK_CHECK_RESULT(vkCreateRenderPass(m_Context->GetDevice()->GetVkDevice(), &renderPassInfo, nullptr, &m_RenderPass))
+    NOC_CORE_INFO("Frames in flight: {0}", m_FramesInFlight);
 }
 
-void VulkanRenderer::CreateFramebuffers()
+bool VulkanRenderer::RecreateSwapchain()
 {
-    auto swapChainImageCount = m_Context->GetSwapchain()->GetVkSwapchainImages().size();
-    m_Framebuffers.resize(swapChainImageCount);
+    NOC_PROFILE_FUNCTION();
 
-    VkFramebufferCreateInfo framebufferInfo{};
-    framebufferInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-    framebufferInfo.width           = m_Context->GetSwapchain()->GetVkSwapchainExtent().width;
-    framebufferInfo.height          = m_Context->GetSwapchain()->GetVkSwapchainExtent().height;
-    framebufferInfo.renderPass      = m_RenderPass;
-    framebufferInfo.layers          = 1;
-    framebufferInfo.attachmentCount = 1;
+    auto swapchain = m_Context->GetSwapchain();
 
-    for (uint32_t i = 0; i < m_Context->GetSwapchain()->GetVkSwapchainImages().size(); i++)
-    {
-        framebufferInfo.pAttachments = &m_Context->GetSwapchain()->GetVkSwapchainImageViews()[i];
+    swapchain->Recreate();
+    if (swapchain->NeedsRecreate())
+        return false;
+
+    // Frames still in flight may reference the old framebuffers, they go away with the old swapchain
+    m_RenderGraphExecutor->ReleaseFramebuffers();
+    return true;
+}
 
-        VK_CHECK_RESULT(
-            vkCreateFramebuffer(m_Context->GetDevice()->GetVkDevice(), &framebufferInfo, nullptr, &m_Framebuffers[i]))
+void VulkanRenderer::OnWindowResize(uint32_t width, uint32_t height)
+{
+    m_Context->GetSwapchain()->OnResize(width, height);
+}
+
+void VulkanRenderer::SetPresentationSettings(const PresentationSettings& settings)
+{
+    auto swapchain = m_Context->GetSwapchain();
+    swapchain->SetPresentMode(settings.Mode);
+    swapchain->SetRequestedImageCount(settings.SwapchainImageCount);
+
+    m_RequestedFramesInFlight = std::clamp(settings.FramesInFlight, 1u, MAX_FRAMES_IN_FLIGHT);
+}
+
+PresentationSettings VulkanRenderer::GetPresentationSettings() const
+{
+    PresentationSettings settings;
+    settings.Mode                = m_Context->GetSwapchain()->GetPresentMode();
+    settings.FramesInFlight      = m_RequestedFramesInFlight;
+    settings.SwapchainImageCount = m_Context->GetSwapchain()->GetRequestedImageCount();
+    return settings;
+}
+
+std::vector<DeviceMemoryHeap> VulkanRenderer::GetDeviceMemoryHeaps() const
+{
+    std::vector<DeviceMemoryHeap> heaps;
+    for (const VulkanHeapStatistics& statistics : m_Context->GetAllocator()->GetHeapStatistics())
+    {
+        DeviceMemoryHeap& heap = heaps.emplace_back();
+        heap.Size              = statistics.HeapSize;
+        heap.DeviceLocal       = statistics.DeviceLocal;
+        heap.AllocatedBytes    = statistics.AllocatedBytes;
+        heap.UsedBytes         = statistics.UsedBytes;
+        heap.AllocationCount   = statistics.AllocationCount;
     }
+    return heaps;
+}
+
+void VulkanRenderer::SubmitResourceFree(std::function<void()>&& func)
+{
+    // Outside a frame the current slot is the next one BeginFrame waits on and flushes, while the frame submitted
+    // last, which may still use the resource, sits in the slot before it
+    const uint32_t frameIndex =
+        m_FrameInProgress ? m_CurrentFrame : (m_CurrentFrame + m_FramesInFlight - 1) % m_FramesInFlight;
+    m_ResourceFreeQueues[frameIndex].push_back(std::move(func));
 }
 
-void VulkanRenderer::BeginFrame()
+void VulkanRenderer::FlushResourceFreeQueue(uint32_t frameIndex)
 {
+    for (auto& func : m_ResourceFreeQueues[frameIndex])
+        func();
+    m_ResourceFreeQueues[frameIndex].clear();
+}
+
+bool VulkanRenderer::BeginFrame()
+{
+    NOC_PROFILE_FUNCTION();
+
     auto device    = m_Context->GetDevice()->GetVkDevice();
-    auto swapChain = m_Context->GetSwapchain()->GetVkSwapchain();
+    auto swapchain = m_Context->GetSwapchain();
+
+    if (m_RequestedFramesInFlight != m_FramesInFlight)
+        RecreateFrameResources(m_RequestedFramesInFlight);
+
+    {
+        NOC_PROFILE_SCOPE("vkWaitForFences");
+        vkWaitForFences(device, 1, &m_InFlightFences[m_CurrentFrame], VK_TRUE, UINT64_MAX);
+    }
+
+    FlushResourceFreeQueue(m_CurrentFrame);
+    m_ComputeQueue->BeginFrame(m_CurrentFrame);
 
-    vkWaitForFences(device, 1, &m_InFlightFences[m_CurrentFrame], VK_TRUE, UINT64_MAX);
+    // Recreating here instead of idling the device: the old swapchain is handed to the new one and
+    // retired through the free queue, so frames already in flight finish undisturbed
+    if (swapchain->NeedsRecreate() && !RecreateSwapchain())
+        return false;
 
-    VK_CHECK_RESULT(vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, m_ImageAvailableSemaphores[m_CurrentFrame],
-                                          VK_NULL_HANDLE, &m_CurrentImageIndex));
+    {
+        NOC_PROFILE_SCOPE("vkAcquireNextImageKHR");
+        const VkResult result =
+            swapchain->AcquireNextImage(m_ImageAvailableSemaphores[m_CurrentFrame], m_CurrentImageIndex);
+
+        // The fence is still signaled, so this slot can simply be reused next frame
+        if (result == VK_ERROR_OUT_OF_DATE_KHR)
+            return false;
+        if (result != VK_SUBOPTIMAL_KHR)
+            VK_CHECK_RESULT(result);
+    }
 
     vkResetFences(device, 1, &m_InFlightFences[m_CurrentFrame]);
 
-    vkResetCommandBuffer(m_CommandBuffers[m_CurrentFrame], 0);
+    m_CommandPools->BeginFrame(m_CurrentFrame);
+    m_CommandBuffer = m_CommandPools->Allocate(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
 
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
-    VK_CHECK_RESULT(vkBeginCommandBuffer(m_CommandBuffers[m_CurrentFrame], &beginInfo));
+    VK_CHECK_RESULT(vkBeginCommandBuffer(m_CommandBuffer, &beginInfo));
+
+    m_GPUProfiler->BeginFrame(m_CommandBuffer, m_CurrentFrame);
+
+    const VkExtent2D extent = swapchain->GetVkSwapchainExtent();
+
+    RenderGraphTextureDesc backbufferDesc;
+    backbufferDesc.Width  = extent.width;
+    backbufferDesc.Height = extent.height;
+    // The actual format comes with the image bound at EndFrame
+    backbufferDesc.Format = RenderGraphFormat::Undefined;
 
-    // Begin render pass
-    VkRenderPassBeginInfo renderPassInfo{};
-    renderPassInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    renderPassInfo.renderPass        = m_RenderPass;
-    renderPassInfo.framebuffer       = m_Framebuffers[m_CurrentImageIndex];
-    renderPassInfo.renderArea.extent = m_Context->GetSwapchain()->GetVkSwapchainExtent();
+    m_RenderGraph.Reset();
+    m_Backbuffer = m_RenderGraph.ImportTexture(
+        "Backbuffer", backbufferDesc, RenderGraphUsage::None,
+        swapchain->IsOffscreen() ? RenderGraphUsage::TransferSrc : RenderGraphUsage::Present);
 
-    VkClearValue clearColor{};
-    clearColor.color               = {1.0f, 0.0f, 1.0f, 1.0f};
-    renderPassInfo.clearValueCount = 1;
-    renderPassInfo.pClearValues    = &clearColor;
+    m_RenderGraph.AddPass("Main Pass", RenderGraphPassType::Graphics, {})
+        .ClearColor(m_Backbuffer, 1.0f, 0.0f, 1.0f, 1.0f);
 
-    vkCmdBeginRenderPass(m_CommandBuffers[m_CurrentFrame], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    m_FrameInProgress = true;
+    return true;
 }
 
 void VulkanRenderer::EndFrame()
 {
-    vkCmdEndRenderPass(m_CommandBuffers[m_CurrentFrame]);
+    NOC_PROFILE_FUNCTION();
+
+    auto swapchain = m_Context->GetSwapchain();
+    m_RenderGraphExecutor->BindImage(m_Backbuffer, swapchain->GetVkSwapchainImages()[m_CurrentImageIndex],
+                                     swapchain->GetVkSwapchainImageViews()[m_CurrentImageIndex],
+                                     swapchain->GetVkSwapchainImageFormat());
+    m_RenderGraphExecutor->Execute(m_RenderGraph, m_CommandBuffer, m_CurrentFrame, m_GPUProfiler.get());
+
+    m_GPUProfiler->EndFrame(m_CommandBuffer);
+
+    VK_CHECK_RESULT(vkEndCommandBuffer(m_CommandBuffer));
+
+    // Uploads recorded this frame go to the transfer queue now, the frame waits for them and acquires ownership
+    m_SubmitWaitSemaphores.assign(1, m_ImageAvailableSemaphores[m_CurrentFrame]);
+    m_SubmitWaitStages.assign(1, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    m_SubmitCommandBuffers.clear();
 
-    VK_CHECK_RESULT(vkEndCommandBuffer(m_CommandBuffers[m_CurrentFrame]));
+    auto uploader = m_Context->GetUploader();
+    uploader->Flush();
+    uploader->ConsumeUploads(m_SubmitWaitSemaphores, m_SubmitWaitStages, m_SubmitCommandBuffers);
+    m_SubmitCommandBuffers.push_back(m_CommandBuffer);
+
+    m_ComputeQueue->SubmitBeforeGraphics(m_SubmitWaitSemaphores, m_SubmitWaitStages);
+
+    m_SubmitSignalSemaphores.assign(1, m_RenderFinishedSemaphores[m_CurrentFrame]);
+    if (VkSemaphore semaphore = m_ComputeQueue->GetGraphicsFinishedSemaphore())
+        m_SubmitSignalSemaphores.push_back(semaphore);
 
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
-    VkSemaphore waitSemaphores[]      = {m_ImageAvailableSemaphores[m_CurrentFrame]};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount     = 1;
-    submitInfo.pWaitSemaphores        = waitSemaphores;
-    submitInfo.pWaitDstStageMask      = waitStages;
-
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers    = &m_CommandBuffers[m_CurrentFrame];
+    submitInfo.waitSemaphoreCount = static_cast<uint32_t>(m_SubmitWaitSemaphores.size());
+    submitInfo.pWaitSemaphores    = m_SubmitWaitSemaphores.data();
+    submitInfo.pWaitDstStageMask  = m_SubmitWaitStages.data();
 
-    VkSemaphore signalSemaphores[]  = {m_RenderFinishedSemaphores[m_CurrentFrame]};
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores    = signalSemaphores;
+    submitInfo.commandBufferCount = static_cast<uint32_t>(m_SubmitCommandBuffers.size());
+    submitInfo.pCommandBuffers    = m_SubmitCommandBuffers.data();
 
-    VK_CHECK_RESULT(
-        vkQueueSubmit(m_Context->GetDevice()->GetVkGraphicsQueue(), 1, &submitInfo, m_InFlightFences[m_CurrentFrame]));
+    submitInfo.signalSemaphoreCount = static_cast<uint32_t>(m_SubmitSignalSemaphores.size());
+    submitInfo.pSignalSemaphores    = m_SubmitSignalSemaphores.data();
 
-    VkPresentInfoKHR presentInfo{};
-    presentInfo.sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores    = signalSemaphores;
+    {
+        NOC_PROFILE_SCOPE("vkQueueSubmit");
+        std::lock_guard lock(m_Context->GetDevice()->GetQueueMutex());
+        VK_CHECK_RESULT(vkQueueSubmit(m_Context->GetDevice()->GetVkGraphicsQueue(), 1, &submitInfo,
+                                      m_InFlightFences[m_CurrentFrame]));
+    }
+    m_FrameInProgress = false;
+    m_GPUProfiler->OnSubmit();
+    m_ComputeQueue->SubmitAfterGraphics();
 
-    VkSwapchainKHR swapChains[] = {m_Context->GetSwapchain()->GetVkSwapchain()};
-    presentInfo.swapchainCount  = 1;
-    presentInfo.pSwapchains     = swapChains;
-    presentInfo.pImageIndices   = &m_CurrentImageIndex;
+    {
+        NOC_PROFILE_SCOPE("vkQueuePresentKHR");
+        // Out of date and suboptimal results flag the swapchain, it is recreated at the start of the next frame
+        const VkResult result = m_Context->GetSwapchain()->Present(m_Context->GetDevice()->GetVkPresentQueue(),
+                                                                   m_RenderFinishedSemaphores[m_CurrentFrame],
+                                                                   m_CurrentImageIndex);
+        if (result != VK_ERROR_OUT_OF_DATE_KHR && result != VK_SUBOPTIMAL_KHR)
+            VK_CHECK_RESULT(result);
+    }
 
-    VK_CHECK_RESULT(vkQueuePresentKHR(m_Context->GetDevice()->GetVkPresentQueue(), &presentInfo));
+    m_CurrentFrame = (m_CurrentFrame + 1) % m_FramesInFlight;
 
-    m_CurrentFrame = (m_CurrentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+    if (m_PipelineCacheSaveTimer.Elapsed() > PIPELINE_CACHE_SAVE_INTERVAL)
+    {
+        m_Context->GetDevice()->SavePipelineCacheAsync();
+        m_PipelineCacheSaveTimer.Reset();
+    }
 }
 
 } // namespace Noctis
\ No newline at end of file
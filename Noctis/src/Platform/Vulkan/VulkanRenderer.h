@@ -1,6 +1,12 @@
 #pragma once
 
+#include "VulkanCommandPools.h"
+#include "VulkanComputeQueue.h"
 #include "VulkanContext.h"
+#include "VulkanGPUProfiler.h"
+#include "VulkanRenderGraph.h"
+#include "Engine/Core/Timer.h"
+#include "Engine/Renderer/RenderGraph.h"
 #include "Engine/Renderer/RendererAPI.h"
 
 namespace Noctis
@@ -12,33 +18,84 @@ class VulkanRenderer : public RendererAPI
     void Init() override;
     void Shutdown() override;
 
-    void BeginFrame() override;
+    bool BeginFrame() override;
     void EndFrame() override;
 
+    void OnWindowResize(uint32_t width, uint32_t height) override;
+
+    void SetPresentationSettings(const PresentationSettings& settings) override;
+    PresentationSettings GetPresentationSettings() const override;
+    void SubmitResourceFree(std::function<void()>&& func) override;
+
+    const std::vector<GPUTiming>& GetGPUTimings() const override { return m_GPUProfiler->GetTimings(); }
+    std::vector<DeviceMemoryHeap> GetDeviceMemoryHeaps() const override;
+
+    // Valid between BeginFrame and EndFrame
+    VulkanComputeQueue& GetComputeQueue() { return *m_ComputeQueue; }
+    // Rebuilt every frame: passes added between BeginFrame and EndFrame are recorded at EndFrame
+    RenderGraph& GetRenderGraph() { return m_RenderGraph; }
+    RenderGraphResource GetBackbuffer() const { return m_Backbuffer; }
+    // Binds the resources behind imported ones for this frame's EndFrame
+    VulkanRenderGraphExecutor& GetRenderGraphExecutor() { return *m_RenderGraphExecutor; }
+    // Changes whenever the executor is recreated along with its render passes. Pipelines cached by VkRenderPass have
+    // to be dropped then, a new render pass may reuse the handle of a destroyed, incompatible one.
+    uint64_t GetRenderPassGeneration() const { return m_RenderPassGeneration; }
+
+    static VulkanRenderer& Get() { return static_cast<VulkanRenderer&>(Renderer::GetRendererAPI()); }
+
   private:
-    void CreateCommandPool();
-    void CreateCommandBuffers();
+    // Everything sized by the frames in flight count besides the sync objects
+    void CreateFrameObjects();
     void CreateSyncObjects();
+    void DestroySyncObjects();
+
+    // Rebuilds everything sized by the frames in flight count, after the GPU is done with all of it
+    void RecreateFrameResources(uint32_t framesInFlight);
 
-    void CreateRenderPass();
-    void CreateFramebuffers();
+    // Returns false if the swapchain can't be rendered into yet (e.g. the window is minimized)
+    bool RecreateSwapchain();
+    void FlushResourceFreeQueue(uint32_t frameIndex);
 
   private:
     Ref<VulkanContext> m_Context;
-    VkCommandPool m_CommandPool = VK_NULL_HANDLE;
-    std::vector<VkCommandBuffer> m_CommandBuffers;
+    // Per thread and frame in flight. The frame's primary command buffer comes from the main thread's pool.
+    Scope<VulkanCommandPools> m_CommandPools;
+    VkCommandBuffer m_CommandBuffer = VK_NULL_HANDLE;
 
     // Synchronization objects
     std::vector<VkSemaphore> m_ImageAvailableSemaphores;
     std::vector<VkSemaphore> m_RenderFinishedSemaphores;
     std::vector<VkFence> m_InFlightFences;
 
-    static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
-    uint32_t m_CurrentFrame                   = 0;
-    uint32_t m_CurrentImageIndex              = 0;
+    // Reused every frame, the frame's submission also waits on the uploads made during it
+    std::vector<VkSemaphore> m_SubmitWaitSemaphores;
+    std::vector<VkPipelineStageFlags> m_SubmitWaitStages;
+    std::vector<VkCommandBuffer> m_SubmitCommandBuffers;
+    std::vector<VkSemaphore> m_SubmitSignalSemaphores;
+
+    Scope<VulkanComputeQueue> m_ComputeQueue;
+
+    // New pipelines are written to disk now and then, not only at shutdown, so a crash doesn't lose them
+    static constexpr float PIPELINE_CACHE_SAVE_INTERVAL = 60.0f;
+    Timer m_PipelineCacheSaveTimer;
+
+    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 4;
+    uint32_t m_FramesInFlight                      = 2;
+    uint32_t m_RequestedFramesInFlight             = 2;
+    uint32_t m_CurrentFrame                        = 0;
+    uint32_t m_CurrentImageIndex                   = 0;
+    // Between a successful BeginFrame and the frame's submission
+    bool m_FrameInProgress = false;
+
+    RenderGraph m_RenderGraph;
+    RenderGraphResource m_Backbuffer;
+    Scope<VulkanRenderGraphExecutor> m_RenderGraphExecutor;
+    uint64_t m_RenderPassGeneration = 0;
+
+    // Released after the fence of the frame slot they were queued in has been waited on, see SubmitResourceFree
+    std::vector<std::vector<std::function<void()>>> m_ResourceFreeQueues;
 
-    VkRenderPass m_RenderPass;
-    std::vector<VkFramebuffer> m_Framebuffers;
+    Scope<VulkanGPUProfiler> m_GPUProfiler;
 };
 
 } // namespace Noctis
\ No newline at end of file
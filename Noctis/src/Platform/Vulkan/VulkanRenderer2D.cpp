@@ -0,0 +1,479 @@
+#include "VulkanRenderer2D.h"
+#include "VulkanRenderer.h"
+#include "VulkanShaderReflection.h"
+#include "VulkanTexture.h"
+
+namespace Noctis
+{
+
+namespace
+{
+
+constexpr const char* VERTEX_SHADER_PATH   = "assets/shaders/Renderer2D.vert";
+constexpr const char* FRAGMENT_SHADER_PATH = "assets/shaders/Renderer2D.frag";
+
+VkShaderModule CreateShaderModule(VkDevice device, const std::vector<uint32_t>& spirv)
+{
+    VkShaderModuleCreateInfo moduleInfo{};
+    moduleInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    moduleInfo.codeSize = spirv.size() * sizeof(uint32_t);
+    moduleInfo.pCode    = spirv.data();
+
+    VkShaderModule module = VK_NULL_HANDLE;
+    VK_CHECK_RESULT(vkCreateShaderModule(device, &moduleInfo, nullptr, &module));
+    return module;
+}
+
+} // namespace
+
+void VulkanRenderer2D::Init()
+{
+    NOC_PROFILE_FUNCTION();
+
+    m_Context   = VulkanContext::Get();
+    m_FreeLists = CreateScope<FreeLists>();
+
+    m_VertexShader   = ShaderCompiler::Load(VERTEX_SHADER_PATH);
+    m_FragmentShader = ShaderCompiler::Load(FRAGMENT_SHADER_PATH);
+    m_VertexShader->Wait();
+    m_FragmentShader->Wait();
+    UpdatePipelineLayout();
+
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter    = VK_FILTER_LINEAR;
+    samplerInfo.minFilter    = VK_FILTER_LINEAR;
+    samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.maxLod       = VK_LOD_CLAMP_NONE;
+    VK_CHECK_RESULT(vkCreateSampler(m_Context->GetDevice()->GetVkDevice(), &samplerInfo, nullptr, &m_Sampler));
+
+    const uint32_t white = 0xffffffff;
+    m_WhiteTexture       = Texture2D::Create(1, 1, &white);
+}
+
+void VulkanRenderer2D::Shutdown()
+{
+    NOC_PROFILE_FUNCTION();
+
+    auto vkDevice = m_Context->GetDevice()->GetVkDevice();
+
+    // Chunks and pools are handed back by the renderer's free queue, which isn't flushed before the device is idle
+    vkDeviceWaitIdle(vkDevice);
+
+    for (auto& [renderPass, pipeline] : m_Pipelines)
+        vkDestroyPipeline(vkDevice, pipeline, nullptr);
+    m_Pipelines.clear();
+
+    for (Chunk& chunk : m_Chunks)
+    {
+        vkDestroyBuffer(vkDevice, chunk.Buffer, nullptr);
+        m_Context->GetAllocator()->Free(chunk.Allocation);
+    }
+    m_Chunks.clear();
+
+    for (VkDescriptorPool pool : m_DescriptorPools)
+        vkDestroyDescriptorPool(vkDevice, pool, nullptr);
+    m_DescriptorPools.clear();
+
+    vkDestroySampler(vkDevice, m_Sampler, nullptr);
+    m_WhiteTexture.reset();
+
+    if (m_FreeLists->InFlightCount > 0)
+        m_FreeLists.release()->Orphaned = true;
+    m_FreeLists.reset();
+    m_Context.reset();
+}
+
+void VulkanRenderer2D::UpdatePipelineLayout()
+{
+    m_VertexShaderVersion   = m_VertexShader->GetVersion();
+    m_FragmentShaderVersion = m_FragmentShader->GetVersion();
+
+    auto vertexSPIRV   = m_VertexShader->GetSPIRV();
+    auto fragmentSPIRV = m_FragmentShader->GetSPIRV();
+    NOC_CORE_ASSERT(vertexSPIRV && fragmentSPIRV, "Renderer2D shaders failed to compile");
+
+    const VulkanShaderReflection vertexReflection(*vertexSPIRV);
+    const VulkanShaderReflection fragmentReflection(*fragmentSPIRV);
+    const PipelineLayoutDesc desc =
+        VulkanShaderReflection::CreatePipelineLayoutDesc({&vertexReflection, &fragmentReflection});
+    NOC_CORE_ASSERT(desc.SetLayouts.size() == 1 && desc.PushConstantRanges.size() == 1,
+                    "Renderer2D shaders must use one descriptor set and push constants");
+
+    auto layoutCache      = m_Context->GetLayoutCache();
+    m_DescriptorSetLayout = layoutCache->GetDescriptorSetLayout(desc.SetLayouts[0]);
+    m_PipelineLayout      = layoutCache->GetPipelineLayout(desc);
+    m_PushConstantStages  = desc.PushConstantRanges[0].stageFlags;
+
+    // A pool's worth, vkAllocateDescriptorSets reads one per set
+    m_SetLayouts.assign(DESCRIPTOR_POOL_SETS, m_DescriptorSetLayout);
+}
+
+VkPipeline VulkanRenderer2D::GetPipeline(VkRenderPass renderPass)
+{
+    auto it = m_Pipelines.find(renderPass);
+    if (it != m_Pipelines.end())
+        return it->second;
+
+    NOC_PROFILE_FUNCTION();
+
+    auto vkDevice = m_Context->GetDevice()->GetVkDevice();
+
+    VkShaderModule vertexModule   = CreateShaderModule(vkDevice, *m_VertexShader->GetSPIRV());
+    VkShaderModule fragmentModule = CreateShaderModule(vkDevice, *m_FragmentShader->GetSPIRV());
+
+    VkPipelineShaderStageCreateInfo stages[2]{};
+    stages[0].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage  = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = vertexModule;
+    stages[0].pName  = "main";
+    stages[1].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = fragmentModule;
+    stages[1].pName  = "main";
+
+    // One instance per quad, the four corners come from gl_VertexIndex
+    VkVertexInputBindingDescription binding{};
+    binding.binding   = 0;
+    binding.stride    = sizeof(QuadInstance);
+    binding.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+    const VkVertexInputAttributeDescription attributes[] = {
+        {0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(QuadInstance, Position)},
+        {1, 0, VK_FORMAT_R32_SFLOAT, offsetof(QuadInstance, Rotation)},
+        {2, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(QuadInstance, Size)},
+        {3, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(QuadInstance, Color)},
+        {4, 0, VK_FORMAT_R32_UINT, offsetof(QuadInstance, TextureIndex)},
+        {5, 0, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(QuadInstance, UVRect)},
+    };
+
+    VkPipelineVertexInputStateCreateInfo vertexInput{};
+    vertexInput.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInput.vertexBindingDescriptionCount   = 1;
+    vertexInput.pVertexBindingDescriptions      = &binding;
+    vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(std::size(attributes));
+    vertexInput.pVertexAttributeDescriptions    = attributes;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+
+    VkPipelineViewportStateCreateInfo viewport{};
+    viewport.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewport.viewportCount = 1;
+    viewport.scissorCount  = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterization{};
+    rasterization.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterization.cullMode    = VK_CULL_MODE_NONE;
+    rasterization.frontFace   = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    rasterization.lineWidth   = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo multisample{};
+    multisample.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineColorBlendAttachmentState blendAttachment{};
+    blendAttachment.blendEnable         = VK_TRUE;
+    blendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    blendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    blendAttachment.colorBlendOp        = VK_BLEND_OP_ADD;
+    blendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    blendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    blendAttachment.alphaBlendOp        = VK_BLEND_OP_ADD;
+    blendAttachment.colorWriteMask =
+        VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+    VkPipelineColorBlendStateCreateInfo colorBlend{};
+    colorBlend.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlend.attachmentCount = 1;
+    colorBlend.pAttachments    = &blendAttachment;
+
+    const VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = static_cast<uint32_t>(std::size(dynamicStates));
+    dynamicState.pDynamicStates    = dynamicStates;
+
+    VkGraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount          = 2;
+    pipelineInfo.pStages             = stages;
+    pipelineInfo.pVertexInputState   = &vertexInput;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState      = &viewport;
+    pipelineInfo.pRasterizationState = &rasterization;
+    pipelineInfo.pMultisampleState   = &multisample;
+    pipelineInfo.pColorBlendState    = &colorBlend;
+    pipelineInfo.pDynamicState       = &dynamicState;
+    pipelineInfo.layout              = m_PipelineLayout;
+    pipelineInfo.renderPass          = renderPass;
+    pipelineInfo.subpass             = 0;
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VK_CHECK_RESULT(vkCreateGraphicsPipelines(vkDevice, m_Context->GetDevice()->GetVkPipelineCache(), 1, &pipelineInfo,
+                                              nullptr, &pipeline));
+
+    vkDestroyShaderModule(vkDevice, vertexModule, nullptr);
+    vkDestroyShaderModule(vkDevice, fragmentModule, nullptr);
+
+    m_Pipelines.emplace(renderPass, pipeline);
+    return pipeline;
+}
+
+void VulkanRenderer2D::DestroyPipelines()
+{
+    // Frames in flight may still be drawing with them
+    auto vkDevice = m_Context->GetDevice()->GetVkDevice();
+    Renderer::SubmitResourceFree([vkDevice, pipelines = std::move(m_Pipelines)]() {
+        for (auto& [renderPass, pipeline] : pipelines)
+            vkDestroyPipeline(vkDevice, pipeline, nullptr);
+    });
+    m_Pipelines.clear();
+}
+
+uint32_t VulkanRenderer2D::AcquireChunk(QuadInstance*& instances)
+{
+    uint32_t index;
+    if (!m_FreeLists->Chunks.empty())
+    {
+        index = m_FreeLists->Chunks.back();
+        m_FreeLists->Chunks.pop_back();
+    }
+    else
+    {
+        NOC_PROFILE_FUNCTION();
+
+        Chunk& chunk = m_Chunks.emplace_back();
+        index        = static_cast<uint32_t>(m_Chunks.size() - 1);
+
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size        = sizeof(QuadInstance) * Renderer2D::QUADS_PER_CHUNK;
+        bufferInfo.usage       = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        VK_CHECK_RESULT(vkCreateBuffer(m_Context->GetDevice()->GetVkDevice(), &bufferInfo, nullptr, &chunk.Buffer));
+
+        chunk.Allocation = m_Context->GetAllocator()->AllocateBuffer(chunk.Buffer, MemoryUsage::CPUToGPU);
+        NOC_CORE_ASSERT(chunk.Allocation.IsValid() && chunk.Allocation.MappedData,
+                        "Out of host visible memory for Renderer2D instances");
+    }
+
+    instances = static_cast<QuadInstance*>(m_Chunks[index].Allocation.MappedData);
+    return index;
+}
+
+void VulkanRenderer2D::ReleaseChunks(const std::vector<uint32_t>& chunks)
+{
+    m_FreeLists->Chunks.insert(m_FreeLists->Chunks.end(), chunks.begin(), chunks.end());
+}
+
+VulkanRenderer2D::RetiredFrame& VulkanRenderer2D::FreeLists::PushFrame()
+{
+    if (InFlightCount == InFlight.size())
+    {
+        // Unrolled so the new record goes after the newest one
+        std::rotate(InFlight.begin(), InFlight.begin() + InFlightFirst, InFlight.end());
+        InFlight.emplace_back();
+        InFlightFirst = 0;
+    }
+
+    RetiredFrame& frame = InFlight[(InFlightFirst + InFlightCount) % InFlight.size()];
+    InFlightCount++;
+    return frame;
+}
+
+void VulkanRenderer2D::FreeLists::ReleaseOldest(FreeLists* freeLists)
+{
+    NOC_CORE_ASSERT(freeLists->InFlightCount > 0, "Renderer2D: no frame in flight to release!");
+
+    RetiredFrame& frame = freeLists->InFlight[freeLists->InFlightFirst];
+    freeLists->Chunks.insert(freeLists->Chunks.end(), frame.Chunks.begin(), frame.Chunks.end());
+    freeLists->DescriptorPools.insert(freeLists->DescriptorPools.end(), frame.DescriptorPools.begin(),
+                                      frame.DescriptorPools.end());
+    frame.Chunks.clear();
+    frame.DescriptorPools.clear();
+
+    freeLists->InFlightFirst = (freeLists->InFlightFirst + 1) % static_cast<uint32_t>(freeLists->InFlight.size());
+    freeLists->InFlightCount--;
+
+    if (freeLists->Orphaned && freeLists->InFlightCount == 0)
+        delete freeLists;
+}
+
+uint32_t VulkanRenderer2D::AcquireDescriptorPool()
+{
+    auto vkDevice = m_Context->GetDevice()->GetVkDevice();
+
+    if (!m_FreeLists->DescriptorPools.empty())
+    {
+        const uint32_t index = m_FreeLists->DescriptorPools.back();
+        m_FreeLists->DescriptorPools.pop_back();
+        VK_CHECK_RESULT(vkResetDescriptorPool(vkDevice, m_DescriptorPools[index], 0));
+        return index;
+    }
+
+    NOC_PROFILE_FUNCTION();
+
+    VkDescriptorPoolSize poolSize{};
+    poolSize.type            = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    poolSize.descriptorCount = DESCRIPTOR_POOL_SETS * Renderer2D::MAX_TEXTURE_SLOTS;
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets       = DESCRIPTOR_POOL_SETS;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes    = &poolSize;
+
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    VK_CHECK_RESULT(vkCreateDescriptorPool(vkDevice, &poolInfo, nullptr, &pool));
+
+    m_DescriptorPools.push_back(pool);
+    return static_cast<uint32_t>(m_DescriptorPools.size() - 1);
+}
+
+void VulkanRenderer2D::AllocateDescriptorSets(std::vector<uint32_t>& usedPools)
+{
+    NOC_PROFILE_FUNCTION();
+
+    auto vkDevice = m_Context->GetDevice()->GetVkDevice();
+
+    const std::vector<Renderer2DBatch>& batches = m_Frame.Batches;
+    m_DescriptorSets.resize(batches.size());
+
+    for (uint32_t first = 0; first < batches.size(); first += DESCRIPTOR_POOL_SETS)
+    {
+        usedPools.push_back(AcquireDescriptorPool());
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool     = m_DescriptorPools[usedPools.back()];
+        allocInfo.descriptorSetCount = std::min(DESCRIPTOR_POOL_SETS, static_cast<uint32_t>(batches.size()) - first);
+        allocInfo.pSetLayouts        = m_SetLayouts.data();
+        VK_CHECK_RESULT(vkAllocateDescriptorSets(vkDevice, &allocInfo, &m_DescriptorSets[first]));
+    }
+
+    const auto* whiteTexture = static_cast<const VulkanTexture2D*>(m_WhiteTexture.get());
+
+    m_ImageInfos.resize(batches.size() * Renderer2D::MAX_TEXTURE_SLOTS);
+    m_DescriptorWrites.resize(batches.size());
+    for (uint32_t i = 0; i < batches.size(); i++)
+    {
+        // Unused slots still need a valid descriptor
+        VkDescriptorImageInfo* slots = &m_ImageInfos[i * Renderer2D::MAX_TEXTURE_SLOTS];
+        for (uint32_t slot = 0; slot < Renderer2D::MAX_TEXTURE_SLOTS; slot++)
+        {
+            const Texture2D* texture = slot < batches[i].TextureCount ? batches[i].Textures[slot] : nullptr;
+            const auto* vulkanTexture =
+                texture ? static_cast<const VulkanTexture2D*>(texture) : whiteTexture;
+
+            slots[slot].sampler     = m_Sampler;
+            slots[slot].imageView   = vulkanTexture->GetVkImageView();
+            slots[slot].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        }
+
+        VkWriteDescriptorSet& write = m_DescriptorWrites[i];
+        write.sType                 = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet                = m_DescriptorSets[i];
+        write.dstBinding            = 0;
+        write.descriptorCount       = Renderer2D::MAX_TEXTURE_SLOTS;
+        write.descriptorType        = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo            = slots;
+    }
+    vkUpdateDescriptorSets(vkDevice, static_cast<uint32_t>(m_DescriptorWrites.size()), m_DescriptorWrites.data(), 0,
+                           nullptr);
+}
+
+void VulkanRenderer2D::Render(Renderer2DFrame& frame)
+{
+    NOC_PROFILE_FUNCTION();
+
+    if (frame.Batches.empty())
+    {
+        ReleaseChunks(frame.Chunks);
+        return;
+    }
+
+    // Picked up at the start of a frame, so the pipelines of the frame's render pass are all built from one version
+    if (m_VertexShader->GetVersion() != m_VertexShaderVersion ||
+        m_FragmentShader->GetVersion() != m_FragmentShaderVersion)
+    {
+        DestroyPipelines();
+        UpdatePipelineLayout();
+    }
+
+    // The executor was recreated, the cached render pass handles may have been reused by different render passes
+    VulkanRenderer& renderer = VulkanRenderer::Get();
+    if (renderer.GetRenderPassGeneration() != m_RenderPassGeneration)
+    {
+        DestroyPipelines();
+        m_RenderPassGeneration = renderer.GetRenderPassGeneration();
+    }
+
+    // The frontend gets the previous frame's vectors back, both keep their capacity
+    std::swap(m_Frame, frame);
+
+    RetiredFrame& retired = m_FreeLists->PushFrame();
+    retired.Chunks.assign(m_Frame.Chunks.begin(), m_Frame.Chunks.end());
+    AllocateDescriptorSets(retired.DescriptorPools);
+
+    renderer.GetRenderGraph()
+        .AddPass("Renderer2D", RenderGraphPassType::Graphics,
+                 [this](RenderGraphPassContext& context) {
+                     Draw(static_cast<VulkanRenderGraphPassContext&>(context));
+                 })
+        .Write(renderer.GetBackbuffer(), RenderGraphUsage::ColorAttachment);
+
+    Renderer::SubmitResourceFree([freeLists = m_FreeLists.get()]() { FreeLists::ReleaseOldest(freeLists); });
+}
+
+void VulkanRenderer2D::Draw(VulkanRenderGraphPassContext& context)
+{
+    NOC_PROFILE_FUNCTION();
+
+    VkCommandBuffer commandBuffer = context.GetCommandBuffer();
+    const VkExtent2D extent       = context.GetExtent();
+
+    VkViewport viewport{};
+    viewport.width    = static_cast<float>(extent.width);
+    viewport.height   = static_cast<float>(extent.height);
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+    VkRect2D scissor{};
+    scissor.extent = extent;
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, GetPipeline(context.GetRenderPass()));
+
+    uint32_t boundScene = UINT32_MAX;
+    uint32_t boundChunk = UINT32_MAX;
+    for (uint32_t i = 0; i < m_Frame.Batches.size(); i++)
+    {
+        const Renderer2DBatch& batch = m_Frame.Batches[i];
+
+        if (batch.Scene != boundScene)
+        {
+            vkCmdPushConstants(commandBuffer, m_PipelineLayout, m_PushConstantStages, 0,
+                               sizeof(Renderer2DScene::ViewProjection), m_Frame.Scenes[batch.Scene].ViewProjection);
+            boundScene = batch.Scene;
+        }
+        if (batch.Chunk != boundChunk)
+        {
+            const VkDeviceSize offset = 0;
+            vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_Chunks[batch.Chunk].Buffer, &offset);
+            boundChunk = batch.Chunk;
+        }
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_PipelineLayout, 0, 1,
+                                &m_DescriptorSets[i], 0, nullptr);
+        vkCmdDraw(commandBuffer, 4, batch.InstanceCount, 0, batch.FirstInstance);
+    }
+}
+
+} // namespace Noctis
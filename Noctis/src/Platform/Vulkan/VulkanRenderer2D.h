@@ -0,0 +1,99 @@
+#pragma once
+
+#include "VulkanContext.h"
+#include "VulkanRenderGraph.h"
+
+#include "Engine/Renderer/Renderer2D.h"
+#include "Engine/Renderer/ShaderCompiler.h"
+
+namespace Noctis
+{
+
+class VulkanRenderer2D : public Renderer2DAPI
+{
+  public:
+    void Init() override;
+    void Shutdown() override;
+
+    uint32_t AcquireChunk(QuadInstance*& instances) override;
+    void Render(Renderer2DFrame& frame) override;
+    void ReleaseChunks(const std::vector<uint32_t>& chunks) override;
+
+  private:
+    struct Chunk
+    {
+        VkBuffer Buffer = VK_NULL_HANDLE;
+        VulkanAllocation Allocation;
+    };
+
+    // The chunks and descriptor pools of a rendered frame, handed back once the GPU is done with it
+    struct RetiredFrame
+    {
+        std::vector<uint32_t> Chunks;
+        std::vector<uint32_t> DescriptorPools;
+    };
+
+    // Reached by the resource free callbacks, which may run after Shutdown: it is then orphaned and the last callback
+    // deletes it. The callbacks only capture a pointer, so queueing them doesn't allocate.
+    struct FreeLists
+    {
+        std::vector<uint32_t> Chunks;
+        std::vector<uint32_t> DescriptorPools;
+
+        // Rendered frames, oldest first, in a ring whose records keep their capacity
+        std::vector<RetiredFrame> InFlight;
+        uint32_t InFlightFirst = 0;
+        uint32_t InFlightCount = 0;
+        bool Orphaned          = false;
+
+        RetiredFrame& PushFrame();
+        // Frames finish in submission order, so whichever frame's callback runs, the oldest frame is done
+        static void ReleaseOldest(FreeLists* freeLists);
+    };
+
+    void UpdatePipelineLayout();
+    VkPipeline GetPipeline(VkRenderPass renderPass);
+    void DestroyPipelines();
+
+    uint32_t AcquireDescriptorPool();
+    void AllocateDescriptorSets(std::vector<uint32_t>& usedPools);
+
+    void Draw(VulkanRenderGraphPassContext& context);
+
+    // Descriptor sets per pool, each pool covers that many batches
+    static constexpr uint32_t DESCRIPTOR_POOL_SETS = 64;
+
+  private:
+    Ref<VulkanContext> m_Context;
+
+    Ref<CompiledShader> m_VertexShader;
+    Ref<CompiledShader> m_FragmentShader;
+    uint64_t m_VertexShaderVersion   = 0;
+    uint64_t m_FragmentShaderVersion = 0;
+
+    VkDescriptorSetLayout m_DescriptorSetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout m_PipelineLayout           = VK_NULL_HANDLE;
+    VkShaderStageFlags m_PushConstantStages     = 0;
+    // One per render pass the batches were drawn in
+    std::unordered_map<VkRenderPass, VkPipeline> m_Pipelines;
+    // The executor's render pass generation the pipelines were built for
+    uint64_t m_RenderPassGeneration = 0;
+
+    VkSampler m_Sampler = VK_NULL_HANDLE;
+    Ref<Texture2D> m_WhiteTexture;
+
+    std::vector<Chunk> m_Chunks;
+    std::vector<VkDescriptorPool> m_DescriptorPools;
+    Scope<FreeLists> m_FreeLists;
+
+    // The frame being rendered, and a descriptor set per batch
+    Renderer2DFrame m_Frame;
+    std::vector<VkDescriptorSet> m_DescriptorSets;
+
+    // Reused every frame
+    std::vector<VkDescriptorSetLayout> m_SetLayouts;
+    std::vector<VkDescriptorImageInfo> m_ImageInfos;
+    std::vector<VkWriteDescriptorSet> m_DescriptorWrites;
+};
+
+} // namespace Noctis
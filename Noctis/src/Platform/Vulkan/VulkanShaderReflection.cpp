@@ -0,0 +1,658 @@
+#include "VulkanShaderReflection.h"
+
+#include "Engine/Core/Hash.h"
+
+#include <cstring>
+
+namespace Noctis
+{
+
+namespace
+{
+
+// The subset of the SPIR-V spec the reflection needs, values from the unified1 grammar
+constexpr uint32_t SPIRV_MAGIC       = 0x07230203;
+constexpr uint32_t SPIRV_HEADER_SIZE = 5;
+
+enum SpvOp : uint32_t
+{
+    OpName                         = 5,
+    OpEntryPoint                   = 15,
+    OpExecutionMode                = 16,
+    OpTypeBool                     = 20,
+    OpTypeInt                      = 21,
+    OpTypeFloat                    = 22,
+    OpTypeVector                   = 23,
+    OpTypeMatrix                   = 24,
+    OpTypeImage                    = 25,
+    OpTypeSampler                  = 26,
+    OpTypeSampledImage             = 27,
+    OpTypeArray                    = 28,
+    OpTypeRuntimeArray             = 29,
+    OpTypeStruct                   = 30,
+    OpTypePointer                  = 32,
+    OpConstant                     = 43,
+    OpSpecConstant                 = 50,
+    OpVariable                     = 59,
+    OpDecorate                     = 71,
+    OpMemberDecorate               = 72,
+    OpTypeAccelerationStructureKHR = 5341
+};
+
+enum SpvDecoration : uint32_t
+{
+    DecorationBufferBlock   = 3,
+    DecorationArrayStride   = 6,
+    DecorationMatrixStride  = 7,
+    DecorationBuiltIn       = 11,
+    DecorationLocation      = 30,
+    DecorationBinding       = 33,
+    DecorationDescriptorSet = 34,
+    DecorationOffset        = 35
+};
+
+enum SpvStorageClass : uint32_t
+{
+    StorageClassUniformConstant = 0,
+    StorageClassInput           = 1,
+    StorageClassUniform         = 2,
+    StorageClassPushConstant    = 9,
+    StorageClassStorageBuffer   = 12
+};
+
+enum SpvDim : uint32_t
+{
+    DimBuffer      = 5,
+    DimSubpassData = 6
+};
+
+constexpr uint32_t EXECUTION_MODE_LOCAL_SIZE = 17;
+
+struct SpvId
+{
+    uint32_t Opcode = 0;
+    // Word offset of the defining instruction
+    uint32_t Instruction = 0;
+    std::string Name;
+
+    uint32_t Set         = UINT32_MAX;
+    uint32_t Binding     = UINT32_MAX;
+    uint32_t Location    = UINT32_MAX;
+    uint32_t ArrayStride = 0;
+    bool BuiltIn         = false;
+    bool BufferBlock     = false;
+
+    // Struct types only
+    std::vector<uint32_t> MemberOffsets;
+    std::vector<uint32_t> MemberMatrixStrides;
+};
+
+class SpvModule
+{
+  public:
+    SpvModule(const uint32_t* code, size_t wordCount) : m_Code(code), m_WordCount(wordCount) {}
+
+    bool Parse()
+    {
+        if (m_WordCount < SPIRV_HEADER_SIZE || m_Code[0] != SPIRV_MAGIC)
+            return false;
+
+        m_Ids.resize(m_Code[3]);
+
+        for (size_t offset = SPIRV_HEADER_SIZE; offset < m_WordCount;)
+        {
+            const uint32_t opcode    = m_Code[offset] & 0xffff;
+            const uint32_t wordCount = m_Code[offset] >> 16;
+            if (wordCount == 0 || offset + wordCount > m_WordCount)
+                return false;
+
+            if (!ParseInstruction(opcode, &m_Code[offset], wordCount, static_cast<uint32_t>(offset)))
+                return false;
+
+            offset += wordCount;
+        }
+        return true;
+    }
+
+    const SpvId& Get(uint32_t id) const { return m_Ids[id]; }
+    const uint32_t* Words(uint32_t id) const { return &m_Code[m_Ids[id].Instruction]; }
+
+    // Type id behind pointers and arrays, multiplying count by the array lengths. count ends up 0 for runtime arrays.
+    uint32_t ResolveArrays(uint32_t typeId, uint32_t& count) const
+    {
+        while (true)
+        {
+            const SpvId& type = m_Ids[typeId];
+            if (type.Opcode == OpTypeArray)
+            {
+                count *= GetConstant(Words(typeId)[3]);
+                typeId = Words(typeId)[2];
+            }
+            else if (type.Opcode == OpTypeRuntimeArray)
+            {
+                count  = 0;
+                typeId = Words(typeId)[2];
+            }
+            else
+            {
+                return typeId;
+            }
+        }
+    }
+
+    uint32_t GetConstant(uint32_t id) const
+    {
+        const SpvId& constant = m_Ids[id];
+        if (constant.Opcode != OpConstant && constant.Opcode != OpSpecConstant)
+            return 1;
+        return Words(id)[3];
+    }
+
+    // Size in bytes of a type in an explicitly laid out block
+    uint32_t GetTypeSize(uint32_t typeId, uint32_t matrixStride = 0) const
+    {
+        const SpvId& type    = m_Ids[typeId];
+        const uint32_t* word = Words(typeId);
+
+        switch (type.Opcode)
+        {
+            case OpTypeBool:
+                return 4;
+            case OpTypeInt:
+            case OpTypeFloat:
+                return word[2] / 8;
+            case OpTypeVector:
+                return word[3] * GetTypeSize(word[2]);
+            case OpTypeMatrix:
+                return word[3] * (matrixStride != 0 ? matrixStride : GetTypeSize(word[2]));
+            case OpTypeArray:
+            {
+                const uint32_t length = GetConstant(word[3]);
+                const uint32_t stride = type.ArrayStride != 0 ? type.ArrayStride : GetTypeSize(word[2], matrixStride);
+                return length * stride;
+            }
+            case OpTypeRuntimeArray:
+                return 0;
+            case OpTypeStruct:
+            {
+                uint32_t size = 0;
+                for (uint32_t i = 0; i < type.MemberOffsets.size(); i++)
+                {
+                    const uint32_t memberSize = GetTypeSize(word[2 + i], type.MemberMatrixStrides[i]);
+                    size                      = std::max(size, type.MemberOffsets[i] + memberSize);
+                }
+                return size;
+            }
+            default:
+                return 0;
+        }
+    }
+
+    // Lowest member offset of a push constant block, ranges start there instead of at 0
+    uint32_t GetFirstMemberOffset(uint32_t structId) const
+    {
+        const SpvId& type = m_Ids[structId];
+        if (type.MemberOffsets.empty())
+            return 0;
+        return *std::min_element(type.MemberOffsets.begin(), type.MemberOffsets.end());
+    }
+
+    uint32_t EntryPointModel = UINT32_MAX;
+    std::string EntryPoint;
+    std::array<uint32_t, 3> LocalSize = {1, 1, 1};
+    std::vector<uint32_t> Variables;
+
+  private:
+    bool ParseInstruction(uint32_t opcode, const uint32_t* word, uint32_t wordCount, uint32_t offset)
+    {
+        auto isValidId = [&](uint32_t id) { return id < m_Ids.size(); };
+
+        switch (opcode)
+        {
+            case OpName:
+                if (wordCount < 3 || !isValidId(word[1]))
+                    return false;
+                m_Ids[word[1]].Name = ReadString(&word[2], wordCount - 2);
+                break;
+            case OpEntryPoint:
+                // Only the first entry point is reflected, shaderc emits one per module
+                if (wordCount < 4 || EntryPointModel != UINT32_MAX)
+                    break;
+                EntryPointModel = word[1];
+                EntryPoint      = ReadString(&word[3], wordCount - 3);
+                break;
+            case OpExecutionMode:
+                if (wordCount >= 6 && word[2] == EXECUTION_MODE_LOCAL_SIZE)
+                    LocalSize = {word[3], word[4], word[5]};
+                break;
+            case OpDecorate:
+            {
+                if (wordCount < 3 || !isValidId(word[1]))
+                    return false;
+                SpvId& target          = m_Ids[word[1]];
+                const uint32_t literal = wordCount > 3 ? word[3] : 0;
+                switch (word[2])
+                {
+                    case DecorationBufferBlock:
+                        target.BufferBlock = true;
+                        break;
+                    case DecorationArrayStride:
+                        target.ArrayStride = literal;
+                        break;
+                    case DecorationBuiltIn:
+                        target.BuiltIn = true;
+                        break;
+                    case DecorationLocation:
+                        target.Location = literal;
+                        break;
+                    case DecorationBinding:
+                        target.Binding = literal;
+                        break;
+                    case DecorationDescriptorSet:
+                        target.Set = literal;
+                        break;
+                }
+                break;
+            }
+            case OpMemberDecorate:
+            {
+                if (wordCount < 4 || !isValidId(word[1]))
+                    return false;
+                SpvId& target         = m_Ids[word[1]];
+                const uint32_t member = word[2];
+                if (target.MemberOffsets.size() <= member)
+                {
+                    target.MemberOffsets.resize(member + 1, 0);
+                    target.MemberMatrixStrides.resize(member + 1, 0);
+                }
+                if (word[3] == DecorationOffset && wordCount > 4)
+                    target.MemberOffsets[member] = word[4];
+                else if (word[3] == DecorationMatrixStride && wordCount > 4)
+                    target.MemberMatrixStrides[member] = word[4];
+                break;
+            }
+            case OpTypeBool:
+            case OpTypeInt:
+            case OpTypeFloat:
+            case OpTypeVector:
+            case OpTypeMatrix:
+            case OpTypeImage:
+            case OpTypeSampler:
+            case OpTypeSampledImage:
+            case OpTypeArray:
+            case OpTypeRuntimeArray:
+            case OpTypePointer:
+            case OpTypeAccelerationStructureKHR:
+                if (wordCount < 2 || !isValidId(word[1]))
+                    return false;
+                m_Ids[word[1]].Opcode      = opcode;
+                m_Ids[word[1]].Instruction = offset;
+                break;
+            case OpTypeStruct:
+            {
+                if (wordCount < 2 || !isValidId(word[1]))
+                    return false;
+                SpvId& type      = m_Ids[word[1]];
+                type.Opcode      = opcode;
+                type.Instruction = offset;
+                // Member decorations usually come first, but make sure every member has an entry
+                type.MemberOffsets.resize(std::max<size_t>(type.MemberOffsets.size(), wordCount - 2), 0);
+                type.MemberMatrixStrides.resize(type.MemberOffsets.size(), 0);
+                break;
+            }
+            case OpConstant:
+            case OpSpecConstant:
+            case OpVariable:
+                if (wordCount < 3 || !isValidId(word[2]))
+                    return false;
+                m_Ids[word[2]].Opcode      = opcode;
+                m_Ids[word[2]].Instruction = offset;
+                if (opcode == OpVariable)
+                    Variables.push_back(word[2]);
+                break;
+        }
+        return true;
+    }
+
+    static std::string ReadString(const uint32_t* words, uint32_t wordCount)
+    {
+        const char* chars = reinterpret_cast<const char*>(words);
+        return std::string(chars, ::strnlen(chars, wordCount * sizeof(uint32_t)));
+    }
+
+  private:
+    const uint32_t* m_Code;
+    size_t m_WordCount;
+    std::vector<SpvId> m_Ids;
+};
+
+VkShaderStageFlagBits GetShaderStage(uint32_t executionModel)
+{
+    switch (executionModel)
+    {
+        case 0:
+            return VK_SHADER_STAGE_VERTEX_BIT;
+        case 1:
+            return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+        case 2:
+            return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+        case 3:
+            return VK_SHADER_STAGE_GEOMETRY_BIT;
+        case 4:
+            return VK_SHADER_STAGE_FRAGMENT_BIT;
+        case 5:
+            return VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+    return VK_SHADER_STAGE_ALL;
+}
+
+VkDescriptorType GetDescriptorType(const SpvModule& module, uint32_t typeId, uint32_t storageClass)
+{
+    const SpvId& type    = module.Get(typeId);
+    const uint32_t* word = module.Words(typeId);
+
+    switch (storageClass)
+    {
+        case StorageClassStorageBuffer:
+            return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        case StorageClassUniform:
+            return type.BufferBlock ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        case StorageClassUniformConstant:
+            break;
+        default:
+            return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+    }
+
+    switch (type.Opcode)
+    {
+        case OpTypeSampler:
+            return VK_DESCRIPTOR_TYPE_SAMPLER;
+        case OpTypeSampledImage:
+            return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        case OpTypeAccelerationStructureKHR:
+            return VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+        case OpTypeImage:
+        {
+            const uint32_t dim     = word[3];
+            const uint32_t sampled = word[7];
+            if (dim == DimSubpassData)
+                return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+            if (dim == DimBuffer)
+                return sampled == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+            return sampled == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        }
+    }
+    return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+}
+
+// Format of one location's worth of a vertex input (a scalar or vector)
+VkFormat GetVertexFormat(const SpvModule& module, uint32_t typeId, uint32_t& size)
+{
+    uint32_t components = 1;
+    if (module.Get(typeId).Opcode == OpTypeVector)
+    {
+        components = module.Words(typeId)[3];
+        typeId     = module.Words(typeId)[2];
+    }
+
+    const SpvId& scalar  = module.Get(typeId);
+    const uint32_t* word = module.Words(typeId);
+    const uint32_t width = word[2];
+    size                 = components * width / 8;
+
+    static constexpr VkFormat FLOAT_FORMATS[]  = {VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT,
+                                                  VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT};
+    static constexpr VkFormat DOUBLE_FORMATS[] = {VK_FORMAT_R64_SFLOAT, VK_FORMAT_R64G64_SFLOAT,
+                                                  VK_FORMAT_R64G64B64_SFLOAT, VK_FORMAT_R64G64B64A64_SFLOAT};
+    static constexpr VkFormat SINT_FORMATS[]   = {VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT,
+                                                  VK_FORMAT_R32G32B32A32_SINT};
+    static constexpr VkFormat UINT_FORMATS[]   = {VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT,
+                                                  VK_FORMAT_R32G32B32A32_UINT};
+
+    if (components < 1 || components > 4)
+        return VK_FORMAT_UNDEFINED;
+
+    if (scalar.Opcode == OpTypeFloat && width == 32)
+        return FLOAT_FORMATS[components - 1];
+    if (scalar.Opcode == OpTypeFloat && width == 64)
+        return DOUBLE_FORMATS[components - 1];
+    if (scalar.Opcode == OpTypeInt && width == 32)
+        return word[3] ? SINT_FORMATS[components - 1] : UINT_FORMATS[components - 1];
+    return VK_FORMAT_UNDEFINED;
+}
+
+} // namespace
+
+bool DescriptorSetLayoutDesc::operator==(const DescriptorSetLayoutDesc& other) const
+{
+    if (Flags != other.Flags || BindingFlags != other.BindingFlags || Bindings.size() != other.Bindings.size())
+        return false;
+
+    for (size_t i = 0; i < Bindings.size(); i++)
+    {
+        const VkDescriptorSetLayoutBinding& a = Bindings[i];
+        const VkDescriptorSetLayoutBinding& b = other.Bindings[i];
+        if (a.binding != b.binding || a.descriptorType != b.descriptorType ||
+            a.descriptorCount != b.descriptorCount || a.stageFlags != b.stageFlags)
+            return false;
+    }
+    return true;
+}
+
+uint64_t DescriptorSetLayoutDesc::GetHash() const
+{
+    uint64_t hash = Hash::Combine(Hash::OFFSET_BASIS, Flags);
+    for (const VkDescriptorSetLayoutBinding& binding : Bindings)
+    {
+        hash = Hash::Combine(hash, binding.binding);
+        hash = Hash::Combine(hash, binding.descriptorType);
+        hash = Hash::Combine(hash, binding.descriptorCount);
+        hash = Hash::Combine(hash, binding.stageFlags);
+    }
+    for (VkDescriptorBindingFlags flags : BindingFlags)
+        hash = Hash::Combine(hash, flags);
+    return hash;
+}
+
+VulkanShaderReflection::VulkanShaderReflection(const std::vector<uint32_t>& spirv)
+{
+    Reflect(spirv.data(), spirv.size());
+}
+
+VulkanShaderReflection::VulkanShaderReflection(const uint32_t* code, size_t wordCount)
+{
+    Reflect(code, wordCount);
+}
+
+void VulkanShaderReflection::Reflect(const uint32_t* code, size_t wordCount)
+{
+    NOC_PROFILE_FUNCTION();
+
+    SpvModule module(code, wordCount);
+    if (!module.Parse() || module.EntryPointModel == UINT32_MAX)
+    {
+        NOC_CORE_ERROR("Shader reflection: invalid SPIR-V module");
+        return;
+    }
+
+    m_Stage      = GetShaderStage(module.EntryPointModel);
+    m_EntryPoint = module.EntryPoint;
+    m_LocalSize  = module.LocalSize;
+
+    for (uint32_t variableId : module.Variables)
+    {
+        const SpvId& variable        = module.Get(variableId);
+        const uint32_t* variableWord = module.Words(variableId);
+        const uint32_t storageClass  = variableWord[3];
+
+        const uint32_t pointerId = variableWord[1];
+        if (module.Get(pointerId).Opcode != OpTypePointer)
+            continue;
+        const uint32_t pointeeId = module.Words(pointerId)[3];
+
+        if (storageClass == StorageClassPushConstant)
+        {
+            const uint32_t offset = module.GetFirstMemberOffset(pointeeId);
+            const uint32_t size   = module.GetTypeSize(pointeeId);
+
+            m_PushConstantRange.stageFlags = m_Stage;
+            m_PushConstantRange.offset     = offset;
+            m_PushConstantRange.size       = size - offset;
+            continue;
+        }
+
+        if (storageClass == StorageClassInput)
+        {
+            if (m_Stage != VK_SHADER_STAGE_VERTEX_BIT || variable.BuiltIn || variable.Location == UINT32_MAX)
+                continue;
+
+            // Matrices and arrays take one location per column or element
+            uint32_t count  = 1;
+            uint32_t typeId = module.ResolveArrays(pointeeId, count);
+            if (module.Get(typeId).Opcode == OpTypeMatrix)
+            {
+                count *= module.Words(typeId)[3];
+                typeId = module.Words(typeId)[2];
+            }
+
+            for (uint32_t i = 0; i < count; i++)
+            {
+                ShaderVertexInput& input = m_VertexInputs.emplace_back();
+                input.Location           = variable.Location + i;
+                input.Format             = GetVertexFormat(module, typeId, input.Size);
+                input.Name               = variable.Name;
+            }
+            continue;
+        }
+
+        if (variable.Binding == UINT32_MAX)
+            continue;
+
+        uint32_t count              = 1;
+        const uint32_t typeId       = module.ResolveArrays(pointeeId, count);
+        const VkDescriptorType type = GetDescriptorType(module, typeId, storageClass);
+        if (type == VK_DESCRIPTOR_TYPE_MAX_ENUM)
+            continue;
+
+        ShaderResourceBinding& binding = m_Bindings.emplace_back();
+        binding.Set                    = variable.Set != UINT32_MAX ? variable.Set : 0;
+        binding.Binding                = variable.Binding;
+        binding.Type                   = type;
+        binding.Count                  = count;
+        binding.StageFlags             = m_Stage;
+        // Uniform blocks are usually declared without an instance name
+        binding.Name = !variable.Name.empty() ? variable.Name : module.Get(typeId).Name;
+    }
+
+    std::sort(m_Bindings.begin(), m_Bindings.end(), [](const ShaderResourceBinding& a, const ShaderResourceBinding& b) {
+        return a.Set != b.Set ? a.Set < b.Set : a.Binding < b.Binding;
+    });
+    std::sort(m_VertexInputs.begin(), m_VertexInputs.end(),
+              [](const ShaderVertexInput& a, const ShaderVertexInput& b) { return a.Location < b.Location; });
+
+    m_Valid = true;
+}
+
+VertexInputLayout VulkanShaderReflection::GetVertexInputLayout(uint32_t binding) const
+{
+    VertexInputLayout layout;
+    layout.Binding.binding   = binding;
+    layout.Binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    uint32_t offset = 0;
+    for (const ShaderVertexInput& input : m_VertexInputs)
+    {
+        VkVertexInputAttributeDescription& attribute = layout.Attributes.emplace_back();
+        attribute.location                           = input.Location;
+        attribute.binding                            = binding;
+        attribute.format                             = input.Format;
+        attribute.offset                             = offset;
+        offset += input.Size;
+    }
+    layout.Binding.stride = offset;
+
+    return layout;
+}
+
+PipelineLayoutDesc VulkanShaderReflection::CreatePipelineLayoutDesc(
+    const std::vector<const VulkanShaderReflection*>& stages)
+{
+    NOC_PROFILE_FUNCTION();
+
+    PipelineLayoutDesc desc;
+
+    // Runtime sized arrays per set, by binding
+    std::vector<std::set<uint32_t>> runtimeArrays;
+    uint32_t pushConstantBegin            = UINT32_MAX;
+    uint32_t pushConstantEnd              = 0;
+    VkShaderStageFlags pushConstantStages = 0;
+
+    for (const VulkanShaderReflection* stage : stages)
+    {
+        for (const ShaderResourceBinding& resource : stage->GetBindings())
+        {
+            if (desc.SetLayouts.size() <= resource.Set)
+            {
+                desc.SetLayouts.resize(resource.Set + 1);
+                runtimeArrays.resize(resource.Set + 1);
+            }
+            DescriptorSetLayoutDesc& set = desc.SetLayouts[resource.Set];
+            if (resource.Count == 0)
+                runtimeArrays[resource.Set].insert(resource.Binding);
+
+            auto it = std::lower_bound(set.Bindings.begin(), set.Bindings.end(), resource.Binding,
+                                       [](const VkDescriptorSetLayoutBinding& b, uint32_t i) { return b.binding < i; });
+
+            const uint32_t count = resource.Count != 0 ? resource.Count : MAX_RUNTIME_ARRAY_DESCRIPTORS;
+            if (it != set.Bindings.end() && it->binding == resource.Binding)
+            {
+                if (it->descriptorType != resource.Type)
+                    NOC_CORE_ERROR("Shader reflection: set {0} binding {1} ({2}) has different types across stages",
+                                   resource.Set, resource.Binding, resource.Name);
+                it->descriptorCount = std::max(it->descriptorCount, count);
+                it->stageFlags |= resource.StageFlags;
+                continue;
+            }
+
+            VkDescriptorSetLayoutBinding binding{};
+            binding.binding         = resource.Binding;
+            binding.descriptorType  = resource.Type;
+            binding.descriptorCount = count;
+            binding.stageFlags      = resource.StageFlags;
+            set.Bindings.insert(it, binding);
+        }
+
+        const VkPushConstantRange& range = stage->GetPushConstantRange();
+        if (range.size != 0)
+        {
+            pushConstantBegin = std::min(pushConstantBegin, range.offset);
+            pushConstantEnd   = std::max(pushConstantEnd, range.offset + range.size);
+            pushConstantStages |= range.stageFlags;
+        }
+    }
+
+    // Runtime arrays are partially bound, and the set's last binding may also have a variable count
+    for (uint32_t i = 0; i < desc.SetLayouts.size(); i++)
+    {
+        DescriptorSetLayoutDesc& set = desc.SetLayouts[i];
+        if (runtimeArrays[i].empty())
+            continue;
+
+        set.BindingFlags.assign(set.Bindings.size(), 0);
+        for (size_t j = 0; j < set.Bindings.size(); j++)
+        {
+            if (!runtimeArrays[i].contains(set.Bindings[j].binding))
+                continue;
+            set.BindingFlags[j] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+            if (j == set.Bindings.size() - 1)
+                set.BindingFlags[j] |= VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT;
+        }
+    }
+
+    if (pushConstantStages != 0)
+        desc.PushConstantRanges.push_back({pushConstantStages, pushConstantBegin, pushConstantEnd - pushConstantBegin});
+
+    return desc;
+}
+
+} // namespace Noctis
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Vulkan.h"
+
+namespace Noctis
+{
+
+struct ShaderResourceBinding
+{
+    uint32_t Set          = 0;
+    uint32_t Binding      = 0;
+    VkDescriptorType Type = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+    // 0 for runtime sized arrays
+    uint32_t Count                = 1;
+    VkShaderStageFlags StageFlags = 0;
+    std::string Name;
+};
+
+struct ShaderVertexInput
+{
+    uint32_t Location = 0;
+    VkFormat Format   = VK_FORMAT_UNDEFINED;
+    uint32_t Size     = 0;
+    std::string Name;
+};
+
+struct VertexInputLayout
+{
+    VkVertexInputBindingDescription Binding{};
+    std::vector<VkVertexInputAttributeDescription> Attributes;
+};
+
+struct DescriptorSetLayoutDesc
+{
+    // Sorted by binding. Entries never use immutable samplers.
+    std::vector<VkDescriptorSetLayoutBinding> Bindings;
+    // Either empty or one entry per binding
+    std::vector<VkDescriptorBindingFlags> BindingFlags;
+    VkDescriptorSetLayoutCreateFlags Flags = 0;
+
+    bool operator==(const DescriptorSetLayoutDesc& other) const;
+    uint64_t GetHash() const;
+};
+
+// Everything a VkPipelineLayout is made of, with the sets indexed by set number. Sets a pipeline doesn't use are
+// left empty, which still makes a valid (empty) set layout.
+struct PipelineLayoutDesc
+{
+    std::vector<DescriptorSetLayoutDesc> SetLayouts;
+    std::vector<VkPushConstantRange> PushConstantRanges;
+};
+
+// Descriptor bindings, push constants and vertex inputs of one SPIR-V shader stage, read straight from the module so
+// layouts never have to be written by hand.
+class VulkanShaderReflection
+{
+  public:
+    VulkanShaderReflection(const std::vector<uint32_t>& spirv);
+    VulkanShaderReflection(const uint32_t* code, size_t wordCount);
+
+    bool IsValid() const { return m_Valid; }
+
+    VkShaderStageFlagBits GetStage() const { return m_Stage; }
+    const std::string& GetEntryPoint() const { return m_EntryPoint; }
+
+    // Sorted by set, then binding
+    const std::vector<ShaderResourceBinding>& GetBindings() const { return m_Bindings; }
+    // Covers all push constant members of the stage, size 0 if there are none
+    const VkPushConstantRange& GetPushConstantRange() const { return m_PushConstantRange; }
+    // Vertex stage only, sorted by location. Built-ins like gl_VertexIndex are skipped.
+    const std::vector<ShaderVertexInput>& GetVertexInputs() const { return m_VertexInputs; }
+    // Compute stage only
+    const std::array<uint32_t, 3>& GetLocalSize() const { return m_LocalSize; }
+
+    // Interleaves the vertex inputs tightly in location order, in a single per vertex buffer
+    VertexInputLayout GetVertexInputLayout(uint32_t binding = 0) const;
+
+    // Unites the stages of a pipeline. A binding used by several stages is visible to all of them, and push
+    // constants become one range spanning all stages' members, so vkCmdPushConstants takes the range's stage flags.
+    static PipelineLayoutDesc CreatePipelineLayoutDesc(const std::vector<const VulkanShaderReflection*>& stages);
+
+    // Descriptor count given to runtime sized arrays (bindless tables), which are created partially bound with a
+    // variable count of at most this many descriptors
+    static constexpr uint32_t MAX_RUNTIME_ARRAY_DESCRIPTORS = 4096;
+
+  private:
+    void Reflect(const uint32_t* code, size_t wordCount);
+
+  private:
+    bool m_Valid = false;
+
+    VkShaderStageFlagBits m_Stage = VK_SHADER_STAGE_ALL;
+    std::string m_EntryPoint;
+
+    std::vector<ShaderResourceBinding> m_Bindings;
+    VkPushConstantRange m_PushConstantRange{};
+    std::vector<ShaderVertexInput> m_VertexInputs;
+    std::array<uint32_t, 3> m_LocalSize = {1, 1, 1};
+};
+
+} // namespace Noctis
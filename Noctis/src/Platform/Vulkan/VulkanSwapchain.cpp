@@ -1,27 +1,56 @@
 #include "VulkanSwapchain.h"
 
+#include "Engine/Renderer/Renderer.h"
+
 namespace Noctis
 {
 
-VulkanSwapchain::VulkanSwapchain(const VulkanDevice& device, const VkSurfaceKHR& surface)
-    : m_Device(device), m_Surface(surface)
+VulkanSwapchain::VulkanSwapchain(const VulkanDevice& device, VulkanAllocator& allocator, const VkSurfaceKHR& surface)
+    : m_Device(device), m_Allocator(allocator), m_Surface(surface)
 {
 }
 
 VulkanSwapchain::~VulkanSwapchain()
 {
+    NOC_PROFILE_FUNCTION();
+
     for (auto imageView : m_SwapchainImageViews)
     {
         vkDestroyImageView(m_Device.GetVkDevice(), imageView, nullptr);
     }
     m_SwapchainImageViews.clear();
 
-    vkDestroySwapchainKHR(m_Device.GetVkDevice(), m_Swapchain, nullptr);
+    if (IsOffscreen())
+    {
+        for (size_t i = 0; i < m_SwapchainImages.size(); i++)
+        {
+            vkDestroyImage(m_Device.GetVkDevice(), m_SwapchainImages[i], nullptr);
+            m_Allocator.Free(m_OffscreenMemory[i]);
+        }
+        m_SwapchainImages.clear();
+        m_OffscreenMemory.clear();
+    }
+
+    // Not even loaded when offscreen, VK_KHR_swapchain isn't enabled then
+    if (m_Swapchain != VK_NULL_HANDLE)
+        vkDestroySwapchainKHR(m_Device.GetVkDevice(), m_Swapchain, nullptr);
     m_Swapchain = VK_NULL_HANDLE;
 }
 
 void VulkanSwapchain::CreateSwapchain(uint32_t width, uint32_t height)
 {
+    NOC_PROFILE_FUNCTION();
+
+    m_Width         = width;
+    m_Height        = height;
+    m_NeedsRecreate = false;
+
+    if (IsOffscreen())
+    {
+        CreateOffscreenImages(width, height);
+        return;
+    }
+
     // Query swapchain support details
     SwapchainSupportDetails details = QuerySwapchainSupport(m_Device.GetVkPhysicalDevice(), m_Surface);
 
@@ -30,7 +59,21 @@ void VulkanSwapchain::CreateSwapchain(uint32_t width, uint32_t height)
     VkPresentModeKHR presentMode     = ChooseSwapPresentMode(details.PresentModes);
     VkExtent2D extent                = ChooseSwapExtent(details.Capabilities, width, height);
 
+    // A minimized window has a zero-sized surface, try again once it has an area
+    if (extent.width == 0 || extent.height == 0)
+    {
+        m_NeedsRecreate = true;
+        return;
+    }
+
+    // Kept alive until frames in flight are done with them, they are released after the new swapchain exists
+    VkSwapchainKHR oldSwapchain            = m_Swapchain;
+    std::vector<VkImageView> oldImageViews = std::move(m_SwapchainImageViews);
+    m_SwapchainImageViews.clear();
+
     uint32_t imageCount = details.Capabilities.minImageCount + 1;
+    if (m_RequestedImageCount > 0)
+        imageCount = std::max(m_RequestedImageCount, details.Capabilities.minImageCount);
     if (details.Capabilities.maxImageCount > 0 && imageCount > details.Capabilities.maxImageCount)
     {
         imageCount = details.Capabilities.maxImageCount;
@@ -56,12 +99,28 @@ void VulkanSwapchain::CreateSwapchain(uint32_t width, uint32_t height)
     createInfo.compositeAlpha         = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
     createInfo.presentMode            = presentMode;
     createInfo.clipped                = VK_TRUE;
-    createInfo.oldSwapchain           = VK_NULL_HANDLE;
+    createInfo.oldSwapchain           = oldSwapchain;
 
     VkResult result = vkCreateSwapchainKHR(m_Device.GetVkDevice(), &createInfo, nullptr, &m_Swapchain);
     NOC_CORE_ASSERT(result == VK_SUCCESS, "Failed to create swapchain!");
 
-    NOC_CORE_INFO("Swapchain created");
+    NOC_CORE_INFO("Swapchain created ({0}x{1})", extent.width, extent.height);
+
+    if (oldSwapchain != VK_NULL_HANDLE)
+    {
+        Renderer::SubmitResourceFree([&device = m_Device, oldSwapchain, oldImageViews]() {
+            // The frame fence doesn't cover presents still queued on the old swapchain. By now they are almost
+            // certainly done, so this rarely waits.
+            {
+                std::lock_guard lock(device.GetQueueMutex());
+                vkQueueWaitIdle(device.GetVkPresentQueue());
+            }
+
+            for (VkImageView imageView : oldImageViews)
+                vkDestroyImageView(device.GetVkDevice(), imageView, nullptr);
+            vkDestroySwapchainKHR(device.GetVkDevice(), oldSwapchain, nullptr);
+        });
+    }
 
     // Retrieve swapchain images
     vkGetSwapchainImagesKHR(m_Device.GetVkDevice(), m_Swapchain, &imageCount, nullptr);
@@ -71,7 +130,11 @@ void VulkanSwapchain::CreateSwapchain(uint32_t width, uint32_t height)
     m_SwapchainImageFormat = surfaceFormat.format;
     m_SwapchainExtent      = extent;
 
-    // Create image views
+    CreateImageViews();
+}
+
+void VulkanSwapchain::CreateImageViews()
+{
     m_SwapchainImageViews.resize(m_SwapchainImages.size());
     for (size_t i = 0; i < m_SwapchainImages.size(); i++)
     {
@@ -90,11 +153,164 @@ void VulkanSwapchain::CreateSwapchain(uint32_t width, uint32_t height)
         viewInfo.subresourceRange.baseArrayLayer = 0;
         viewInfo.subresourceRange.layerCount     = 1;
 
-        result = vkCreateImageView(m_Device.GetVkDevice(), &viewInfo, nullptr, &m_SwapchainImageViews[i]);
+        VkResult result = vkCreateImageView(m_Device.GetVkDevice(), &viewInfo, nullptr, &m_SwapchainImageViews[i]);
         NOC_CORE_ASSERT(result == VK_SUCCESS, "Failed to create image view!");
     }
 }
 
+void VulkanSwapchain::CreateOffscreenImages(uint32_t width, uint32_t height)
+{
+    NOC_PROFILE_FUNCTION();
+
+    if (width == 0 || height == 0)
+    {
+        m_NeedsRecreate = true;
+        return;
+    }
+
+    const VkDevice device = m_Device.GetVkDevice();
+
+    // Same deferred release as a retired swapchain
+    if (!m_SwapchainImages.empty())
+    {
+        Renderer::SubmitResourceFree([device, &allocator = m_Allocator, images = std::move(m_SwapchainImages),
+                                      imageViews = std::move(m_SwapchainImageViews),
+                                      memory = std::move(m_OffscreenMemory)]() mutable {
+            for (size_t i = 0; i < images.size(); i++)
+            {
+                vkDestroyImageView(device, imageViews[i], nullptr);
+                vkDestroyImage(device, images[i], nullptr);
+                allocator.Free(memory[i]);
+            }
+        });
+        m_SwapchainImages.clear();
+        m_SwapchainImageViews.clear();
+        m_OffscreenMemory.clear();
+    }
+
+    m_SwapchainImageFormat = VK_FORMAT_R8G8B8A8_SRGB;
+    m_SwapchainExtent      = {width, height};
+
+    const uint32_t imageCount = std::max(m_RequestedImageCount, MIN_OFFSCREEN_IMAGE_COUNT);
+    m_SwapchainImages.resize(imageCount);
+    m_OffscreenMemory.resize(imageCount);
+
+    for (uint32_t i = 0; i < imageCount; i++)
+    {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imageInfo.format        = m_SwapchainImageFormat;
+        imageInfo.extent        = {width, height, 1};
+        imageInfo.mipLevels     = 1;
+        imageInfo.arrayLayers   = 1;
+        imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage         = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        VK_CHECK_RESULT(vkCreateImage(device, &imageInfo, nullptr, &m_SwapchainImages[i]));
+
+        m_OffscreenMemory[i] = m_Allocator.AllocateImage(m_SwapchainImages[i], MemoryUsage::GPUOnly);
+        NOC_CORE_ASSERT(m_OffscreenMemory[i].IsValid(), "Failed to allocate offscreen image memory!");
+    }
+
+    NOC_CORE_INFO("Offscreen swapchain created ({0}x{1}, {2} images)", width, height, imageCount);
+
+    CreateImageViews();
+}
+
+void VulkanSwapchain::OnResize(uint32_t width, uint32_t height)
+{
+    if (width == m_Width && height == m_Height && IsValid())
+        return;
+
+    m_Width         = width;
+    m_Height        = height;
+    m_NeedsRecreate = true;
+}
+
+void VulkanSwapchain::Recreate()
+{
+    CreateSwapchain(m_Width, m_Height);
+}
+
+void VulkanSwapchain::SetPresentMode(PresentMode mode)
+{
+    if (mode == m_PresentMode)
+        return;
+
+    m_PresentMode   = mode;
+    m_NeedsRecreate = true;
+}
+
+void VulkanSwapchain::SetRequestedImageCount(uint32_t count)
+{
+    if (count == m_RequestedImageCount)
+        return;
+
+    m_RequestedImageCount = count;
+    m_NeedsRecreate       = true;
+}
+
+VkResult VulkanSwapchain::AcquireNextImage(VkSemaphore imageAvailableSemaphore, uint32_t& imageIndex)
+{
+    if (IsOffscreen())
+    {
+        imageIndex            = m_OffscreenImageIndex;
+        m_OffscreenImageIndex = (m_OffscreenImageIndex + 1) % static_cast<uint32_t>(m_SwapchainImages.size());
+
+        // Nothing to wait for, signal the semaphore so the renderer's submit is the same as with a real swapchain
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores    = &imageAvailableSemaphore;
+
+        std::lock_guard lock(m_Device.GetQueueMutex());
+        return vkQueueSubmit(m_Device.GetVkGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
+    }
+
+    const VkResult result = vkAcquireNextImageKHR(m_Device.GetVkDevice(), m_Swapchain, UINT64_MAX,
+                                                  imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+        m_NeedsRecreate = true;
+
+    return result;
+}
+
+VkResult VulkanSwapchain::Present(VkQueue queue, VkSemaphore waitSemaphore, uint32_t imageIndex)
+{
+    std::lock_guard lock(m_Device.GetQueueMutex());
+
+    if (IsOffscreen())
+    {
+        // Consumes the render finished semaphore, the image simply stays in GetImageLayout() for readback
+        const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores    = &waitSemaphore;
+        submitInfo.pWaitDstStageMask  = &waitStage;
+        return vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+    }
+
+    VkPresentInfoKHR presentInfo{};
+    presentInfo.sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    presentInfo.waitSemaphoreCount = 1;
+    presentInfo.pWaitSemaphores    = &waitSemaphore;
+    presentInfo.swapchainCount     = 1;
+    presentInfo.pSwapchains        = &m_Swapchain;
+    presentInfo.pImageIndices      = &imageIndex;
+
+    const VkResult result = vkQueuePresentKHR(queue, &presentInfo);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+        m_NeedsRecreate = true;
+
+    return result;
+}
+
 VulkanSwapchain::SwapchainSupportDetails VulkanSwapchain::QuerySwapchainSupport(VkPhysicalDevice device,
                                                                                 VkSurfaceKHR surface)
 {
@@ -133,14 +349,37 @@ VkSurfaceFormatKHR VulkanSwapchain::ChooseSwapSurfaceFormat(const std::vector<Vk
     return availableFormats[0];
 }
 
-VkPresentModeKHR VulkanSwapchain::ChooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes)
+VkPresentModeKHR VulkanSwapchain::ChooseSwapPresentMode(
+    const std::vector<VkPresentModeKHR>& availablePresentModes) const
 {
-    for (const auto& presentMode : availablePresentModes)
+    struct Candidate
     {
-        if (presentMode == VK_PRESENT_MODE_MAILBOX_KHR)
+        PresentMode Mode;
+        VkPresentModeKHR VulkanMode;
+        const char* Name;
+    };
+
+    // Walks from the requested mode towards Fifo, giving up as little latency as possible. Mailbox never falls back
+    // to FIFO Relaxed, which can tear.
+    static constexpr Candidate candidates[] = {
+        {PresentMode::Immediate, VK_PRESENT_MODE_IMMEDIATE_KHR, "Immediate"},
+        {PresentMode::Mailbox, VK_PRESENT_MODE_MAILBOX_KHR, "Mailbox"},
+        {PresentMode::FifoRelaxed, VK_PRESENT_MODE_FIFO_RELAXED_KHR, "FIFO Relaxed"},
+    };
+
+    for (const Candidate& candidate : candidates)
+    {
+        if (candidate.Mode < m_PresentMode ||
+            (m_PresentMode == PresentMode::Mailbox && candidate.Mode == PresentMode::FifoRelaxed))
+            continue;
+
+        for (const auto& presentMode : availablePresentModes)
         {
-            NOC_CORE_INFO("Present Mode: Mailbox");
-            return presentMode;
+            if (presentMode == candidate.VulkanMode)
+            {
+                NOC_CORE_INFO("Present Mode: {0}", candidate.Name);
+                return presentMode;
+            }
         }
     }
     NOC_CORE_INFO("Present Mode: FIFO");
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "VulkanAllocator.h"
 #include "VulkanDevice.h"
 
+#include "Engine/Renderer/RendererAPI.h"
+
 #include <vulkan/vulkan.h>
 
 namespace Noctis
@@ -10,11 +13,39 @@ namespace Noctis
 class VulkanSwapchain
 {
   public:
-    VulkanSwapchain(const VulkanDevice& device, const VkSurfaceKHR& surface);
+    VulkanSwapchain(const VulkanDevice& device, VulkanAllocator& allocator, const VkSurfaceKHR& surface);
     ~VulkanSwapchain();
 
     void CreateSwapchain(uint32_t width, uint32_t height);
 
+    // Recreation is deferred to the renderer's next frame, which calls Recreate once it is safe to do so
+    void OnResize(uint32_t width, uint32_t height);
+    void Invalidate() { m_NeedsRecreate = true; }
+    bool NeedsRecreate() const { return m_NeedsRecreate; }
+    // Builds a new swapchain from the current one. The old one keeps presenting until the handoff and is destroyed
+    // through Renderer::SubmitResourceFree, once no frame in flight can reference its images.
+    void Recreate();
+
+    // Both flag the swapchain for recreation when they report it out of date or suboptimal
+    VkResult AcquireNextImage(VkSemaphore imageAvailableSemaphore, uint32_t& imageIndex);
+    VkResult Present(VkQueue queue, VkSemaphore waitSemaphore, uint32_t imageIndex);
+
+    bool IsValid() const { return !m_SwapchainImages.empty(); }
+    // Without a surface the "swapchain" is a ring of device-local images, acquire and present only pass the
+    // semaphores along so the renderer runs the exact same path
+    bool IsOffscreen() const { return m_Surface == VK_NULL_HANDLE; }
+    // Layout the images are left in at the end of a frame
+    VkImageLayout GetImageLayout() const
+    {
+        return IsOffscreen() ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    }
+
+    // Both take effect on the next recreation
+    void SetPresentMode(PresentMode mode);
+    void SetRequestedImageCount(uint32_t count);
+    PresentMode GetPresentMode() const { return m_PresentMode; }
+    uint32_t GetRequestedImageCount() const { return m_RequestedImageCount; }
+
     VkSwapchainKHR& GetVkSwapchain() { return m_Swapchain; }
     const std::vector<VkImage>& GetVkSwapchainImages() const { return m_SwapchainImages; }
     const std::vector<VkImageView>& GetVkSwapchainImageViews() const { return m_SwapchainImageViews; }
@@ -30,11 +61,15 @@ class VulkanSwapchain
     };
     SwapchainSupportDetails QuerySwapchainSupport(VkPhysicalDevice device, VkSurfaceKHR surface);
     VkSurfaceFormatKHR ChooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats);
-    VkPresentModeKHR ChooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes);
+    VkPresentModeKHR ChooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes) const;
     VkExtent2D ChooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities, uint32_t width, uint32_t height);
 
+    void CreateImageViews();
+    void CreateOffscreenImages(uint32_t width, uint32_t height);
+
   private:
     const VulkanDevice& m_Device;
+    VulkanAllocator& m_Allocator;
     VkSurfaceKHR m_Surface;
 
     VkSwapchainKHR m_Swapchain = VK_NULL_HANDLE;
@@ -43,6 +78,18 @@ class VulkanSwapchain
 
     VkFormat m_SwapchainImageFormat;
     VkExtent2D m_SwapchainExtent;
+
+    uint32_t m_Width     = 0;
+    uint32_t m_Height    = 0;
+    bool m_NeedsRecreate = false;
+
+    PresentMode m_PresentMode      = PresentMode::Mailbox;
+    uint32_t m_RequestedImageCount = 0;
+
+    // At least as many as the renderer's maximum frames in flight, so its frame fences also guard image reuse
+    static constexpr uint32_t MIN_OFFSCREEN_IMAGE_COUNT = 4;
+    std::vector<VulkanAllocation> m_OffscreenMemory;
+    uint32_t m_OffscreenImageIndex = 0;
 };
 
 } // namespace Noctis
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "VulkanTexture.h"
+#include "VulkanContext.h"
+
+#include "Engine/Renderer/Renderer.h"
+
+namespace Noctis
+{
+
+VulkanTexture2D::VulkanTexture2D(uint32_t width, uint32_t height, const void* pixels)
+    : m_Width(width), m_Height(height)
+{
+    NOC_PROFILE_FUNCTION();
+
+    auto context  = VulkanContext::Get();
+    auto vkDevice = context->GetDevice()->GetVkDevice();
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+    imageInfo.format        = VK_FORMAT_R8G8B8A8_SRGB;
+    imageInfo.extent        = {width, height, 1};
+    imageInfo.mipLevels     = 1;
+    imageInfo.arrayLayers   = 1;
+    imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage         = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VK_CHECK_RESULT(vkCreateImage(vkDevice, &imageInfo, nullptr, &m_Image));
+
+    m_Allocation = context->GetAllocator()->AllocateImage(m_Image, MemoryUsage::GPUOnly);
+    NOC_CORE_ASSERT(m_Allocation.IsValid(), "Out of memory for texture");
+
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType                       = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image                       = m_Image;
+    viewInfo.viewType                    = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format                      = imageInfo.format;
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.layerCount = 1;
+    VK_CHECK_RESULT(vkCreateImageView(vkDevice, &viewInfo, nullptr, &m_ImageView));
+
+    const VkDeviceSize size = static_cast<VkDeviceSize>(width) * height * 4;
+    context->GetUploader()->UploadImage(m_Image, imageInfo.extent, pixels, size,
+                                        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                        VK_ACCESS_SHADER_READ_BIT);
+
+    if (auto bindlessTable = context->GetBindlessTable())
+        m_BindlessIndex = bindlessTable->AddImage(m_ImageView);
+}
+
+VulkanTexture2D::~VulkanTexture2D()
+{
+    if (auto bindlessTable = VulkanContext::Get()->GetBindlessTable())
+        bindlessTable->Remove(BindlessResourceType::SampledImage, m_BindlessIndex);
+
+    Renderer::SubmitResourceFree([image = m_Image, view = m_ImageView, allocation = m_Allocation]() mutable {
+        auto context  = VulkanContext::Get();
+        auto vkDevice = context->GetDevice()->GetVkDevice();
+
+        vkDestroyImageView(vkDevice, view, nullptr);
+        vkDestroyImage(vkDevice, image, nullptr);
+        context->GetAllocator()->Free(allocation);
+    });
+}
+
+} // namespace Noctis
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "VulkanAllocator.h"
+#include "VulkanBindlessTable.h"
+
+#include "Engine/Renderer/Texture.h"
+
+namespace Noctis
+{
+
+class VulkanTexture2D : public Texture2D
+{
+  public:
+    VulkanTexture2D(uint32_t width, uint32_t height, const void* pixels);
+    ~VulkanTexture2D() override;
+
+    uint32_t GetWidth() const override { return m_Width; }
+    uint32_t GetHeight() const override { return m_Height; }
+
+    // In VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, readable from the first graphics submission after creation
+    VkImage GetVkImage() const { return m_Image; }
+    VkImageView GetVkImageView() const { return m_ImageView; }
+    // Index into the bindless table's sampled images, VulkanBindlessTable::INVALID_INDEX without one
+    uint32_t GetBindlessIndex() const { return m_BindlessIndex; }
+
+  private:
+    uint32_t m_Width;
+    uint32_t m_Height;
+
+    VkImage m_Image         = VK_NULL_HANDLE;
+    VkImageView m_ImageView = VK_NULL_HANDLE;
+    VulkanAllocation m_Allocation;
+    uint32_t m_BindlessIndex = VulkanBindlessTable::INVALID_INDEX;
+};
+
+} // namespace Noctis
@@ -0,0 +1,474 @@
+#include "VulkanUploader.h"
+
+#include "Engine/Renderer/Renderer.h"
+
+#include <cstring>
+
+namespace Noctis
+{
+
+namespace
+{
+
+VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+VkBuffer CreateStagingBuffer(VkDevice device, VkDeviceSize size)
+{
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size        = size;
+    bufferInfo.usage       = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VK_CHECK_RESULT(vkCreateBuffer(device, &bufferInfo, nullptr, &buffer));
+    return buffer;
+}
+
+} // namespace
+
+VulkanUploader::VulkanUploader(const VulkanDevice& device, VulkanAllocator& allocator, VkDeviceSize ringSize)
+    : m_Device(device), m_Allocator(allocator), m_RingSize(ringSize)
+{
+    NOC_PROFILE_FUNCTION();
+
+    const QueueFamilyIndices indices = m_Device.GetQueueFamilyIndices();
+
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = indices.TransferFamily;
+    VK_CHECK_RESULT(vkCreateCommandPool(m_Device.GetVkDevice(), &poolInfo, nullptr, &m_TransferCommandPool));
+
+    poolInfo.queueFamilyIndex = indices.GraphicsFamily;
+    VK_CHECK_RESULT(vkCreateCommandPool(m_Device.GetVkDevice(), &poolInfo, nullptr, &m_GraphicsCommandPool));
+
+    // 16 bytes keeps image copies aligned for every texel size up to RGBA32F
+    m_RingAlignment =
+        std::max<VkDeviceSize>(m_Device.GetProperties().limits.optimalBufferCopyOffsetAlignment, 16);
+
+    m_RingBuffer     = CreateStagingBuffer(m_Device.GetVkDevice(), m_RingSize);
+    m_RingAllocation = m_Allocator.AllocateBuffer(m_RingBuffer, MemoryUsage::CPUOnly);
+    NOC_CORE_ASSERT(m_RingAllocation.IsValid() && m_RingAllocation.MappedData, "Failed to allocate the staging ring!");
+
+    NOC_CORE_INFO("Uploader: {0} MB staging ring, {1} transfer queue", m_RingSize / (1024 * 1024),
+                  m_Device.HasDedicatedTransferQueue() ? "dedicated" : "shared graphics");
+}
+
+VulkanUploader::~VulkanUploader()
+{
+    NOC_PROFILE_FUNCTION();
+
+    auto device = m_Device.GetVkDevice();
+
+    {
+        std::lock_guard lock(m_Device.GetQueueMutex());
+        vkQueueWaitIdle(m_Device.GetVkTransferQueue());
+    }
+
+    for (const Scope<UploadBatch>& batch : m_Batches)
+    {
+        for (auto& [buffer, allocation] : batch->OversizedStaging)
+        {
+            vkDestroyBuffer(device, buffer, nullptr);
+            m_Allocator.Free(allocation);
+        }
+        vkDestroyFence(device, batch->Fence, nullptr);
+        vkDestroySemaphore(device, batch->Semaphore, nullptr);
+    }
+    m_Batches.clear();
+
+    vkDestroyBuffer(device, m_RingBuffer, nullptr);
+    m_Allocator.Free(m_RingAllocation);
+
+    vkDestroyCommandPool(device, m_TransferCommandPool, nullptr);
+    vkDestroyCommandPool(device, m_GraphicsCommandPool, nullptr);
+}
+
+uint64_t VulkanUploader::UploadBuffer(VkBuffer buffer, VkDeviceSize offset, const void* data, VkDeviceSize size,
+                                      VkPipelineStageFlags dstStage, VkAccessFlags dstAccess)
+{
+    NOC_PROFILE_FUNCTION();
+
+    std::lock_guard lock(m_Mutex);
+
+    VkBuffer stagingBuffer;
+    VkDeviceSize stagingOffset;
+    void* mapped;
+    if (!AllocateStaging(size, stagingBuffer, stagingOffset, mapped))
+        return 0;
+
+    std::memcpy(mapped, data, size);
+
+    UploadBatch* batch = GetRecordingBatch();
+
+    VkBufferCopy region{};
+    region.srcOffset = stagingOffset;
+    region.dstOffset = offset;
+    region.size      = size;
+    vkCmdCopyBuffer(batch->TransferCommandBuffer, stagingBuffer, buffer, 1, &region);
+
+    const QueueFamilyIndices indices = m_Device.GetQueueFamilyIndices();
+
+    VkBufferMemoryBarrier barrier{};
+    barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.buffer              = buffer;
+    barrier.offset              = offset;
+    barrier.size                = size;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+    if (m_Device.HasDedicatedTransferQueue())
+    {
+        // Release on the transfer queue, the matching acquire runs on the graphics queue after the semaphore wait
+        barrier.srcQueueFamilyIndex = indices.TransferFamily;
+        barrier.dstQueueFamilyIndex = indices.GraphicsFamily;
+        vkCmdPipelineBarrier(batch->TransferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = dstAccess;
+        vkCmdPipelineBarrier(batch->AcquireCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStage, 0, 0, nullptr,
+                             1, &barrier, 0, nullptr);
+        batch->HasAcquires = true;
+    }
+    else
+    {
+        barrier.dstAccessMask = dstAccess;
+        vkCmdPipelineBarrier(batch->TransferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStage, 0, 0, nullptr, 1,
+                             &barrier, 0, nullptr);
+    }
+
+    batch->DstStages |= dstStage;
+    batch->Empty = false;
+    return batch->Id;
+}
+
+uint64_t VulkanUploader::UploadImage(VkImage image, VkExtent3D extent, const void* data, VkDeviceSize size,
+                                     VkImageLayout finalLayout, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess)
+{
+    NOC_PROFILE_FUNCTION();
+
+    std::lock_guard lock(m_Mutex);
+
+    VkBuffer stagingBuffer;
+    VkDeviceSize stagingOffset;
+    void* mapped;
+    if (!AllocateStaging(size, stagingBuffer, stagingOffset, mapped))
+        return 0;
+
+    std::memcpy(mapped, data, size);
+
+    UploadBatch* batch = GetRecordingBatch();
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask                   = 0;
+    barrier.dstAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image                           = image;
+    barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel   = 0;
+    barrier.subresourceRange.levelCount     = 1;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount     = 1;
+    vkCmdPipelineBarrier(batch->TransferCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    VkBufferImageCopy region{};
+    region.bufferOffset                = stagingOffset;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent                 = extent;
+    vkCmdCopyBufferToImage(batch->TransferCommandBuffer, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
+                           &region);
+
+    const QueueFamilyIndices indices = m_Device.GetQueueFamilyIndices();
+
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout     = finalLayout;
+
+    if (m_Device.HasDedicatedTransferQueue())
+    {
+        // The layout transition is part of the ownership transfer, release and acquire must describe it identically
+        barrier.dstAccessMask       = 0;
+        barrier.srcQueueFamilyIndex = indices.TransferFamily;
+        barrier.dstQueueFamilyIndex = indices.GraphicsFamily;
+        vkCmdPipelineBarrier(batch->TransferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = dstAccess;
+        vkCmdPipelineBarrier(batch->AcquireCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStage, 0, 0, nullptr,
+                             0, nullptr, 1, &barrier);
+        batch->HasAcquires = true;
+    }
+    else
+    {
+        barrier.dstAccessMask = dstAccess;
+        vkCmdPipelineBarrier(batch->TransferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStage, 0, 0, nullptr, 0,
+                             nullptr, 1, &barrier);
+    }
+
+    batch->DstStages |= dstStage;
+    batch->Empty = false;
+    return batch->Id;
+}
+
+void VulkanUploader::Flush()
+{
+    NOC_PROFILE_FUNCTION();
+
+    std::lock_guard lock(m_Mutex);
+    FlushInternal();
+}
+
+bool VulkanUploader::IsComplete(uint64_t batchId)
+{
+    std::lock_guard lock(m_Mutex);
+    RetireCompletedBatches(false);
+    return batchId <= m_CompletedBatchId;
+}
+
+void VulkanUploader::ConsumeUploads(std::vector<VkSemaphore>& waitSemaphores,
+                                    std::vector<VkPipelineStageFlags>& waitStages,
+                                    std::vector<VkCommandBuffer>& commandBuffers)
+{
+    std::lock_guard lock(m_Mutex);
+
+    for (UploadBatch* batch : m_PendingBatches)
+    {
+        waitSemaphores.push_back(batch->Semaphore);
+        waitStages.push_back(batch->DstStages);
+        if (batch->HasAcquires)
+            commandBuffers.push_back(batch->AcquireCommandBuffer);
+
+        // The semaphore and acquire command buffer belong to the graphics submission from here on
+        Renderer::SubmitResourceFree([this, batch]() { RecycleBatch(batch); });
+    }
+    m_PendingBatches.clear();
+}
+
+VulkanUploader::UploadBatch* VulkanUploader::GetRecordingBatch()
+{
+    if (!m_RecordingBatch)
+        m_RecordingBatch = AcquireBatch();
+
+    return m_RecordingBatch;
+}
+
+VulkanUploader::UploadBatch* VulkanUploader::AcquireBatch()
+{
+    auto device = m_Device.GetVkDevice();
+
+    UploadBatch* batch = nullptr;
+    if (!m_FreeBatches.empty())
+    {
+        batch = m_FreeBatches.back();
+        m_FreeBatches.pop_back();
+
+        vkResetFences(device, 1, &batch->Fence);
+        vkResetCommandBuffer(batch->TransferCommandBuffer, 0);
+        vkResetCommandBuffer(batch->AcquireCommandBuffer, 0);
+    }
+    else
+    {
+        m_Batches.push_back(CreateScope<UploadBatch>());
+        batch = m_Batches.back().get();
+
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool        = m_TransferCommandPool;
+        allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+        VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &allocInfo, &batch->TransferCommandBuffer));
+
+        allocInfo.commandPool = m_GraphicsCommandPool;
+        VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &allocInfo, &batch->AcquireCommandBuffer));
+
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        VK_CHECK_RESULT(vkCreateFence(device, &fenceInfo, nullptr, &batch->Fence));
+
+        VkSemaphoreCreateInfo semaphoreInfo{};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &batch->Semaphore));
+    }
+
+    batch->Id          = m_NextBatchId++;
+    batch->DstStages   = 0;
+    batch->HasAcquires = false;
+    batch->Empty       = true;
+    batch->RingEnd     = 0;
+    batch->RingBytes   = 0;
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    VK_CHECK_RESULT(vkBeginCommandBuffer(batch->TransferCommandBuffer, &beginInfo));
+    VK_CHECK_RESULT(vkBeginCommandBuffer(batch->AcquireCommandBuffer, &beginInfo));
+
+    return batch;
+}
+
+void VulkanUploader::RecycleBatch(UploadBatch* batch)
+{
+    std::lock_guard lock(m_Mutex);
+
+    // The graphics submission that waited on the batch is done, so is the transfer it waited for
+    RetireCompletedBatches(false);
+    m_FreeBatches.push_back(batch);
+}
+
+void VulkanUploader::FlushInternal()
+{
+    if (!m_RecordingBatch || m_RecordingBatch->Empty)
+        return;
+
+    UploadBatch* batch = m_RecordingBatch;
+    m_RecordingBatch   = nullptr;
+
+    VK_CHECK_RESULT(vkEndCommandBuffer(batch->TransferCommandBuffer));
+    VK_CHECK_RESULT(vkEndCommandBuffer(batch->AcquireCommandBuffer));
+
+    batch->RingEnd = m_RingHead;
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount   = 1;
+    submitInfo.pCommandBuffers      = &batch->TransferCommandBuffer;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores    = &batch->Semaphore;
+
+    {
+        NOC_PROFILE_SCOPE("vkQueueSubmit");
+        std::lock_guard lock(m_Device.GetQueueMutex());
+        VK_CHECK_RESULT(vkQueueSubmit(m_Device.GetVkTransferQueue(), 1, &submitInfo, batch->Fence));
+    }
+
+    m_InFlightBatches.push_back(batch);
+    m_PendingBatches.push_back(batch);
+}
+
+bool VulkanUploader::AllocateStaging(VkDeviceSize size, VkBuffer& buffer, VkDeviceSize& offset, void*& mapped)
+{
+    // Big uploads get a staging buffer of their own instead of draining the ring for every other upload
+    if (size > m_RingSize / 4)
+    {
+        buffer                      = CreateStagingBuffer(m_Device.GetVkDevice(), size);
+        VulkanAllocation allocation = m_Allocator.AllocateBuffer(buffer, MemoryUsage::CPUOnly);
+        if (!allocation.IsValid())
+        {
+            vkDestroyBuffer(m_Device.GetVkDevice(), buffer, nullptr);
+            NOC_CORE_ERROR("Uploader: failed to allocate {0} bytes of staging memory", size);
+            return false;
+        }
+
+        offset = 0;
+        mapped = allocation.MappedData;
+        GetRecordingBatch()->OversizedStaging.emplace_back(buffer, allocation);
+        return true;
+    }
+
+    while (true)
+    {
+        const VkDeviceSize usedBefore = m_RingUsed;
+        if (TryAllocateRing(size, offset))
+        {
+            GetRecordingBatch()->RingBytes += m_RingUsed - usedBefore;
+            break;
+        }
+
+        // The ring is full of this batch's uploads: submit them and wait for the copies, not for rendering
+        if (m_InFlightBatches.empty())
+            FlushInternal();
+
+        NOC_PROFILE_SCOPE("Uploader::WaitForRing");
+        RetireCompletedBatches(true);
+    }
+
+    buffer = m_RingBuffer;
+    mapped = static_cast<uint8_t*>(m_RingAllocation.MappedData) + offset;
+    return true;
+}
+
+bool VulkanUploader::TryAllocateRing(VkDeviceSize size, VkDeviceSize& offset)
+{
+    if (m_RingUsed == 0)
+    {
+        m_RingHead = 0;
+        m_RingTail = 0;
+    }
+
+    const VkDeviceSize aligned = AlignUp(m_RingHead, m_RingAlignment);
+    const bool full            = m_RingUsed > 0 && m_RingHead == m_RingTail;
+
+    if (m_RingHead >= m_RingTail && !full)
+    {
+        // Free space is [head, end) followed by [0, tail)
+        if (aligned + size <= m_RingSize)
+        {
+            offset = aligned;
+            m_RingUsed += aligned + size - m_RingHead;
+            m_RingHead = aligned + size;
+            return true;
+        }
+        if (size <= m_RingTail)
+        {
+            // The end of the ring is wasted until the tail wraps around as well
+            offset = 0;
+            m_RingUsed += m_RingSize - m_RingHead + size;
+            m_RingHead = size;
+            return true;
+        }
+        return false;
+    }
+
+    if (!full && aligned + size <= m_RingTail)
+    {
+        offset = aligned;
+        m_RingUsed += aligned + size - m_RingHead;
+        m_RingHead = aligned + size;
+        return true;
+    }
+    return false;
+}
+
+void VulkanUploader::RetireCompletedBatches(bool wait)
+{
+    auto device = m_Device.GetVkDevice();
+
+    if (wait && !m_InFlightBatches.empty())
+        vkWaitForFences(device, 1, &m_InFlightBatches.front()->Fence, VK_TRUE, UINT64_MAX);
+
+    while (!m_InFlightBatches.empty())
+    {
+        UploadBatch* batch = m_InFlightBatches.front();
+        if (vkGetFenceStatus(device, batch->Fence) != VK_SUCCESS)
+            break;
+
+        m_RingTail = batch->RingEnd;
+        m_RingUsed -= batch->RingBytes;
+
+        for (auto& [buffer, allocation] : batch->OversizedStaging)
+        {
+            vkDestroyBuffer(device, buffer, nullptr);
+            m_Allocator.Free(allocation);
+        }
+        batch->OversizedStaging.clear();
+
+        m_CompletedBatchId = batch->Id;
+        m_InFlightBatches.pop_front();
+    }
+}
+
+} // namespace Noctis
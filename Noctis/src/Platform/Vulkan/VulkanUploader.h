@@ -0,0 +1,113 @@
+#pragma once
+
+#include "VulkanAllocator.h"
+#include "VulkanDevice.h"
+
+#include <deque>
+#include <mutex>
+
+namespace Noctis
+{
+
+// Streams buffer and image data to the GPU through a persistently mapped staging ring on the transfer queue.
+// Uploads are batched into one transfer submission per frame (or sooner when the ring fills up), and the renderer's
+// next graphics submission waits on it and acquires ownership of the uploaded resources, so a texture or mesh in
+// flight never stalls rendering. Thread safe: streaming threads may upload while the main thread renders.
+//
+// Destination resources must use VK_SHARING_MODE_EXCLUSIVE and must not be used by the GPU before the graphics
+// submission that follows the upload.
+class VulkanUploader
+{
+  public:
+    VulkanUploader(const VulkanDevice& device, VulkanAllocator& allocator, VkDeviceSize ringSize = DEFAULT_RING_SIZE);
+    ~VulkanUploader();
+
+    VulkanUploader(const VulkanUploader&)            = delete;
+    VulkanUploader& operator=(const VulkanUploader&) = delete;
+
+    // dstStage and dstAccess describe the first use of the data on the graphics queue. The returned batch id can be
+    // passed to IsComplete.
+    uint64_t UploadBuffer(VkBuffer buffer, VkDeviceSize offset, const void* data, VkDeviceSize size,
+                          VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+    // Fills mip 0, layer 0 of a color image, whose previous contents are discarded. The image ends up in finalLayout.
+    uint64_t UploadImage(VkImage image, VkExtent3D extent, const void* data, VkDeviceSize size,
+                         VkImageLayout finalLayout, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+
+    // Submits the uploads recorded so far to the transfer queue
+    void Flush();
+    // True once the transfer queue has finished the batch
+    bool IsComplete(uint64_t batchId);
+
+    // Called by the renderer right before its graphics submission, after Flush. Appends the semaphores the
+    // submission has to wait on and the command buffers acquiring the uploaded resources, which must come before the
+    // frame's own command buffers.
+    void ConsumeUploads(std::vector<VkSemaphore>& waitSemaphores, std::vector<VkPipelineStageFlags>& waitStages,
+                        std::vector<VkCommandBuffer>& commandBuffers);
+
+    VkDeviceSize GetRingSize() const { return m_RingSize; }
+
+    static constexpr VkDeviceSize DEFAULT_RING_SIZE = 64ull * 1024 * 1024;
+
+  private:
+    struct UploadBatch
+    {
+        uint64_t Id = 0;
+
+        VkCommandBuffer TransferCommandBuffer = VK_NULL_HANDLE;
+        // Ownership acquire barriers, recorded on the graphics family. Unused without a dedicated transfer queue.
+        VkCommandBuffer AcquireCommandBuffer = VK_NULL_HANDLE;
+        VkFence Fence                        = VK_NULL_HANDLE;
+        VkSemaphore Semaphore                = VK_NULL_HANDLE;
+
+        VkPipelineStageFlags DstStages = 0;
+        bool HasAcquires               = false;
+        bool Empty                     = true;
+
+        // Ring space to give back once the transfer is done, and staging buffers for uploads bigger than the ring
+        VkDeviceSize RingEnd   = 0;
+        VkDeviceSize RingBytes = 0;
+        std::vector<std::pair<VkBuffer, VulkanAllocation>> OversizedStaging;
+    };
+
+    UploadBatch* GetRecordingBatch();
+    UploadBatch* AcquireBatch();
+    void RecycleBatch(UploadBatch* batch);
+    void FlushInternal();
+
+    // Ring space for size bytes, waiting for in flight batches if the ring is full. Returns false if the upload
+    // can never fit in the ring.
+    bool AllocateStaging(VkDeviceSize size, VkBuffer& buffer, VkDeviceSize& offset, void*& mapped);
+    bool TryAllocateRing(VkDeviceSize size, VkDeviceSize& offset);
+    // Gives back the ring space of finished batches, in submission order
+    void RetireCompletedBatches(bool wait);
+
+  private:
+    const VulkanDevice& m_Device;
+    VulkanAllocator& m_Allocator;
+
+    VkCommandPool m_TransferCommandPool = VK_NULL_HANDLE;
+    VkCommandPool m_GraphicsCommandPool = VK_NULL_HANDLE;
+
+    VkBuffer m_RingBuffer = VK_NULL_HANDLE;
+    VulkanAllocation m_RingAllocation;
+    VkDeviceSize m_RingSize;
+    VkDeviceSize m_RingAlignment;
+    // Writes go at the head, the tail is where the oldest batch still being transferred starts
+    VkDeviceSize m_RingHead = 0;
+    VkDeviceSize m_RingTail = 0;
+    VkDeviceSize m_RingUsed = 0;
+
+    std::mutex m_Mutex;
+    std::vector<Scope<UploadBatch>> m_Batches;
+    std::vector<UploadBatch*> m_FreeBatches;
+    UploadBatch* m_RecordingBatch = nullptr;
+    // Submitted to the transfer queue, oldest first, until their ring space is given back
+    std::deque<UploadBatch*> m_InFlightBatches;
+    // Submitted but not yet waited on by a graphics submission
+    std::vector<UploadBatch*> m_PendingBatches;
+
+    uint64_t m_NextBatchId      = 1;
+    uint64_t m_CompletedBatchId = 0;
+};
+
+} // namespace Noctis
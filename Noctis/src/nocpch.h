@@ -15,4 +15,6 @@
 #include <unordered_set>
 
 #include "Engine/Core/Base.h"
-#include "Engine/Core/Log.h"
\ No newline at end of file
+#include "Engine/Core/Log.h"
+#include "Engine/Debug/MemoryTracker.h"
+#include "Engine/Debug/Profiler.h"
\ No newline at end of file